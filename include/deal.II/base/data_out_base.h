@@ -31,6 +31,7 @@
 #include <boost/serialization/map.hpp>
 
 #include <limits>
+#include <map>
 #include <ostream>
 #include <string>
 #include <tuple>
@@ -1219,6 +1220,105 @@ namespace DataOutBase
   };
 
 
+  /**
+   * Flags controlling the details of output in the VTKHDF format, see
+   * DataOutBase::write_vtkhdf_parallel().
+   *
+   * @ingroup output
+   */
+  struct VtkHdfFlags : public OutputFlagsBase<VtkHdfFlags>
+  {
+    /**
+     * The time associated with the data written. Every call to
+     * DataOutBase::write_vtkhdf_parallel() adds one time step with this
+     * time value to the file.
+     */
+    double time;
+
+    /**
+     * If <tt>true</tt> and the output file already exists, the data is
+     * appended to the file as an additional time step instead of replacing
+     * the file. This way, all time steps of a simulation end up in a single
+     * file that visualization programs read as a time series. If the file
+     * does not yet exist, it is created in either case.
+     *
+     * Default is <tt>false</tt>.
+     */
+    bool append_time_step;
+
+    /**
+     * Flag determining the compression level at which zlib is run on the
+     * chunks of the datasets written. Both <tt>no_compression</tt> and
+     * <tt>plain_text</tt> disable compression. The default is
+     * <tt>best_speed</tt>.
+     */
+    DataOutBase::CompressionLevel compression_level;
+
+    /**
+     * The number of rows (i.e., points, cells, or connectivity entries) per
+     * chunk of the datasets in the file. Chunks are the unit in which
+     * HDF5 compresses data and in which datasets grow when appending time
+     * steps.
+     *
+     * Default is 16384.
+     */
+    unsigned int chunk_size;
+
+    /**
+     * Flag determining whether to write patches as linear cells or as a
+     * high-order Lagrange cell, see VtkFlags::write_higher_order_cells.
+     *
+     * Default is <tt>false</tt>.
+     */
+    bool write_higher_order_cells;
+
+    /**
+     * Flag determining whether the mesh (i.e., the points and the cells) is
+     * written along with the point data. If this flag is <tt>false</tt> and
+     * a time step is appended to an existing file, only the point data is
+     * written and the new time step refers to the mesh of the previous time
+     * step. This requires that the patches of every process have the same
+     * geometry and connectivity as in the previous time step; in particular,
+     * that each process has the same number of points. The mesh is always
+     * written when a new file is created.
+     *
+     * Default is <tt>true</tt>.
+     */
+    bool write_mesh;
+
+    /**
+     * Flag determining whether DataOutInterface::write_vtkhdf_parallel() may
+     * skip writing the mesh of a time step on its own. If this flag and
+     * #write_mesh are both <tt>true</tt>, that function only writes the mesh
+     * if the patches have changed, according to
+     * DataOutInterface::patch_geometry_revision(), since the same object last
+     * wrote the mesh into the same file. Otherwise, the new time step refers
+     * to the mesh of the time step that last wrote it. This also works if
+     * output is only written every few time steps, or alternately into
+     * several files.
+     *
+     * This flag has no effect in DataOutBase::write_vtkhdf_parallel(), which
+     * does not know about earlier output.
+     *
+     * Default is <tt>false</tt>.
+     */
+    bool reuse_unchanged_mesh;
+
+    /**
+     * Constructor. Initializes the member variables with names corresponding
+     * to the argument names of this function.
+     */
+    explicit VtkHdfFlags(
+      const double           time              = 0.,
+      const bool             append_time_step  = false,
+      const CompressionLevel compression_level = CompressionLevel::best_speed,
+      const unsigned int     chunk_size        = 16384,
+      const bool             write_higher_order_cells = false,
+      const bool             write_mesh               = true,
+      const bool             reuse_unchanged_mesh     = false);
+  };
+
+
   /**
    * Flags for SVG output.
    *
@@ -1661,7 +1761,13 @@ namespace DataOutBase
     /**
      * Output in HDF5 format.
      */
-    hdf5
+    hdf5,
+
+    /**
+     * Output in the VTKHDF format, i.e., an HDF5 file laid out so that VTK
+     * based programs such as Paraview can read it directly.
+     */
+    vtkhdf
   };
 
 
@@ -2396,6 +2502,46 @@ namespace DataOutBase
                       const std::string &solution_filename,
                       const MPI_Comm     comm);
 
+  /**
+   * Write the given list of patches into a single file in the VTKHDF format
+   * (an "UnstructuredGrid" in the terminology of VTK), which Paraview and
+   * other VTK based programs read natively.
+   *
+   * In contrast to write_vtu(), the data is not encoded as text but written
+   * as binary HDF5 datasets, optionally compressed chunk by chunk (see
+   * VtkHdfFlags::compression_level). In contrast to write_vtu_in_parallel()
+   * and write_vtu_with_pvtu_record(), all processes in @p comm write their
+   * part of the data into the same file via collective parallel HDF5 I/O,
+   * and each process's data forms one "part" of the data set, so that no
+   * additional record file is necessary.
+   *
+   * If VtkHdfFlags::append_time_step is set and the file already exists, the
+   * data is appended as a new time step to the existing file, so that the
+   * output of a whole time dependent simulation can be kept in a single file.
+   * All time steps need to provide the same data sets, but the mesh, the
+   * number of processes, and the partitioning may change between time steps.
+   * If the mesh does not change, setting VtkHdfFlags::write_mesh to
+   * <tt>false</tt> makes the appended time step refer to the mesh of the
+   * previous one, so that only the point data is written and the cost of
+   * writing a time step no longer depends on the size of the mesh.
+   *
+   * This function requires deal.II to be configured with HDF5 support.
+   */
+  template <int dim, int spacedim>
+  void
+  write_vtkhdf_parallel(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string>          &data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+                      &nonscalar_data_ranges,
+    const VtkHdfFlags &flags,
+    const std::string &filename,
+    const MPI_Comm     comm);
+
   /**
    * DataOutFilter is an intermediate data format that reduces the amount of
    * data that will be written to files. The object filled by this function
@@ -2952,6 +3098,31 @@ public:
                       const std::string                &solution_filename,
                       const MPI_Comm                    comm) const;
 
+  /**
+   * Collective MPI call to write the data of all processes in @p comm into a
+   * single file in the VTKHDF format, see DataOutBase::write_vtkhdf_parallel()
+   * for details. Time series are written by calling this function once per
+   * time step with the same file name after setting
+   * DataOutBase::VtkHdfFlags::time and
+   * DataOutBase::VtkHdfFlags::append_time_step via set_flags():
+   * @code
+   * DataOutBase::VtkHdfFlags flags;
+   * flags.time             = time;
+   * flags.append_time_step = (timestep_number > 0);
+   * data_out.set_flags(flags);
+   * data_out.write_vtkhdf_parallel("solution.vtkhdf", MPI_COMM_WORLD);
+   * @endcode
+   *
+   * If DataOutBase::VtkHdfFlags::reuse_unchanged_mesh is set, this object
+   * remembers for every file name the time step into which it last wrote
+   * the mesh, along with the patch_geometry_revision() of the patches at
+   * that time. Appended time steps then only contain the point data and
+   * refer to the mesh of that time step if the revision is still the same on
+   * all processes of @p comm.
+   */
+  void
+  write_vtkhdf_parallel(const std::string &filename, const MPI_Comm comm) const;
+
   /**
    * DataOutFilter is an intermediate data format that reduces the amount of
    * data that will be written to files. The object filled by this function
@@ -3038,6 +3209,44 @@ public:
   std::size_t
   memory_consumption() const;
 
+  /**
+   * Return whether the patches returned by get_patches() have the same
+   * geometry and connectivity as the previous set of patches this object
+   * provided (e.g., before the last call to DataOut::build_patches()), i.e.,
+   * whether only the data stored on the patches has changed since. Writers
+   * that can refer to the mesh of an earlier output, such as
+   * write_vtkhdf_parallel(), use this to only write the data, and users can
+   * use it to decide whether a new mesh file needs to be written in
+   * write_hdf5_parallel().
+   *
+   * The result refers to the patches of the current process only. Parallel
+   * writers need to combine it over all processes, as
+   * write_vtkhdf_parallel() does.
+   *
+   * Derived classes that can track changes of the mesh, for example
+   * DataOut, override this function. The default implementation always
+   * returns <tt>false</tt>.
+   */
+  virtual bool
+  patch_geometry_unchanged() const;
+
+  /**
+   * Return a number that identifies the geometry and connectivity of the
+   * patches returned by get_patches(). Two calls to this function return the
+   * same number only if the patches have kept their geometry in between,
+   * even if they have been rebuilt several times (e.g., by several calls to
+   * DataOut::build_patches()). write_vtkhdf_parallel() uses this to decide
+   * whether the mesh already written into a file can be reused, see
+   * DataOutBase::VtkHdfFlags::reuse_unchanged_mesh.
+   *
+   * As for patch_geometry_unchanged(), the result refers to the patches of
+   * the current process only. The default implementation returns
+   * numbers::invalid_unsigned_int, which means that changes of the geometry
+   * are not tracked and the mesh is never reused.
+   */
+  virtual unsigned int
+  patch_geometry_revision() const;
+
 protected:
   /**
    * This is the abstract function through which derived classes propagate
@@ -3160,6 +3369,20 @@ private:
    */
   DataOutBase::VtkFlags vtk_flags;
 
+  /**
+   * Flags to be used upon output of VTKHDF data. Can be changed by using the
+   * <tt>set_flags</tt> function.
+   */
+  DataOutBase::VtkHdfFlags vtkhdf_flags;
+
+  /**
+   * For each file written by write_vtkhdf_parallel(), the
+   * patch_geometry_revision() of the last mesh this object wrote into it,
+   * and the index of the time step that contains this mesh.
+   */
+  mutable std::map<std::string, std::pair<unsigned int, unsigned int>>
+    vtkhdf_mesh_time_steps;
+
   /**
    * Flags to be used upon output of svg data in one space dimension. Can be
    * changed by using the <tt>set_flags</tt> function.
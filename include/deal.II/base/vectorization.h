@@ -1425,6 +1425,23 @@ public:
     data = vld1q_f32(ptr);
   }
 
+  /**
+   * Load @p size() double-precision values from memory into the calling
+   * class, starting at the given address, and convert them to single
+   * precision. The result for each entry is the same as that of a
+   * `static_cast<float>`, i.e., the value is rounded to the nearest
+   * representable float with the default rounding mode. The memory need not
+   * be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int i = 0; i < 4; ++i)
+      data[i] = ptr[i];
+  }
+
   /**
    * Write the content of the calling class into memory in form of @p
    * size() to the given address. The memory need not be aligned by
@@ -1437,6 +1454,20 @@ public:
     vst1q_f32(ptr, data);
   }
 
+  /**
+   * Write the content of the calling class into memory in form of @p size()
+   * double-precision values to the given address. The conversion from single
+   * to double precision is exact. The memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int i = 0; i < 4; ++i)
+      ptr[i] = data[i];
+  }
+
   /**
    * @copydoc VectorizedArray<Number>::streaming_store()
    * @note Memory must be aligned by 16 bytes.
@@ -2221,6 +2252,22 @@ public:
     data = _mm_loadu_ps(ptr);
   }
 
+  /**
+   * Load @p size() double-precision values from memory into the calling
+   * class, starting at the given address, and convert them to single
+   * precision. The result for each entry is the same as that of a
+   * `static_cast<float>`, i.e., the value is rounded to the nearest
+   * representable float with the default rounding mode. The memory need not
+   * be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    data = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(ptr)),
+                         _mm_cvtpd_ps(_mm_loadu_pd(ptr + 2)));
+  }
+
   /**
    * Write the content of the calling class into memory in form of @p
    * size() to the given address. The memory need not be aligned by
@@ -2234,6 +2281,19 @@ public:
     _mm_storeu_ps(ptr, data);
   }
 
+  /**
+   * Write the content of the calling class into memory in form of @p size()
+   * double-precision values to the given address. The conversion from single
+   * to double precision is exact. The memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    _mm_storeu_pd(ptr, _mm_cvtps_pd(data));
+    _mm_storeu_pd(ptr + 2, _mm_cvtps_pd(_mm_movehl_ps(data, data)));
+  }
+
   /**
    * @copydoc VectorizedArray<Number>::streaming_store()
    * @note Memory must be aligned by 16 bytes.
@@ -3323,6 +3383,24 @@ public:
     data = _mm256_loadu_ps(ptr);
   }
 
+  /**
+   * Load @p size() double-precision values from memory into the calling
+   * class, starting at the given address, and convert them to single
+   * precision. The result for each entry is the same as that of a
+   * `static_cast<float>`, i.e., the value is rounded to the nearest
+   * representable float with the default rounding mode. The memory need not
+   * be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    data = _mm256_insertf128_ps(
+      _mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(ptr))),
+      _mm256_cvtpd_ps(_mm256_loadu_pd(ptr + 4)),
+      1);
+  }
+
   /**
    * Write the content of the calling class into memory in form of @p
    * size() to the given address. The memory need not be aligned by
@@ -3336,6 +3414,19 @@ public:
     _mm256_storeu_ps(ptr, data);
   }
 
+  /**
+   * Write the content of the calling class into memory in form of @p size()
+   * double-precision values to the given address. The conversion from single
+   * to double precision is exact. The memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    _mm256_storeu_pd(ptr, _mm256_cvtps_pd(_mm256_castps256_ps128(data)));
+    _mm256_storeu_pd(ptr + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(data, 1)));
+  }
+
   /**
    * @copydoc VectorizedArray<Number>::streaming_store()
    * @note Memory must be aligned by 32 bytes.
@@ -4566,6 +4657,28 @@ public:
     data = _mm512_loadu_ps(ptr);
   }
 
+  /**
+   * Load @p size() double-precision values from memory into the calling
+   * class, starting at the given address, and convert them to single
+   * precision. The result for each entry is the same as that of a
+   * `static_cast<float>`, i.e., the value is rounded to the nearest
+   * representable float with the default rounding mode. The memory need not
+   * be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    // convert the two halves separately and combine them with a 256-bit
+    // insert on the double representation, which only needs AVX-512F
+    const __m256 low  = _mm512_cvtpd_ps(_mm512_loadu_pd(ptr));
+    const __m256 high = _mm512_cvtpd_ps(_mm512_loadu_pd(ptr + 8));
+    data              = _mm512_castpd_ps(
+      _mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(low)),
+                         _mm256_castps_pd(high),
+                         1));
+  }
+
   /**
    * Write the content of the calling class into memory in form of @p
    * size() to the given address. The memory need not be aligned by
@@ -4579,6 +4692,21 @@ public:
     _mm512_storeu_ps(ptr, data);
   }
 
+  /**
+   * Write the content of the calling class into memory in form of @p size()
+   * double-precision values to the given address. The conversion from single
+   * to double precision is exact. The memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    _mm512_storeu_pd(ptr, _mm512_cvtps_pd(_mm512_castps512_ps256(data)));
+    _mm512_storeu_pd(ptr + 8,
+                     _mm512_cvtps_pd(_mm256_castpd_ps(
+                       _mm512_extractf64x4_pd(_mm512_castps_pd(data), 1))));
+  }
+
   /**
    * @copydoc VectorizedArray<Number>::streaming_store()
    * @note Memory must be aligned by 64 bytes.
@@ -5265,6 +5393,20 @@ public:
     data = vec_vsx_ld(0, ptr);
   }
 
+  /**
+   * Load @p size() single-precision values from memory into the calling
+   * class, starting at the given address, and convert them to double
+   * precision. The conversion is exact. The memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const float *ptr)
+  {
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int i = 0; i < 2; ++i)
+      data[i] = ptr[i];
+  }
+
   /**
    * Write the content of the calling class into memory in form of @p
    * size() to the given address.
@@ -5276,6 +5418,22 @@ public:
     vec_vsx_st(data, 0, ptr);
   }
 
+  /**
+   * Write the content of the calling class into memory in form of @p size()
+   * single-precision values to the given address. The result for each entry
+   * is the same as that of a `static_cast<float>`, i.e., the value is rounded
+   * to the nearest representable float with the default rounding mode. The
+   * memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(float *ptr) const
+  {
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int i = 0; i < 2; ++i)
+      ptr[i] = data[i];
+  }
+
   /**
    * @copydoc VectorizedArray<Number>::streaming_store()
    */
@@ -5526,6 +5684,23 @@ public:
     data = vec_vsx_ld(0, ptr);
   }
 
+  /**
+   * Load @p size() double-precision values from memory into the calling
+   * class, starting at the given address, and convert them to single
+   * precision. The result for each entry is the same as that of a
+   * `static_cast<float>`, i.e., the value is rounded to the nearest
+   * representable float with the default rounding mode. The memory need not
+   * be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int i = 0; i < 4; ++i)
+      data[i] = ptr[i];
+  }
+
   /**
    * Write the content of the calling class into memory in form of @p
    * size() to the given address.
@@ -5537,6 +5712,20 @@ public:
     vec_vsx_st(data, 0, ptr);
   }
 
+  /**
+   * Write the content of the calling class into memory in form of @p size()
+   * double-precision values to the given address. The conversion from single
+   * to double precision is exact. The memory need not be aligned.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int i = 0; i < 4; ++i)
+      ptr[i] = data[i];
+  }
+
   /**
    * @copydoc VectorizedArray<Number>::streaming_store()
    */
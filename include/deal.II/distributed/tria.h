@@ -345,7 +345,22 @@ namespace parallel
          * active cell that owns an arbitrary point in case all attached
          * manifolds are flat.
          */
-        communicate_vertices_to_p4est = 0x8
+        communicate_vertices_to_p4est = 0x8,
+        /**
+         * If set, save() and load() transfer the data attached to cells (for
+         * example by SolutionTransfer) by mapping each process's section of
+         * the checkpoint files into memory rather than via MPI I/O. The
+         * receiving buffers are filled with a single copy out of the mapped
+         * files, without zero-initializing them first. The files have the
+         * same layout in both cases, so checkpoints written with this flag
+         * can be read without it and vice versa.
+         *
+         * This requires a file system whose <tt>mmap</tt> semantics are
+         * coherent across all processes writing to the same file, such as
+         * node-local storage. It has no effect on platforms without
+         * memory-mapped files.
+         */
+        memory_mapped_checkpoint = 0x10
       };
 
 
@@ -890,7 +905,8 @@ namespace parallel
         mesh_reconstruction_after_repartitioning = 0x1,
         construct_multigrid_hierarchy            = 0x2,
         no_automatic_repartitioning              = 0x4,
-        communicate_vertices_to_p4est            = 0x8
+        communicate_vertices_to_p4est            = 0x8,
+        memory_mapped_checkpoint                 = 0x10
       };
 
       /**
@@ -1025,7 +1041,8 @@ namespace parallel
         mesh_reconstruction_after_repartitioning = 0x1,
         construct_multigrid_hierarchy            = 0x2,
         no_automatic_repartitioning              = 0x4,
-        communicate_vertices_to_p4est            = 0x8
+        communicate_vertices_to_p4est            = 0x8,
+        memory_mapped_checkpoint                 = 0x10
       };
 
       /**
@@ -0,0 +1,228 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_dof_numbering_transfer_h
+#define dealii_dof_numbering_transfer_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class AffineConstraints;
+class SparsityPattern;
+#endif
+
+/**
+ * A class that carries the numbering of the degrees of freedom of a
+ * DoFHandler and the sparsity pattern built on it over a step of mesh
+ * refinement and coarsening, such that only the parts that are affected by
+ * the changes of the mesh need to be set up anew.
+ *
+ * After every change of the mesh, adaptive programs call
+ * DoFHandler::distribute_dofs(), possibly renumber the degrees of freedom,
+ * and build a new sparsity pattern. If only a small fraction of the cells
+ * is refined or coarsened, most of this work reproduces what was there
+ * before: the degrees of freedom on all other cells still exist, and so do
+ * the rows of the sparsity pattern that only couple them among each other.
+ * This class connects to the Triangulation::Signals::pre_refinement signal
+ * and records the degrees of freedom of all active cells at the time the
+ * refinement and coarsening flags are final. After the degrees of freedom
+ * have been distributed on the new mesh, it can
+ * - renumber the degrees of freedom such that the ones that existed before
+ *   keep their relative order, and new ones are placed next to the degrees
+ *   of freedom of the cells they replace, see renumber_dofs(). A numbering
+ *   computed once, for example with DoFRenumbering::Cuthill_McKee(), is
+ *   thereby kept up to date without running the renumbering algorithm on
+ *   the whole mesh again.
+ * - update the sparsity pattern by copying the rows of all degrees of
+ *   freedom whose couplings have not changed, and only computing the rows
+ *   of degrees of freedom on cells that changed or whose constraints
+ *   changed, see update_sparsity_pattern().
+ *
+ * A typical use looks like this:
+ * @code
+ *   DoFNumberingTransfer<dim> numbering_transfer(dof_handler);
+ *
+ *   // in every cycle: flag cells for refinement and coarsening, then
+ *   triangulation.execute_coarsening_and_refinement();
+ *   dof_handler.distribute_dofs(fe);
+ *   numbering_transfer.renumber_dofs();
+ *
+ *   AffineConstraints<double> new_constraints;
+ *   DoFTools::make_hanging_node_constraints(dof_handler, new_constraints);
+ *   new_constraints.close();
+ *
+ *   numbering_transfer.update_sparsity_pattern(constraints,
+ *                                              new_constraints,
+ *                                              sparsity_pattern,
+ *                                              false);
+ *   constraints = std::move(new_constraints);
+ *   system_matrix.reinit(sparsity_pattern);
+ * @endcode
+ * The call to renumber_dofs() is optional, but without it, the rows of the
+ * sparsity pattern that are copied need to be sorted again.
+ *
+ * @note This class only works for sequential triangulations and DoFHandler
+ * objects without hp-capabilities. Between the calls to
+ * DoFHandler::distribute_dofs() and update_sparsity_pattern(), the degrees
+ * of freedom must not be renumbered other than through renumber_dofs().
+ *
+ * @ingroup dofs
+ */
+template <int dim, int spacedim = dim>
+class DoFNumberingTransfer : public Subscriptor
+{
+public:
+  /**
+   * Constructor. Connect to the triangulation of @p dof_handler, such that
+   * the degrees of freedom are recorded every time the mesh is refined or
+   * coarsened.
+   */
+  DoFNumberingTransfer(DoFHandler<dim, spacedim> &dof_handler);
+
+  /**
+   * Destructor. Disconnect from the triangulation.
+   */
+  ~DoFNumberingTransfer() override;
+
+  /**
+   * Renumber the degrees of freedom of the DoFHandler, which must have been
+   * distributed after the last refinement of the mesh. The degrees of
+   * freedom that existed before the refinement keep their relative order,
+   * and the ones that are new are numbered after the degree of freedom with
+   * the smallest old index on the cells they replace, i.e., the refined cell
+   * for its children and the coarsened children for their parent.
+   */
+  void
+  renumber_dofs();
+
+  /**
+   * Update @p sparsity_pattern, which has to be the pattern created by
+   * DoFTools::make_sparsity_pattern() for the DoFHandler before the last
+   * refinement of the mesh, with the constraints @p old_constraints and
+   * the flag @p keep_constrained_dofs, to the one DoFTools::
+   * make_sparsity_pattern() creates with the same flag and the
+   * constraints @p new_constraints on the current mesh.
+   *
+   * A row of the pattern is computed anew if its degree of freedom lies on
+   * a cell that was refined or coarsened or on a cell with a degree of
+   * freedom whose constraint has changed, if it lay on such a cell before
+   * the refinement, or if it is the target of a constraint of a degree of
+   * freedom on such a cell. All other rows are copied from the old pattern.
+   *
+   * @note Both constraint objects must be closed.
+   */
+  template <typename number>
+  void
+  update_sparsity_pattern(const AffineConstraints<number> &old_constraints,
+                          const AffineConstraints<number> &new_constraints,
+                          SparsityPattern                 &sparsity_pattern,
+                          const bool keep_constrained_dofs = true);
+
+private:
+  /**
+   * Record the degrees of freedom of all active cells and which of the
+   * cells will persist. Called through the pre_refinement signal of the
+   * triangulation.
+   */
+  void
+  record_dof_indices();
+
+  /**
+   * Compute the maps between the old and the new degrees of freedom from
+   * the cells that persisted, if not done yet since the last refinement.
+   */
+  void
+  compute_dof_maps();
+
+  /**
+   * Pointer to the DoFHandler given to the constructor.
+   */
+  SmartPointer<DoFHandler<dim, spacedim>, DoFNumberingTransfer<dim, spacedim>>
+    dof_handler;
+
+  /**
+   * The connection to the pre_refinement signal of the triangulation.
+   */
+  boost::signals2::connection pre_refinement_connection;
+
+  /**
+   * The number of degrees of freedom before the last refinement, or
+   * numbers::invalid_dof_index if none were distributed at that time.
+   */
+  types::global_dof_index n_old_dofs;
+
+  /**
+   * The level and index of every active cell before the last refinement,
+   * and whether the cell persisted.
+   */
+  std::vector<std::pair<std::pair<int, int>, bool>> old_cells;
+
+  /**
+   * The degrees of freedom of the cells in #old_cells, with the ones of
+   * cell i starting at index i times the number of degrees of freedom per
+   * cell.
+   */
+  std::vector<types::global_dof_index> old_dof_indices;
+
+  /**
+   * For every cell that replaces cells that were refined or coarsened,
+   * i.e., the refined cells themselves and the parents of coarsened cells,
+   * the smallest old index of the degrees of freedom on the replaced cells.
+   */
+  std::map<std::pair<int, int>, types::global_dof_index> replaced_cells;
+
+  /**
+   * Whether the maps below have been computed since the last refinement.
+   */
+  bool dof_maps_computed;
+
+  /**
+   * The new index of every old degree of freedom that persisted, and
+   * numbers::invalid_dof_index for the others.
+   */
+  std::vector<types::global_dof_index> new_of_old;
+
+  /**
+   * The old index of every degree of freedom that existed before the last
+   * refinement, and numbers::invalid_dof_index for the new ones.
+   */
+  std::vector<types::global_dof_index> old_of_new;
+
+  /**
+   * For every active cell, indexed by its active cell index, whether it
+   * persisted in the last refinement.
+   */
+  std::vector<bool> cell_persisted;
+};
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
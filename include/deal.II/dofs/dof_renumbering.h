@@ -841,6 +841,45 @@ namespace DoFRenumbering
   void
   hierarchical(DoFHandler<dim, spacedim> &dof_handler);
 
+  /**
+   * Sort the degrees of freedom along a Hilbert space-filling curve through
+   * their locations in space. The location of a degree of freedom is its
+   * support point if the finite element has support points, and the center
+   * of the first cell it is found on otherwise. For support points, the
+   * position is computed with a (bi-,tri-)linear mapping of the cell, so
+   * that no Mapping object is needed.
+   *
+   * Degrees of freedom that are close to each other in space, and hence
+   * couple in the matrix, get close indices. The bandwidth of the resulting
+   * matrix is typically larger than the one produced by Cuthill_McKee(), but
+   * the ordering is cache-oblivious: on every scale, the degrees of freedom
+   * within a small region of space form a contiguous range of indices, which
+   * gives good data locality in matrix-vector products and in loops over
+   * the cells. In contrast to Cuthill_McKee(), this function does not need a
+   * sparsity pattern, and both the computation of the locations and the
+   * sorting along the curve run in parallel. The result does not depend on
+   * the number of threads.
+   *
+   * For parallel triangulations, the locally owned degrees of freedom of
+   * each process are sorted among themselves, and the set of locally owned
+   * degrees of freedom does not change.
+   */
+  template <int dim, int spacedim>
+  void
+  space_filling_curve(DoFHandler<dim, spacedim> &dof_handler);
+
+  /**
+   * Compute the renumbering vector needed by the space_filling_curve()
+   * function. Does not perform the renumbering on the @p DoFHandler dofs but
+   * returns the renumbering vector, which needs to have as many elements as
+   * there are locally owned degrees of freedom.
+   */
+  template <int dim, int spacedim>
+  void
+  compute_space_filling_curve(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandler<dim, spacedim>      &dof_handler);
+
   /**
    * Renumber degrees of freedom by cell. The function takes a vector of cell
    * iterators (which needs to list <i>all</i> locally owned active cells of the
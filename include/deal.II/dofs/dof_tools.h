@@ -417,6 +417,18 @@ namespace DoFTools
    * need to remember using SparsityPattern::compress() after generating the
    * pattern.
    *
+   * @note If more than one thread is available (see MultithreadInfo) and the
+   * mesh is large enough, the loop over cells of this function and of
+   * make_flux_sparsity_pattern() runs in parallel: every thread collects the
+   * entries of its cells in a separate buffer of (row, column) pairs, the
+   * buffers are sorted and merged by row ranges in parallel, and the
+   * resulting rows are then added to @p sparsity_pattern in one sweep, with
+   * sorted and unique column indices. The pattern created is the same as the
+   * one of the sequential loop. If @p sparsity_pattern is a
+   * SparsityPatternBuilder, the threads add their entries to it directly, and
+   * SparsityPattern::copy_from() creates the final pattern from it without
+   * the detour through a DynamicSparsityPattern.
+   *
    * @ingroup constraints
    */
   template <int dim, int spacedim, typename number = double>
@@ -651,6 +663,12 @@ namespace DoFTools
    *      return 0 < face_center[0];
    *    };
    * @endcode
+   *
+   * The loop over cells may run in parallel (see the note at
+   * make_sparsity_pattern()). @p face_has_flux_coupling is nevertheless
+   * only called from the calling thread: this function evaluates it for all
+   * interior faces of the cells it works on before that loop, so it does not
+   * need to be thread-safe.
    */
   template <int dim, int spacedim, typename number>
   void
@@ -17,6 +17,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/lazy.h>
+
 #include <deal.II/fe/block_mask.h>
 #include <deal.II/fe/component_mask.h>
 #include <deal.II/fe/fe_data.h>
@@ -2426,6 +2428,48 @@ protected:
    */
   std::vector<std::vector<FullMatrix<double>>> prolongation;
 
+  /**
+   * Return <code>prolongation[refinement_case-1][child]</code>, and fill it
+   * with the result of @p creator if it is requested for the first time.
+   * Derived classes that compute their prolongation matrices on demand call
+   * this function from their get_prolongation_matrix() function, so that
+   * each matrix is computed only for the children and refinement cases that
+   * are actually used, e.g., only for isotropic refinement.
+   *
+   * This function is thread safe: @p creator is called exactly once per
+   * matrix, and other threads that request the same matrix at the same time
+   * wait for it. Once a matrix has been computed, the check in this function
+   * is a single atomic load without any lock. Different matrices can be
+   * computed concurrently.
+   */
+  template <typename Creator>
+  const FullMatrix<double> &
+  get_or_compute_prolongation_matrix(const unsigned int         child,
+                                     const RefinementCase<dim> &refinement_case,
+                                     const Creator             &creator) const;
+
+  /**
+   * Return <code>restriction[refinement_case-1][child]</code>, and fill it
+   * with the result of @p creator if it is requested for the first time. See
+   * get_or_compute_prolongation_matrix() for details.
+   */
+  template <typename Creator>
+  const FullMatrix<double> &
+  get_or_compute_restriction_matrix(const unsigned int         child,
+                                    const RefinementCase<dim> &refinement_case,
+                                    const Creator             &creator) const;
+
+  /**
+   * Objects that record which of the matrices in #prolongation and
+   * #restriction have been computed by
+   * get_or_compute_prolongation_matrix() and
+   * get_or_compute_restriction_matrix(), and that ensure this happens only
+   * once. The value they store is irrelevant; only whether they have been
+   * initialized matters. They have the same layout as the matrices.
+   */
+  mutable std::vector<std::vector<Lazy<bool>>> prolongation_is_computed;
+  mutable std::vector<std::vector<Lazy<bool>>> restriction_is_computed;
+
   /**
    * Specify the constraints which the dofs on the two sides of a cell
    * interface underlie if the line connects two cells of which one is refined
@@ -3093,6 +3137,59 @@ protected:
 //----------------------------------------------------------------------//
 #ifndef DOXYGEN
 
+template <int dim, int spacedim>
+template <typename Creator>
+inline const FullMatrix<double> &
+FiniteElement<dim, spacedim>::get_or_compute_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case,
+  const Creator             &creator) const
+{
+  AssertIndexRange(refinement_case,
+                   RefinementCase<dim>::isotropic_refinement + 1);
+  Assert(refinement_case != RefinementCase<dim>::no_refinement,
+         ExcMessage(
+           "Prolongation matrices are only available for refined cells!"));
+  AssertIndexRange(child,
+                   prolongation_is_computed[refinement_case - 1].size());
+
+  prolongation_is_computed[refinement_case - 1][child].ensure_initialized(
+    [&]() {
+      const_cast<FullMatrix<double> &>(
+        prolongation[refinement_case - 1][child]) = creator();
+      return true;
+    });
+  return prolongation[refinement_case - 1][child];
+}
+
+
+
+template <int dim, int spacedim>
+template <typename Creator>
+inline const FullMatrix<double> &
+FiniteElement<dim, spacedim>::get_or_compute_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case,
+  const Creator             &creator) const
+{
+  AssertIndexRange(refinement_case,
+                   RefinementCase<dim>::isotropic_refinement + 1);
+  Assert(refinement_case != RefinementCase<dim>::no_refinement,
+         ExcMessage(
+           "Restriction matrices are only available for refined cells!"));
+  AssertIndexRange(child, restriction_is_computed[refinement_case - 1].size());
+
+  restriction_is_computed[refinement_case - 1][child].ensure_initialized(
+    [&]() {
+      const_cast<FullMatrix<double> &>(
+        restriction[refinement_case - 1][child]) = creator();
+      return true;
+    });
+  return restriction[refinement_case - 1][child];
+}
+
+
+
 template <int dim, int spacedim>
 inline std::pair<unsigned int, unsigned int>
 FiniteElement<dim, spacedim>::system_to_component_index(
@@ -18,6 +18,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/lazy.h>
 #include <deal.II/base/mutex.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/polynomials_nedelec.h>
@@ -624,6 +625,14 @@ private:
   void
   initialize_restriction();
 
+  /**
+   * Initialize the interface constraints from the embedding matrices of the
+   * faces. Called from the constructor unless the matrices are found in the
+   * cache of FETools::MatrixCache.
+   */
+  void
+  initialize_interface_constraints();
+
   /**
    * These are the factors multiplied to a function in the
    * #generalized_face_support_points when computing the integration.
@@ -635,11 +644,19 @@ private:
   Table<2, double> boundary_weights;
 
   /**
-   * Mutex variables used for protecting the initialization of restriction
-   * and embedding matrices.
+   * Compute all restriction and embedding matrices if this has not happened
+   * before. Called from get_prolongation_matrix() and
+   * get_restriction_matrix().
+   */
+  void
+  ensure_refinement_matrices_are_computed() const;
+
+  /**
+   * An object that records whether the restriction and embedding matrices
+   * have been computed, and that ensures this happens only once even if
+   * several threads ask for them at the same time.
    */
-  mutable Threads::Mutex restriction_matrix_mutex;
-  mutable Threads::Mutex prolongation_matrix_mutex;
+  mutable Lazy<bool> refinement_matrices_are_computed;
 
   /**
    * Initialize the permutation pattern and the pattern of sign change.
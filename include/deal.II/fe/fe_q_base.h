@@ -326,13 +326,6 @@ protected:
   friend struct FE_Q_Base<dim, spacedim>::Implementation;
 
 private:
-  /**
-   * Mutex variables used for protecting the initialization of restriction
-   * and embedding matrices.
-   */
-  mutable Threads::Mutex restriction_matrix_mutex;
-  mutable Threads::Mutex prolongation_matrix_mutex;
-
   /**
    * The highest polynomial degree of the underlying tensor product space
    * without any enrichment. For FE_Q*(p) this is p. Note that enrichments
@@ -589,7 +589,9 @@ public:
                            FullMatrix<double>       &matrix) const override;
 
   /**
-   * Embedding matrix between grids. Only isotropic refinement is supported.
+   * Embedding matrix between grids. Only isotropic refinement is supported,
+   * the matrices for anisotropic refinement cases are empty.
+   * The matrix is computed when it is requested for the first time.
    */
   virtual const FullMatrix<double> &
   get_prolongation_matrix(
@@ -597,6 +599,17 @@ public:
     const RefinementCase<dim> &refinement_case =
       RefinementCase<dim>::isotropic_refinement) const override;
 
+  /**
+   * Projection matrix between grids. Only isotropic refinement is supported,
+   * the matrices for anisotropic refinement cases are empty.
+   * The matrix is computed when it is requested for the first time.
+   */
+  virtual const FullMatrix<double> &
+  get_restriction_matrix(
+    const unsigned int         child,
+    const RefinementCase<dim> &refinement_case =
+      RefinementCase<dim>::isotropic_refinement) const override;
+
   /**
    * If, on a vertex, several finite elements are active, the hp-code first
    * assigns the degrees of freedom of each of these FEs different global
@@ -760,12 +773,15 @@ private:
   initialize_constraints(const std::vector<FullMatrix<double>> &dofs_subcell);
 
   /**
-   * Initialize the embedding matrices. Called from the constructor.
+   * Compute the embedding matrix of the given child from the matrices
+   * @p dofs_subcell, or the restriction matrix from @p dofs_cell, as
+   * computed by build_dofs_cell(). Called from get_prolongation_matrix()
+   * and get_restriction_matrix().
    */
-  void
-  initialize_embedding_and_restriction(
-    const std::vector<FullMatrix<double>> &dofs_cell,
-    const std::vector<FullMatrix<double>> &dofs_subcell);
+  FullMatrix<double>
+  compute_embedding_or_restriction(
+    const std::vector<FullMatrix<double>> &matrices_1d,
+    const unsigned int                     child) const;
 
   /**
    * Initialize the @p generalized_support_points field of the FiniteElement class.
@@ -1323,13 +1323,6 @@ private:
       base_fe_output_objects;
   };
 
-  /**
-   * Mutex variables used for protecting the initialization of restriction
-   * and embedding matrices.
-   */
-  mutable std::mutex restriction_matrix_mutex;
-  mutable std::mutex prolongation_matrix_mutex;
-
   friend class FE_Enriched<dim, spacedim>;
 };
 
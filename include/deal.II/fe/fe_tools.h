@@ -31,6 +31,7 @@
 
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -1337,6 +1338,98 @@ namespace FETools
   add_fe_name(const std::string                  &name,
               const FEFactoryBase<dim, spacedim> *factory);
 
+  /**
+   * A process-wide cache for the matrices that finite elements compute when
+   * they are constructed or first asked for them, such as inverse node
+   * matrices, embedding and restriction matrices, or the matrices of
+   * interface constraints. For elements like FE_Nedelec or FE_RaviartThomas
+   * of higher degree, computing these matrices can take seconds, and
+   * programs that create the same element many times (for example in
+   * hp::FECollection objects, or once per MPI process) would otherwise repeat
+   * this work every time.
+   *
+   * Entries are identified by a string key that the element builds from its
+   * name as returned by FiniteElement::get_name() and the kind of matrices
+   * stored, for example <code>FE_Nedelec<3>(4):prolongation</code>. The
+   * cache only stores copies of the matrices; the elements still own the
+   * matrices they use.
+   *
+   * In addition to the cache in memory, the matrices can be stored in files
+   * in a directory set by set_directory(), or by the environment variable
+   * <code>DEAL_II_FE_MATRIX_CACHE_DIRECTORY</code>, so that later runs of a
+   * program can read them instead of computing them again. The files are
+   * written in the binary format of the machine and are only meant to be
+   * read on the same kind of machine.
+   *
+   * @note All functions in this namespace are thread safe.
+   */
+  namespace MatrixCache
+  {
+    /**
+     * The type of the objects stored in the cache: a collection of matrices
+     * grouped by an outer index, such as the refinement case in the
+     * FiniteElement::prolongation and FiniteElement::restriction members.
+     * Single matrices are stored as a collection with one group of one
+     * matrix.
+     */
+    using MatrixSet = std::vector<std::vector<FullMatrix<double>>>;
+
+    /**
+     * Return the matrices stored for the given @p key. If there are none in
+     * memory, read them from the directory set by set_directory() if
+     * possible, and call @p compute otherwise. Matrices that are computed
+     * are added to the cache and written to the directory if one is set.
+     *
+     * @p compute is called without holding a lock, so it may itself create
+     * finite elements that use the cache. If several threads ask for the
+     * same key at the same time, each of them may compute the matrices, and
+     * the cache keeps the result stored first.
+     *
+     * @p dofs_per_cell is the number of degrees of freedom per cell of the
+     * element the matrices belong to. No matrix has more rows or columns
+     * than that, so files that contain larger matrices are considered
+     * damaged and ignored, like files that are shorter than the sizes
+     * stored in them or that were written by another version of deal.II.
+     *
+     * Keys of elements whose name does not describe them completely, namely
+     * names that contain <code>QUnknownNodes</code>, are not cached; for
+     * those, this function simply returns the result of @p compute.
+     */
+    std::shared_ptr<const MatrixSet>
+    get_or_compute(const std::string                &key,
+                   const unsigned int                dofs_per_cell,
+                   const std::function<MatrixSet()> &compute);
+
+    /**
+     * Set the directory in which the cache stores its matrices in files. An
+     * empty string, which is the default unless the environment variable
+     * <code>DEAL_II_FE_MATRIX_CACHE_DIRECTORY</code> is set, disables the
+     * storage in files. The directory is created if it does not exist.
+     */
+    void
+    set_directory(const std::string &directory);
+
+    /**
+     * Return the directory set by set_directory(), or an empty string if the
+     * matrices are only cached in memory.
+     */
+    std::string
+    get_directory();
+
+    /**
+     * Remove all matrices from the cache in memory. Files in the directory
+     * set by set_directory() are not touched.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of entries in the cache in memory.
+     */
+    std::size_t
+    n_entries();
+  } // namespace MatrixCache
+
   /**
    * The string used for get_fe_by_name() cannot be translated to a finite
    * element.
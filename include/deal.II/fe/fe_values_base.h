@@ -51,6 +51,18 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declaration
+#ifndef DOXYGEN
+namespace internal
+{
+  namespace FEValuesImplementation
+  {
+    template <int dim, int spacedim>
+    class TensorProductEvaluator;
+  }
+} // namespace internal
+#endif
+
 /**
  * FEValues, FEFaceValues and FESubfaceValues objects are interfaces to finite
  * element and mapping classes on the one hand side, to cells and quadrature
@@ -147,6 +159,25 @@ DEAL_II_NAMESPACE_OPEN
  * and about the
  * @ref FE_vs_Mapping_vs_FEValues "How Mapping, FiniteElement, and FEValues work together".
  *
+ * For elements such as FE_Q and FE_DGQ, whose shape functions are tensor
+ * products of one-dimensional polynomials, used with a quadrature formula
+ * that is the tensor product of one one-dimensional formula such as QGauss,
+ * FEValues evaluates finite element functions by sum factorization: the
+ * get_function_values() and get_function_gradients() functions of this
+ * class and of FEValuesViews::Scalar and FEValuesViews::Vector then apply
+ * the one-dimensional shape functions direction by direction, rather than
+ * summing over all shape functions in all quadrature points. This reduces
+ * the cost of these functions per cell from $\mathcal O(p^{2d})$ to
+ * $\mathcal O(d p^{d+1})$ for polynomial degree $p$ and is selected
+ * automatically; the results only differ by roundoff. The gradients on the
+ * reference cell are transformed with the inverse Jacobians of the mapping,
+ * so get_function_gradients() only uses sum factorization if
+ * #update_inverse_jacobians is among the update flags; otherwise, it sums
+ * over the shape functions and reinit() does not pay for the additional
+ * mapping data. The cost of reinit() is not reduced: it still fills the
+ * values and gradients of all shape functions requested by the update
+ * flags.
+ *
  *
  * @ingroup feaccess
  */
@@ -1740,6 +1771,17 @@ protected:
                                                                      spacedim>
     finite_element_output;
 
+  /**
+   * An object that evaluates finite element functions and their gradients
+   * by sum factorization in the get_function_values() and
+   * get_function_gradients() functions. Set up by FEValues if the finite
+   * element and the quadrature formula allow it, and a null pointer
+   * otherwise.
+   */
+  std::unique_ptr<const internal::FEValuesImplementation::
+                    TensorProductEvaluator<dim, spacedim>>
+    tensor_product_evaluator;
+
 
   /**
    * Original update flags handed to the constructor of FEValues.
@@ -0,0 +1,530 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_fe_values_batch_h
+#define dealii_fe_values_batch_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/derivative_form.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/std_cxx20/iota_view.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * Finite element evaluated in the quadrature points of a batch of cells.
+ *
+ * This class provides a subset of the functionality of FEValues, namely the
+ * shape function values and gradients, the JxW values and the quadrature
+ * points, for up to VectorizedArray<double>::size() cells at once. Each of
+ * these quantities is returned as a VectorizedArray (or a tensor or point of
+ * VectorizedArray entries), whose lanes hold the values on the different
+ * cells of the batch. The mapped shape gradients are stored such that the
+ * gradient of one shape function in one quadrature point is a single
+ * Tensor<1,spacedim,VectorizedArray<double>>, i.e., as a structure of arrays
+ * over the cells of the batch. This allows writing local assembly loops that
+ * compute the cell matrices of several cells at once with SIMD instructions,
+ * without switching to the matrix-free framework:
+ * @code
+ *   FEValuesBatch<dim> fe_batch(fe, quadrature,
+ *                               update_gradients | update_JxW_values);
+ *   std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+ *   for (const auto &cell : dof_handler.active_cell_iterators())
+ *     {
+ *       cells.push_back(cell);
+ *       if (cells.size() < fe_batch.n_lanes &&
+ *           cell->active_cell_index() + 1 < triangulation.n_active_cells())
+ *         continue;
+ *
+ *       fe_batch.reinit(cells);
+ *       for (const unsigned int q : fe_batch.quadrature_point_indices())
+ *         for (const unsigned int i : fe_batch.dof_indices())
+ *           for (const unsigned int j : fe_batch.dof_indices())
+ *             cell_matrix(i, j) += fe_batch.shape_grad(i, q) *
+ *                                  fe_batch.shape_grad(j, q) *
+ *                                  fe_batch.JxW(q);
+ *       // lane l of cell_matrix(i, j) now holds the entry of the matrix of
+ *       // cells[l], whose degrees of freedom are given by
+ *       // fe_batch.get_dof_indices(l)
+ *       cells.clear();
+ *     }
+ * @endcode
+ * Here, `cell_matrix` is a Table<2, VectorizedArray<double>>.
+ *
+ * The geometric data of each cell is computed through an FEValues object
+ * with the given mapping. The shape functions are only evaluated once on
+ * the reference cell, and their gradients are transformed to each cell of
+ * the batch with vectorized operations. This is possible for all primitive
+ * elements whose base elements are derived from FE_Poly, such as FE_Q,
+ * FE_DGQ, FE_SimplexP, and FESystem objects composed of these elements, for
+ * which the values of the shape functions do not depend on the cell and the
+ * gradients are transformed with the inverse of the Jacobian of the mapping.
+ * As for FEValues, the functions of this class for such an FESystem return
+ * the value or gradient of the only nonzero component of a shape function.
+ *
+ * If fewer cells than VectorizedArray<double>::size() are passed to reinit(),
+ * the remaining lanes contain the data of the first cell.
+ *
+ * @ingroup feaccess
+ */
+template <int dim, int spacedim = dim>
+class FEValuesBatch : public Subscriptor
+{
+public:
+  /**
+   * The type used to hold the values on all cells of a batch.
+   */
+  using VectorizedArrayType = VectorizedArray<double>;
+
+  /**
+   * The number of cells that can be processed in one batch.
+   */
+  static constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+  /**
+   * The type of the cells passed to reinit().
+   */
+  using active_cell_iterator =
+    typename DoFHandler<dim, spacedim>::active_cell_iterator;
+
+  /**
+   * Constructor. Sets up the FEValues object used for the mapping of the
+   * cells and evaluates the shape functions on the reference cell.
+   *
+   * Supported update flags are update_values, update_gradients,
+   * update_JxW_values and update_quadrature_points.
+   */
+  FEValuesBatch(const Mapping<dim, spacedim>       &mapping,
+                const FiniteElement<dim, spacedim> &fe,
+                const Quadrature<dim>              &quadrature,
+                const UpdateFlags                   update_flags);
+
+  /**
+   * Constructor. This constructor is equivalent to the other one except that
+   * it makes the object use the default linear mapping of the reference cell
+   * of @p fe.
+   */
+  FEValuesBatch(const FiniteElement<dim, spacedim> &fe,
+                const Quadrature<dim>              &quadrature,
+                const UpdateFlags                   update_flags);
+
+  /**
+   * Reinitialize the data for the given cells, of which there must be at
+   * least one and at most #n_lanes. All cells must use the finite element
+   * given to the constructor.
+   */
+  void
+  reinit(const ArrayView<const active_cell_iterator> &cells);
+
+  /**
+   * Return the number of cells given to the last call of reinit().
+   */
+  unsigned int
+  n_active_lanes() const;
+
+  /**
+   * Return the cell of lane @p lane given to the last call of reinit().
+   */
+  const active_cell_iterator &
+  get_cell(const unsigned int lane) const;
+
+  /**
+   * Return the global indices of the degrees of freedom of the cell in lane
+   * @p lane, as DoFCellAccessor::get_dof_indices() does.
+   */
+  ArrayView<const types::global_dof_index>
+  get_dof_indices(const unsigned int lane) const;
+
+  /**
+   * Return an object that can be thought of as an array containing all
+   * indices from zero to `dofs_per_cell`, see FEValuesBase::dof_indices().
+   */
+  std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  dof_indices() const;
+
+  /**
+   * Return an object that can be thought of as an array containing all
+   * indices from zero to `n_quadrature_points`, see
+   * FEValuesBase::quadrature_point_indices().
+   */
+  std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  quadrature_point_indices() const;
+
+  /**
+   * Return the value of shape function @p i at quadrature point @p q. As
+   * the values do not depend on the cell, a single number is returned.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  double
+  shape_value(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the gradient of shape function @p i at quadrature point @p q on
+   * all cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  const Tensor<1, spacedim, VectorizedArrayType> &
+  shape_grad(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the mapped quadrature weight at quadrature point @p q on all
+   * cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_JxW_values}
+   */
+  const VectorizedArrayType &
+  JxW(const unsigned int q) const;
+
+  /**
+   * Return the location of quadrature point @p q on all cells of the batch.
+   *
+   * @dealiiRequiresUpdateFlags{update_quadrature_points}
+   */
+  const Point<spacedim, VectorizedArrayType> &
+  quadrature_point(const unsigned int q) const;
+
+  /**
+   * Return the values of the finite element function @p fe_function at the
+   * quadrature points of all cells of the batch, as FEValuesBase::
+   * get_function_values() does for a single cell. Only implemented for
+   * scalar elements. The lanes not used by the last call to reinit() are
+   * zero.
+   *
+   * @dealiiRequiresUpdateFlags{update_values}
+   */
+  template <typename InputVector>
+  void
+  get_function_values(const InputVector                &fe_function,
+                      std::vector<VectorizedArrayType> &values) const;
+
+  /**
+   * Return the gradients of the finite element function @p fe_function at
+   * the quadrature points of all cells of the batch, as FEValuesBase::
+   * get_function_gradients() does for a single cell. Only implemented for
+   * scalar elements. The lanes not used by the last call to reinit() are
+   * zero.
+   *
+   * @dealiiRequiresUpdateFlags{update_gradients}
+   */
+  template <typename InputVector>
+  void
+  get_function_gradients(
+    const InputVector                                     &fe_function,
+    std::vector<Tensor<1, spacedim, VectorizedArrayType>> &gradients) const;
+
+  /**
+   * Return a reference to the finite element given to the constructor.
+   */
+  const FiniteElement<dim, spacedim> &
+  get_fe() const;
+
+  /**
+   * Return the update flags given to the constructor.
+   */
+  UpdateFlags
+  get_update_flags() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * The number of degrees of freedom per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+  /**
+   * The number of quadrature points per cell.
+   */
+  const unsigned int n_quadrature_points;
+
+private:
+  /**
+   * Pointer to the finite element given to the constructor.
+   */
+  SmartPointer<const FiniteElement<dim, spacedim>,
+               FEValuesBatch<dim, spacedim>>
+    fe;
+
+  /**
+   * The update flags given to the constructor.
+   */
+  const UpdateFlags update_flags;
+
+  /**
+   * The FEValues object that computes the geometric data of the cells, one
+   * after the other.
+   */
+  FEValues<dim, spacedim> mapping_values;
+
+  /**
+   * The values of the shape functions on the reference cell, indexed by
+   * shape function and quadrature point.
+   */
+  Table<2, double> reference_values;
+
+  /**
+   * The gradients of the shape functions on the reference cell, indexed by
+   * shape function and quadrature point.
+   */
+  Table<2, Tensor<1, dim>> reference_gradients;
+
+  /**
+   * The gradients of the shape functions on the cells of the batch, with
+   * the one of shape function i at quadrature point q at index
+   * `i * n_quadrature_points + q`.
+   */
+  AlignedVector<Tensor<1, spacedim, VectorizedArrayType>> shape_gradients;
+
+  /**
+   * The inverse Jacobians of the mapping on the cells of the batch, used to
+   * transform the shape gradients.
+   */
+  AlignedVector<DerivativeForm<1, spacedim, dim, VectorizedArrayType>>
+    inverse_jacobians;
+
+  /**
+   * The JxW values on the cells of the batch.
+   */
+  AlignedVector<VectorizedArrayType> JxW_values;
+
+  /**
+   * The quadrature points on the cells of the batch.
+   */
+  AlignedVector<Point<spacedim, VectorizedArrayType>> quadrature_points;
+
+  /**
+   * The cells given to the last call of reinit().
+   */
+  std::vector<active_cell_iterator> cells;
+
+  /**
+   * The indices of the degrees of freedom of the cells, with the ones of
+   * lane l starting at index `l * dofs_per_cell`.
+   */
+  std::vector<types::global_dof_index> dof_indices_of_cells;
+};
+
+
+
+#ifndef DOXYGEN
+
+template <int dim, int spacedim>
+inline unsigned int
+FEValuesBatch<dim, spacedim>::n_active_lanes() const
+{
+  return cells.size();
+}
+
+
+
+template <int dim, int spacedim>
+inline const typename FEValuesBatch<dim, spacedim>::active_cell_iterator &
+FEValuesBatch<dim, spacedim>::get_cell(const unsigned int lane) const
+{
+  AssertIndexRange(lane, cells.size());
+  return cells[lane];
+}
+
+
+
+template <int dim, int spacedim>
+inline ArrayView<const types::global_dof_index>
+FEValuesBatch<dim, spacedim>::get_dof_indices(const unsigned int lane) const
+{
+  AssertIndexRange(lane, cells.size());
+  return make_array_view(dof_indices_of_cells.data() + lane * dofs_per_cell,
+                         dof_indices_of_cells.data() +
+                           (lane + 1) * dofs_per_cell);
+}
+
+
+
+template <int dim, int spacedim>
+inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+FEValuesBatch<dim, spacedim>::dof_indices() const
+{
+  return {0U, dofs_per_cell};
+}
+
+
+
+template <int dim, int spacedim>
+inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+FEValuesBatch<dim, spacedim>::quadrature_point_indices() const
+{
+  return {0U, n_quadrature_points};
+}
+
+
+
+template <int dim, int spacedim>
+inline double
+FEValuesBatch<dim, spacedim>::shape_value(const unsigned int i,
+                                          const unsigned int q) const
+{
+  Assert(update_flags & update_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_values")));
+  return reference_values(i, q);
+}
+
+
+
+template <int dim, int spacedim>
+inline const Tensor<1, spacedim, VectorizedArray<double>> &
+FEValuesBatch<dim, spacedim>::shape_grad(const unsigned int i,
+                                         const unsigned int q) const
+{
+  Assert(update_flags & update_gradients,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_gradients")));
+  AssertIndexRange(i, dofs_per_cell);
+  AssertIndexRange(q, n_quadrature_points);
+  return shape_gradients[i * n_quadrature_points + q];
+}
+
+
+
+template <int dim, int spacedim>
+inline const VectorizedArray<double> &
+FEValuesBatch<dim, spacedim>::JxW(const unsigned int q) const
+{
+  Assert(update_flags & update_JxW_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_JxW_values")));
+  AssertIndexRange(q, n_quadrature_points);
+  return JxW_values[q];
+}
+
+
+
+template <int dim, int spacedim>
+inline const Point<spacedim, VectorizedArray<double>> &
+FEValuesBatch<dim, spacedim>::quadrature_point(const unsigned int q) const
+{
+  Assert(update_flags & update_quadrature_points,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_quadrature_points")));
+  AssertIndexRange(q, n_quadrature_points);
+  return quadrature_points[q];
+}
+
+
+
+template <int dim, int spacedim>
+template <typename InputVector>
+void
+FEValuesBatch<dim, spacedim>::get_function_values(
+  const InputVector                &fe_function,
+  std::vector<VectorizedArrayType> &values) const
+{
+  Assert(update_flags & update_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_values")));
+  AssertDimension(fe->n_components(), 1);
+  Assert(cells.size() > 0, ExcNotInitialized());
+
+  values.resize(n_quadrature_points);
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    values[q] = 0.;
+
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    {
+      VectorizedArrayType dof_value = 0.;
+      for (unsigned int l = 0; l < cells.size(); ++l)
+        dof_value[l] = fe_function(dof_indices_of_cells[l * dofs_per_cell + i]);
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        values[q] += reference_values(i, q) * dof_value;
+    }
+}
+
+
+
+template <int dim, int spacedim>
+template <typename InputVector>
+void
+FEValuesBatch<dim, spacedim>::get_function_gradients(
+  const InputVector                                     &fe_function,
+  std::vector<Tensor<1, spacedim, VectorizedArrayType>> &gradients) const
+{
+  Assert(update_flags & update_gradients,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_gradients")));
+  AssertDimension(fe->n_components(), 1);
+  Assert(cells.size() > 0, ExcNotInitialized());
+
+  gradients.resize(n_quadrature_points);
+  for (unsigned int q = 0; q < n_quadrature_points; ++q)
+    gradients[q] = Tensor<1, spacedim, VectorizedArrayType>();
+
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    {
+      VectorizedArrayType dof_value = 0.;
+      for (unsigned int l = 0; l < cells.size(); ++l)
+        dof_value[l] = fe_function(dof_indices_of_cells[l * dofs_per_cell + i]);
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        gradients[q] +=
+          dof_value * shape_gradients[i * n_quadrature_points + q];
+    }
+}
+
+
+
+template <int dim, int spacedim>
+inline const FiniteElement<dim, spacedim> &
+FEValuesBatch<dim, spacedim>::get_fe() const
+{
+  return *fe;
+}
+
+
+
+template <int dim, int spacedim>
+inline UpdateFlags
+FEValuesBatch<dim, spacedim>::get_update_flags() const
+{
+  return update_flags;
+}
+
+#endif
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
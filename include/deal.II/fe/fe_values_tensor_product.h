@@ -0,0 +1,364 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_fe_values_tensor_product_h
+#define dealii_fe_values_tensor_product_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/derivative_form.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <complex>
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace FEValuesImplementation
+  {
+    /**
+     * A class that evaluates finite element functions and their gradients
+     * in the quadrature points of a cell by sum factorization, i.e., by
+     * applying the one-dimensional shape functions direction by direction
+     * with the kernels of tensor_product_kernels.h. For elements of degree
+     * $p$ and quadrature formulas with $q$ points per direction, this
+     * costs $\mathcal O(d p q^d)$ operations per cell, rather than the
+     * $\mathcal O(p^d q^d)$ operations of summing over all shape functions
+     * in all quadrature points.
+     *
+     * The evaluation is possible for those vector components of the finite
+     * element whose base element is derived from FE_Poly with a polynomial
+     * space of type TensorProductPolynomials, such as FE_Q and FE_DGQ, if
+     * the quadrature formula is the tensor product of the same
+     * one-dimensional formula in all directions, such as QGauss.
+     * FEValues creates an object of this class whenever this is the case
+     * for at least one component, and uses it in the get_function_values()
+     * functions, as well as in the get_function_gradients() functions if
+     * the inverse Jacobians of the mapping are computed.
+     */
+    template <int dim, int spacedim>
+    class TensorProductEvaluator
+    {
+    public:
+      /**
+       * Return whether the evaluation by sum factorization is possible for
+       * at least one component of @p fe with the quadrature formula
+       * @p quadrature.
+       */
+      static bool
+      is_applicable(const FiniteElement<dim, spacedim> &fe,
+                    const Quadrature<dim>              &quadrature);
+
+      /**
+       * Constructor. Set up the one-dimensional shape functions in the
+       * one-dimensional quadrature points for all components for which the
+       * evaluation is possible.
+       */
+      TensorProductEvaluator(const FiniteElement<dim, spacedim> &fe,
+                             const Quadrature<dim>              &quadrature);
+
+      /**
+       * Return whether values and gradients of the given vector component
+       * can be evaluated by this class, with results of type @p Number.
+       */
+      template <typename Number>
+      bool
+      is_applicable_to_component(const unsigned int component) const;
+
+      /**
+       * Evaluate the values of the given vector component of the finite
+       * element function with the values @p dof_values of all degrees of
+       * freedom on the cell in the quadrature points. The computations are
+       * done with the type @p OutputNumber of the result.
+       */
+      template <typename Number, typename OutputNumber>
+      void
+      evaluate_values(const unsigned int             component,
+                      const ArrayView<const Number> &dof_values,
+                      const ArrayView<OutputNumber> &values) const;
+
+      /**
+       * Evaluate the gradients of the given vector component of the finite
+       * element function with the values @p dof_values of all degrees of
+       * freedom on the cell in the quadrature points, using the inverse
+       * Jacobians of the mapping of the cell to transform them from the
+       * reference cell.
+       */
+      template <typename Number, typename OutputNumber>
+      void
+      evaluate_gradients(
+        const unsigned int                                   component,
+        const ArrayView<const Number>                       &dof_values,
+        const std::vector<DerivativeForm<1, spacedim, dim>> &inverse_jacobians,
+        const ArrayView<Tensor<1, spacedim, OutputNumber>>  &gradients) const;
+
+      /**
+       * Return an estimate (in bytes) for the memory consumption of this
+       * object.
+       */
+      std::size_t
+      memory_consumption() const;
+
+    private:
+      /**
+       * Whether the kernels, which multiply the given numbers by shape
+       * functions stored as double numbers, can be used for the type
+       * @p Number.
+       */
+      template <typename Number>
+      static constexpr bool is_supported_number =
+        std::is_same_v<Number, double> || std::is_same_v<Number, float> ||
+        std::is_same_v<Number, std::complex<double>>;
+
+      /**
+       * Data needed to evaluate one vector component.
+       */
+      struct ComponentData
+      {
+        /**
+         * The number of one-dimensional shape functions, or zero if the
+         * component cannot be evaluated by sum factorization.
+         */
+        unsigned int n_dofs_1d = 0;
+
+        /**
+         * The values of the one-dimensional shape functions in the
+         * one-dimensional quadrature points, with the point running
+         * fastest.
+         */
+        AlignedVector<double> shape_values;
+
+        /**
+         * The derivatives of the one-dimensional shape functions in the
+         * one-dimensional quadrature points, with the point running
+         * fastest.
+         */
+        AlignedVector<double> shape_gradients;
+
+        /**
+         * The index of the degree of freedom on the cell for every shape
+         * function of this component in lexicographic numbering.
+         */
+        std::vector<unsigned int> dof_indices;
+      };
+
+      /**
+       * Evaluate the values, and the gradients on the reference cell if
+       * @p reference_gradients is not empty, of the given component. The
+       * gradient in direction $d$ in quadrature point $q$ is stored at
+       * index $d n_q + q$.
+       */
+      template <typename Number, typename OutputNumber>
+      void
+      evaluate(const unsigned int             component,
+               const ArrayView<const Number> &dof_values,
+               const ArrayView<OutputNumber> &values,
+               const ArrayView<OutputNumber> &reference_gradients) const;
+
+      /**
+       * The number of points of the one-dimensional quadrature formula.
+       */
+      unsigned int n_q_points_1d;
+
+      /**
+       * The data of every vector component of the finite element.
+       */
+      std::vector<ComponentData> component_data;
+    };
+
+
+
+    /* ----------------------- inline functions ----------------------- */
+
+
+    template <int dim, int spacedim>
+    template <typename Number>
+    inline bool
+    TensorProductEvaluator<dim, spacedim>::is_applicable_to_component(
+      const unsigned int component) const
+    {
+      AssertIndexRange(component, component_data.size());
+      return is_supported_number<Number> &&
+             component_data[component].n_dofs_1d > 0;
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename Number, typename OutputNumber>
+    inline void
+    TensorProductEvaluator<dim, spacedim>::evaluate(
+      const unsigned int             component,
+      const ArrayView<const Number> &dof_values,
+      const ArrayView<OutputNumber> &values,
+      const ArrayView<OutputNumber> &reference_gradients) const
+    {
+      const ComponentData &data = component_data[component];
+      const unsigned int   n_dofs_1d = data.n_dofs_1d;
+      const unsigned int   n_q_points =
+        Utilities::fixed_power<dim>(n_q_points_1d);
+      Assert(n_dofs_1d > 0, ExcInternalError());
+      Assert(values.empty() || values.size() == n_q_points,
+             ExcDimensionMismatch(values.size(), n_q_points));
+      Assert(reference_gradients.empty() ||
+               reference_gradients.size() == dim * n_q_points,
+             ExcDimensionMismatch(reference_gradients.size(),
+                                  dim * n_q_points));
+
+      // gather the values of the degrees of freedom of the component in
+      // lexicographic order, and provide two temporary arrays that are
+      // large enough for all intermediate results
+      const unsigned int n_max =
+        Utilities::fixed_power<dim>(std::max(n_dofs_1d, n_q_points_1d));
+      std::vector<OutputNumber> scratch(3 * n_max);
+      OutputNumber *const       in   = scratch.data();
+      OutputNumber *const       tmp1 = scratch.data() + n_max;
+      OutputNumber *const       tmp2 = scratch.data() + 2 * n_max;
+      for (unsigned int i = 0; i < data.dof_indices.size(); ++i)
+        in[i] = dof_values[data.dof_indices[i]];
+
+      const EvaluatorTensorProduct<evaluate_general,
+                                   dim,
+                                   0,
+                                   0,
+                                   OutputNumber,
+                                   double>
+        eval(data.shape_values.data(),
+             data.shape_gradients.data(),
+             nullptr,
+             n_dofs_1d,
+             n_q_points_1d);
+
+      if constexpr (dim == 1)
+        {
+          if (!values.empty())
+            eval.template values<0, true, false>(in, values.data());
+          if (!reference_gradients.empty())
+            eval.template gradients<0, true, false>(in,
+                                                    reference_gradients.data());
+        }
+      else if constexpr (dim == 2)
+        {
+          if (!reference_gradients.empty())
+            {
+              eval.template gradients<0, true, false>(in, tmp1);
+              eval.template values<1, true, false>(tmp1,
+                                                   reference_gradients.data());
+            }
+          eval.template values<0, true, false>(in, tmp1);
+          if (!reference_gradients.empty())
+            eval.template gradients<1, true, false>(
+              tmp1, reference_gradients.data() + n_q_points);
+          if (!values.empty())
+            eval.template values<1, true, false>(tmp1, values.data());
+        }
+      else if constexpr (dim == 3)
+        {
+          if (!reference_gradients.empty())
+            {
+              eval.template gradients<0, true, false>(in, tmp1);
+              eval.template values<1, true, false>(tmp1, tmp2);
+              eval.template values<2, true, false>(tmp2,
+                                                   reference_gradients.data());
+            }
+          eval.template values<0, true, false>(in, tmp1);
+          if (!reference_gradients.empty())
+            {
+              eval.template gradients<1, true, false>(tmp1, tmp2);
+              eval.template values<2, true, false>(
+                tmp2, reference_gradients.data() + n_q_points);
+            }
+          eval.template values<1, true, false>(tmp1, tmp2);
+          if (!reference_gradients.empty())
+            eval.template gradients<2, true, false>(
+              tmp2, reference_gradients.data() + 2 * n_q_points);
+          if (!values.empty())
+            eval.template values<2, true, false>(tmp2, values.data());
+        }
+      else
+        DEAL_II_NOT_IMPLEMENTED();
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename Number, typename OutputNumber>
+    inline void
+    TensorProductEvaluator<dim, spacedim>::evaluate_values(
+      const unsigned int             component,
+      const ArrayView<const Number> &dof_values,
+      const ArrayView<OutputNumber> &values) const
+    {
+      if constexpr (is_supported_number<OutputNumber>)
+        evaluate(component, dof_values, values, ArrayView<OutputNumber>());
+      else
+        DEAL_II_ASSERT_UNREACHABLE();
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename Number, typename OutputNumber>
+    inline void
+    TensorProductEvaluator<dim, spacedim>::evaluate_gradients(
+      const unsigned int                                   component,
+      const ArrayView<const Number>                       &dof_values,
+      const std::vector<DerivativeForm<1, spacedim, dim>> &inverse_jacobians,
+      const ArrayView<Tensor<1, spacedim, OutputNumber>>  &gradients) const
+    {
+      const unsigned int n_q_points = gradients.size();
+      AssertDimension(inverse_jacobians.size(), n_q_points);
+
+      if constexpr (is_supported_number<OutputNumber>)
+        {
+          std::vector<OutputNumber> reference_gradients(dim * n_q_points);
+          evaluate(component,
+                   dof_values,
+                   ArrayView<OutputNumber>(),
+                   make_array_view(reference_gradients));
+
+          // multiply the gradients on the reference cell by the transpose of
+          // the inverse Jacobian
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                OutputNumber sum =
+                  reference_gradients[q] * inverse_jacobians[q][0][d];
+                for (unsigned int e = 1; e < dim; ++e)
+                  sum += reference_gradients[e * n_q_points + q] *
+                         inverse_jacobians[q][e][d];
+                gradients[q][d] = sum;
+              }
+        }
+      else
+        DEAL_II_ASSERT_UNREACHABLE();
+    }
+  } // namespace FEValuesImplementation
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
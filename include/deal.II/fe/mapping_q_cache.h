@@ -1,7 +1,7 @@
 // ------------------------------------------------------------------------
 //
 // SPDX-License-Identifier: LGPL-2.1-or-later
-// Copyright (C) 2019 - 2023 by the deal.II authors
+// Copyright (C) 2019 - 2025 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -47,6 +47,15 @@ class DoFHandler;
  * which is used in all operations of MappingQ. The information of the
  * mapping is pre-computed by the MappingQCache::initialize() function.
  *
+ * The support points of all cells are stored in a single contiguous array,
+ * indexed by the level and index of a cell, rather than in a separate vector
+ * per cell. Optionally, the points can be stored in single precision, which
+ * halves the memory consumption of the cache at the price of a relative
+ * accuracy of the geometry of around $10^{-7}$. For meshes whose cells move
+ * over time, e.g., in arbitrary Lagrangian-Eulerian (ALE) methods, the
+ * support points of a subset of cells can be recomputed by the update()
+ * function without setting up the whole cache again.
+ *
  * The use of this class is discussed extensively in step-65.
  */
 template <int dim, int spacedim = dim>
@@ -56,9 +65,12 @@ public:
   /**
    * Constructor. @p polynomial_degree denotes the polynomial degree of the
    * polynomials that are used to map cells from the reference to the real
-   * cell.
+   * cell. If @p store_in_single_precision is set to true, the support points
+   * are stored in single precision in the cache and converted back to double
+   * precision when they are used.
    */
-  explicit MappingQCache(const unsigned int polynomial_degree);
+  explicit MappingQCache(const unsigned int polynomial_degree,
+                         const bool store_in_single_precision = false);
 
   /**
    * Copy constructor.
@@ -191,6 +203,28 @@ public:
              const MGLevelObject<VectorType> &vectors,
              const bool vector_describes_relative_displacement);
 
+  /**
+   * Recompute the mapping support points of the given @p cells by the
+   * function @p compute_points_on_cell, keeping the support points of all
+   * other cells. The requirements on the function are the same as in the
+   * initialize() function taking a function as argument, and the function is
+   * invoked in parallel in the same way. This function is meant for meshes
+   * where only some cells move between two evaluations of the mapping, which
+   * would otherwise require to set up the whole cache again.
+   *
+   * The cache must have been set up by one of the initialize() functions
+   * before, and the triangulation must not have changed since then.
+   *
+   * @note Copies of this object created via clone() or the copy constructor
+   * share the cache and therefore also see the updated support points.
+   */
+  void
+  update(const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+           &cells,
+         const std::function<std::vector<Point<spacedim>>(
+           const typename Triangulation<dim, spacedim>::cell_iterator &)>
+           &compute_points_on_cell);
+
   /**
    * @copydoc Mapping::get_vertices()
    */
@@ -215,13 +249,73 @@ protected:
     const override;
 
 private:
+  /**
+   * The support points of all cells of a triangulation, stored in one
+   * contiguous array. Only one of the two arrays @p points and
+   * @p points_single is used, depending on the precision selected in the
+   * constructor.
+   */
+  struct SupportPointCache
+  {
+    /**
+     * The position of the first cell of each level in the list of all
+     * cells, with one additional entry holding the number of all cells.
+     */
+    std::vector<std::size_t> level_offsets;
+
+    /**
+     * The number of support points of each cell.
+     */
+    unsigned int n_points_per_cell;
+
+    /**
+     * The support points in double precision.
+     */
+    std::vector<Point<spacedim>> points;
+
+    /**
+     * The support points in single precision.
+     */
+    std::vector<Point<spacedim, float>> points_single;
+
+    /**
+     * Return the position of the first support point of the cell with the
+     * given level and index in the arrays above.
+     */
+    std::size_t
+    offset(const unsigned int level, const unsigned int index) const;
+
+    /**
+     * Return the memory consumption (in bytes) of this object.
+     */
+    std::size_t
+    memory_consumption() const;
+  };
+
+  /**
+   * Compute the support points of the given @p cells by the function
+   * @p compute_points_on_cell and store them in the cache, working on
+   * several cells in parallel.
+   */
+  void
+  compute_support_points(
+    const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      &cells,
+    const std::function<std::vector<Point<spacedim>>(
+      const typename Triangulation<dim, spacedim>::cell_iterator &)>
+      &compute_points_on_cell);
+
   /**
    * The point cache filled upon calling initialize(). It is made a shared
    * pointer to allow several instances (created via clone()) to share this
    * cache.
    */
-  std::shared_ptr<std::vector<std::vector<std::vector<Point<spacedim>>>>>
-    support_point_cache;
+  std::shared_ptr<SupportPointCache> support_point_cache;
+
+  /**
+   * Specifies whether the support points are stored in single precision.
+   */
+  bool store_in_single_precision;
 
   /**
    * The connection to Triangulation::signals::any that must be reset once
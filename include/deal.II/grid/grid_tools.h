@@ -605,6 +605,53 @@ namespace GridTools
       &cell_hint =
         typename Triangulation<dim, spacedim>::active_cell_iterator());
 
+  /**
+   * Find the active cell around each of the given @p points, and the
+   * coordinates of the point on the reference cell of that cell. This is the
+   * same as calling find_active_cell_around_point() with the given @p cache
+   * and @p tolerance for every point, but it is designed for large numbers
+   * of points:
+   * - The points are processed in batches, which are distributed to several
+   *   threads.
+   * - The candidate cells of each point are the non-artificial cells whose
+   *   bounding boxes, as stored in
+   *   GridTools::Cache::get_cell_bounding_boxes_rtree(), contain the point.
+   *   Within a batch, the points are grouped by candidate cell, and
+   *   Mapping::transform_points_real_to_unit_cell() is called once for
+   *   all points of each cell, which uses vectorized Newton iterations for
+   *   MappingQ.
+   * - A point lies in a candidate cell if ReferenceCell::contains_point()
+   *   returns true for its reference coordinates and @p tolerance. Of all
+   *   candidate cells the point lies in, the one with the smallest distance
+   *   of the reference coordinates to the reference cell is returned, and
+   *   the one with the smallest active cell index among those with equal
+   *   distance. The result is therefore independent of the number of
+   *   threads.
+   * - Only for the points for which no candidate cell is found, e.g.,
+   *   because a curved cell extends beyond the bounding box computed by the
+   *   mapping, find_active_cell_around_point() is called.
+   *
+   * @return A vector with one entry per point. For point @p i, the entry is
+   * a pair of the cell the point lies in and the coordinates of the point
+   * on the reference cell of that cell. If the point could not be found,
+   * the cell iterator is equal to Triangulation::end().
+   *
+   * @note If a point lies on the interface between two or more cells, it is
+   * not specified which of these cells is returned, nor does it need to be
+   * the same cell that find_active_cell_around_point() returns for the
+   * point.
+   *
+   * @note This function is not implemented for the codimension one case
+   * (<tt>spacedim != dim</tt>).
+   */
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+  find_active_cell_around_points(const Cache<dim, spacedim>         &cache,
+                                 const std::vector<Point<spacedim>> &points,
+                                 const double tolerance = 1.e-10);
+
   /**
    * Given a @p cache and a list of
    * @p local_points for each process, find the points lying on the locally
@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/bounding_box.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
@@ -33,14 +35,130 @@
 
 #include <boost/signals2.hpp>
 
+#include <array>
 #include <atomic>
 #include <cmath>
+#include <vector>
 
 
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
 {
+  /**
+   * A structure that stores the geometric information of all active cells of
+   * a Triangulation that is queried most often: the vertices, the center, the
+   * bounding box, the diameter and the measure of each cell. The data is
+   * indexed by the active cell index (see CellAccessor::active_cell_index())
+   * and stored as a structure of arrays, i.e., with one contiguous array per
+   * quantity and coordinate direction. Reading it thus avoids the
+   * indirections through the vertex indices of TriaAccessor::vertex() as well
+   * as the repeated computation of TriaAccessor::measure() and
+   * TriaAccessor::diameter(), and the arrays can be loaded directly into
+   * VectorizedArray objects to process several cells at once.
+   *
+   * All values are the ones returned by the corresponding functions of
+   * TriaAccessor, i.e., they are computed from the vertices of the
+   * triangulation and do not take into account a manifold or mapping.
+   *
+   * Objects of this type are created and kept up to date by
+   * Cache::get_cell_geometry().
+   */
+  template <int dim, int spacedim = dim>
+  struct CellGeometryData
+  {
+    /**
+     * Return the number of active cells for which data is stored.
+     */
+    unsigned int
+    size() const;
+
+    /**
+     * Return the vertex with number @p v of the active cell with index
+     * @p active_cell_index, as TriaAccessor::vertex() does.
+     */
+    Point<spacedim>
+    vertex(const unsigned int active_cell_index, const unsigned int v) const;
+
+    /**
+     * Return the center of the active cell with index @p active_cell_index,
+     * as TriaAccessor::center() does.
+     */
+    Point<spacedim>
+    center(const unsigned int active_cell_index) const;
+
+    /**
+     * Return the bounding box of the active cell with index
+     * @p active_cell_index, as TriaAccessor::bounding_box() does.
+     */
+    BoundingBox<spacedim>
+    bounding_box(const unsigned int active_cell_index) const;
+
+    /**
+     * Return the diameter of the active cell with index @p active_cell_index,
+     * as TriaAccessor::diameter() does.
+     */
+    double
+    diameter(const unsigned int active_cell_index) const;
+
+    /**
+     * Return the measure of the active cell with index @p active_cell_index,
+     * as TriaAccessor::measure() does.
+     */
+    double
+    measure(const unsigned int active_cell_index) const;
+
+    /**
+     * The number of entries per cell in the arrays of #vertices, i.e., the
+     * largest number of vertices of the cells of the triangulation. For
+     * cells with fewer vertices, the remaining entries repeat the first
+     * vertex of the cell.
+     */
+    unsigned int n_vertices_per_cell;
+
+    /**
+     * The number of vertices of each active cell.
+     */
+    std::vector<unsigned char> n_vertices;
+
+    /**
+     * The coordinates of the vertices of the active cells, with component
+     * @p d of vertex @p v of cell @p c stored in
+     * `vertices[d][c * n_vertices_per_cell + v]`.
+     */
+    std::array<AlignedVector<double>, spacedim> vertices;
+
+    /**
+     * The coordinates of the centers of the active cells, with component
+     * @p d of the center of cell @p c stored in `centers[d][c]`.
+     */
+    std::array<AlignedVector<double>, spacedim> centers;
+
+    /**
+     * The lower left corners of the bounding boxes of the active cells,
+     * stored like #centers.
+     */
+    std::array<AlignedVector<double>, spacedim> lower_corners;
+
+    /**
+     * The upper right corners of the bounding boxes of the active cells,
+     * stored like #centers.
+     */
+    std::array<AlignedVector<double>, spacedim> upper_corners;
+
+    /**
+     * The diameters of the active cells.
+     */
+    AlignedVector<double> diameters;
+
+    /**
+     * The measures of the active cells.
+     */
+    AlignedVector<double> measures;
+  };
+
+
+
   /**
    * A class that caches computationally intensive information about a
    * Triangulation.
@@ -221,6 +339,19 @@ namespace GridTools
     const RTree<std::pair<BoundingBox<spacedim>, unsigned int>> &
     get_covering_rtree(const unsigned int level = 0) const;
 
+    /**
+     * Return the cached vertices, centers, bounding boxes, diameters and
+     * measures of the active cells of the triangulation. See the
+     * CellGeometryData class for how to access them.
+     *
+     * As all other data of this class, the values are recomputed after the
+     * triangulation has changed. If the vertices have been moved without
+     * triggering a signal of the triangulation, call mark_for_update() with
+     * the flag update_cell_geometry.
+     */
+    const CellGeometryData<dim, spacedim> &
+    get_cell_geometry() const;
+
   private:
     /**
      * Keep track of what needs to be updated every time the triangulation
@@ -327,6 +458,12 @@ namespace GridTools
                        vertices_with_ghost_neighbors;
     mutable std::mutex vertices_with_ghost_neighbors_mutex;
 
+    /**
+     * Store the geometric information of the active cells.
+     */
+    mutable CellGeometryData<dim, spacedim> cell_geometry;
+    mutable std::mutex                      cell_geometry_mutex;
+
     /**
      * Storage for the status of the triangulation change signal.
      */
@@ -341,6 +478,83 @@ namespace GridTools
 
 
   // Inline functions
+  template <int dim, int spacedim>
+  inline unsigned int
+  CellGeometryData<dim, spacedim>::size() const
+  {
+    return diameters.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline Point<spacedim>
+  CellGeometryData<dim, spacedim>::vertex(const unsigned int active_cell_index,
+                                          const unsigned int v) const
+  {
+    AssertIndexRange(active_cell_index, size());
+    AssertIndexRange(v, n_vertices[active_cell_index]);
+    Point<spacedim> p;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      p[d] = vertices[d][active_cell_index * n_vertices_per_cell + v];
+    return p;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline Point<spacedim>
+  CellGeometryData<dim, spacedim>::center(
+    const unsigned int active_cell_index) const
+  {
+    AssertIndexRange(active_cell_index, size());
+    Point<spacedim> p;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      p[d] = centers[d][active_cell_index];
+    return p;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline BoundingBox<spacedim>
+  CellGeometryData<dim, spacedim>::bounding_box(
+    const unsigned int active_cell_index) const
+  {
+    AssertIndexRange(active_cell_index, size());
+    std::pair<Point<spacedim>, Point<spacedim>> corners;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        corners.first[d]  = lower_corners[d][active_cell_index];
+        corners.second[d] = upper_corners[d][active_cell_index];
+      }
+    return BoundingBox<spacedim>(corners);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline double
+  CellGeometryData<dim, spacedim>::diameter(
+    const unsigned int active_cell_index) const
+  {
+    AssertIndexRange(active_cell_index, size());
+    return diameters[active_cell_index];
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline double
+  CellGeometryData<dim, spacedim>::measure(
+    const unsigned int active_cell_index) const
+  {
+    AssertIndexRange(active_cell_index, size());
+    return measures[active_cell_index];
+  }
+
+
+
   template <int dim, int spacedim>
   inline const Triangulation<dim, spacedim> &
   Cache<dim, spacedim>::get_triangulation() const
@@ -89,6 +89,12 @@ namespace GridTools
      */
     update_vertex_with_ghost_neighbors = 0x200,
 
+    /**
+     * Update the vertices, centers, bounding boxes, diameters and measures
+     * of the active cells, as returned by Cache::get_cell_geometry().
+     */
+    update_cell_geometry = 0x400,
+
     /**
      * Update all objects.
      */
@@ -112,6 +118,8 @@ namespace GridTools
       s << "|vertex_to_cells_centers_directions";
     if (u & update_covering_rtree)
       s << "|covering_rtree";
+    if (u & update_cell_geometry)
+      s << "|cell_geometry";
     return s;
   }
 
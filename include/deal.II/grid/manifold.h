@@ -279,6 +279,21 @@ namespace Manifolds
  * approximate the limit process, and derived classes should do so.
  *
  *
+ * <h3>Thread safety</h3>
+ *
+ * The functions of this class may be called concurrently from several
+ * threads on the same object, for example by
+ * Triangulation::execute_coarsening_and_refinement(), which computes the
+ * locations of the new vertices in parallel, or by MappingQ during an
+ * assembly loop run through WorkStream. Derived classes must therefore
+ * implement the query functions, in particular get_new_point(),
+ * get_new_points(), project_to_manifold(), and the functions they call, such
+ * that they can run concurrently, i.e., they must not modify state shared
+ * between calls without synchronization. If a manifold cannot satisfy this
+ * requirement, the program needs to run with a single thread, see
+ * MultithreadInfo::set_thread_limit().
+ *
+ *
  * @ingroup manifold
  */
 template <int dim, int spacedim = dim>
@@ -362,6 +377,9 @@ public:
    * project_to_manifold() function with the convex combination of its
    * arguments. For simple situations you may get away by implementing
    * only the project_to_manifold() function.
+   *
+   * @note This function may be called concurrently from several threads,
+   * see the section on thread safety in the documentation of this class.
    */
   virtual Point<spacedim>
   get_new_point(const ArrayView<const Point<spacedim>> &surrounding_points,
@@ -492,6 +492,46 @@ namespace internal
          const unsigned int n_attached_deserialize_variable,
          const MPI_Comm    &mpi_communicator);
 
+    /**
+     * Same as save(), but each process maps its own section of the files
+     * into memory and copies its packed buffers directly into the mapping
+     * instead of going through MPI I/O or a stream.
+     *
+     * The files written have exactly the same layout as those written by
+     * save(), i.e., both functions and both load() and load_memory_mapped()
+     * can be used interchangeably. Since all processes write into shared
+     * mappings of the same files, the file system needs to provide POSIX
+     * coherent <tt>mmap</tt> semantics across all processes involved, which
+     * is the case for node-local storage but not necessarily for network file
+     * systems.
+     *
+     * On platforms without support for memory-mapped files, this function
+     * falls back to save().
+     */
+    void
+    save_memory_mapped(const unsigned int global_first_cell,
+                       const unsigned int global_num_cells,
+                       const std::string &file_basename,
+                       const MPI_Comm    &mpi_communicator) const;
+
+    /**
+     * Same as load(), but each process maps only its own section of the files
+     * into memory and fills the buffers used by unpack_data() with a single
+     * copy out of the mapping. In contrast to load(), the receiving buffers
+     * are neither zero-initialized first nor staged through MPI I/O.
+     *
+     * On platforms without support for memory-mapped files, this function
+     * falls back to load().
+     */
+    void
+    load_memory_mapped(const unsigned int global_first_cell,
+                       const unsigned int global_num_cells,
+                       const unsigned int local_num_cells,
+                       const std::string &file_basename,
+                       const unsigned int n_attached_deserialize_fixed,
+                       const unsigned int n_attached_deserialize_variable,
+                       const MPI_Comm    &mpi_communicator);
+
     /**
      * Clears all containers and associated data, and resets member
      * values to their default state.
@@ -2172,6 +2212,14 @@ public:
    * distorted (see the extensive discussion on
    * @ref GlossDistorted "distorted cells").
    *
+   * @note The locations of the new vertices, and thereby the calls to
+   * Manifold::get_new_point() and Manifold::project_to_manifold() of the
+   * manifolds attached to the triangulation, as well as the checks for
+   * distorted children are computed in parallel on several threads. The
+   * manifolds must therefore be thread-safe, see the documentation of the
+   * Manifold class. To keep this work serial, limit the number of threads to
+   * one with MultithreadInfo::set_thread_limit().
+   *
    * @note This function is <tt>virtual</tt> to allow derived classes to
    * insert hooks, such as saving refinement flags and the like (see e.g. the
    * PersistentTriangulation class).
@@ -3868,19 +3916,25 @@ protected:
    * Save additional cell-attached data from files all starting with
    * the base name given as last argument. The first
    * arguments are used to determine the offsets where to write buffers to.
+   * If @p memory_mapped is set, the files are written through memory
+   * mappings instead of MPI I/O, see
+   * internal::CellAttachedDataSerializer::save_memory_mapped().
    *
    * Called by @ref save.
    */
   void
   save_attached_data(const unsigned int global_first_cell,
                      const unsigned int global_num_cells,
-                     const std::string &file_basename) const;
+                     const std::string &file_basename,
+                     const bool         memory_mapped = false) const;
 
   /**
    * Load additional cell-attached data files all starting with the
    * base name given as fourth argument, if any was saved.
    * The first arguments are used to determine the offsets where to read
-   * buffers from.
+   * buffers from. If @p memory_mapped is set, the files are read through
+   * memory mappings instead of MPI I/O, see
+   * internal::CellAttachedDataSerializer::load_memory_mapped().
    *
    * Called by @ref load.
    */
@@ -3890,7 +3944,8 @@ protected:
                      const unsigned int local_num_cells,
                      const std::string &file_basename,
                      const unsigned int n_attached_deserialize_fixed,
-                     const unsigned int n_attached_deserialize_variable);
+                     const unsigned int n_attached_deserialize_variable,
+                     const bool         memory_mapped = false);
 
   /**
    * A function to record the CellStatus of currently active cells.
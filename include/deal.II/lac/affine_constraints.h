@@ -17,6 +17,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/subscriptor.h>
@@ -31,6 +32,8 @@
 #include <boost/range/iterator_range.hpp>
 
 #include <algorithm>
+#include <iterator>
+#include <optional>
 #include <set>
 #include <type_traits>
 #include <utility>
@@ -954,6 +957,30 @@ public:
   void
   close();
 
+  /**
+   * Select whether close() stores the constraints in a compact form. By
+   * default, every constraint stores its entries in a std::vector of its
+   * own. For problems with many constraints, e.g. from hanging nodes and
+   * periodicity on large meshes, the memory overhead of these many small
+   * vectors becomes significant, and functions that loop over all
+   * constraints, like distribute() or set_zero(), need to follow a pointer
+   * to a different place in memory for every constraint. If compact storage
+   * is selected, close() instead moves the entries of all constraints into
+   * one contiguous array, together with an array of offsets into it.
+   *
+   * All functions of this class work the same way with either form of
+   * storage. In particular, get_lines() and get_constraint_entries() return
+   * views of the entries, which refer to the compact array if the object
+   * uses compact storage. Functions that modify a closed object, like
+   * merge() or shift(), keep the compact form of storage.
+   *
+   * The setting is kept when calling clear() or reinit(). If the object
+   * is already closed, calling this function converts the storage
+   * immediately.
+   */
+  void
+  set_compact_storage(const bool compact_storage);
+
   /**
    * Check if the function close() was called or there are no
    * constraints locally, which is normally the case if a dummy
@@ -1172,10 +1199,14 @@ public:
   has_inhomogeneities() const;
 
   /**
-   * Return a pointer to the vector of entries if a line is constrained,
-   * and a zero pointer in case the dof is not constrained.
+   * Return a view of the entries of line @p line_n if this line is
+   * constrained, and an empty object in case the dof is not constrained.
+   *
+   * The view refers to the storage of the current object, independent of
+   * whether it uses compact storage, see set_compact_storage(). It is
+   * invalidated by any function that modifies the current object.
    */
-  const std::vector<std::pair<size_type, number>> *
+  std::optional<ArrayView<const std::pair<size_type, number>>>
   get_constraint_entries(const size_type line_n) const;
 
   /**
@@ -1934,10 +1965,142 @@ public:
     }
   };
 
+  /**
+   * A view of one constraint of an AffineConstraints object, as obtained by
+   * dereferencing the iterators of the range returned by get_lines(). In
+   * contrast to ConstraintLine, the entries are a view into the storage of
+   * the AffineConstraints object, which works with either form of storage,
+   * see set_compact_storage(). The view is invalidated by any function that
+   * modifies the AffineConstraints object.
+   */
+  struct ConstraintLineView
+  {
+    /**
+     * Global DoF index of this line.
+     */
+    size_type index;
+
+    /**
+     * Row numbers and values of the entries in this line.
+     */
+    ArrayView<const std::pair<size_type, number>> entries;
+
+    /**
+     * Value of the inhomogeneity.
+     */
+    number inhomogeneity;
+  };
+
+  /**
+   * An iterator over the constraints stored in an AffineConstraints object.
+   * Dereferencing the iterator gives a ConstraintLineView of the current
+   * line. Like the iterators of the Triangulation class, the iterator
+   * stores this view, so the reference returned by operator*() is only
+   * valid until the iterator is changed or destroyed.
+   */
+  class LineIterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = ConstraintLineView;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = const ConstraintLineView &;
+    using pointer           = const ConstraintLineView *;
+
+    /**
+     * Constructor. Create an iterator pointing to line number @p position
+     * in the list of lines stored in @p constraints.
+     */
+    LineIterator(const AffineConstraints<number> *constraints,
+                 const std::size_t                position);
+
+    /**
+     * Dereferencing operator.
+     */
+    reference
+    operator*() const;
+
+    /**
+     * Dereferencing operator.
+     */
+    pointer
+    operator->() const;
+
+    /**
+     * Prefix increment.
+     */
+    LineIterator &
+    operator++();
+
+    /**
+     * Postfix increment.
+     */
+    LineIterator
+    operator++(int);
+
+    /**
+     * Prefix decrement.
+     */
+    LineIterator &
+    operator--();
+
+    /**
+     * Move the iterator by @p n lines.
+     */
+    LineIterator &
+    operator+=(const difference_type n);
+
+    /**
+     * Return an iterator that is moved by @p n lines.
+     */
+    LineIterator
+    operator+(const difference_type n) const;
+
+    /**
+     * Return the distance between the current iterator and @p other.
+     */
+    difference_type
+    operator-(const LineIterator &other) const;
+
+    /**
+     * Comparison operator.
+     */
+    bool
+    operator==(const LineIterator &other) const;
+
+    /**
+     * Comparison operator.
+     */
+    bool
+    operator!=(const LineIterator &other) const;
+
+    /**
+     * Comparison operator.
+     */
+    bool
+    operator<(const LineIterator &other) const;
+
+  private:
+    /**
+     * The object whose lines are iterated over.
+     */
+    const AffineConstraints<number> *constraints;
+
+    /**
+     * The index of the current line in AffineConstraints::lines.
+     */
+    std::size_t position;
+
+    /**
+     * The view of the current line, set up by the dereferencing operators.
+     */
+    mutable ConstraintLineView view;
+  };
+
   /**
    * Alias for the iterator type that is used in the LineRange container.
    */
-  using const_iterator = typename std::vector<ConstraintLine>::const_iterator;
+  using const_iterator = LineIterator;
 
   /**
    * Alias for the return type used by get_lines().
@@ -1950,7 +2113,9 @@ public:
    * initialize range-based for loops as supported by C++11.
    *
    * @return A range object for the half open range <code>[this->begin(),
-   * this->end())</code> of line entries.
+   * this->end())</code> of line entries. Dereferencing its iterators gives
+   * a ConstraintLineView of a line, which works with either form of storage,
+   * see set_compact_storage().
    */
   LineRange
   get_lines() const;
@@ -2194,6 +2359,47 @@ private:
    */
   std::vector<size_type> lines_cache;
 
+  /**
+   * Whether close() stores the entries of the lines in compact form, see
+   * set_compact_storage().
+   */
+  bool compact_storage = false;
+
+  /**
+   * If the object is closed with compact storage, the entries of lines[i]
+   * are stored in compact_entries, starting at index compact_line_starts[i]
+   * and ending before compact_line_starts[i+1], and the vectors
+   * ConstraintLine::entries are empty. Otherwise, both arrays are empty.
+   */
+  std::vector<std::size_t> compact_line_starts;
+
+  /**
+   * The entries of all lines if the object is closed with compact storage,
+   * see compact_line_starts.
+   */
+  std::vector<std::pair<size_type, number>> compact_entries;
+
+  /**
+   * Return the entries of the line @p line, which must be an element of
+   * #lines, independent of the form of storage.
+   */
+  ArrayView<const std::pair<size_type, number>>
+  get_entries(const ConstraintLine &line) const;
+
+  /**
+   * Move the entries of all lines into compact storage.
+   */
+  void
+  compact_lines();
+
+  /**
+   * Move the entries of all lines from compact storage back into the
+   * vectors ConstraintLine::entries. If the object does not use compact
+   * storage, this function does nothing.
+   */
+  void
+  expand_compact_lines();
+
   /**
    * This IndexSet denotes the set of locally owned DoFs (or, more correctly,
    * the locally owned vector elements when operating on parallel vectors)
@@ -2344,6 +2550,9 @@ inline AffineConstraints<number>::AffineConstraints(
   : Subscriptor()
   , lines(affine_constraints.lines)
   , lines_cache(affine_constraints.lines_cache)
+  , compact_storage(affine_constraints.compact_storage)
+  , compact_line_starts(affine_constraints.compact_line_starts)
+  , compact_entries(affine_constraints.compact_entries)
   , locally_owned_dofs(affine_constraints.locally_owned_dofs)
   , local_lines(affine_constraints.local_lines)
   , needed_elements_for_distribute(
@@ -2471,9 +2680,10 @@ AffineConstraints<number>::n_identities() const
 {
   return std::count_if(lines.begin(),
                        lines.end(),
-                       [](const ConstraintLine &line) {
-                         return (line.entries.size() == 1) &&
-                                (line.entries[0].second == number(1.));
+                       [this](const ConstraintLine &line) {
+                         const auto entries = get_entries(line);
+                         return (entries.size() == 1) &&
+                                (entries[0].second == number(1.));
                        });
 }
 
@@ -2519,20 +2729,21 @@ AffineConstraints<number>::is_inhomogeneously_constrained(
 }
 
 template <typename number>
-inline const std::vector<std::pair<types::global_dof_index, number>> *
+inline std::optional<
+  ArrayView<const std::pair<types::global_dof_index, number>>>
 AffineConstraints<number>::get_constraint_entries(const size_type line_n) const
 {
   if (lines.empty())
-    return nullptr;
+    return {};
 
   // check whether the entry is constrained. could use is_constrained, but
   // that means computing the line index twice
   const size_type line_index = calculate_line_index(line_n);
   if (line_index >= lines_cache.size() ||
       lines_cache[line_index] == numbers::invalid_size_type)
-    return nullptr;
+    return {};
   else
-    return &lines[lines_cache[line_index]].entries;
+    return get_entries(lines[lines_cache[line_index]]);
 }
 
 template <typename number>
@@ -2549,6 +2760,126 @@ AffineConstraints<number>::get_inhomogeneity(const size_type line_n) const
     return lines[lines_cache[line_index]].inhomogeneity;
 }
 
+template <typename number>
+inline ArrayView<const std::pair<types::global_dof_index, number>>
+AffineConstraints<number>::get_entries(const ConstraintLine &line) const
+{
+  if (compact_line_starts.empty())
+    return make_array_view(line.entries);
+
+  const std::size_t position = &line - lines.data();
+  AssertIndexRange(position, lines.size());
+  return make_array_view(compact_entries.data() +
+                           compact_line_starts[position],
+                         compact_entries.data() +
+                           compact_line_starts[position + 1]);
+}
+
+template <typename number>
+inline AffineConstraints<number>::LineIterator::LineIterator(
+  const AffineConstraints<number> *constraints,
+  const std::size_t                position)
+  : constraints(constraints)
+  , position(position)
+{}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator::reference
+AffineConstraints<number>::LineIterator::operator*() const
+{
+  AssertIndexRange(position, constraints->lines.size());
+  const ConstraintLine &line = constraints->lines[position];
+  view.index                 = line.index;
+  view.entries               = constraints->get_entries(line);
+  view.inhomogeneity         = line.inhomogeneity;
+  return view;
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator::pointer
+AffineConstraints<number>::LineIterator::operator->() const
+{
+  return &(this->operator*());
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator &
+AffineConstraints<number>::LineIterator::operator++()
+{
+  ++position;
+  return *this;
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator
+AffineConstraints<number>::LineIterator::operator++(int)
+{
+  const LineIterator copy(*this);
+  ++position;
+  return copy;
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator &
+AffineConstraints<number>::LineIterator::operator--()
+{
+  --position;
+  return *this;
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator &
+AffineConstraints<number>::LineIterator::operator+=(const difference_type n)
+{
+  position += n;
+  return *this;
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator
+AffineConstraints<number>::LineIterator::operator+(
+  const difference_type n) const
+{
+  return LineIterator(constraints, position + n);
+}
+
+template <typename number>
+inline typename AffineConstraints<number>::LineIterator::difference_type
+AffineConstraints<number>::LineIterator::operator-(
+  const LineIterator &other) const
+{
+  Assert(constraints == other.constraints,
+         ExcMessage("The two iterators point to different objects."));
+  return static_cast<difference_type>(position) -
+         static_cast<difference_type>(other.position);
+}
+
+template <typename number>
+inline bool
+AffineConstraints<number>::LineIterator::operator==(
+  const LineIterator &other) const
+{
+  return constraints == other.constraints && position == other.position;
+}
+
+template <typename number>
+inline bool
+AffineConstraints<number>::LineIterator::operator!=(
+  const LineIterator &other) const
+{
+  return !(*this == other);
+}
+
+template <typename number>
+inline bool
+AffineConstraints<number>::LineIterator::operator<(
+  const LineIterator &other) const
+{
+  Assert(constraints == other.constraints,
+         ExcMessage("The two iterators point to different objects."));
+  return position < other.position;
+}
+
 template <typename number>
 inline types::global_dof_index
 AffineConstraints<number>::calculate_line_index(const size_type line_n) const
@@ -2607,9 +2938,8 @@ AffineConstraints<number>::distribute_local_to_global(
     {
       const ConstraintLine &position =
         lines[lines_cache[calculate_line_index(index)]];
-      for (size_type j = 0; j < position.entries.size(); ++j)
-        global_vector(position.entries[j].first) +=
-          value * position.entries[j].second;
+      for (const auto &entry : get_entries(position))
+        global_vector(entry.first) += value * entry.second;
     }
 }
 
@@ -2636,11 +2966,9 @@ AffineConstraints<number>::distribute_local_to_global(
         {
           const ConstraintLine &position =
             lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          for (size_type j = 0; j < position.entries.size(); ++j)
+          for (const auto &entry : get_entries(position))
             internal::ElementAccess<VectorType>::add(
-              (*local_vector_begin) * position.entries[j].second,
-              position.entries[j].first,
-              global_vector);
+              (*local_vector_begin) * entry.second, entry.first, global_vector);
         }
     }
 }
@@ -2684,9 +3012,8 @@ AffineConstraints<number>::get_dof_values(
           const ConstraintLine &position =
             lines[lines_cache[calculate_line_index(*local_indices_begin)]];
           typename VectorType::value_type value = position.inhomogeneity;
-          for (size_type j = 0; j < position.entries.size(); ++j)
-            value += (global_vector(position.entries[j].first) *
-                      position.entries[j].second);
+          for (const auto &entry : get_entries(position))
+            value += (global_vector(entry.first) * entry.second);
           *local_vector_begin = value;
         }
     }
@@ -2782,14 +3109,22 @@ AffineConstraints<number>::copy_from(
   lines.reserve(other.lines.size());
 
   for (const auto &l : other.lines)
-    lines.emplace_back(l.index,
-                       typename ConstraintLine::Entries(l.entries.begin(),
-                                                        l.entries.end()),
-                       l.inhomogeneity);
+    {
+      const auto entries = other.get_entries(l);
+      lines.emplace_back(l.index,
+                         typename ConstraintLine::Entries(entries.begin(),
+                                                          entries.end()),
+                         l.inhomogeneity);
+    }
 
-  lines_cache = other.lines_cache;
-  local_lines = other.local_lines;
-  sorted      = other.sorted;
+  lines_cache     = other.lines_cache;
+  local_lines     = other.local_lines;
+  sorted          = other.sorted;
+  compact_storage = other.compact_storage;
+  compact_line_starts.clear();
+  compact_entries.clear();
+  if (sorted && compact_storage)
+    compact_lines();
 
   locally_owned_dofs             = other.locally_owned_dofs;
   needed_elements_for_distribute = other.needed_elements_for_distribute;
@@ -2813,7 +3148,8 @@ AffineConstraints<number>::merge(
 
   // store the previous state with respect to sorting
   const bool object_was_sorted = sorted;
-  sorted                       = false;
+  expand_compact_lines();
+  sorted = false;
 
   // first action is to fold into the present object possible constraints
   // in the second object. we don't strictly need to do this any more since
@@ -2845,13 +3181,16 @@ AffineConstraints<number>::merge(
             // entry by a sequence of new entries taken from the other
             // object, but with multiplied weights
             {
-              const auto *other_entries =
-                other_constraints.get_constraint_entries(entry.first);
-              Assert(other_entries != nullptr, ExcInternalError());
+              const auto &other_line =
+                other_constraints.lines[other_constraints.lines_cache
+                                          [other_constraints
+                                             .calculate_line_index(
+                                               entry.first)]];
 
               const number weight = entry.second;
 
-              for (const auto &other_entry : *other_entries)
+              for (const auto &other_entry :
+                   other_constraints.get_entries(other_line))
                 tmp.emplace_back(other_entry.first,
                                  other_entry.second * weight);
 
@@ -2886,13 +3225,14 @@ AffineConstraints<number>::merge(
     // Add other_constraints to lines cache and our list of constraints
     for (const auto &line : other_constraints.lines)
       {
+        const auto      other_entries = other_constraints.get_entries(line);
         const size_type local_line_no = calculate_line_index(line.index);
         if (local_line_no >= lines_cache.size())
           {
             lines_cache.resize(local_line_no + 1, numbers::invalid_size_type);
             lines.emplace_back(line.index,
                                typename ConstraintLine::Entries(
-                                 line.entries.begin(), line.entries.end()),
+                                 other_entries.begin(), other_entries.end()),
                                line.inhomogeneity);
             lines_cache[local_line_no] = index++;
           }
@@ -2901,7 +3241,7 @@ AffineConstraints<number>::merge(
             // there are no constraints for that line yet
             lines.emplace_back(line.index,
                                typename ConstraintLine::Entries(
-                                 line.entries.begin(), line.entries.end()),
+                                 other_entries.begin(), other_entries.end()),
                                line.inhomogeneity);
             AssertIndexRange(local_line_no, lines_cache.size());
             lines_cache[local_line_no] = index++;
@@ -2924,8 +3264,8 @@ AffineConstraints<number>::merge(
                   AssertIndexRange(local_line_no, lines_cache.size());
                   lines[lines_cache[local_line_no]] = {
                     line.index,
-                    typename ConstraintLine::Entries(line.entries.begin(),
-                                                     line.entries.end()),
+                    typename ConstraintLine::Entries(other_entries.begin(),
+                                                     other_entries.end()),
                     static_cast<number>(line.inhomogeneity)};
                   break;
 
@@ -58,6 +58,7 @@
 
 #include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <iomanip>
 #include <numeric>
 #include <ostream>
@@ -200,7 +201,8 @@ template <typename number>
 typename AffineConstraints<number>::LineRange
 AffineConstraints<number>::get_lines() const
 {
-  return boost::make_iterator_range(lines.begin(), lines.end());
+  return boost::make_iterator_range(const_iterator(this, 0),
+                                    const_iterator(this, lines.size()));
 }
 
 
@@ -225,7 +227,15 @@ AffineConstraints<number>::is_consistent_in_parallel(
         return empty;
       }
     else
-      return lines[lines_cache[line_index]];
+      {
+        const ConstraintLine &line    = lines[lines_cache[line_index]];
+        const auto            entries = get_entries(line);
+        const ConstraintLine  copy    = {line.index,
+                                         typename ConstraintLine::Entries(
+                                           entries.begin(), entries.end()),
+                                         line.inhomogeneity};
+        return copy;
+      }
   };
 
   // identify non-owned rows and send to owner:
@@ -492,7 +502,7 @@ namespace internal
 
           if (const auto constraints =
                 constraints_in.get_constraint_entries(index))
-            entry.entries = *constraints;
+            entry.entries.assign(constraints->begin(), constraints->end());
 
           if (constrained_indices_owners[i] == my_rank)
             locally_relevant_constraints.push_back(entry);
@@ -889,7 +899,8 @@ AffineConstraints<number>::add_selected_constraints(
         const size_type row = filter.index_within_set(line.index);
         add_line(row);
         set_inhomogeneity(row, line.inhomogeneity);
-        for (const std::pair<size_type, number> &entry : line.entries)
+        for (const std::pair<size_type, number> &entry :
+             constraints.get_entries(line))
           if (filter.is_element(entry.first))
             add_entry(row, filter.index_within_set(entry.first), entry.second);
       }
@@ -904,25 +915,22 @@ AffineConstraints<number>::close()
   if (sorted == true)
     return;
 
-  // sort the lines
-  std::sort(lines.begin(),
-            lines.end(),
-            [](const ConstraintLine &l1, const ConstraintLine &l2) {
-              return l1.index < l2.index;
-            });
-
-  // update list of pointers and give the vector a sharp size since we
+  // sort the lines by the index of the constrained DoF. lines_cache is
+  // indexed by a monotone function of these indices, so walking through it
+  // gives the sorted order without comparison sort. at the same time, update
+  // the list of pointers, and give the vector of lines a sharp size since we
   // won't modify the size any more after this point.
   {
-    std::vector<size_type> new_lines(lines_cache.size(),
-                                     numbers::invalid_size_type);
-    size_type              counter = 0;
-    for (const ConstraintLine &line : lines)
-      {
-        new_lines[calculate_line_index(line.index)] = counter;
-        ++counter;
-      }
-    lines_cache = std::move(new_lines);
+    std::vector<ConstraintLine> sorted_lines;
+    sorted_lines.reserve(lines.size());
+    for (size_type &line_position : lines_cache)
+      if (line_position != numbers::invalid_size_type)
+        {
+          sorted_lines.push_back(std::move(lines[line_position]));
+          line_position = sorted_lines.size() - 1;
+        }
+    AssertDimension(sorted_lines.size(), lines.size());
+    lines.swap(sorted_lines);
   }
 
   // in debug mode: check whether we really set the pointers correctly.
@@ -930,6 +938,8 @@ AffineConstraints<number>::close()
     if (lines_cache[i] != numbers::invalid_size_type)
       Assert(i == calculate_line_index(lines[lines_cache[i]].index),
              ExcInternalError());
+  for (size_type i = 1; i < lines.size(); ++i)
+    Assert(lines[i - 1].index < lines[i].index, ExcInternalError());
 
   // The second part is that we need to work on the individual lines.
   // Let us start by stripping zero entries. That would mean that in the linear
@@ -956,173 +966,121 @@ AffineConstraints<number>::close()
 
 
 
-#ifdef DEBUG
-  // In debug mode we are computing an estimate for the maximum number
-  // of constraints so that we can bail out if there is a cycle in the
-  // constraints (which is easier than searching for cycles in the graph).
+  // replace references to dofs that are themselves constrained. because we
+  // may replace references to other dofs that may themselves be constrained
+  // to third ones, we do this in rounds: in every round, we expand all lines
+  // whose references to constrained dofs only point to lines that are
+  // already final, i.e., that do not reference constrained dofs any more.
+  // these lines are then final themselves at the end of the round. since a
+  // line only reads lines that have become final in earlier rounds and only
+  // writes to itself, all lines of a round can be worked on in parallel. the
+  // number of rounds is the length of the longest chain of constraints,
+  // which is small in practice.
   //
-  // Let us figure out the largest dof index. This is an upper bound for the
-  // number of constraints because it is an approximation for the number of dofs
-  // in our system.
-  size_type largest_idx = 0;
-  for (const ConstraintLine &line : lines)
-    for (const std::pair<size_type, number> &entry : line.entries)
-      largest_idx = std::max(largest_idx, entry.first);
-#endif
-
-      // replace references to dofs that are themselves constrained. note that
-      // because we may replace references to other dofs that may themselves be
-      // constrained to third ones, we have to iterate over all this until we
-      // replace no chains of constraints any more
-      //
-      // the iteration replaces references to constrained degrees of freedom by
-      // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
-      // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
-      // twice. we will throw this duplicate out in the following step, where
-      // we sort the list so that throwing out duplicates becomes much more
-      // efficient. also, we have to do it only once, rather than in each
-      // iteration
-#ifdef DEBUG
-  size_type iteration = 0;
-#endif
-  bool              chained_constraint_replaced = false;
-  std::vector<bool> line_finalized(lines.size(), false);
-  do
-    {
-      chained_constraint_replaced = false;
-      for (unsigned int line_index = 0; line_index < lines.size(); ++line_index)
-        if (line_finalized[line_index] == false)
-          {
-            ConstraintLine &line = lines[line_index];
-
-#ifdef DEBUG
-            // we need to keep track of how many replacements we do in this
-            // line, because we can end up in a cycle A->B->C->A without the
-            // number of entries growing.
-            size_type n_replacements = 0;
-#endif
-
-            // loop over all entries of this line (including ones that we
-            // have appended in this go around) and see whether they are
-            // further constrained. ignore elements that we don't store on
-            // the current processor.
-            const unsigned int n_original_entries  = line.entries.size();
-            bool               has_sub_constraints = false;
-            const size_type    lines_cache_size    = lines_cache.size();
-            for (unsigned int entry = 0; entry < n_original_entries; ++entry)
-              {
-                const size_type dof_index =
-                  calculate_line_index(line.entries[entry].first);
-
-                if (dof_index < lines_cache_size &&
-                    lines_cache[dof_index] != numbers::invalid_size_type)
-                  {
-                    // Now we found an index that is further constrained, so
-                    // we need to resolve the entries.  We may replace some of
-                    // them, and we may add some, but we only walk through the
-                    // original entries (and also don't touch the
-                    // replacements) even though in principle we could also do
-                    // the ones we have added or replaced. There is no harm in
-                    // doing so: we will simply treat those in the next round
-                    // around of the outer iteration.
-                    has_sub_constraints = true;
-
-                    const number weight = line.entries[entry].second;
-                    Assert(line.entries[entry].first != line.index,
-                           ExcMessage("Cycle in constraints detected!"));
-
-                    const ConstraintLine &constrained_line =
-                      lines[lines_cache[dof_index]];
-                    Assert(constrained_line.index == line.entries[entry].first,
-                           ExcInternalError());
-
-                    // now we have to replace an entry by its expansion. we do
-                    // that by overwriting the entry by the first entry of the
-                    // expansion and adding the remaining ones to the end,
-                    // where we will later process them once more
-                    //
-                    // we can of course only do that if the DoF that we are
-                    // currently handling is constrained by a linear combination
-                    // of other dofs:
-                    if (constrained_line.entries.size() > 0)
-                      {
-                        for (size_type i = 0;
-                             i < constrained_line.entries.size();
-                             ++i)
-                          Assert(line.entries[entry].first !=
-                                   constrained_line.entries[i].first,
-                                 ExcMessage("Cycle in constraints detected!"));
-
-                        // replace first entry, then tack the rest to the end
-                        // of the list
-                        line.entries[entry] = std::pair<size_type, number>(
-                          constrained_line.entries[0].first,
-                          constrained_line.entries[0].second * weight);
-
-                        for (size_type i = 1;
-                             i < constrained_line.entries.size();
-                             ++i)
-                          line.entries.emplace_back(
-                            constrained_line.entries[i].first,
-                            constrained_line.entries[i].second * weight);
-
-#ifdef DEBUG
-                        // keep track of how many entries we replace in this
-                        // line. If we do more than there are constraints or
-                        // dofs in our system, we must have a cycle.
-                        ++n_replacements;
-                        Assert(n_replacements / 2 < largest_idx,
-                               ExcMessage("Cycle in constraints detected!"));
-#endif
-                      }
-                    else
-                      // the DoF that we encountered is not constrained by a
-                      // linear combination of other dofs but is equal to just
-                      // the inhomogeneity (i.e. its chain of entries is
-                      // empty). in that case, we can't just overwrite the
-                      // current entry, but we have to actually eliminate
-                      // it. we do not want to change the loop length above we
-                      // do so by setting the 'first' entry to
-                      // invalid_size_type here to finally remove entries in a
-                      // second loop
-                      {
-                        line.entries[entry].first = numbers::invalid_size_type;
-                      }
-
-                    line.inhomogeneity +=
-                      constrained_line.inhomogeneity * weight;
-                  }
-              }
+  // the expansion replaces references to constrained degrees of freedom by
+  // their expansions. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2, then the
+  // new list will be x3=x0/2+x0/4+x1/4. note that x0 appear twice. we will
+  // throw this duplicate out in the following step, where we sort the list
+  // so that throwing out duplicates becomes much more efficient.
+  {
+    const size_type lines_cache_size = lines_cache.size();
+    const auto      get_line_position = [&](const size_type dof) {
+      const size_type dof_index = calculate_line_index(dof);
+      return (dof_index < lines_cache_size ? lines_cache[dof_index] :
+                                             numbers::invalid_size_type);
+    };
 
-            // If none of the entries in the current line refer to DoFs that are
-            // themselves constrained, then we can move on:
-            if (has_sub_constraints == false)
-              line_finalized[line_index] = true;
-            else
-              {
-                chained_constraint_replaced = true;
+    // the state of every line: whether it is final, and whether it has been
+    // expanded in the current round. the latter is only written to in the
+    // parallel loop, the former only read.
+    std::vector<std::uint8_t> line_is_final(lines.size(), 0);
+    std::vector<std::uint8_t> line_expanded(lines.size(), 0);
+    size_type                 n_final_lines = 0;
+    while (n_final_lines < lines.size())
+      {
+        parallel::apply_to_subranges(
+          size_type(0),
+          size_type(lines.size()),
+          [&](const size_type begin, const size_type end) {
+            for (size_type l = begin; l < end; ++l)
+              if (line_is_final[l] == 0)
+                {
+                  ConstraintLine &line = lines[l];
+
+                  // ignore elements that we don't store on the current
+                  // processor. if one of the referenced lines is not yet
+                  // final, we need to wait for a later round
+                  bool has_sub_constraints = false;
+                  bool can_expand          = true;
+                  for (const std::pair<size_type, number> &entry :
+                       line.entries)
+                    {
+                      const size_type position =
+                        get_line_position(entry.first);
+                      if (position != numbers::invalid_size_type)
+                        {
+                          has_sub_constraints = true;
+                          if (line_is_final[position] == 0)
+                            {
+                              can_expand = false;
+                              break;
+                            }
+                        }
+                    }
+                  if (can_expand == false)
+                    continue;
 
-                // Now delete the elements we have marked for deletion.
-                auto remaining_entries = line.entries.begin();
-                for (const auto &entry : line.entries)
-                  if (entry.first != numbers::invalid_size_type)
+                  if (has_sub_constraints)
                     {
-                      *remaining_entries = entry;
-                      ++remaining_entries;
+                      typename ConstraintLine::Entries new_entries;
+                      new_entries.reserve(line.entries.size());
+                      for (const std::pair<size_type, number> &entry :
+                           line.entries)
+                        {
+                          const size_type position =
+                            get_line_position(entry.first);
+                          if (position == numbers::invalid_size_type)
+                            new_entries.push_back(entry);
+                          else
+                            {
+                              // if the constrained DoF is equal to just an
+                              // inhomogeneity (i.e. its list of entries is
+                              // empty), the entry is simply eliminated
+                              const ConstraintLine &constrained_line =
+                                lines[position];
+                              for (const std::pair<size_type, number>
+                                     &sub_entry : constrained_line.entries)
+                                new_entries.emplace_back(sub_entry.first,
+                                                         sub_entry.second *
+                                                           entry.second);
+                              line.inhomogeneity +=
+                                constrained_line.inhomogeneity * entry.second;
+                            }
+                        }
+                      line.entries.swap(new_entries);
                     }
-                line.entries.erase(remaining_entries, line.entries.end());
-              }
-          }
 
-#ifdef DEBUG
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size() + 1, ExcInternalError());
-#endif
-    }
-  while (chained_constraint_replaced == true);
+                  line_expanded[l] = 1;
+                }
+          },
+          /* grainsize = */ 100);
+
+        size_type n_expanded_lines = 0;
+        for (size_type l = 0; l < lines.size(); ++l)
+          if (line_expanded[l] != 0)
+            {
+              line_expanded[l] = 0;
+              line_is_final[l] = 1;
+              ++n_expanded_lines;
+            }
+
+        // if no line could be expanded in this round, the remaining lines
+        // reference each other
+        AssertThrow(n_expanded_lines > 0,
+                    ExcMessage("Cycle in constraints detected!"));
+        n_final_lines += n_expanded_lines;
+      }
+  }
 
   // Finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
@@ -1291,6 +1249,78 @@ AffineConstraints<number>::close()
     }
 
   sorted = true;
+
+  if (compact_storage)
+    compact_lines();
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::set_compact_storage(const bool compact_storage)
+{
+  this->compact_storage = compact_storage;
+
+  if (sorted == true)
+    {
+      if (compact_storage)
+        compact_lines();
+      else
+        expand_compact_lines();
+    }
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::compact_lines()
+{
+  if (compact_line_starts.empty() == false)
+    return;
+
+  std::size_t n_entries = 0;
+  for (const ConstraintLine &line : lines)
+    n_entries += line.entries.size();
+
+  compact_line_starts.resize(lines.size() + 1);
+  compact_entries.reserve(n_entries);
+  for (size_type i = 0; i < lines.size(); ++i)
+    {
+      compact_line_starts[i] = compact_entries.size();
+      compact_entries.insert(compact_entries.end(),
+                             lines[i].entries.begin(),
+                             lines[i].entries.end());
+
+      // release the memory of the line's own vector
+      typename ConstraintLine::Entries().swap(lines[i].entries);
+    }
+  compact_line_starts.back() = compact_entries.size();
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::expand_compact_lines()
+{
+  if (compact_line_starts.empty())
+    return;
+
+  for (size_type i = 0; i < lines.size(); ++i)
+    lines[i].entries.assign(compact_entries.begin() + compact_line_starts[i],
+                            compact_entries.begin() +
+                              compact_line_starts[i + 1]);
+
+  {
+    std::vector<std::size_t> tmp;
+    compact_line_starts.swap(tmp);
+  }
+  {
+    std::vector<std::pair<size_type, number>> tmp;
+    compact_entries.swap(tmp);
+  }
 }
 
 
@@ -1333,6 +1363,8 @@ AffineConstraints<number>::shift(const size_type offset)
       for (std::pair<size_type, number> &entry : line.entries)
         entry.first += offset;
     }
+  for (std::pair<size_type, number> &entry : compact_entries)
+    entry.first += offset;
 
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
@@ -1379,7 +1411,7 @@ AffineConstraints<number>::get_view(const IndexSet &mask) const
     if (mask.is_element(line.index))
       {
 #ifdef DEBUG
-        for (const std::pair<size_type, number> &entry : line.entries)
+        for (const std::pair<size_type, number> &entry : get_entries(line))
           {
             Assert(
               mask.is_element(entry.first),
@@ -1397,8 +1429,9 @@ AffineConstraints<number>::get_view(const IndexSet &mask) const
           }
 #endif
 
-        std::vector<std::pair<size_type, number>> translated_entries =
-          line.entries;
+        const auto entries = get_entries(line);
+        std::vector<std::pair<size_type, number>> translated_entries(
+          entries.begin(), entries.end());
         for (auto &entry : translated_entries)
           entry.first = mask.index_within_set(entry.first);
 
@@ -1427,6 +1460,16 @@ AffineConstraints<number>::clear()
     lines_cache.swap(tmp);
   }
 
+  {
+    std::vector<std::size_t> tmp;
+    compact_line_starts.swap(tmp);
+  }
+
+  {
+    std::vector<std::pair<size_type, number>> tmp;
+    compact_entries.swap(tmp);
+  }
+
   locally_owned_dofs             = {};
   local_lines                    = {};
   needed_elements_for_distribute = {};
@@ -1491,7 +1534,8 @@ AffineConstraints<number>::is_identity_constrained(const size_type line_n) const
 
   // return if an entry for this line was found and if it has only one
   // entry equal to 1.0
-  return (line.entries.size() == 1) && (line.entries[0].second == number(1.0));
+  const auto entries = get_entries(line);
+  return (entries.size() == 1) && (entries[0].second == number(1.0));
 }
 
 
@@ -1506,24 +1550,24 @@ AffineConstraints<number>::are_identity_constrained(
       const ConstraintLine &line =
         lines[lines_cache[calculate_line_index(line_n_1)]];
       Assert(line.index == line_n_1, ExcInternalError());
+      const auto entries = get_entries(line);
 
       // return if an entry for this line was found and if it has only one
       // entry equal to 1.0 and that one is index2
-      return ((line.entries.size() == 1) &&
-              (line.entries[0].first == line_n_2) &&
-              (line.entries[0].second == number(1.0)));
+      return ((entries.size() == 1) && (entries[0].first == line_n_2) &&
+              (entries[0].second == number(1.0)));
     }
   else if (is_constrained(line_n_2) == true)
     {
       const ConstraintLine &line =
         lines[lines_cache[calculate_line_index(line_n_2)]];
       Assert(line.index == line_n_2, ExcInternalError());
+      const auto entries = get_entries(line);
 
       // return if an entry for this line was found and if it has only one
       // entry equal to 1.0 and that one is line_n_1
-      return ((line.entries.size() == 1) &&
-              (line.entries[0].first == line_n_1) &&
-              (line.entries[0].second == number(1.0)));
+      return ((entries.size() == 1) && (entries[0].first == line_n_1) &&
+              (entries[0].second == number(1.0)));
     }
   else
     return false;
@@ -1540,7 +1584,7 @@ AffineConstraints<number>::max_constraint_indirections() const
     // use static cast, since typeof(size)==std::size_t, which is !=
     // size_type on AIX
     return_value =
-      std::max(return_value, static_cast<size_type>(line.entries.size()));
+      std::max(return_value, static_cast<size_type>(get_entries(line).size()));
 
   return return_value;
 }
@@ -1567,9 +1611,10 @@ AffineConstraints<number>::print(std::ostream &out) const
   for (const ConstraintLine &line : lines)
     {
       // output the list of constraints as pairs of dofs and their weights
-      if (line.entries.size() > 0)
+      const auto entries = get_entries(line);
+      if (entries.size() > 0)
         {
-          for (const std::pair<size_type, number> &entry : line.entries)
+          for (const std::pair<size_type, number> &entry : entries)
             out << "    " << line.index << ' ' << entry.first << ":  "
                 << entry.second << '\n';
 
@@ -1602,10 +1647,11 @@ AffineConstraints<number>::write_dot(std::ostream &out) const
   for (size_type i = 0; i != lines.size(); ++i)
     {
       // same concept as in the previous function
-      if (lines[i].entries.size() > 0)
-        for (size_type j = 0; j < lines[i].entries.size(); ++j)
-          out << "  " << lines[i].index << "->" << lines[i].entries[j].first
-              << "; // weight: " << lines[i].entries[j].second << '\n';
+      const auto entries = get_entries(lines[i]);
+      if (entries.size() > 0)
+        for (size_type j = 0; j < entries.size(); ++j)
+          out << "  " << lines[i].index << "->" << entries[j].first
+              << "; // weight: " << entries[j].second << '\n';
       else
         out << "  " << lines[i].index << '\n';
     }
@@ -1620,6 +1666,8 @@ AffineConstraints<number>::memory_consumption() const
 {
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
+          MemoryConsumption::memory_consumption(compact_line_starts) +
+          MemoryConsumption::memory_consumption(compact_entries) +
           MemoryConsumption::memory_consumption(sorted) +
           MemoryConsumption::memory_consumption(local_lines));
 }
@@ -1632,19 +1680,13 @@ AffineConstraints<number>::resolve_indices(
   std::vector<types::global_dof_index> &indices) const
 {
   const unsigned int indices_size = indices.size();
-  const std::vector<std::pair<types::global_dof_index, number>> *line_ptr;
   for (unsigned int i = 0; i < indices_size; ++i)
-    {
-      line_ptr = get_constraint_entries(indices[i]);
-      // if the index is constraint, the constraints indices are added to the
-      // indices vector
-      if (line_ptr != nullptr)
-        {
-          const unsigned int line_size = line_ptr->size();
-          for (unsigned int j = 0; j < line_size; ++j)
-            indices.push_back((*line_ptr)[j].first);
-        }
-    }
+    // if the index is constraint, the constraints indices are added to the
+    // indices vector
+    if (is_constrained(indices[i]))
+      for (const auto &entry :
+           get_entries(lines[lines_cache[calculate_line_index(indices[i])]]))
+        indices.push_back(entry.first);
 
   // keep only the unique elements
   std::sort(indices.begin(), indices.end());
@@ -1697,11 +1739,9 @@ AffineConstraints<number>::condense(SparsityPattern &sparsity) const
                 {
                   // distribute entry at regular row @p{row} and irregular
                   // column sparsity.colnums[j]
-                  for (size_type q = 0;
-                       q != lines[distribute[column]].entries.size();
-                       ++q)
-                    sparsity.add(row,
-                                 lines[distribute[column]].entries[q].first);
+                  for (const std::pair<size_type, number> &column_entry :
+                       get_entries(lines[distribute[column]]))
+                    sparsity.add(row, column_entry.first);
                 }
             }
         }
@@ -1717,21 +1757,17 @@ AffineConstraints<number>::condense(SparsityPattern &sparsity) const
               if (distribute[column] == numbers::invalid_size_type)
                 // distribute entry at irregular row @p{row} and regular
                 // column sparsity.colnums[j]
-                for (size_type q = 0;
-                     q != lines[distribute[row]].entries.size();
-                     ++q)
-                  sparsity.add(lines[distribute[row]].entries[q].first, column);
+                for (const std::pair<size_type, number> &row_entry :
+                     get_entries(lines[distribute[row]]))
+                  sparsity.add(row_entry.first, column);
               else
                 // distribute entry at irregular row @p{row} and irregular
                 // column sparsity.get_column_numbers()[j]
-                for (size_type p = 0;
-                     p != lines[distribute[row]].entries.size();
-                     ++p)
-                  for (size_type q = 0;
-                       q != lines[distribute[column]].entries.size();
-                       ++q)
-                    sparsity.add(lines[distribute[row]].entries[p].first,
-                                 lines[distribute[column]].entries[q].first);
+                for (const std::pair<size_type, number> &row_entry :
+                     get_entries(lines[distribute[row]]))
+                  for (const std::pair<size_type, number> &column_entry :
+                       get_entries(lines[distribute[column]]))
+                    sparsity.add(row_entry.first, column_entry.first);
             }
         }
     }
@@ -1798,11 +1834,9 @@ AffineConstraints<number>::condense(BlockSparsityPattern &sparsity) const
                     // distribute entry at regular row @p{row} and
                     // irregular column global_col
                     {
-                      for (size_type q = 0;
-                           q != lines[distribute[global_col]].entries.size();
-                           ++q)
-                        sparsity.add(
-                          row, lines[distribute[global_col]].entries[q].first);
+                      for (const std::pair<size_type, number> &column_entry :
+                           get_entries(lines[distribute[global_col]]))
+                        sparsity.add(row, column_entry.first);
                     }
                 }
             }
@@ -1829,25 +1863,19 @@ AffineConstraints<number>::condense(BlockSparsityPattern &sparsity) const
                     // distribute entry at irregular row @p{row} and
                     // regular column global_col.
                     {
-                      for (size_type q = 0;
-                           q != lines[distribute[row]].entries.size();
-                           ++q)
-                        sparsity.add(lines[distribute[row]].entries[q].first,
-                                     global_col);
+                      for (const std::pair<size_type, number> &row_entry :
+                           get_entries(lines[distribute[row]]))
+                        sparsity.add(row_entry.first, global_col);
                     }
                   else
                     // distribute entry at irregular row @p{row} and
                     // irregular column @p{global_col}
                     {
-                      for (size_type p = 0;
-                           p != lines[distribute[row]].entries.size();
-                           ++p)
-                        for (size_type q = 0;
-                             q != lines[distribute[global_col]].entries.size();
-                             ++q)
-                          sparsity.add(
-                            lines[distribute[row]].entries[p].first,
-                            lines[distribute[global_col]].entries[q].first);
+                      for (const std::pair<size_type, number> &row_entry :
+                           get_entries(lines[distribute[row]]))
+                        for (const std::pair<size_type, number> &column_entry :
+                             get_entries(lines[distribute[global_col]]))
+                          sparsity.add(row_entry.first, column_entry.first);
                     }
                 }
             }
@@ -1905,12 +1933,10 @@ AffineConstraints<number>::condense(DynamicSparsityPattern &sparsity) const
                 // front that did not exist before. check whether it
                 // existed before by tracking the length of this row
                 size_type old_rowlength = sparsity.row_length(row);
-                for (size_type q = 0;
-                     q != lines[distribute[column]].entries.size();
-                     ++q)
+                for (const std::pair<size_type, number> &column_entry :
+                     get_entries(lines[distribute[column]]))
                   {
-                    const size_type new_col =
-                      lines[distribute[column]].entries[q].first;
+                    const size_type new_col = column_entry.first;
 
                     sparsity.add(row, new_col);
 
@@ -1930,22 +1956,17 @@ AffineConstraints<number>::condense(DynamicSparsityPattern &sparsity) const
             if (distribute[column] == numbers::invalid_size_type)
               // distribute entry at irregular row @p{row} and regular
               // column sparsity.colnums[j]
-              for (size_type q = 0; q != lines[distribute[row]].entries.size();
-                   ++q)
-                sparsity.add(lines[distribute[row]].entries[q].first, column);
+              for (const std::pair<size_type, number> &row_entry :
+                   get_entries(lines[distribute[row]]))
+                sparsity.add(row_entry.first, column);
             else
               // distribute entry at irregular row @p{row} and irregular
               // column sparsity.get_column_numbers()[j]
-              for (size_type p = 0; p != lines[distribute[row]].entries.size();
-                   ++p)
-                for (size_type q = 0;
-                     q != lines[distribute[sparsity.column_number(row, j)]]
-                            .entries.size();
-                     ++q)
-                  sparsity.add(lines[distribute[row]].entries[p].first,
-                               lines[distribute[sparsity.column_number(row, j)]]
-                                 .entries[q]
-                                 .first);
+              for (const std::pair<size_type, number> &row_entry :
+                   get_entries(lines[distribute[row]]))
+                for (const std::pair<size_type, number> &column_entry :
+                     get_entries(lines[distribute[column]]))
+                  sparsity.add(row_entry.first, column_entry.first);
           }
     }
 }
@@ -2012,11 +2033,9 @@ AffineConstraints<number>::condense(BlockDynamicSparsityPattern &sparsity) const
                     // distribute entry at regular row @p{row} and
                     // irregular column global_col
                     {
-                      for (size_type q = 0;
-                           q != lines[distribute[global_col]].entries.size();
-                           ++q)
-                        sparsity.add(
-                          row, lines[distribute[global_col]].entries[q].first);
+                      for (const std::pair<size_type, number> &column_entry :
+                           get_entries(lines[distribute[global_col]]))
+                        sparsity.add(row, column_entry.first);
                     }
                 }
             }
@@ -2040,25 +2059,19 @@ AffineConstraints<number>::condense(BlockDynamicSparsityPattern &sparsity) const
                     // distribute entry at irregular row @p{row} and
                     // regular column global_col.
                     {
-                      for (size_type q = 0;
-                           q != lines[distribute[row]].entries.size();
-                           ++q)
-                        sparsity.add(lines[distribute[row]].entries[q].first,
-                                     global_col);
+                      for (const std::pair<size_type, number> &row_entry :
+                           get_entries(lines[distribute[row]]))
+                        sparsity.add(row_entry.first, global_col);
                     }
                   else
                     // distribute entry at irregular row @p{row} and
                     // irregular column @p{global_col}
                     {
-                      for (size_type p = 0;
-                           p != lines[distribute[row]].entries.size();
-                           ++p)
-                        for (size_type q = 0;
-                             q != lines[distribute[global_col]].entries.size();
-                             ++q)
-                          sparsity.add(
-                            lines[distribute[row]].entries[p].first,
-                            lines[distribute[global_col]].entries[q].first);
+                      for (const std::pair<size_type, number> &row_entry :
+                           get_entries(lines[distribute[row]]))
+                        for (const std::pair<size_type, number> &column_entry :
+                             get_entries(lines[distribute[global_col]]))
+                          sparsity.add(row_entry.first, column_entry.first);
                     }
                 }
             }
@@ -2116,7 +2129,7 @@ AffineConstraints<number>::condense(const VectorType &vec_ghosted,
                         "without any matrix specified."));
 
       const typename VectorType::value_type old_value = vec_ghosted(line.index);
-      for (const std::pair<size_type, number> &entry : line.entries)
+      for (const std::pair<size_type, number> &entry : get_entries(line))
         if (vec.in_local_range(entry.first) == true)
           vec(entry.first) +=
             (static_cast<typename VectorType::value_type>(old_value) *
@@ -2199,18 +2212,16 @@ AffineConstraints<number>::condense(SparseMatrix<number> &uncondensed,
                 // column sparsity.get_column_numbers()[j]; set old entry
                 // to zero
                 {
-                  for (size_type q = 0;
-                       q != lines[distribute[column]].entries.size();
-                       ++q)
+                  for (const std::pair<size_type, number> &column_entry :
+                       get_entries(lines[distribute[column]]))
                     {
                       // need a temporary variable to avoid errors like no
                       // known conversion from 'complex<typename
                       // ProductType<float, double>::type>' to 'const
                       // complex<float>' for 3rd argument
                       number v = static_cast<number>(entry->value());
-                      v *= lines[distribute[column]].entries[q].second;
-                      uncondensed.add(
-                        row, lines[distribute[column]].entries[q].first, v);
+                      v *= column_entry.second;
+                      uncondensed.add(row, column_entry.first, v);
                     }
 
                   // need to subtract this element from the vector. this
@@ -2245,19 +2256,16 @@ AffineConstraints<number>::condense(SparseMatrix<number> &uncondensed,
                 // distribute entry at irregular row @p row and regular
                 // column column. set old entry to zero
                 {
-                  for (size_type q = 0;
-                       q != lines[distribute[row]].entries.size();
-                       ++q)
+                  for (const std::pair<size_type, number> &row_entry :
+                       get_entries(lines[distribute[row]]))
                     {
                       // need a temporary variable to avoid errors like
                       // no known conversion from 'complex<typename
                       // ProductType<float, double>::type>' to 'const
                       // complex<float>' for 3rd argument
                       number v = static_cast<number>(entry->value());
-                      v *= lines[distribute[row]].entries[q].second;
-                      uncondensed.add(lines[distribute[row]].entries[q].first,
-                                      column,
-                                      v);
+                      v *= row_entry.second;
+                      uncondensed.add(row_entry.first, column, v);
                     }
 
                   // set old entry to zero
@@ -2268,31 +2276,27 @@ AffineConstraints<number>::condense(SparseMatrix<number> &uncondensed,
                 // column @p column set old entry to one on main diagonal,
                 // zero otherwise
                 {
-                  for (size_type p = 0;
-                       p != lines[distribute[row]].entries.size();
-                       ++p)
+                  for (const std::pair<size_type, number> &row_entry :
+                       get_entries(lines[distribute[row]]))
                     {
-                      for (size_type q = 0;
-                           q != lines[distribute[column]].entries.size();
-                           ++q)
+                      for (const std::pair<size_type, number> &column_entry :
+                           get_entries(lines[distribute[column]]))
                         {
                           // need a temporary variable to avoid errors like
                           // no known conversion from 'complex<typename
                           // ProductType<float, double>::type>' to 'const
                           // complex<float>' for 3rd argument
                           number v = static_cast<number>(entry->value());
-                          v *= lines[distribute[row]].entries[p].second *
-                               lines[distribute[column]].entries[q].second;
-                          uncondensed.add(
-                            lines[distribute[row]].entries[p].first,
-                            lines[distribute[column]].entries[q].first,
-                            v);
+                          v *= row_entry.second * column_entry.second;
+                          uncondensed.add(row_entry.first,
+                                          column_entry.first,
+                                          v);
                         }
 
                       if (use_vectors == true)
-                        vec(lines[distribute[row]].entries[p].first) -=
+                        vec(row_entry.first) -=
                           static_cast<number>(entry->value()) *
-                          lines[distribute[row]].entries[p].second *
+                          row_entry.second *
                           lines[distribute[column]].inhomogeneity;
                     }
 
@@ -2304,10 +2308,9 @@ AffineConstraints<number>::condense(SparseMatrix<number> &uncondensed,
           // take care of vector
           if (use_vectors == true)
             {
-              for (size_type q = 0; q != lines[distribute[row]].entries.size();
-                   ++q)
-                vec(lines[distribute[row]].entries[q].first) +=
-                  (vec(row) * lines[distribute[row]].entries[q].second);
+              for (const std::pair<size_type, number> &row_entry :
+                   get_entries(lines[distribute[row]]))
+                vec(row_entry.first) += (vec(row) * row_entry.second);
 
               vec(lines[distribute[row]].index) = 0.;
             }
@@ -2395,14 +2398,11 @@ AffineConstraints<number>::condense(BlockSparseMatrix<number> &uncondensed,
                     {
                       const number old_value = entry->value();
 
-                      for (size_type q = 0;
-                           q != lines[distribute[global_col]].entries.size();
-                           ++q)
-                        uncondensed.add(
-                          row,
-                          lines[distribute[global_col]].entries[q].first,
-                          old_value *
-                            lines[distribute[global_col]].entries[q].second);
+                      for (const std::pair<size_type, number> &column_entry :
+                           get_entries(lines[distribute[global_col]]))
+                        uncondensed.add(row,
+                                        column_entry.first,
+                                        old_value * column_entry.second);
 
                       // need to subtract this element from the vector.
                       // this corresponds to an explicit elimination in the
@@ -2439,13 +2439,11 @@ AffineConstraints<number>::condense(BlockSparseMatrix<number> &uncondensed,
                     {
                       const number old_value = entry->value();
 
-                      for (size_type q = 0;
-                           q != lines[distribute[row]].entries.size();
-                           ++q)
-                        uncondensed.add(
-                          lines[distribute[row]].entries[q].first,
-                          global_col,
-                          old_value * lines[distribute[row]].entries[q].second);
+                      for (const std::pair<size_type, number> &row_entry :
+                           get_entries(lines[distribute[row]]))
+                        uncondensed.add(row_entry.first,
+                                        global_col,
+                                        old_value * row_entry.second);
 
                       entry->value() = 0.;
                     }
@@ -2456,27 +2454,20 @@ AffineConstraints<number>::condense(BlockSparseMatrix<number> &uncondensed,
                     {
                       const number old_value = entry->value();
 
-                      for (size_type p = 0;
-                           p != lines[distribute[row]].entries.size();
-                           ++p)
+                      for (const std::pair<size_type, number> &row_entry :
+                           get_entries(lines[distribute[row]]))
                         {
-                          for (size_type q = 0;
-                               q !=
-                               lines[distribute[global_col]].entries.size();
-                               ++q)
-                            uncondensed.add(
-                              lines[distribute[row]].entries[p].first,
-                              lines[distribute[global_col]].entries[q].first,
-                              old_value *
-                                lines[distribute[row]].entries[p].second *
-                                lines[distribute[global_col]]
-                                  .entries[q]
-                                  .second);
+                          for (const std::pair<size_type, number>
+                                 &column_entry :
+                               get_entries(lines[distribute[global_col]]))
+                            uncondensed.add(row_entry.first,
+                                            column_entry.first,
+                                            old_value * row_entry.second *
+                                              column_entry.second);
 
                           if (use_vectors == true)
-                            vec(lines[distribute[row]].entries[p].first) -=
-                              old_value *
-                              lines[distribute[row]].entries[p].second *
+                            vec(row_entry.first) -=
+                              old_value * row_entry.second *
                               lines[distribute[global_col]].inhomogeneity;
                         }
 
@@ -2489,10 +2480,9 @@ AffineConstraints<number>::condense(BlockSparseMatrix<number> &uncondensed,
           // take care of vector
           if (use_vectors == true)
             {
-              for (size_type q = 0; q != lines[distribute[row]].entries.size();
-                   ++q)
-                vec(lines[distribute[row]].entries[q].first) +=
-                  (vec(row) * lines[distribute[row]].entries[q].second);
+              for (const std::pair<size_type, number> &row_entry :
+                   get_entries(lines[distribute[row]]))
+                vec(row_entry.first) += (vec(row) * row_entry.second);
 
               vec(lines[distribute[row]].index) = 0.;
             }
@@ -2756,15 +2746,15 @@ AffineConstraints<number>::distribute_local_to_global(
                 lines[lines_cache[calculate_line_index(
                   local_dof_indices_row[j])]];
 
-              for (size_type q = 0; q < position_j.entries.size(); ++q)
+              for (const std::pair<size_type, number> &entry :
+                   get_entries(position_j))
                 {
                   Assert(!(!local_lines.size() ||
-                           local_lines.is_element(
-                             position_j.entries[q].first)) ||
-                           is_constrained(position_j.entries[q].first) == false,
+                           local_lines.is_element(entry.first)) ||
+                           is_constrained(entry.first) == false,
                          ExcMessage("Tried to distribute to a fixed dof."));
-                  global_vector(position_j.entries[q].first) -=
-                    val * position_j.entries[q].second * matrix_entry;
+                  global_vector(entry.first) -=
+                    val * entry.second * matrix_entry;
                 }
             }
 
@@ -2773,14 +2763,14 @@ AffineConstraints<number>::distribute_local_to_global(
         // the entries of fixed dofs
         if (diagonal)
           {
-            for (size_type j = 0; j < position.entries.size(); ++j)
+            for (const std::pair<size_type, number> &entry :
+                 get_entries(position))
               {
                 Assert(!(!local_lines.size() ||
-                         local_lines.is_element(position.entries[j].first)) ||
-                         is_constrained(position.entries[j].first) == false,
+                         local_lines.is_element(entry.first)) ||
+                         is_constrained(entry.first) == false,
                        ExcMessage("Tried to distribute to a fixed dof."));
-                global_vector(position.entries[j].first) +=
-                  local_vector(i) * position.entries[j].second;
+                global_vector(entry.first) += local_vector(i) * entry.second;
               }
           }
       }
@@ -3093,21 +3083,41 @@ AffineConstraints<number>::distribute(VectorType &vec) const
                 std::bool_constant<IsBlockVector<VectorType>::value>());
             }
 
-          for (const ConstraintLine &line : lines)
-            if (vec_owned_elements.is_element(line.index))
-              {
-                typename VectorType::value_type new_value = line.inhomogeneity;
-                for (const std::pair<size_type, number> &entry : line.entries)
-                  new_value +=
-                    (static_cast<typename VectorType::value_type>(
-                       internal::ElementAccess<VectorType>::get(ghosted_vector,
-                                                                entry.first)) *
-                     entry.second);
-                AssertIsFinite(new_value);
-                internal::ElementAccess<VectorType>::set(new_value,
-                                                         line.index,
-                                                         vec);
-              }
+          // the lines are sorted by the index of the constrained DoF, so
+          // rather than asking the index set about every single line, walk
+          // through the contiguous ranges of locally owned elements and the
+          // lines in the same order
+          auto line = lines.begin();
+          for (auto interval = vec_owned_elements.begin_intervals();
+               interval != vec_owned_elements.end_intervals() &&
+               line != lines.end();
+               ++interval)
+            {
+              const size_type first_index = *interval->begin();
+              const size_type last_index  = interval->last();
+              line                        = std::lower_bound(
+                line,
+                lines.end(),
+                first_index,
+                [](const ConstraintLine &l, const size_type index) {
+                  return l.index < index;
+                });
+              for (; line != lines.end() && line->index <= last_index; ++line)
+                {
+                  typename VectorType::value_type new_value =
+                    line->inhomogeneity;
+                  for (const std::pair<size_type, number> &entry :
+                       get_entries(*line))
+                    new_value += (static_cast<typename VectorType::value_type>(
+                                    internal::ElementAccess<VectorType>::get(
+                                      ghosted_vector, entry.first)) *
+                                  entry.second);
+                  AssertIsFinite(new_value);
+                  internal::ElementAccess<VectorType>::set(new_value,
+                                                           line->index,
+                                                           vec);
+                }
+            }
 
           // now compress to communicate the entries that we added to
           // and that weren't to local processors to the owner
@@ -3130,7 +3140,7 @@ AffineConstraints<number>::distribute(VectorType &vec) const
           typename VectorType::value_type new_value =
             next_constraint.inhomogeneity;
           for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
+               get_entries(next_constraint))
             new_value +=
               (static_cast<typename VectorType::value_type>(
                  internal::ElementAccess<VectorType>::get(vec, entry.first)) *
@@ -4261,10 +4271,8 @@ AffineConstraints<number>::make_sorted_row_list(
         lines[lines_cache[calculate_line_index(global_row)]];
       if (position.inhomogeneity != number(0.))
         global_rows.set_ith_constraint_inhomogeneous(i);
-      for (size_type q = 0; q < position.entries.size(); ++q)
-        global_rows.insert_index(position.entries[q].first,
-                                 local_row,
-                                 position.entries[q].second);
+      for (const std::pair<size_type, number> &entry : get_entries(position))
+        global_rows.insert_index(entry.first, local_row, entry.second);
     }
 }
 
@@ -4303,9 +4311,9 @@ AffineConstraints<number>::make_sorted_row_list(
       const size_type       global_row = local_dof_indices[local_row];
       const ConstraintLine &position =
         lines[lines_cache[calculate_line_index(global_row)]];
-      for (size_type q = 0; q < position.entries.size(); ++q)
+      for (const std::pair<size_type, number> &entry : get_entries(position))
         {
-          const size_type new_index = position.entries[q].first;
+          const size_type new_index = entry.first;
           // in case all dofs are constrained, we might insert at
           // active_dofs.begin(), but we should never insert before that
           AssertIndexRange(i - 1, active_dofs.size() + 1);
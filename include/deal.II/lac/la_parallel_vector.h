@@ -694,6 +694,22 @@ namespace LinearAlgebra
       void
       copy_locally_owned_data_from(const Vector<Number2, MemorySpace> &src);
 
+      /**
+       * Add a multiple of the locally owned range of another distributed
+       * vector @p src to the calling vector, i.e., `*this += a * src` on the
+       * locally owned entries. As opposed to add(), the vector @p src may use
+       * a different number type. The conversion is done while reading @p src,
+       * which for float and double vectors runs on SIMD registers and avoids
+       * creating a temporary copy of @p src with the number type of the
+       * calling vector. The same prerequisites as in
+       * copy_locally_owned_data_from() apply: the ghost range is ignored
+       * and no data exchange is performed.
+       */
+      template <typename Number2>
+      void
+      add_locally_owned_data_from(const Number                       a,
+                                  const Vector<Number2, MemorySpace> &src);
+
       /**
        * Import all the elements present in the distributed vector @p src.
        * VectorOperation::values @p operation is used to decide if the elements
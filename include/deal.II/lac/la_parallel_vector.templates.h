@@ -916,6 +916,30 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    template <typename Number2>
+    void
+    Vector<Number, MemorySpaceType>::add_locally_owned_data_from(
+      const Number                           a,
+      const Vector<Number2, MemorySpaceType> &src)
+    {
+      AssertIsFinite(a);
+      AssertDimension(partitioner->locally_owned_size(),
+                      src.partitioner->locally_owned_size());
+      if (partitioner->locally_owned_size() > 0)
+        {
+          dealii::internal::VectorOperations::
+            functions<Number, Number2, MemorySpaceType>::add_av_converted(
+              thread_loop_partitioner,
+              partitioner->locally_owned_size(),
+              a,
+              src.data,
+              data);
+        }
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     template <typename MemorySpaceType2>
     void
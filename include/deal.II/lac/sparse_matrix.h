@@ -42,6 +42,8 @@ template <typename Matrix>
 class BlockMatrixBase;
 template <typename number>
 class SparseILU;
+template <typename number>
+class SparseMatrixScatter;
 #  ifdef DEAL_II_WITH_MPI
 namespace Utilities
 {
@@ -1771,6 +1773,10 @@ private:
   template <typename>
   friend class SparseILU;
 
+  // To allow adding cell matrices directly to the array of values.
+  template <typename>
+  friend class SparseMatrixScatter;
+
   // To allow it calling private prepare_add() and prepare_set().
   template <typename>
   friend class BlockMatrixBase;
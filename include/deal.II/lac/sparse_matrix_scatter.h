@@ -0,0 +1,262 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_scatter_h
+#define dealii_sparse_matrix_scatter_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/types.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class AffineConstraints;
+template <typename number>
+class FullMatrix;
+template <typename number>
+class SparseMatrix;
+class SparsityPattern;
+#endif
+
+/**
+ * @addtogroup Matrices
+ * @{
+ */
+
+/**
+ * A class that adds cell matrices into a SparseMatrix while resolving the
+ * constraints of an AffineConstraints object, with the same result as
+ * AffineConstraints::distribute_local_to_global() (up to round-off from a
+ * different order of summation).
+ *
+ * AffineConstraints::distribute_local_to_global() determines anew for every
+ * cell which rows and columns the entries of the cell matrix end up in after
+ * resolving the constraints, and then searches for every resulting entry in
+ * the respective row of the sparsity pattern. If the same matrix is assembled
+ * many times on the same mesh, as in time stepping or nonlinear iterations,
+ * all of this work is repeated every time. This class does it only once per
+ * cell, in add_cell(), and stores a plan that contains the position in the
+ * array of matrix values of every entry of the cell matrix together with the
+ * weights that come from the constraints. Adding a cell matrix then only
+ * consists of a loop over this plan; for cells without constrained degrees
+ * of freedom, it is a plain gather-scatter operation.
+ *
+ * The plans are computed by the add_cell() function, which may be called
+ * concurrently for different cells, for example from the worker function of
+ * WorkStream::run(). The distribute_local_to_global() function that takes a
+ * batch of cell matrices splits the matrix into ranges of rows and lets each
+ * thread add the contributions of all cells of the batch to its range, so
+ * that no synchronization between the threads is necessary and the result
+ * does not depend on the number of threads. A typical use looks like this:
+ * @code
+ *   SparseMatrixScatter<double> scatter;
+ *   scatter.reinit(constraints, sparsity_pattern,
+ *                  triangulation.n_active_cells());
+ *   for (const auto &cell : dof_handler.active_cell_iterators())
+ *     {
+ *       cell->get_dof_indices(local_dof_indices);
+ *       scatter.add_cell(cell->active_cell_index(), local_dof_indices);
+ *     }
+ *
+ *   // in every assembly: compute a batch of cell matrices and then
+ *   scatter.distribute_local_to_global(cell_indices, cell_matrices,
+ *                                      system_matrix);
+ * @endcode
+ *
+ * For the right hand side vector, AffineConstraints::
+ * distribute_local_to_global() is still the function to use.
+ *
+ * The plan stores one index into the array of matrix values per entry of the
+ * cell matrices, so this class needs a few times the memory of the sparse
+ * matrix itself.
+ *
+ * @note The sparsity pattern must be square, and the constraints must be
+ * closed, as is required by AffineConstraints::distribute_local_to_global()
+ * as well. The diagonal entries of constrained rows are treated as in that
+ * function, i.e., every cell adds the absolute value of its diagonal entry,
+ * or the average of its diagonal entries if that entry is zero.
+ */
+template <typename number>
+class SparseMatrixScatter : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Constructor. The object needs to be initialized with reinit() before it
+   * can be used.
+   */
+  SparseMatrixScatter() = default;
+
+  /**
+   * Delete all plans and set up the object for the given constraints and
+   * sparsity pattern and @p n_cells cells. Both objects are stored by
+   * reference and need to remain unchanged as long as this object is used.
+   */
+  void
+  reinit(const AffineConstraints<number> &constraints,
+         const SparsityPattern           &sparsity_pattern,
+         const unsigned int               n_cells);
+
+  /**
+   * Compute the plan for the cell with number @p cell_index that has the
+   * global degrees of freedom @p local_dof_indices.
+   *
+   * This function may be called concurrently for different values of
+   * @p cell_index.
+   */
+  void
+  add_cell(const unsigned int                 cell_index,
+           const ArrayView<const size_type> &local_dof_indices);
+
+  /**
+   * Add the cell matrix @p cell_matrix of the cell with number @p cell_index
+   * to @p global_matrix, which must be based on the sparsity pattern given to
+   * reinit().
+   */
+  void
+  distribute_local_to_global(const unsigned int        cell_index,
+                             const FullMatrix<number> &cell_matrix,
+                             SparseMatrix<number>     &global_matrix) const;
+
+  /**
+   * Add the cell matrices @p cell_matrices of the cells with numbers
+   * @p cell_indices to @p global_matrix, which must be based on the sparsity
+   * pattern given to reinit(). For batches that are large enough, this
+   * function works in parallel on different ranges of rows of the matrix.
+   */
+  void
+  distribute_local_to_global(
+    const ArrayView<const unsigned int>       &cell_indices,
+    const ArrayView<const FullMatrix<number>> &cell_matrices,
+    SparseMatrix<number>                      &global_matrix) const;
+
+  /**
+   * Return whether a plan has been computed for the cell with number
+   * @p cell_index.
+   */
+  bool
+  has_cell(const unsigned int cell_index) const;
+
+  /**
+   * Return an estimate for the memory consumption of this object, in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * An entry of a cell matrix whose row or column belongs to a constrained
+   * degree of freedom: the entry with index @p local_index in the row-wise
+   * ordering of the cell matrix is added to the matrix value at @p position,
+   * multiplied by @p weight.
+   */
+  struct IndirectEntry
+  {
+    std::size_t  position;
+    number       weight;
+    unsigned int local_index;
+  };
+
+  /**
+   * The plan of one cell.
+   */
+  struct CellPlan
+  {
+    /**
+     * The number of degrees of freedom of the cell, or
+     * numbers::invalid_unsigned_int if no plan has been computed.
+     */
+    unsigned int n_dofs = numbers::invalid_unsigned_int;
+
+    /**
+     * The local indices of the unconstrained degrees of freedom.
+     */
+    std::vector<unsigned int> unconstrained_dofs;
+
+    /**
+     * The positions in the array of matrix values of the couplings between
+     * the unconstrained degrees of freedom, with the entries of the
+     * unconstrained_dofs[i]th row of the cell matrix starting at index
+     * i*unconstrained_dofs.size(). Entries that are not part of the sparsity
+     * pattern are set to numbers::invalid_size_type.
+     */
+    std::vector<std::size_t> direct_positions;
+
+    /**
+     * Whether all entries of @p direct_positions are valid.
+     */
+    bool all_direct_positions_valid = true;
+
+    /**
+     * The contributions of entries in rows or columns of constrained degrees
+     * of freedom.
+     */
+    std::vector<IndirectEntry> indirect_entries;
+
+    /**
+     * The local indices of the constrained degrees of freedom together with
+     * the position of their diagonal entry in the array of matrix values.
+     */
+    std::vector<std::pair<unsigned int, std::size_t>> constrained_diagonals;
+  };
+
+  /**
+   * Add the parts of the given cell matrix that go into the range
+   * [@p begin, @p end) of the array of matrix values @p values.
+   */
+  void
+  add_cell_matrix(const CellPlan           &plan,
+                  const FullMatrix<number> &cell_matrix,
+                  const std::size_t         begin,
+                  const std::size_t         end,
+                  number                   *values) const;
+
+  /**
+   * Pointer to the constraints given to reinit().
+   */
+  SmartPointer<const AffineConstraints<number>, SparseMatrixScatter<number>>
+    constraints;
+
+  /**
+   * Pointer to the sparsity pattern given to reinit().
+   */
+  SmartPointer<const SparsityPattern, SparseMatrixScatter<number>>
+    sparsity_pattern;
+
+  /**
+   * The plans of all cells.
+   */
+  std::vector<CellPlan> cell_plans;
+};
+
+/**
+ * @}
+ */
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
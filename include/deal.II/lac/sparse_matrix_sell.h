@@ -0,0 +1,612 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * @addtogroup Matrix1
+ * @{
+ */
+
+/**
+ * A read-only copy of a SparseMatrix in the sliced ELLPACK format
+ * SELL-C-$\sigma$, which allows the matrix-vector product to run with SIMD
+ * instructions through VectorizedArray.
+ *
+ * The rows of the matrix are grouped into chunks of $C$ consecutive rows,
+ * where $C$ is the number of lanes of VectorizedArray<number>. Within each
+ * chunk, all rows are padded with zeros to the length of the longest row,
+ * and the entries are stored such that the $j$-th entries of the $C$ rows
+ * are adjacent in memory. The matrix-vector product then loads $C$ matrix
+ * entries at once, gathers the corresponding $C$ entries of the source
+ * vector, and accumulates the $C$ row sums in the lanes of a
+ * VectorizedArray. To keep the overhead of the padding small, the rows are
+ * sorted by decreasing length within windows of $\sigma$ consecutive rows
+ * (the @p sorting_scope) before they are grouped into chunks. For matrices
+ * from finite element discretizations, where most rows have similar lengths,
+ * the padding is typically a few percent of the nonzero entries.
+ *
+ * This class is meant as a drop-in replacement for the matrix in iterative
+ * solvers once the SparseMatrix has been assembled: It provides the
+ * functions vmult(), Tvmult(), vmult_add(), Tvmult_add(), and
+ * precondition_Jacobi() with the same meaning as in SparseMatrix, and can
+ * thus be used with SolverCG and PreconditionJacobi. The matrix-vector
+ * product supports Vector and (serial) LinearAlgebra::distributed::Vector
+ * objects. Since the entries are copied, a change of the original matrix is
+ * only visible after calling reinit() again.
+ *
+ * @tparam number The type of the matrix entries.
+ */
+template <typename number>
+class SparseMatrixSELL : public virtual Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * The number of rows in one chunk, which equals the number of lanes of
+   * VectorizedArray<number>.
+   */
+  static constexpr unsigned int chunk_size = VectorizedArray<number>::size();
+
+  /**
+   * Default constructor, giving an empty matrix.
+   */
+  SparseMatrixSELL();
+
+  /**
+   * Constructor that copies the given @p matrix, see reinit().
+   */
+  template <typename number2>
+  explicit SparseMatrixSELL(const SparseMatrix<number2> &matrix,
+                            const unsigned int sorting_scope = 32 * chunk_size);
+
+  /**
+   * Copy the entries of @p matrix into the sliced ELLPACK format. The rows
+   * are sorted by their length within windows of @p sorting_scope rows,
+   * which is rounded up to a multiple of the chunk size. A value of
+   * @p chunk_size keeps the original order of rows, whereas a value equal to
+   * the number of rows sorts all rows globally.
+   */
+  template <typename number2>
+  void
+  reinit(const SparseMatrix<number2> &matrix,
+         const unsigned int           sorting_scope = 32 * chunk_size);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the object is empty.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero elements of the original matrix.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of stored elements including the zeros padded to the
+   * rows within a chunk.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  vmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix. This function does the same as vmult() but takes the transposed
+   * matrix.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  Tvmult(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding Matrix-vector multiplication. Add $M*src$ on $dst$ with $M$ being
+   * this matrix.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  vmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Adding Matrix-vector multiplication. Add $M^T*src$ to $dst$ with $M$
+   * being this matrix. This function does the same as vmult_add() but takes
+   * the transposed matrix.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  Tvmult_add(OutVector &dst, const InVector &src) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * <tt>src</tt> vector by the inverse of the respective diagonal element
+   * and multiplies the result with the relaxation factor <tt>omega</tt>.
+   */
+  template <typename somenumber>
+  void
+  precondition_Jacobi(Vector<somenumber>       &dst,
+                      const Vector<somenumber> &src,
+                      const number              omega = 1.) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two vectors that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+
+private:
+  /**
+   * Compute the product of the rows in the chunks from @p begin to @p end
+   * with @p src and write (or add if @p add is set) the result into @p dst.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  vmult_on_subrange(const unsigned int begin,
+                    const unsigned int end,
+                    OutVector         &dst,
+                    const InVector    &src,
+                    const bool         add) const;
+
+  /**
+   * Number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * Number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * Number of nonzero entries of the original matrix.
+   */
+  std::size_t n_nonzero;
+
+  /**
+   * The start of each chunk within @p values and @p column_indices, with
+   * the length of the longest row in the chunk given by the difference to
+   * the next entry divided by the chunk size.
+   */
+  std::vector<std::size_t> chunk_start;
+
+  /**
+   * The row of the original matrix stored in each lane of each chunk, or
+   * numbers::invalid_unsigned_int for the lanes of the last chunk beyond the
+   * number of rows.
+   */
+  std::vector<unsigned int> row_indices;
+
+  /**
+   * The matrix entries, with the $j$-th entries of the rows of a chunk
+   * stored next to each other.
+   */
+  AlignedVector<number> values;
+
+  /**
+   * The column indices of the entries in @p values. Padded entries point to
+   * a valid column of the same row such that they can be gathered.
+   */
+  AlignedVector<unsigned int> column_indices;
+
+  /**
+   * The diagonal of the matrix, used by precondition_Jacobi().
+   */
+  std::vector<number> diagonal;
+};
+
+/** @} */
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline SparseMatrixSELL<number>::SparseMatrixSELL()
+  : n_rows(0)
+  , n_cols(0)
+  , n_nonzero(0)
+{}
+
+
+
+template <typename number>
+template <typename number2>
+inline SparseMatrixSELL<number>::SparseMatrixSELL(
+  const SparseMatrix<number2> &matrix,
+  const unsigned int           sorting_scope)
+  : SparseMatrixSELL()
+{
+  reinit(matrix, sorting_scope);
+}
+
+
+
+template <typename number>
+template <typename number2>
+inline void
+SparseMatrixSELL<number>::reinit(const SparseMatrix<number2> &matrix,
+                                 const unsigned int           sorting_scope)
+{
+  AssertThrow(matrix.m() < std::numeric_limits<unsigned int>::max() &&
+                matrix.n() < std::numeric_limits<unsigned int>::max(),
+              ExcMessage("SparseMatrixSELL stores 32-bit row and column "
+                         "indices, which do not suffice for this matrix."));
+
+  n_rows    = matrix.m();
+  n_cols    = matrix.n();
+  n_nonzero = matrix.n_nonzero_elements();
+
+  std::vector<unsigned int> row_lengths(n_rows);
+  for (unsigned int row = 0; row < n_rows; ++row)
+    row_lengths[row] = matrix.get_row_length(row);
+
+  // sort the rows by decreasing length within each window of the sorting
+  // scope, keeping the original order for rows of the same length
+  const unsigned int scope =
+    std::max(1U, (sorting_scope + chunk_size - 1) / chunk_size) * chunk_size;
+  std::vector<unsigned int> permutation(n_rows);
+  std::iota(permutation.begin(), permutation.end(), 0U);
+  for (unsigned int start = 0; start < n_rows; start += scope)
+    std::stable_sort(permutation.begin() + start,
+                     permutation.begin() +
+                       std::min<size_type>(start + scope, n_rows),
+                     [&row_lengths](const unsigned int a, const unsigned int b) {
+                       return row_lengths[a] > row_lengths[b];
+                     });
+
+  const unsigned int n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+  row_indices.clear();
+  row_indices.resize(n_chunks * chunk_size, numbers::invalid_unsigned_int);
+  std::copy(permutation.begin(), permutation.end(), row_indices.begin());
+
+  chunk_start.resize(n_chunks + 1);
+  chunk_start[0] = 0;
+  for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+    {
+      unsigned int max_length = 0;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        if (row_indices[chunk * chunk_size + v] != numbers::invalid_unsigned_int)
+          max_length = std::max(max_length,
+                                row_lengths[row_indices[chunk * chunk_size + v]]);
+      chunk_start[chunk + 1] = chunk_start[chunk] + max_length * chunk_size;
+    }
+
+  values.resize_fast(chunk_start.back());
+  column_indices.resize_fast(chunk_start.back());
+  diagonal.clear();
+  diagonal.resize(n_rows);
+  for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+    {
+      const unsigned int length =
+        (chunk_start[chunk + 1] - chunk_start[chunk]) / chunk_size;
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const unsigned int row       = row_indices[chunk * chunk_size + v];
+          std::size_t        index     = chunk_start[chunk] + v;
+          unsigned int       last_col  = 0;
+          unsigned int       n_entries = 0;
+          if (row != numbers::invalid_unsigned_int)
+            for (auto entry = matrix.begin(row); entry != matrix.end(row);
+                 ++entry, ++n_entries, index += chunk_size)
+              {
+                values[index]         = entry->value();
+                column_indices[index] = entry->column();
+                last_col              = entry->column();
+                if (entry->column() == row)
+                  diagonal[row] = entry->value();
+              }
+          for (; n_entries < length; ++n_entries, index += chunk_size)
+            {
+              values[index]         = number();
+              column_indices[index] = last_col;
+            }
+        }
+    }
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrixSELL<number>::clear()
+{
+  n_rows    = 0;
+  n_cols    = 0;
+  n_nonzero = 0;
+  chunk_start.clear();
+  row_indices.clear();
+  values.clear();
+  column_indices.clear();
+  diagonal.clear();
+}
+
+
+
+template <typename number>
+inline bool
+SparseMatrixSELL<number>::empty() const
+{
+  return n_rows == 0 || n_cols == 0;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_nonzero_elements() const
+{
+  return n_nonzero;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_stored_elements() const
+{
+  return values.size();
+}
+
+
+
+template <typename number>
+template <typename OutVector, typename InVector>
+inline void
+SparseMatrixSELL<number>::vmult_on_subrange(const unsigned int begin,
+                                            const unsigned int end,
+                                            OutVector         &dst,
+                                            const InVector    &src,
+                                            const bool         add) const
+{
+  using Number2          = typename InVector::value_type;
+  const Number2 *src_ptr = src.begin();
+  for (unsigned int chunk = begin; chunk < end; ++chunk)
+    {
+      const number       *val_ptr = values.data() + chunk_start[chunk];
+      const unsigned int *col_ptr = column_indices.data() + chunk_start[chunk];
+      const std::size_t   n_entries = chunk_start[chunk + 1] - chunk_start[chunk];
+
+      VectorizedArray<number> sum = number();
+      for (std::size_t j = 0; j < n_entries; j += chunk_size)
+        {
+          VectorizedArray<number> matrix_entries, vector_entries;
+          matrix_entries.load(val_ptr + j);
+          if constexpr (std::is_same_v<Number2, number>)
+            vector_entries.gather(src_ptr, col_ptr + j);
+          else
+            for (unsigned int v = 0; v < chunk_size; ++v)
+              vector_entries[v] = src_ptr[col_ptr[j + v]];
+          sum += matrix_entries * vector_entries;
+        }
+
+      for (unsigned int v = 0; v < chunk_size; ++v)
+        {
+          const unsigned int row = row_indices[chunk * chunk_size + v];
+          if (row == numbers::invalid_unsigned_int)
+            break;
+          if (add)
+            dst(row) += sum[v];
+          else
+            dst(row) = sum[v];
+        }
+    }
+}
+
+
+
+template <typename number>
+template <typename OutVector, typename InVector>
+inline void
+SparseMatrixSELL<number>::vmult(OutVector &dst, const InVector &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+      vmult_on_subrange(begin, end, dst, src, false);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      chunk_size);
+}
+
+
+
+template <typename number>
+template <typename OutVector, typename InVector>
+inline void
+SparseMatrixSELL<number>::vmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_start.size() - 1),
+    [this, &src, &dst](const unsigned int begin, const unsigned int end) {
+      vmult_on_subrange(begin, end, dst, src, true);
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+      chunk_size);
+}
+
+
+
+template <typename number>
+template <typename OutVector, typename InVector>
+inline void
+SparseMatrixSELL<number>::Tvmult(OutVector &dst, const InVector &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  dst = 0;
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <typename OutVector, typename InVector>
+inline void
+SparseMatrixSELL<number>::Tvmult_add(OutVector &dst, const InVector &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
+
+  // the entries of different rows write into the same entries of dst, so
+  // this product runs in serial like for SparseMatrix
+  for (unsigned int chunk = 0; chunk + 1 < chunk_start.size(); ++chunk)
+    for (unsigned int v = 0; v < chunk_size; ++v)
+      {
+        const unsigned int row = row_indices[chunk * chunk_size + v];
+        if (row == numbers::invalid_unsigned_int)
+          break;
+        const number src_value = src(row);
+        for (std::size_t j = chunk_start[chunk] + v; j < chunk_start[chunk + 1];
+             j += chunk_size)
+          dst(column_indices[j]) += values[j] * src_value;
+      }
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+inline void
+SparseMatrixSELL<number>::precondition_Jacobi(Vector<somenumber>       &dst,
+                                              const Vector<somenumber> &src,
+                                              const number omega) const
+{
+  Assert(m() == n(),
+         ExcMessage("This operation is only valid on square matrices."));
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  for (size_type i = 0; i < n_rows; ++i)
+    {
+      Assert(diagonal[i] != number(), ExcDivideByZero());
+      dst(i) = omega * src(i) / diagonal[i];
+    }
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(chunk_start) +
+         MemoryConsumption::memory_consumption(row_indices) +
+         values.memory_consumption() + column_indices.memory_consumption() +
+         MemoryConsumption::memory_consumption(diagonal);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
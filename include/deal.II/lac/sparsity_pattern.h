@@ -45,6 +45,7 @@ DEAL_II_NAMESPACE_OPEN
 // Forward declarations
 #ifndef DOXYGEN
 class SparsityPattern;
+class SparsityPatternBuilder;
 class DynamicSparsityPattern;
 class ChunkSparsityPattern;
 template <typename number>
@@ -689,6 +690,22 @@ public:
   void
   copy_from(const SparsityPattern &sp);
 
+  /**
+   * Create the pattern from the entries recorded in a SparsityPatternBuilder.
+   * Previous content of this object is lost, and the sparsity pattern is in
+   * compressed mode afterwards.
+   *
+   * The pattern is built in two passes over the rows, both of which run in
+   * parallel: the first one merges the entries recorded for every row and
+   * counts them, which gives the exact size of each row; the second one
+   * merges them again and writes the sorted column indices directly into the
+   * arrays allocated after the first pass. In contrast to creating the
+   * pattern from a DynamicSparsityPattern, no second copy of the column
+   * indices exists at any time.
+   */
+  void
+  copy_from(const SparsityPatternBuilder &builder);
+
   /**
    * Take a full matrix and use its nonzero entries to generate a sparse
    * matrix entry pattern for this object.
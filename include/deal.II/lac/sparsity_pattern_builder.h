@@ -0,0 +1,184 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#ifndef dealii_sparsity_pattern_builder_h
+#define dealii_sparsity_pattern_builder_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/thread_local_storage.h>
+
+#include <deal.II/lac/sparsity_pattern_base.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declaration
+#ifndef DOXYGEN
+class SparsityPattern;
+#endif
+
+/**
+ * @addtogroup Sparsity
+ * @{
+ */
+
+/**
+ * A class that records the entries that are added to it through the
+ * SparsityPatternBase interface, for the sole purpose of creating a
+ * SparsityPattern from them via SparsityPattern::copy_from().
+ *
+ * The usual way to set up a SparsityPattern is to first fill a
+ * DynamicSparsityPattern, for example with DoFTools::make_sparsity_pattern(),
+ * and then copy it into the SparsityPattern. At the time of the copy, both
+ * objects exist and the column indices of every row are stored twice. This
+ * class instead keeps the entries in the form in which they are added:
+ * functions like AffineConstraints::add_entries_local_to_global() add the
+ * same list of column indices to all rows that belong to a cell, and this
+ * list is only stored once, together with the rows it was added to. For
+ * patterns that originate from couplings between the degrees of freedom of a
+ * cell, this is much less memory than the final pattern needs.
+ * SparsityPattern::copy_from() then creates the compressed pattern in two
+ * parallel passes over the rows: the first one determines the exact number of
+ * entries of each row, the second one writes the sorted column indices
+ * directly into the final arrays.
+ *
+ * Entries may be added concurrently from several threads, as every thread
+ * records into its own storage. DoFTools::make_sparsity_pattern() and
+ * DoFTools::make_flux_sparsity_pattern() make use of this and loop over the
+ * cells in parallel if they are given an object of this type.
+ *
+ * A typical use looks like this:
+ * @code
+ *   SparsityPatternBuilder builder(dof_handler.n_dofs(),
+ *                                  dof_handler.n_dofs());
+ *   DoFTools::make_sparsity_pattern(dof_handler, builder, constraints, false);
+ *
+ *   SparsityPattern sparsity_pattern;
+ *   sparsity_pattern.copy_from(builder);
+ * @endcode
+ */
+class SparsityPatternBuilder : public SparsityPatternBase
+{
+public:
+  /**
+   * Constructor. Set up an empty builder for a sparsity pattern of size
+   * @p n_rows times @p n_cols.
+   */
+  SparsityPatternBuilder(const size_type n_rows = 0,
+                         const size_type n_cols = 0);
+
+  /**
+   * Copy constructor, deleted since the object holds a mutex.
+   */
+  SparsityPatternBuilder(const SparsityPatternBuilder &) = delete;
+
+  /**
+   * Copy assignment, deleted since the object holds a mutex.
+   */
+  SparsityPatternBuilder &
+  operator=(const SparsityPatternBuilder &) = delete;
+
+  /**
+   * Delete all entries recorded so far and set the size of the sparsity
+   * pattern to be created to @p n_rows times @p n_cols.
+   */
+  void
+  reinit(const size_type n_rows, const size_type n_cols);
+
+  /**
+   * Record the entries @p columns of row @p row. If the list of columns is
+   * the same as the one of the previous call from the same thread, it is not
+   * stored again.
+   *
+   * This function may be called concurrently from several threads.
+   */
+  virtual void
+  add_row_entries(const size_type                  &row,
+                  const ArrayView<const size_type> &columns,
+                  const bool indices_are_sorted = false) override;
+
+  /**
+   * Record the given (row, column) pairs.
+   *
+   * This function may be called concurrently from several threads.
+   */
+  virtual void
+  add_entries(const ArrayView<const std::pair<size_type, size_type>> &entries)
+    override;
+
+  using SparsityPatternBase::add_entries;
+
+  /**
+   * Return an estimate for the memory consumption of this object, in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * One call to add_row_entries(): the row the entries were added to, and
+   * the range of the respective column indices in ThreadData::columns.
+   */
+  struct RowEntries
+  {
+    std::size_t  first_column;
+    size_type    row;
+    unsigned int n_columns;
+  };
+
+  /**
+   * The entries recorded by one thread.
+   */
+  struct ThreadData
+  {
+    std::vector<size_type>  columns;
+    std::vector<RowEntries> row_entries;
+  };
+
+  /**
+   * Return the storage of the calling thread, creating it if necessary.
+   */
+  ThreadData &
+  get_thread_data();
+
+  /**
+   * The storage of all threads that have added entries so far.
+   */
+  std::vector<std::unique_ptr<ThreadData>> thread_data;
+
+  /**
+   * A pointer into #thread_data for every thread.
+   */
+  Threads::ThreadLocalStorage<ThreadData *> thread_data_pointer;
+
+  /**
+   * Mutex guarding the creation of new elements of #thread_data.
+   */
+  std::mutex mutex;
+
+  friend class SparsityPattern;
+};
+
+/**
+ * @}
+ */
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
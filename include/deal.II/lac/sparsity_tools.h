@@ -204,6 +204,12 @@ namespace SparsityTools
    * exception if starting indices are given, taking the latter as an
    * indication that the caller of the function would like to override the
    * part of the algorithm that chooses starting indices.
+   *
+   * If more than one thread is available (see MultithreadInfo), the
+   * neighbors of large levels of nodes are searched in parallel. Since the
+   * nodes of each level are numbered in an order that only depends on the
+   * set of nodes of the level, the result does not depend on the number of
+   * threads.
    */
   void
   reorder_Cuthill_McKee(
@@ -224,6 +224,16 @@ namespace internal
       Number *const dst;
     };
 
+    /**
+     * Return whether the two number types are float and double (in any
+     * order), for which VectorizedArray provides converting load() and
+     * store() functions.
+     */
+    template <typename Number, typename OtherNumber>
+    constexpr bool is_float_double_pair =
+      (std::is_same_v<Number, float> && std::is_same_v<OtherNumber, double>) ||
+      (std::is_same_v<Number, double> && std::is_same_v<OtherNumber, float>);
+
     template <typename Number, typename OtherNumber>
     struct Vector_copy
     {
@@ -243,6 +253,23 @@ namespace internal
         if constexpr (std::is_trivially_copyable<Number>() &&
                       std::is_same_v<Number, OtherNumber>)
           std::memcpy(dst + begin, src + begin, (end - begin) * sizeof(Number));
+        else if constexpr (is_float_double_pair<Number, OtherNumber>)
+          {
+            // load and convert with the explicit SIMD conversion
+            // instructions of VectorizedArray, e.g. vcvtpd2ps/vcvtps2pd on
+            // AVX-512, and only work on the remainder element by element
+            constexpr size_type n_lanes = VectorizedArray<Number>::size();
+            const size_type     end_regular =
+              begin + (end - begin) / n_lanes * n_lanes;
+            for (size_type i = begin; i < end_regular; i += n_lanes)
+              {
+                VectorizedArray<Number> tmp;
+                tmp.load(src + i);
+                tmp.store(dst + i);
+              }
+            for (size_type i = end_regular; i < end; ++i)
+              dst[i] = src[i];
+          }
         else
           {
             DEAL_II_OPENMP_SIMD_PRAGMA
@@ -322,6 +349,53 @@ namespace internal
       const Number        stored_factor;
     };
 
+    template <typename Number, typename OtherNumber>
+    struct Vectorization_add_av_converted
+    {
+      Vectorization_add_av_converted(Number *const            val,
+                                     const OtherNumber *const v_val,
+                                     const Number             factor)
+        : val(val)
+        , v_val(v_val)
+        , stored_factor(factor)
+      {}
+
+      void
+      operator()(const size_type begin, const size_type end) const
+      {
+        const Number factor = stored_factor;
+
+        if constexpr (is_float_double_pair<Number, OtherNumber>)
+          {
+            // convert the entries of v_val in registers as part of the
+            // update, rather than going through a temporary vector of type
+            // Number
+            constexpr size_type n_lanes = VectorizedArray<Number>::size();
+            const size_type     end_regular =
+              begin + (end - begin) / n_lanes * n_lanes;
+            for (size_type i = begin; i < end_regular; i += n_lanes)
+              {
+                VectorizedArray<Number> v, result;
+                v.load(v_val + i);
+                result.load(val + i);
+                result += factor * v;
+                result.store(val + i);
+              }
+            for (size_type i = end_regular; i < end; ++i)
+              val[i] += factor * static_cast<Number>(v_val[i]);
+          }
+        else
+          {
+            for (size_type i = begin; i < end; ++i)
+              val[i] += factor * static_cast<Number>(v_val[i]);
+          }
+      }
+
+      Number *const            val;
+      const OtherNumber *const v_val;
+      const Number             stored_factor;
+    };
+
     template <typename Number>
     struct Vectorization_sadd_xav
     {
@@ -1477,6 +1551,22 @@ namespace internal
           "For the Default MemorySpace Number and Number2 should be the same type");
       }
 
+      static void
+      add_av_converted(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
+        /*thread_loop_partitioner*/,
+        const size_type /*size*/,
+        const Number /*a*/,
+        const ::dealii::MemorySpace::MemorySpaceData<Number2, MemorySpace>
+          & /*v_data*/,
+        ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> & /*data*/)
+      {
+        static_assert(
+          std::is_same_v<MemorySpace, ::dealii::MemorySpace::Default> &&
+            std::is_same_v<Number, Number2>,
+          "For the Default MemorySpace Number and Number2 should be the same type");
+      }
+
       static void
       set(
         const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
@@ -1727,6 +1817,23 @@ namespace internal
         parallel_for(copier, 0, size, thread_loop_partitioner);
       }
 
+      static void
+      add_av_converted(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+                       &thread_loop_partitioner,
+        const size_type size,
+        const Number    a,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number2, ::dealii::MemorySpace::Host> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &data)
+      {
+        Vectorization_add_av_converted<Number, Number2> vector_add(
+          data.values.data(), v_data.values.data(), a);
+        parallel_for(vector_add, 0, size, thread_loop_partitioner);
+      }
+
       static void
       set(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
                          &thread_loop_partitioner,
@@ -2138,6 +2245,21 @@ namespace internal
                           Kokkos::pair<size_type, size_type>(0, size)));
       }
 
+      static void
+      add_av_converted(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+                       &thread_loop_partitioner,
+        const size_type size,
+        const Number    a,
+        const ::dealii::MemorySpace::
+          MemorySpaceData<Number, ::dealii::MemorySpace::Default> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Default>
+          &data)
+      {
+        add_av(thread_loop_partitioner, size, a, v_data, data);
+      }
+
       static void
       set(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &,
           const size_type size,
@@ -53,7 +53,7 @@ namespace internal
       template <typename number2>
       unsigned short
       insert_entries(
-        const std::vector<std::pair<types::global_dof_index, number2>>
+        const ArrayView<const std::pair<types::global_dof_index, number2>>
           &entries);
 
       /**
@@ -216,7 +216,8 @@ namespace internal
     template <typename number2>
     unsigned short
     ConstraintValues<Number>::insert_entries(
-      const std::vector<std::pair<types::global_dof_index, number2>> &entries)
+      const ArrayView<const std::pair<types::global_dof_index, number2>>
+        &entries)
     {
       next_constraint.first.resize(entries.size());
       if (entries.size() > 0)
@@ -435,11 +436,11 @@ namespace internal
 
       for (auto current_dof : local_dof_indices_lex)
         {
-          const auto *entries_ptr =
+          const auto entries_ptr =
             constraints.get_constraint_entries(current_dof);
 
           // dof is constrained
-          if (entries_ptr != nullptr)
+          if (entries_ptr.has_value())
             {
               const auto                   &entries   = *entries_ptr;
               const types::global_dof_index n_entries = entries.size();
@@ -524,7 +525,7 @@ namespace internal
 
               constraint_indicator.push_back(constraint_iterator);
               constraint_indicator.back().second =
-                constraint_values.insert_entries(entries);
+                constraint_values.insert_entries(make_array_view(entries));
 
               constraint_iterator.first = 0;
             }
@@ -74,11 +74,11 @@ namespace internal
           for (; i < next; ++i)
             {
               types::global_dof_index current_dof = local_indices_resolved[i];
-              const auto             *entries_ptr =
+              const auto entries_ptr =
                 constraints.get_constraint_entries(current_dof);
 
               // dof is constrained
-              if (entries_ptr != nullptr)
+              if (entries_ptr.has_value())
                 {
                   // in case we want to access plain indices, we need to know
                   // about the location of constrained indices as well (all the
@@ -81,6 +81,13 @@ namespace internal
     static const EvaluatorVariant variant = evaluate_evenodd;
   };
 
+  template <bool is_long>
+  struct EvaluatorSelector<MatrixFreeFunctions::tensor_partially_symmetric,
+                           is_long>
+  {
+    static const EvaluatorVariant variant = evaluate_evenodd_partial;
+  };
+
 
 
   /**
@@ -116,12 +123,19 @@ namespace internal
     using Number2 =
       typename FEEvaluationData<dim, Number, false>::shape_info_number_type;
 
-    using Eval = EvaluatorTensorProduct<variant,
-                                        dim,
-                                        fe_degree + 1,
-                                        n_q_points_1d,
-                                        Number,
-                                        Number2>;
+    using Eval = std::conditional_t<
+      variant == evaluate_evenodd_partial,
+      EvaluatorTensorProductPartialEvenOdd<dim,
+                                           fe_degree + 1,
+                                           n_q_points_1d,
+                                           Number,
+                                           Number2>,
+      EvaluatorTensorProduct<variant,
+                             dim,
+                             fe_degree + 1,
+                             n_q_points_1d,
+                             Number,
+                             Number2>>;
 
     static void
     evaluate(const unsigned int                     n_components,
@@ -141,7 +155,14 @@ namespace internal
       const MatrixFreeFunctions::UnivariateShapeData<Number2>
         *univariate_shape_data)
     {
-      if (variant == evaluate_evenodd)
+      if constexpr (variant == evaluate_evenodd_partial)
+        return Eval(univariate_shape_data->shape_values_eo_partial,
+                    univariate_shape_data->shape_gradients_eo_partial,
+                    univariate_shape_data->shape_hessians_eo_partial,
+                    univariate_shape_data->symmetric_point_pairs,
+                    univariate_shape_data->fe_degree + 1,
+                    univariate_shape_data->n_q_points_1d);
+      else if (variant == evaluate_evenodd)
         return Eval(univariate_shape_data->shape_values_eo,
                     univariate_shape_data->shape_gradients_eo,
                     univariate_shape_data->shape_hessians_eo,
@@ -2083,6 +2104,19 @@ namespace internal
                                       fe_eval,
                                       sum_into_values_array);
         }
+      else if (element_type == ElementType::tensor_partially_symmetric)
+        {
+          evaluate_or_integrate<
+            FEEvaluationImpl<ElementType::tensor_partially_symmetric,
+                             dim,
+                             fe_degree,
+                             n_q_points_1d,
+                             Number>>(n_components,
+                                      actual_flag,
+                                      values_dofs,
+                                      fe_eval,
+                                      sum_into_values_array);
+        }
       else if (element_type == ElementType::truncated_tensor)
         {
           evaluate_or_integrate<FEEvaluationImpl<ElementType::truncated_tensor,
@@ -796,6 +796,13 @@ protected:
    * MatrixFree object was given at initialization.
    */
   mutable std::vector<types::global_dof_index> local_dof_indices;
+
+  /**
+   * Storage for the geometry of cell batches whose Jacobians are computed
+   * on the fly, see MatrixFree::AdditionalData::compute_jacobians_on_the_fly.
+   */
+  internal::MatrixFreeFunctions::CellGeometryOnTheFly<dim, VectorizedArrayType>
+    geometry_on_the_fly;
 };
 
 
@@ -6450,13 +6457,24 @@ FEEvaluation<dim,
   Assert(this->dof_info != nullptr, ExcNotInitialized());
   Assert(this->mapping_data != nullptr, ExcNotInitialized());
   this->cell = cell_index;
-  this->cell_type =
-    this->matrix_free->get_mapping_info().get_cell_type(cell_index);
+  const auto &mapping_info = this->matrix_free->get_mapping_info();
+  this->cell_type          = mapping_info.get_cell_type(cell_index);
 
   const unsigned int offsets =
     this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
+  if (mapping_info.has_cell_geometry_on_the_fly(cell_index))
+    {
+      mapping_info.compute_cell_geometry_on_the_fly(cell_index,
+                                                    this->quad_no,
+                                                    this->geometry_on_the_fly);
+      this->jacobian = this->geometry_on_the_fly.jacobians.data();
+      this->J_value  = this->geometry_on_the_fly.JxW_values.data();
+    }
+  else
+    {
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+    }
   if (!this->mapping_data->jacobian_gradients[0].empty())
     {
       this->jacobian_gradients =
@@ -6661,9 +6679,20 @@ FEEvaluation<dim,
       else
         {
           // general case that at least one cell is not Cartesian or affine
-          const auto cell_type =
-            this->matrix_free->get_mapping_info().get_cell_type(
-              cell_batch_index);
+          const auto &mapping_info = this->matrix_free->get_mapping_info();
+          const auto  cell_type = mapping_info.get_cell_type(cell_batch_index);
+
+          const Tensor<2, dim, VectorizedArrayType> *jacobian_src =
+            this->mapping_data->jacobians[0].data() + offsets;
+          const VectorizedArrayType *J_value_src =
+            this->mapping_data->JxW_values.data() + offsets;
+          if (mapping_info.has_cell_geometry_on_the_fly(cell_batch_index))
+            {
+              mapping_info.compute_cell_geometry_on_the_fly(
+                cell_batch_index, this->quad_no, this->geometry_on_the_fly);
+              jacobian_src = this->geometry_on_the_fly.jacobians.data();
+              J_value_src  = this->geometry_on_the_fly.JxW_values.data();
+            }
 
           for (unsigned int q = 0; q < this->n_quadrature_points; ++q)
             {
@@ -6673,14 +6702,12 @@ FEEvaluation<dim,
                   0 :
                   q;
 
-              this_J_value_data[q][v] =
-                this->mapping_data->JxW_values[offsets + q_src][lane];
+              this_J_value_data[q][v] = J_value_src[q_src][lane];
 
               for (unsigned int i = 0; i < dim; ++i)
                 for (unsigned int j = 0; j < dim; ++j)
                   this_jacobian_data[q][i][j][v] =
-                    this->mapping_data
-                      ->jacobians[0][offsets + q_src][i][j][lane];
+                    jacobian_src[q_src][i][j][lane];
 
               const auto &update_flags_cells =
                 this->matrix_free->get_mapping_info().update_flags_cells;
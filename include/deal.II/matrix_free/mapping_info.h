@@ -33,6 +33,7 @@
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/mapping_info_storage.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
 
@@ -44,6 +45,35 @@ namespace internal
 {
   namespace MatrixFreeFunctions
   {
+    /**
+     * A data structure holding the inverse Jacobians and JxW values of a
+     * cell batch that are computed on the fly by
+     * MappingInfo::compute_cell_geometry_on_the_fly(), together with the
+     * scratch data of the evaluation.
+     *
+     * @ingroup matrixfree
+     */
+    template <int dim, typename VectorizedArrayType>
+    struct CellGeometryOnTheFly
+    {
+      /**
+       * The inverse and transposed Jacobians on the quadrature points.
+       */
+      AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobians;
+
+      /**
+       * The Jacobian determinants times the quadrature weights.
+       */
+      AlignedVector<VectorizedArrayType> JxW_values;
+
+      /**
+       * Scratch data for the evaluation of the mapping.
+       */
+      AlignedVector<VectorizedArrayType> evaluation_data;
+    };
+
+
+
     /**
      * The class that stores all geometry-dependent data related with cell
      * interiors for use in the matrix-free class.
@@ -73,7 +103,8 @@ namespace internal
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
         const UpdateFlags update_flags_faces_by_cells,
-        const bool        piola_transform);
+        const bool        piola_transform,
+        const bool        compute_jacobians_on_the_fly = false);
 
       /**
        * Update the information in the given cells and faces that is the
@@ -95,6 +126,29 @@ namespace internal
       GeometryType
       get_cell_type(const unsigned int cell_chunk_no) const;
 
+      /**
+       * Return whether the inverse Jacobians and JxW values of the given cell
+       * batch are not stored in @p cell_data but must be computed from the
+       * mapping support points via compute_cell_geometry_on_the_fly().
+       */
+      bool
+      has_cell_geometry_on_the_fly(const unsigned int cell_chunk_no) const;
+
+      /**
+       * Compute the inverse Jacobians and the JxW values on the quadrature
+       * points of the quadrature formula with index @p quad_no on the given
+       * cell batch from the mapping support points stored in
+       * @p cell_support_points. The Jacobians are obtained by the
+       * sum-factorization kernels of the matrix-free framework. The results
+       * are placed into the fields of @p geometry, which are resized as
+       * necessary.
+       */
+      void
+      compute_cell_geometry_on_the_fly(
+        const unsigned int                                   cell_chunk_no,
+        const unsigned int                                   quad_no,
+        CellGeometryOnTheFly<dim, VectorizedArrayType> &geometry) const;
+
       /**
        * Clear all data fields in this class.
        */
@@ -200,6 +254,38 @@ namespace internal
        */
       std::vector<std::vector<ReferenceCell>> reference_cell_types;
 
+      /**
+       * Whether the user requested to compute the Jacobians of general cells
+       * on the fly rather than storing them, see
+       * MatrixFree::AdditionalData::compute_jacobians_on_the_fly.
+       */
+      bool compute_jacobians_on_the_fly = false;
+
+      /**
+       * Stores the index offset of a cell batch into @p cell_support_points.
+       * Cell batches whose inverse Jacobians and JxW values are stored in
+       * @p cell_data get the value numbers::invalid_unsigned_int. The field
+       * is empty if no cell computes its geometry on the fly.
+       */
+      AlignedVector<unsigned int> cell_support_point_offsets;
+
+      /**
+       * The support points of the mapping in lexicographic order for the
+       * cell batches of general type in case the Jacobians are computed on
+       * the fly. The points are stored relative to the first support point of
+       * each cell, which keeps the precision of the difference quotients
+       * when @p Number is a single-precision type.
+       *
+       * Indexed by @p cell_support_point_offsets.
+       */
+      AlignedVector<Point<dim, VectorizedArrayType>> cell_support_points;
+
+      /**
+       * The interpolation matrices from the mapping support points to the
+       * quadrature points of the cells, one per quadrature formula.
+       */
+      std::vector<ShapeInfo<Number>> cell_support_point_shape_info;
+
       /**
        * Internal function to compute the geometry for the case the mapping is
        * a MappingQ and a single quadrature formula per slot (non-hp-case) is
@@ -308,6 +394,20 @@ namespace internal
       return cell_type[cell_no];
     }
 
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    inline bool
+    MappingInfo<dim, Number, VectorizedArrayType>::has_cell_geometry_on_the_fly(
+      const unsigned int cell_no) const
+    {
+      if (cell_support_point_offsets.empty())
+        return false;
+      AssertIndexRange(cell_no, cell_support_point_offsets.size());
+      return cell_support_point_offsets[cell_no] !=
+             numbers::invalid_unsigned_int;
+    }
+
   } // end of namespace MatrixFreeFunctions
 } // end of namespace internal
 
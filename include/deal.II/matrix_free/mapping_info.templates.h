@@ -52,6 +52,9 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
+      cell_support_point_offsets.clear();
+      cell_support_points.clear();
+      cell_support_point_shape_info.clear();
       mapping_collection = nullptr;
       mapping            = nullptr;
     }
@@ -71,11 +74,13 @@ namespace internal
       const UpdateFlags update_flags_boundary_faces,
       const UpdateFlags update_flags_inner_faces,
       const UpdateFlags update_flags_faces_by_cells,
-      const bool        piola_transform)
+      const bool        piola_transform,
+      const bool        compute_jacobians_on_the_fly)
     {
       clear();
-      this->mapping_collection = mapping;
-      this->mapping            = &mapping->operator[](0);
+      this->mapping_collection           = mapping;
+      this->mapping                      = &mapping->operator[](0);
+      this->compute_jacobians_on_the_fly = compute_jacobians_on_the_fly;
 
       cell_data.resize(quad.size());
       face_data.resize(quad.size());
@@ -219,6 +224,9 @@ namespace internal
         data.clear_data_fields();
       for (auto &data : face_data_by_cells)
         data.clear_data_fields();
+      cell_support_point_offsets.clear();
+      cell_support_points.clear();
+      cell_support_point_shape_info.clear();
 
       this->mapping_collection = mapping;
       this->mapping            = &mapping->operator[](0);
@@ -1189,7 +1197,9 @@ namespace internal
         for (unsigned int cell = begin_cell; cell < end_cell; ++cell)
           for (unsigned vv = 0; vv < n_lanes; vv += n_lanes_d)
             {
-              if (cell_type[cell] > affine || process_cell[cell])
+              if (process_cell[cell] ||
+                  (cell_type[cell] > affine &&
+                   (update_flags_cells & update_quadrature_points)))
                 {
                   unsigned int start_indices[n_lanes_d];
                   for (unsigned int v = 0; v < n_lanes_d; ++v)
@@ -2781,6 +2791,70 @@ namespace internal
                               preliminary_cell_type.data() + cell + n_lanes);
         }
 
+      // step 3b: in case the Jacobians of general cells should be computed
+      // on the fly, only keep the mapping support points of those cells
+      // (relative to the first support point) and skip the data on the
+      // quadrature points. Second derivatives are not supported by the
+      // evaluation on the fly, so we keep the full data in that case.
+      std::vector<bool> process_cell_data = process_cell;
+      if (compute_jacobians_on_the_fly &&
+          !(update_flags_cells & update_jacobian_grads) &&
+          std::any_of(cell_type.begin(),
+                      cell_type.end(),
+                      [](const GeometryType type) { return type > affine; }))
+        {
+          cell_support_point_offsets.resize(cell_type.size());
+          unsigned int n_support_points = 0;
+          for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+            {
+              if (cell_type[cell] <= affine)
+                cell_support_point_offsets[cell] =
+                  numbers::invalid_unsigned_int;
+              else if (process_cell[cell])
+                {
+                  cell_support_point_offsets[cell] = n_support_points;
+                  n_support_points += n_mapping_points;
+                }
+              else
+                cell_support_point_offsets[cell] =
+                  cell_support_point_offsets[cell_data_index_vect[cell]];
+
+              if (cell_type[cell] > affine)
+                process_cell_data[cell] = false;
+            }
+          cell_support_points.resize_fast(n_support_points);
+
+          dealii::parallel::apply_to_subranges(
+            0U,
+            cell_type.size(),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int cell = begin; cell < end; ++cell)
+                if (cell_type[cell] > affine && process_cell[cell])
+                  for (unsigned int v = 0; v < n_lanes; ++v)
+                    {
+                      const double *points =
+                        plain_quadrature_points.data() +
+                        (cell * n_lanes + v) * dim * n_mapping_points;
+                      Point<dim, VectorizedArrayType> *my_points =
+                        cell_support_points.data() +
+                        cell_support_point_offsets[cell];
+                      for (unsigned int d = 0; d < dim; ++d)
+                        for (unsigned int i = 0; i < n_mapping_points; ++i)
+                          my_points[i][d][v] =
+                            points[d * n_mapping_points + i] -
+                            points[d * n_mapping_points];
+                    }
+            },
+            std::max(cell_type.size() / MultithreadInfo::n_threads() / 2,
+                     std::size_t(2U)));
+
+          FE_DGQ<dim> fe_geometry(mapping_degree);
+          cell_support_point_shape_info.resize(cell_data.size());
+          for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
+            cell_support_point_shape_info[my_q].reinit(
+              cell_data[my_q].descriptor[0].quadrature, fe_geometry);
+        }
+
       // step 4: compute the data on cells from the cached quadrature
       // points, filling up all SIMD lanes as appropriate
       for (unsigned int my_q = 0; my_q < cell_data.size(); ++my_q)
@@ -2800,10 +2874,13 @@ namespace internal
                   my_data.data_index_offsets[cell_data_index_vect[cell]];
               else
                 my_data.data_index_offsets[cell] = max_size;
-              max_size =
-                std::max(max_size,
-                         my_data.data_index_offsets[cell] +
-                           (cell_type[cell] <= affine ? 2 : n_q_points));
+              if (cell_type[cell] <= affine)
+                max_size =
+                  std::max(max_size, my_data.data_index_offsets[cell] + 2);
+              else if (!has_cell_geometry_on_the_fly(cell))
+                max_size = std::max(max_size,
+                                    my_data.data_index_offsets[cell] +
+                                      n_q_points);
             }
 
           my_data.JxW_values.resize_fast(max_size);
@@ -2844,7 +2921,7 @@ namespace internal
                 tria,
                 cell_array,
                 cell_type,
-                process_cell,
+                process_cell_data,
                 update_flags_cells,
                 plain_quadrature_points,
                 shape_infos[my_q],
@@ -3362,6 +3439,58 @@ namespace internal
 
 
 
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::
+      compute_cell_geometry_on_the_fly(
+        const unsigned int                              cell,
+        const unsigned int                              quad_no,
+        CellGeometryOnTheFly<dim, VectorizedArrayType> &geometry) const
+    {
+      Assert(has_cell_geometry_on_the_fly(cell), ExcInternalError());
+      AssertIndexRange(quad_no, cell_support_point_shape_info.size());
+
+      const ShapeInfo<Number> &shape_info =
+        cell_support_point_shape_info[quad_no];
+      const auto        &descriptor = cell_data[quad_no].descriptor[0];
+      const unsigned int n_q_points = descriptor.n_q_points;
+      const unsigned int n_mapping_points =
+        shape_info.dofs_per_component_on_cell;
+
+      FEEvaluationData<dim, VectorizedArrayType, false> eval(shape_info);
+      eval.set_data_pointers(&geometry.evaluation_data, dim);
+
+      const Point<dim, VectorizedArrayType> *points =
+        cell_support_points.data() + cell_support_point_offsets[cell];
+      VectorizedArrayType *dof_values = eval.begin_dof_values();
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int i = 0; i < n_mapping_points; ++i)
+          dof_values[d * n_mapping_points + i] = points[i][d];
+
+      FEEvaluationFactory<dim, VectorizedArrayType>::evaluate(
+        dim, EvaluationFlags::gradients, dof_values, eval);
+
+      if (geometry.jacobians.size() != n_q_points)
+        {
+          geometry.jacobians.resize_fast(n_q_points);
+          geometry.JxW_values.resize_fast(n_q_points);
+        }
+
+      const VectorizedArrayType *gradients = eval.begin_gradients();
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          Tensor<2, dim, VectorizedArrayType> jac;
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int e = 0; e < dim; ++e)
+              jac[d][e] = gradients[e + (d * n_q_points + q) * dim];
+          geometry.JxW_values[q] =
+            determinant(jac) * descriptor.quadrature_weights[q];
+          geometry.jacobians[q] = transpose(invert(jac));
+        }
+    }
+
+
+
     template <int dim, typename Number, typename VectorizedArrayType>
     std::size_t
     MappingInfo<dim, Number, VectorizedArrayType>::memory_consumption() const
@@ -3373,6 +3502,11 @@ namespace internal
       memory += face_type.capacity() * sizeof(GeometryType);
       memory += faces_by_cells_type.capacity() *
                 GeometryInfo<dim>::faces_per_cell * sizeof(GeometryType);
+      memory +=
+        MemoryConsumption::memory_consumption(cell_support_point_offsets);
+      memory += MemoryConsumption::memory_consumption(cell_support_points);
+      memory +=
+        MemoryConsumption::memory_consumption(cell_support_point_shape_info);
       memory += sizeof(*this);
       return memory;
     }
@@ -3401,6 +3535,15 @@ namespace internal
                                           GeometryInfo<dim>::faces_per_cell *
                                           sizeof(GeometryType));
 
+      if (!cell_support_points.empty())
+        {
+          out << "    Cell mapping support points:     ";
+          task_info.print_memory_statistics(
+            out,
+            MemoryConsumption::memory_consumption(cell_support_point_offsets) +
+              MemoryConsumption::memory_consumption(cell_support_points));
+        }
+
       for (unsigned int j = 0; j < cell_data.size(); ++j)
         {
           out << "    Data component " << j << std::endl;
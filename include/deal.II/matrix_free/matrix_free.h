@@ -212,7 +212,14 @@ public:
        * Use the traditional coloring algorithm: this is like
        * TasksParallelScheme::partition_color, but only uses one partition.
        */
-      color = internal::MatrixFreeFunctions::TaskInfo::color
+      color = internal::MatrixFreeFunctions::TaskInfo::color,
+      /**
+       * Partition the cells into two levels like
+       * TasksParallelScheme::partition_partition, but schedule the chunks by
+       * their dependencies with work stealing.
+       */
+      partition_dynamic =
+        internal::MatrixFreeFunctions::TaskInfo::partition_dynamic
     };
 
     /**
@@ -249,6 +256,7 @@ public:
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
       , allow_ghosted_vectors_in_loops(allow_ghosted_vectors_in_loops)
+      , compute_jacobians_on_the_fly(false)
       , communicator_sm(MPI_COMM_SELF)
     {}
 
@@ -275,6 +283,7 @@ public:
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
       , allow_ghosted_vectors_in_loops(other.allow_ghosted_vectors_in_loops)
+      , compute_jacobians_on_the_fly(other.compute_jacobians_on_the_fly)
       , communicator_sm(other.communicator_sm)
     {}
 
@@ -303,13 +312,14 @@ public:
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
       allow_ghosted_vectors_in_loops = other.allow_ghosted_vectors_in_loops;
+      compute_jacobians_on_the_fly   = other.compute_jacobians_on_the_fly;
       communicator_sm                = other.communicator_sm;
 
       return *this;
     }
 
     /**
-     * Set the scheme for task parallelism. There are four options available.
+     * Set the scheme for task parallelism. There are five options available.
      * If set to @p none, the operator application is done in serial without
      * shared memory parallelism. If this class is used together with MPI and
      * MPI is also used for parallelism within the nodes, this flag should be
@@ -336,6 +346,19 @@ public:
      * might degrade parallel performance (bad cache behavior, many
      * synchronization points).
      *
+     * The fourth option @p partition_dynamic uses the same two-level
+     * partitions as @p partition_partition, but replaces the fixed order in
+     * which the task graph works on odd and even partitions by the actual
+     * dependencies between the chunks: A chunk can be started as soon as all
+     * chunks sharing vector entries with it and coming earlier in the
+     * odd-even order have been completed. The ready chunks are kept in one
+     * queue per thread, and threads running out of work steal chunks from
+     * the other queues. This scheme does not rely on the task interface of
+     * older TBB versions and is hence also available when deal.II is
+     * configured with oneTBB, where the other schemes fall back to @p none.
+     * Note that the MPI data exchange around the chunks with ghost cells is
+     * then called from any of the worker threads.
+     *
      * @note Threading support is currently experimental for the case inner
      * face integrals are performed and it is recommended to use MPI
      * parallelism if possible. While the scheme has been verified to work
@@ -547,6 +570,26 @@ public:
      */
     bool allow_ghosted_vectors_in_loops;
 
+    /**
+     * By default, the inverse Jacobians and the JxW values are stored on all
+     * quadrature points of cells that are neither Cartesian nor affine. On
+     * curved meshes with high-order mappings, this data dominates both the
+     * memory consumption and the memory transfer of matrix-free operator
+     * evaluation. If this flag is set to true, only the support points of
+     * the mapping are kept for those cells, and FEEvaluation::reinit()
+     * recomputes the Jacobians on the quadrature points with the
+     * sum-factorization kernels. This trades memory transfer for some
+     * additional arithmetic, which typically pays off for polynomial degrees
+     * of three and higher.
+     *
+     * @note This option only takes effect if the mapping is derived from
+     * MappingQ, a single quadrature formula per index is used (i.e., no
+     * hp-adaptivity), and no second derivatives of the geometry are
+     * requested via @p mapping_update_flags. Otherwise, the full data is
+     * stored. Face data is not affected by this flag.
+     */
+    bool compute_jacobians_on_the_fly;
+
     /**
      * Shared-memory MPI communicator. Default: MPI_COMM_SELF.
      */
@@ -4873,11 +4916,13 @@ namespace internal
       if (operation_after_loop)
         {
           // Run unit matrix operation on constrained dofs if we are at the
-          // last range
+          // last range, or in the threaded case that runs all of the
+          // operation_after_loop at once
           const std::vector<unsigned int> &partition_row_index =
             matrix_free.get_task_info().partition_row_index;
-          if (range_index ==
-              partition_row_index[partition_row_index.size() - 2] - 1)
+          if (range_index == numbers::invalid_unsigned_int ||
+              range_index ==
+                partition_row_index[partition_row_index.size() - 2] - 1)
             apply_operation_to_constrained_dofs(
               matrix_free.get_constrained_dofs(dof_handler_index_pre_post),
               src,
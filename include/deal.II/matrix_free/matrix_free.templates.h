@@ -64,7 +64,8 @@
 // years and is (presumably) not used that often.
 //
 // In case of detected oneAPI backend we simply disable threading in the
-// matrix free backend for now.
+// matrix free backend for now. The exception is the partition_dynamic
+// scheme, which schedules its tasks on top of Threads::new_task().
 //
 // Matthias Maier, Martin Kronbichler, 2021
 //
@@ -472,8 +473,12 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
 
         // initialize the basic multithreading information that needs to be
         // passed to the DoFInfo structure
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
       if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
+#  ifdef DEAL_II_TBB_WITH_ONEAPI
+          additional_data.tasks_parallel_scheme ==
+            AdditionalData::partition_dynamic &&
+#  endif
           MultithreadInfo::n_threads() > 1)
         {
           task_info.scheme =
@@ -844,7 +849,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
         additional_data.mapping_update_flags_faces_by_cells,
-        piola_transform);
+        piola_transform,
+        additional_data.compute_jacobians_on_the_fly);
 
       mapping_is_initialized = true;
     }
@@ -990,7 +996,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_dof_handlers(
 
 namespace internal
 {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
 
 #  ifdef DEAL_II_TBB_WITH_ONEAPI
   struct unsigned_int_pair_hash
@@ -1690,7 +1696,7 @@ namespace internal
         connectivity.reinit(task_info.n_active_cells, task_info.n_active_cells);
         if (do_face_integrals)
           {
-#if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
+#ifdef DEAL_II_WITH_TBB
             // step 1: build map between the index in the matrix-free context
             // and the one in the triangulation
             tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,
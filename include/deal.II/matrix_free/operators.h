@@ -311,6 +311,35 @@ namespace MatrixFreeOperators
     void
     vmult(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Matrix-vector multiplication that interleaves vector operations with
+     * the cell loop. The function @p operation_before_matrix_vector_product
+     * is called on ranges of locally owned entries before the cell loop
+     * first reads the respective entries of @p src, and
+     * @p operation_after_matrix_vector_product is called on ranges of
+     * locally owned entries once the corresponding entries of @p dst are
+     * final, see MatrixFree::cell_loop() for the details. The ranges refer to
+     * the MPI-local index space of the vectors.
+     *
+     * This is the interface used by SolverCG to merge the vector updates,
+     * inner products and the application of a diagonal preconditioner into
+     * the operator evaluation, which saves several sweeps through the
+     * vectors per iteration. Derived classes opt into the interleaved
+     * evaluation by overriding apply_interleaved(). Otherwise, or if the
+     * operator has edge constraints from a multigrid level, the two
+     * functions are called on the complete locally owned range before and
+     * after a plain vmult(), respectively.
+     *
+     * @note This function only supports vectors with a single block.
+     */
+    void
+    vmult(VectorType       &dst,
+          const VectorType &src,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_before_matrix_vector_product,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_after_matrix_vector_product) const;
+
     /**
      * Transpose matrix-vector multiplication.
      */
@@ -428,6 +457,30 @@ namespace MatrixFreeOperators
     virtual void
     Tapply_add(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Apply operator to @p src and write the result into @p dst, running
+     * the two given functions on ranges of the vector entries before and
+     * after the cell loop touches them, as described in the interleaved
+     * vmult(). The entries of @p dst corresponding to constrained degrees of
+     * freedom must be set to the ones of @p src before
+     * @p operation_after_loop sees them. This is the case when the function
+     * is implemented by the variant of MatrixFree::cell_loop() taking the
+     * two functions as arguments, using the first entry of selected_rows as
+     * the index of the DoFHandler for the ranges.
+     *
+     * The default implementation does not interleave the operations but calls
+     * @p operation_before_loop on all locally owned entries, then vmult(), and
+     * finally @p operation_after_loop on all locally owned entries.
+     */
+    virtual void
+    apply_interleaved(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const;
+
     /**
      * MatrixFree object to be used with this operator.
      */
@@ -824,6 +877,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), but overwrites @p dst and interleaves the given
+     * vector operations with the cell loop.
+     */
+    virtual void
+    apply_interleaved(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * For this operator, there is just a cell contribution.
      */
@@ -974,6 +1040,19 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), but overwrites @p dst and interleaves the given
+     * vector operations with the cell loop.
+     */
+    virtual void
+    apply_interleaved(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * Applies the Laplace operator on a cell.
      */
@@ -1470,6 +1549,64 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::vmult(
+    VectorType       &dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_matrix_vector_product,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_matrix_vector_product) const
+  {
+    AssertDimension(dst.size(), src.size());
+    AssertDimension(BlockHelper::n_blocks(dst), 1);
+    AssertDimension(BlockHelper::n_blocks(src), 1);
+    AssertDimension(selected_rows.size(), 1);
+
+    // Edge constraints need to modify the source vector before the loop,
+    // which is incompatible with the operation before the loop changing the
+    // source vector, so use the non-interleaved variant in that case
+    if (edge_constrained_indices[0].empty())
+      {
+        adjust_ghost_range_if_necessary(src, false);
+        adjust_ghost_range_if_necessary(dst, true);
+        apply_interleaved(dst,
+                          src,
+                          operation_before_matrix_vector_product,
+                          operation_after_matrix_vector_product);
+      }
+    else
+      Base<dim, VectorType, VectorizedArrayType>::apply_interleaved(
+        dst,
+        src,
+        operation_before_matrix_vector_product,
+        operation_after_matrix_vector_product);
+  }
+
+
+
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::apply_interleaved(
+    VectorType       &dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const
+  {
+    const unsigned int locally_owned_size =
+      BlockHelper::subblock(dst, 0).locally_owned_size();
+    if (operation_before_loop)
+      operation_before_loop(0, locally_owned_size);
+    vmult(dst, src);
+    if (operation_after_loop)
+      operation_after_loop(0, locally_owned_size);
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::vmult_add(
@@ -2112,6 +2249,39 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  MassOperator<dim,
+              fe_degree,
+              n_q_points_1d,
+              n_components,
+              VectorType,
+              VectorizedArrayType>::
+    apply_interleaved(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &MassOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_q_points_1d,
@@ -2305,6 +2475,39 @@ namespace MatrixFreeOperators
       &LaplaceOperator::local_apply_cell, this, dst, src);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  LaplaceOperator<dim,
+                 fe_degree,
+                 n_q_points_1d,
+                 n_components,
+                 VectorType,
+                 VectorizedArrayType>::
+    apply_interleaved(
+      VectorType       &dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &LaplaceOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
   namespace Implementation
   {
     template <typename VectorizedArrayType>
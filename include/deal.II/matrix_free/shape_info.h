@@ -114,8 +114,19 @@ namespace internal
       /**
        * Shape functions without a tensor product properties.
        */
-      tensor_none = 8
+      tensor_none = 8,
 
+      /**
+       * Tensor product shape functions evaluated in a quadrature formula that
+       * is not symmetric about the midpoint of the unit interval 0.5, but
+       * where some of the pairs of points are mirror images of each other,
+       * such that the shape values in those points show the same symmetry as
+       * ElementType::tensor_symmetric. The evaluation uses the even-odd
+       * decomposition for those pairs and the general scheme for all other
+       * points. In all other places, elements of this type are treated like
+       * ElementType::tensor_general.
+       */
+      tensor_partially_symmetric = 9
 
     };
 
@@ -179,6 +190,16 @@ namespace internal
       bool
       check_and_set_shapes_symmetric();
 
+      /**
+       * Check whether at least one pair of quadrature points $(q, n_q-1-q)$
+       * is symmetric about the midpoint of the unit interval with respect to
+       * the shape values, gradients and Hessians, for the case that the
+       * shape values as a whole are not symmetric. In that case, also fill
+       * the shape_???_eo_partial fields and the symmetric_point_pairs field.
+       */
+      bool
+      check_and_set_shapes_partially_symmetric();
+
       /**
        * Check whether symmetric 1d basis functions are such that the shape
        * values form a diagonal matrix, i.e., the nodal points are collocated
@@ -289,6 +310,37 @@ namespace internal
        */
       AlignedVector<Number> inverse_shape_values_eo;
 
+      /**
+       * Stores the shape values in the partial even-odd format, used when the
+       * quadrature formula is only partly symmetric. The shape functions are
+       * combined into even and odd parts like in shape_values_eo, whereas
+       * all quadrature points are kept. The length of this array is
+       * <tt>n_dofs_1d * n_q_points_1d</tt> and quadrature points are the
+       * index running fastest.
+       */
+      AlignedVector<Number> shape_values_eo_partial;
+
+      /**
+       * Stores the shape gradients in the partial even-odd format, see
+       * shape_values_eo_partial.
+       */
+      AlignedVector<Number> shape_gradients_eo_partial;
+
+      /**
+       * Stores the shape Hessians in the partial even-odd format, see
+       * shape_values_eo_partial.
+       */
+      AlignedVector<Number> shape_hessians_eo_partial;
+
+      /**
+       * For each pair of quadrature points $(q, n_q-1-q)$ with $q < n_q/2$,
+       * stores whether the shape values, gradients and Hessians in the two
+       * points are related by symmetry, such that the evaluation of the
+       * shape_???_eo_partial fields can skip the second point. Only filled
+       * for elements of type ElementType::tensor_partially_symmetric.
+       */
+      std::vector<unsigned char> symmetric_point_pairs;
+
       /**
        * Collects all data of 1d shape values evaluated at the point 0 and 1
        * (the vertices) in one data structure. The sorting of data is to
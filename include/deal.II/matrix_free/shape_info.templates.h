@@ -715,6 +715,10 @@ namespace internal
                   element_type = tensor_symmetric;
             }
         }
+      else if (element_type == tensor_general &&
+               univariate_shape_data
+                 .check_and_set_shapes_partially_symmetric())
+        element_type = tensor_partially_symmetric;
       else if (element_type == tensor_symmetric_plus_dg0)
         univariate_shape_data.check_and_set_shapes_symmetric();
 
@@ -1195,6 +1199,101 @@ namespace internal
 
 
 
+    template <typename Number>
+    bool
+    UnivariateShapeData<Number>::check_and_set_shapes_partially_symmetric()
+    {
+      const double zero_tol =
+        std::is_same_v<Number, double> == true ? 1e-12 : 1e-7;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+
+      // the kernel for sizes given at run time, used when the degree is not
+      // known at compile time, stores the even and odd parts of at most 16
+      // pairs in temporary arrays on the stack. use the general kernel for
+      // larger sizes.
+      if (n_dofs_1d / 2 > 16 || n_q_points_1d / 2 > 16)
+        {
+          symmetric_point_pairs.clear();
+          return false;
+        }
+
+      // same scaling of the tolerances for gradients and Hessians as in
+      // check_and_set_shapes_symmetric()
+      const double zero_tol_gradient =
+        zero_tol * std::sqrt(fe_degree + 1.) * (fe_degree + 1);
+      const double zero_tol_hessian =
+        zero_tol * (fe_degree + 1) * (fe_degree + 1) * (fe_degree + 1);
+
+      symmetric_point_pairs.clear();
+      symmetric_point_pairs.resize(n_q_points_1d / 2, 0);
+      unsigned int n_symmetric_pairs = 0;
+      for (unsigned int q = 0; q < n_q_points_1d / 2; ++q)
+        {
+          const unsigned int q_mirror     = n_q_points_1d - 1 - q;
+          bool               is_symmetric = true;
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            {
+              const unsigned int ind = i * n_q_points_1d + q;
+              const unsigned int ind_mirror =
+                (n_dofs_1d - 1 - i) * n_q_points_1d + q_mirror;
+              if (std::abs(get_first_array_element(shape_values[ind] -
+                                                   shape_values[ind_mirror])) >
+                    std::max(zero_tol,
+                             zero_tol * std::abs(get_first_array_element(
+                                          shape_values[ind]))) ||
+                  std::abs(get_first_array_element(
+                    shape_gradients[ind] + shape_gradients[ind_mirror])) >
+                    zero_tol_gradient ||
+                  std::abs(get_first_array_element(
+                    shape_hessians[ind] - shape_hessians[ind_mirror])) >
+                    zero_tol_hessian)
+                is_symmetric = false;
+            }
+          if (is_symmetric)
+            {
+              symmetric_point_pairs[q] = 1;
+              ++n_symmetric_pairs;
+            }
+        }
+
+      if (n_symmetric_pairs == 0)
+        {
+          symmetric_point_pairs.clear();
+          return false;
+        }
+
+      // combine the shape functions into even and odd parts, but keep all
+      // quadrature points
+      const auto convert_to_eo_partial =
+        [&](const AlignedVector<Number> &array) {
+          AlignedVector<Number> array_eo(n_dofs_1d * n_q_points_1d);
+          for (unsigned int i = 0; i < n_dofs_1d / 2; ++i)
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              {
+                const unsigned int i_mirror = n_dofs_1d - 1 - i;
+                array_eo[i * n_q_points_1d + q] =
+                  0.5 * (array[i * n_q_points_1d + q] +
+                         array[i_mirror * n_q_points_1d + q]);
+                array_eo[i_mirror * n_q_points_1d + q] =
+                  0.5 * (array[i * n_q_points_1d + q] -
+                         array[i_mirror * n_q_points_1d + q]);
+              }
+          if (n_dofs_1d % 2 == 1)
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              array_eo[(n_dofs_1d / 2) * n_q_points_1d + q] =
+                array[(n_dofs_1d / 2) * n_q_points_1d + q];
+          return array_eo;
+        };
+
+      shape_values_eo_partial    = convert_to_eo_partial(shape_values);
+      shape_gradients_eo_partial = convert_to_eo_partial(shape_gradients);
+      shape_hessians_eo_partial  = convert_to_eo_partial(shape_hessians);
+
+      return true;
+    }
+
+
+
     template <typename Number>
     bool
     UnivariateShapeData<Number>::check_shapes_collocation() const
@@ -1342,6 +1441,12 @@ namespace internal
         MemoryConsumption::memory_consumption(shape_gradients_collocation_eo);
       memory +=
         MemoryConsumption::memory_consumption(shape_hessians_collocation_eo);
+      memory += MemoryConsumption::memory_consumption(shape_values_eo_partial);
+      memory +=
+        MemoryConsumption::memory_consumption(shape_gradients_eo_partial);
+      memory +=
+        MemoryConsumption::memory_consumption(shape_hessians_eo_partial);
+      memory += MemoryConsumption::memory_consumption(symmetric_point_pairs);
       for (unsigned int i = 0; i < 2; ++i)
         {
           memory +=
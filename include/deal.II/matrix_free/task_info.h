@@ -108,13 +108,15 @@ namespace internal
       // enum for choice of how to build the task graph. Odd add versions with
       // preblocking and even versions with postblocking. partition_partition
       // and partition_color are deprecated but kept for backward
-      // compatibility.
+      // compatibility. partition_dynamic uses the partitions of
+      // partition_partition but schedules them by a dependency graph.
       enum TasksParallelScheme
       {
         none,
         partition_partition,
         partition_color,
-        color
+        color,
+        partition_dynamic
       };
 
       /**
@@ -405,6 +407,36 @@ namespace internal
       void
       update_task_info(const unsigned int partition);
 
+      /**
+       * Set up the dependency graph between the tasks of the two-level
+       * partitioning for the scheme @p partition_dynamic. Two tasks depend on
+       * each other if any of their cells are connected in @p connectivity,
+       * and the dependency is directed from the odd to the even partitions
+       * of the outer level and, within the same outer partition, from the
+       * odd to the even partitions of the inner level.
+       *
+       * @param connectivity The connectivity between cells in the numbering
+       * before the call to make_thread_graph().
+       *
+       * @param cell_list Element j gives the index in @p connectivity of the
+       * cell that is placed at position j by the thread graph.
+       *
+       * @param irregular_cells The number of filled SIMD lanes of each cell
+       * batch in the final ordering, with zero for completely filled batches.
+       */
+      void
+      make_dependency_graph(const DynamicSparsityPattern     &connectivity,
+                            const std::vector<unsigned int>  &cell_list,
+                            const std::vector<unsigned char> &irregular_cells);
+
+      /**
+       * Run the tasks of the scheme @p partition_dynamic by a set of worker
+       * threads that pick up a task as soon as all tasks it depends on have
+       * been completed. Called from loop().
+       */
+      void
+      loop_dynamic(MFWorkerInterface &funct) const;
+
       /**
        * Creates a task graph from a connectivity structure.
        */
@@ -598,6 +630,27 @@ namespace internal
        */
       unsigned int n_workers;
 
+      /**
+       * Number of tasks each task of the scheme @p partition_dynamic needs
+       * to wait for before it can be started. The tasks are the ranges of
+       * @p cell_partition_data, followed by two entries for finishing the
+       * ghost value update and starting the compress operation of the MPI
+       * data exchange, respectively.
+       */
+      std::vector<unsigned int> dependency_n_predecessors;
+
+      /**
+       * Start of the list of tasks that depend on a given task within
+       * @p dependency_successors, in a compressed row storage fashion.
+       */
+      std::vector<unsigned int> dependency_successors_ptr;
+
+      /**
+       * The tasks that can only be started once the given task has been
+       * completed, for the scheme @p partition_dynamic.
+       */
+      std::vector<unsigned int> dependency_successors;
+
       /**
        * Stores whether a particular task is at an MPI boundary and needs data
        * exchange
@@ -63,7 +63,17 @@ namespace internal
      * coefficient arrays. See the documentation of the EvaluatorTensorProduct
      * specialization for more information.
      */
-    evaluate_symmetric_hierarchical
+    evaluate_symmetric_hierarchical,
+    /**
+     * Use the even-odd decomposition only for those pairs of quadrature
+     * points that are mirror images of each other about the center of the
+     * unit interval, and a general matrix-vector product for the remaining
+     * points. This keeps most of the savings of evaluate_evenodd for
+     * quadrature formulas that are only partly symmetric. See the
+     * documentation of EvaluatorTensorProductPartialEvenOdd for more
+     * information.
+     */
+    evaluate_evenodd_partial
   };
 
 
@@ -1082,6 +1092,223 @@ namespace internal
 
 
 
+  /**
+   * Internal evaluator for 1d tensor product matrices that are only partly
+   * symmetric, stored in the partial even-odd format.
+   *
+   * In this format, the rows of the matrix (i.e., the 1d shape functions)
+   * are combined pairwise into even and odd parts in the same way as for
+   * evaluate_evenodd: row $i < n/2$ holds $\frac{1}{2}(S_{i,q} +
+   * S_{n-1-i,q})$, row $n-1-i$ holds $\frac{1}{2}(S_{i,q} - S_{n-1-i,q})$,
+   * and the middle row of an odd number of rows is kept unchanged. The
+   * columns (i.e., the 1d quadrature points) are stored in full, because
+   * the quadrature formula need not be symmetric. The array @p symmetric_pairs
+   * holds one entry per pair of points $(q, n_q-1-q)$ with $q < n_q/2$; a
+   * non-zero entry states that the two points are mirror images of each
+   * other about the center of the unit interval, in which case the column
+   * of the second point is not read and the result for both points is
+   * computed with half the arithmetic operations, exploiting that values
+   * and Hessians are symmetric and gradients are skew-symmetric. All other
+   * pairs and the middle point are evaluated with a general matrix-vector
+   * product on the even and odd parts of the input.
+   *
+   * Like the other even-odd kernels, this function first reads all input
+   * entries and then writes the output, so it can work in place.
+   */
+  template <EvaluatorVariant  variant,
+            EvaluatorQuantity quantity,
+            int               n_rows_static,
+            int               n_columns_static,
+            int               stride_in_static,
+            int               stride_out_static,
+            bool              transpose_matrix,
+            bool              add,
+            typename Number,
+            typename Number2>
+#ifndef DEBUG
+  inline DEAL_II_ALWAYS_INLINE
+#endif
+    std::enable_if_t<(variant == evaluate_evenodd_partial), void>
+    apply_matrix_vector_product(const Number2 *DEAL_II_RESTRICT matrix,
+                                const unsigned char *symmetric_pairs,
+                                const Number        *in,
+                                Number              *out,
+                                int                  n_rows_runtime     = 0,
+                                int                  n_columns_runtime  = 0,
+                                int                  stride_in_runtime  = 0,
+                                int                  stride_out_runtime = 0)
+  {
+    static_assert(n_rows_static >= 0 && n_columns_static >= 0,
+                  "Negative loop ranges are not allowed!");
+
+    const int n_rows = n_rows_static == 0 ? n_rows_runtime : n_rows_static;
+    const int n_columns =
+      n_rows_static == 0 ? n_columns_runtime : n_columns_static;
+    const int stride_in =
+      stride_in_static == 0 ? stride_in_runtime : stride_in_static;
+    const int stride_out =
+      stride_out_static == 0 ? stride_out_runtime : stride_out_static;
+
+    Assert(n_rows > 0 && n_columns > 0,
+           ExcInternalError("The evaluation needs n_rows, n_columns > 0, but " +
+                            std::to_string(n_rows) + ", " +
+                            std::to_string(n_columns) + " was passed!"));
+
+    // the values of the mirrored point in a symmetric pair are obtained by
+    // subtracting the odd part from the even part, whereas the skew-symmetric
+    // gradients need the opposite sign
+    constexpr bool skew = quantity == EvaluatorQuantity::gradient;
+
+    const int n_half_rows    = n_rows / 2;
+    const int n_half_columns = n_columns / 2;
+
+    constexpr int array_length =
+      (n_rows_static == 0) ?
+        16 // for non-templated execution
+        :
+        (1 + (transpose_matrix ? n_rows_static : n_columns_static) / 2);
+
+    if (transpose_matrix == true)
+      {
+        // interpolation from the rows (shape functions) to the columns
+        // (points): split the input in even and odd parts. the temporary
+        // arrays of the variant with sizes given at run time hold 16
+        // entries, and ShapeInfo only selects this kernel for sizes that fit
+        AssertThrow(n_half_rows <= array_length,
+                    ExcMessage("The partial even-odd kernel supports at most " +
+                               std::to_string(2 * array_length + 1) +
+                               " rows, but " + std::to_string(n_rows) +
+                               " were requested."));
+        std::array<Number, array_length> xp, xm;
+        for (int i = 0; i < n_half_rows; ++i)
+          {
+            xp[i] = in[stride_in * i] + in[stride_in * (n_rows - 1 - i)];
+            xm[i] = in[stride_in * i] - in[stride_in * (n_rows - 1 - i)];
+          }
+        const Number xmid =
+          (n_rows % 2 == 1) ? in[stride_in * n_half_rows] : Number();
+
+        const auto apply_column = [&](const int col, Number &r0, Number &r1) {
+          r0 = (n_rows % 2 == 1) ?
+                 matrix[n_half_rows * n_columns + col] * xmid :
+                 Number();
+          r1 = Number();
+          for (int i = 0; i < n_half_rows; ++i)
+            {
+              r0 += matrix[i * n_columns + col] * xp[i];
+              r1 += matrix[(n_rows - 1 - i) * n_columns + col] * xm[i];
+            }
+        };
+
+        for (int col = 0; col < n_half_columns; ++col)
+          {
+            const int col_mirror = n_columns - 1 - col;
+            Number    r0, r1, r2, r3;
+            apply_column(col, r0, r1);
+            if (symmetric_pairs[col])
+              {
+                r2 = skew ? r1 : r0;
+                r3 = skew ? -r0 : -r1;
+              }
+            else
+              apply_column(col_mirror, r2, r3);
+
+            if (add)
+              {
+                out[stride_out * col] += r0 + r1;
+                out[stride_out * col_mirror] += r2 + r3;
+              }
+            else
+              {
+                out[stride_out * col]        = r0 + r1;
+                out[stride_out * col_mirror] = r2 + r3;
+              }
+          }
+        if (n_columns % 2 == 1)
+          {
+            Number r0, r1;
+            apply_column(n_half_columns, r0, r1);
+            if (add)
+              out[stride_out * n_half_columns] += r0 + r1;
+            else
+              out[stride_out * n_half_columns] = r0 + r1;
+          }
+      }
+    else
+      {
+        // integration from the columns (points) to the rows (test
+        // functions): combine the input of symmetric pairs of points, and
+        // keep the input of the other points unchanged
+        AssertThrow(n_half_columns <= array_length,
+                    ExcMessage("The partial even-odd kernel supports at most " +
+                               std::to_string(2 * array_length + 1) +
+                               " columns, but " + std::to_string(n_columns) +
+                               " were requested."));
+        std::array<Number, array_length> xp, xm;
+        for (int col = 0; col < n_half_columns; ++col)
+          {
+            const Number in0 = in[stride_in * col];
+            const Number in1 = in[stride_in * (n_columns - 1 - col)];
+            if (symmetric_pairs[col])
+              {
+                xp[col] = skew ? in0 - in1 : in0 + in1;
+                xm[col] = skew ? in0 + in1 : in0 - in1;
+              }
+            else
+              {
+                xp[col] = in0;
+                xm[col] = in1;
+              }
+          }
+        const Number xmid =
+          (n_columns % 2 == 1) ? in[stride_in * n_half_columns] : Number();
+
+        const auto apply_row = [&](const int row) {
+          const Number2 *matrix_row = matrix + row * n_columns;
+          Number         r          = (n_columns % 2 == 1) ?
+                                        matrix_row[n_half_columns] * xmid :
+                                        Number();
+          for (int col = 0; col < n_half_columns; ++col)
+            if (symmetric_pairs[col])
+              r += matrix_row[col] *
+                   (row < n_rows - n_half_rows ? xp[col] : xm[col]);
+            else
+              r += matrix_row[col] * xp[col] +
+                   matrix_row[n_columns - 1 - col] * xm[col];
+          return r;
+        };
+
+        for (int row = 0; row < n_half_rows; ++row)
+          {
+            const Number r0 = apply_row(row);
+            const Number r1 = apply_row(n_rows - 1 - row);
+            if (add)
+              {
+                out[stride_out * row] += r0 + r1;
+                out[stride_out * (n_rows - 1 - row)] += r0 - r1;
+              }
+            else
+              {
+                out[stride_out * row]                = r0 + r1;
+                out[stride_out * (n_rows - 1 - row)] = r0 - r1;
+              }
+          }
+        if (n_rows % 2 == 1)
+          {
+            // the middle row is symmetric for values and Hessians and
+            // skew-symmetric for gradients, which is exactly the combination
+            // stored in xp for symmetric pairs
+            const Number r0 = apply_row(n_half_rows);
+            if (add)
+              out[stride_out * n_half_rows] += r0;
+            else
+              out[stride_out * n_half_rows] = r0;
+          }
+      }
+  }
+
+
+
   /**
    * Internal evaluator specialized for "symmetric" finite elements in the
    * symmetric_hierarchical matrix format.
@@ -1856,6 +2083,210 @@ namespace internal
 
 
 
+  /**
+   * Evaluator for tensor products with the partial even-odd decomposition
+   * of the variant evaluate_evenodd_partial. This is the evaluator selected
+   * for MatrixFreeFunctions::tensor_partially_symmetric, i.e., when the 1d
+   * quadrature formula is not symmetric about the center of the unit
+   * interval but some of its points come in mirrored pairs.
+   *
+   * In contrast to EvaluatorTensorProduct, which only holds pointers to the
+   * matrices of shape values, gradients and Hessians, this class also needs
+   * to know which pairs of quadrature points are symmetric, see the
+   * documentation of the respective apply_matrix_vector_product() function.
+   * The matrices are expected in the format of the fields
+   * `shape_values_eo_partial`, `shape_gradients_eo_partial` and
+   * `shape_hessians_eo_partial` of MatrixFreeFunctions::UnivariateShapeData,
+   * with `n_rows * n_columns` entries each.
+   *
+   * If the template arguments @p n_rows and @p n_columns are zero, the sizes
+   * are instead taken from the arguments passed to the constructor.
+   */
+  template <int dim,
+            int n_rows_static,
+            int n_columns_static,
+            typename Number,
+            typename Number2 = Number>
+  struct EvaluatorTensorProductPartialEvenOdd
+  {
+    static constexpr unsigned int n_rows_of_product =
+      n_rows_static == 0 ? numbers::invalid_unsigned_int :
+                           Utilities::pow(n_rows_static, dim);
+    static constexpr unsigned int n_columns_of_product =
+      n_rows_static == 0 ? numbers::invalid_unsigned_int :
+                           Utilities::pow(n_columns_static, dim);
+
+    /**
+     * Constructor, taking the data from ShapeInfo
+     */
+    EvaluatorTensorProductPartialEvenOdd(
+      const AlignedVector<Number2>     &shape_values,
+      const AlignedVector<Number2>     &shape_gradients,
+      const AlignedVector<Number2>     &shape_hessians,
+      const std::vector<unsigned char> &symmetric_pairs,
+      const unsigned int                n_rows    = n_rows_static,
+      const unsigned int                n_columns = n_columns_static)
+      : shape_values(shape_values.begin())
+      , shape_gradients(shape_gradients.begin())
+      , shape_hessians(shape_hessians.begin())
+      , symmetric_pairs(symmetric_pairs.data())
+      , n_rows(n_rows_static == 0 ? n_rows : n_rows_static)
+      , n_columns(n_rows_static == 0 ? n_columns : n_columns_static)
+    {
+      AssertDimension(symmetric_pairs.size(), this->n_columns / 2);
+      Assert(shape_values.empty() ||
+               shape_values.size() == this->n_rows * this->n_columns,
+             ExcDimensionMismatch(shape_values.size(),
+                                  this->n_rows * this->n_columns));
+      Assert(shape_gradients.empty() ||
+               shape_gradients.size() == this->n_rows * this->n_columns,
+             ExcDimensionMismatch(shape_gradients.size(),
+                                  this->n_rows * this->n_columns));
+      Assert(shape_hessians.empty() ||
+               shape_hessians.size() == this->n_rows * this->n_columns,
+             ExcDimensionMismatch(shape_hessians.size(),
+                                  this->n_rows * this->n_columns));
+    }
+
+    /**
+     * Interpolate values with sum factorization. For the documentation of
+     * the template and function parameters, see
+     * EvaluatorTensorProduct::values().
+     */
+    template <int direction, bool contract_over_rows, bool add, int stride = 1>
+    void
+    values(const Number in[], Number out[]) const
+    {
+      apply<direction,
+            contract_over_rows,
+            add,
+            EvaluatorQuantity::value,
+            stride>(shape_values, in, out);
+    }
+
+    /**
+     * Interpolate gradients with sum factorization. For the documentation of
+     * the template and function parameters, see
+     * EvaluatorTensorProduct::values().
+     */
+    template <int direction, bool contract_over_rows, bool add, int stride = 1>
+    void
+    gradients(const Number in[], Number out[]) const
+    {
+      apply<direction,
+            contract_over_rows,
+            add,
+            EvaluatorQuantity::gradient,
+            stride>(shape_gradients, in, out);
+    }
+
+    /**
+     * Interpolate Hessians with sum factorization. For the documentation of
+     * the template and function parameters, see
+     * EvaluatorTensorProduct::values().
+     */
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    hessians(const Number in[], Number out[]) const
+    {
+      apply<direction, contract_over_rows, add, EvaluatorQuantity::hessian>(
+        shape_hessians, in, out);
+    }
+
+  private:
+    template <int               direction,
+              bool              contract_over_rows,
+              bool              add,
+              EvaluatorQuantity quantity,
+              int               stride = 1>
+    void
+    apply(const Number2 *DEAL_II_RESTRICT shape_data,
+          const Number                   *in,
+          Number                         *out) const;
+
+    const Number2       *shape_values;
+    const Number2       *shape_gradients;
+    const Number2       *shape_hessians;
+    const unsigned char *symmetric_pairs;
+    const unsigned int   n_rows;
+    const unsigned int   n_columns;
+  };
+
+
+
+  template <int dim,
+            int n_rows_static,
+            int n_columns_static,
+            typename Number,
+            typename Number2>
+  template <int               direction,
+            bool              contract_over_rows,
+            bool              add,
+            EvaluatorQuantity quantity,
+            int               stride>
+  inline void
+  EvaluatorTensorProductPartialEvenOdd<dim,
+                                       n_rows_static,
+                                       n_columns_static,
+                                       Number,
+                                       Number2>::
+    apply(const Number2 *DEAL_II_RESTRICT shape_data,
+          const Number                   *in,
+          Number                         *out) const
+  {
+    Assert(shape_data != nullptr,
+           ExcMessage(
+             "The given array shape_data must not be the null pointer!"));
+    AssertIndexRange(direction, dim);
+
+    // use the compile-time sizes if available to let the compiler unroll
+    // the loops
+    const int rows    = n_rows_static == 0 ? n_rows : n_rows_static;
+    const int columns = n_rows_static == 0 ? n_columns : n_columns_static;
+    const int mm      = contract_over_rows ? rows : columns,
+              nn      = contract_over_rows ? columns : rows;
+
+    const int stride_operation =
+      direction == 0 ? 1 : Utilities::fixed_power<direction>(columns);
+    const int n_blocks1 = stride_operation;
+    const int n_blocks2 = direction >= dim - 1 ?
+                            1 :
+                            Utilities::fixed_power<dim - direction - 1>(rows);
+
+    constexpr int stride_in  = !contract_over_rows ? stride : 1;
+    constexpr int stride_out = contract_over_rows ? stride : 1;
+    constexpr int stride_operation_static =
+      n_rows_static == 0 ? 0 : Utilities::pow(n_columns_static, direction);
+    for (int i2 = 0; i2 < n_blocks2; ++i2)
+      {
+        for (int i1 = 0; i1 < n_blocks1; ++i1)
+          {
+            apply_matrix_vector_product<evaluate_evenodd_partial,
+                                        quantity,
+                                        n_rows_static,
+                                        n_columns_static,
+                                        stride_operation_static * stride_in,
+                                        stride_operation_static * stride_out,
+                                        contract_over_rows,
+                                        add>(shape_data,
+                                             symmetric_pairs,
+                                             in,
+                                             out,
+                                             rows,
+                                             columns,
+                                             stride_operation * stride_in,
+                                             stride_operation * stride_out);
+
+            in += stride_in;
+            out += stride_out;
+          }
+        in += stride_operation * (mm - 1) * stride_in;
+        out += stride_operation * (nn - 1) * stride_out;
+      }
+  }
+
+
+
   template <int  dim,
             int  fe_degree,
             int  n_q_points_1d,
@@ -608,6 +608,31 @@ MGLevelGlobalTransfer<LinearAlgebra::distributed::Vector<Number>>::
     const MGLevelObject<LinearAlgebra::distributed::Vector<Number>> &src) const
 {
   assert_built(dof_handler);
+  if (perform_plain_copy)
+    {
+      // In this case, we can simply add the local range. The conversion
+      // between the number type of the level vectors and the one of the
+      // global vector is done while adding, without a temporary vector.
+      dst.zero_out_ghost_values();
+      AssertDimension(src[src.max_level()].locally_owned_size(),
+                      dst.locally_owned_size());
+      dst.add_locally_owned_data_from(Number2(1.), src[src.max_level()]);
+      return;
+    }
+  else if (perform_renumbered_plain_copy)
+    {
+      AssertDimension(src[src.max_level()].locally_owned_size(),
+                      dst.locally_owned_size());
+      AssertDimension(copy_indices.back().n_cols(), dst.locally_owned_size());
+      const LinearAlgebra::distributed::Vector<Number> &src_level =
+        src[src.max_level()];
+      dst.zero_out_ghost_values();
+      for (unsigned int i = 0; i < copy_indices.back().n_cols(); ++i)
+        dst.local_element(i) +=
+          src_level.local_element(copy_indices.back()(1, i));
+      return;
+    }
+
   // For non-DG: degrees of freedom in the refinement face may need special
   // attention, since they belong to the coarse level, but have fine level
   // basis functions
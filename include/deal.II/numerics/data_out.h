@@ -23,6 +23,8 @@
 
 #include <deal.II/numerics/data_out_dof_data.h>
 
+#include <boost/signals2/connection.hpp>
+
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -415,6 +417,70 @@ public:
   std::pair<FirstCellFunctionType, NextCellFunctionType>
   get_cell_selection() const;
 
+  /**
+   * Enable or disable caching of the geometric part of the patches between
+   * calls to build_patches(). If enabled, and if the triangulation has not
+   * signaled any change since the previous call to build_patches() (and the
+   * mapping object, the number of subdivisions, the region of curved cells,
+   * and the cell selection are the same), then build_patches() keeps the
+   * list of cells, the vertices, and the locations of the points of curved
+   * cells from the previous call and only recomputes the data on the
+   * patches. In that case, patch_geometry_unchanged() returns <tt>true</tt>
+   * and patch_geometry_revision() returns the same number as before, which
+   * writers such as DataOutInterface::write_vtkhdf_parallel() use to only
+   * write the data, but not the mesh, of a time step if
+   * DataOutBase::VtkHdfFlags::reuse_unchanged_mesh is set.
+   *
+   * This is useful for time dependent problems on a fixed mesh, where the
+   * output of every time step would otherwise recompute and rewrite the same
+   * geometry:
+   * @code
+   *   DataOut<dim> data_out;
+   *   data_out.attach_dof_handler(dof_handler);
+   *   data_out.set_patch_geometry_caching(true);
+   *   DataOutBase::VtkHdfFlags flags;
+   *   flags.reuse_unchanged_mesh = true;
+   *   for (...) // time steps
+   *     {
+   *       data_out.clear_data_vectors();
+   *       data_out.add_data_vector(solution, "solution");
+   *       data_out.build_patches(mapping, 2);
+   *       flags.time             = time;
+   *       flags.append_time_step = (timestep_number > 0);
+   *       data_out.set_flags(flags);
+   *       data_out.write_vtkhdf_parallel("solution.vtkhdf", MPI_COMM_WORLD);
+   *     }
+   * @endcode
+   *
+   * @note Changes of the geometry that the triangulation does not know about
+   *   can not be detected. This is in particular the case for mappings that
+   *   move the mesh, such as MappingQEulerian or MappingFEField, when the
+   *   vector describing the displacement changes. In such cases, call this
+   *   function again, which always discards the cached geometry, or do not
+   *   enable the cache in the first place. The cache is disabled by default.
+   *   Mappings are recognized by the address of the object passed to
+   *   build_patches(), so a mapping object that is destroyed and replaced
+   *   by a different one at the same address is also not detected.
+   */
+  void
+  set_patch_geometry_caching(const bool cache_patch_geometry);
+
+  /**
+   * Return whether the last call to build_patches() reused the geometry of
+   * the patches built by the call before it, see
+   * set_patch_geometry_caching().
+   */
+  virtual bool
+  patch_geometry_unchanged() const override;
+
+  /**
+   * Return the number of times build_patches() has computed the geometry of
+   * the patches anew, rather than reusing it from its previous call, see
+   * set_patch_geometry_caching().
+   */
+  virtual unsigned int
+  patch_geometry_revision() const override;
+
 private:
   /**
    * A function object that is used to select what the first cell is going to
@@ -433,6 +499,94 @@ private:
                               const cell_iterator &)>
     next_cell_function;
 
+  /**
+   * Whether build_patches() may reuse the geometry of the patches built by
+   * its previous call. See set_patch_geometry_caching().
+   */
+  bool cache_patch_geometry;
+
+  /**
+   * Whether the last call to build_patches() did in fact reuse the geometry
+   * of the patches.
+   */
+  bool patch_geometry_reused;
+
+  /**
+   * The number of calls to build_patches() that did not reuse the geometry
+   * of the patches.
+   */
+  unsigned int n_patch_geometry_changes;
+
+  /**
+   * The information build_patches() needs to decide whether the geometry of
+   * the current patches can be reused, together with the list of cells for
+   * which the patches were built.
+   */
+  struct PatchGeometryCache
+  {
+    /**
+     * The triangulation, number of subdivisions, and region of curved cells
+     * for which the patches were built. A null pointer indicates that there
+     * is nothing to reuse.
+     */
+    const Triangulation<dim, spacedim> *triangulation = nullptr;
+    unsigned int                        n_subdivisions     = 0;
+    CurvedCellRegion                    curved_cell_region = no_curved_cells;
+
+    /**
+     * The mappings the patches were built with. Each one is identified by
+     * the address of the mapping object given to build_patches() and, for
+     * MappingQ and derived classes, its polynomial degree (or
+     * numbers::invalid_unsigned_int for other mappings).
+     */
+    std::vector<std::pair<const Mapping<dim, spacedim> *, unsigned int>>
+      mappings;
+
+    /**
+     * A flag that is set by the triangulation's `any_change` signal. It is
+     * stored in a shared pointer so that copies of the DataOut object see
+     * the same flag as the connection to the signal.
+     */
+    std::shared_ptr<bool> triangulation_changed;
+
+    /**
+     * The connection to the triangulation's `any_change` signal, which is
+     * released when the last copy of this object goes away.
+     */
+    std::shared_ptr<boost::signals2::scoped_connection> tria_listener;
+
+    /**
+     * The cells for which patches were built, together with their active
+     * cell indices, and the map from cells to patch indices, see
+     * build_patches().
+     */
+    std::vector<std::pair<cell_iterator, unsigned int>> cells;
+    std::vector<std::vector<unsigned int>>              cell_to_patch_index_map;
+
+    /**
+     * The geometric part of the patches built: The vertices, patch index,
+     * number of subdivisions, reference cell, and `points_are_available` flag
+     * of each patch, where the `data` member only contains the coordinates
+     * of the points of the patch if `points_are_available` is set, and is
+     * empty otherwise. These are kept separately from the patches themselves
+     * since those are deleted whenever the data vectors are cleared.
+     */
+    std::vector<DataOutBase::Patch<dim, spacedim>> patches;
+  } patch_geometry_cache;
+
+  /**
+   * Implementation of the build_patches() functions. The addresses in
+   * @p mappings are those of the mapping objects given by the caller, which
+   * identify the mappings in the cache of the patch geometry, since the
+   * copies stored in @p mapping_collection change from call to call.
+   */
+  void
+  build_patches_for_mappings(
+    const hp::MappingCollection<dim, spacedim>        &mapping_collection,
+    const unsigned int                                 n_subdivisions,
+    const CurvedCellRegion                             curved_region,
+    const std::vector<const Mapping<dim, spacedim> *> &mappings);
+
   /**
    * Build one patch. This function is called in a WorkStream context.
    *
@@ -447,7 +601,8 @@ private:
     const std::pair<cell_iterator, unsigned int> *cell_and_index,
     internal::DataOutImplementation::ParallelData<dim, spacedim> &scratch_data,
     const unsigned int     n_subdivisions,
-    const CurvedCellRegion curved_cell_region);
+    const CurvedCellRegion curved_cell_region,
+    const bool             reuse_geometry);
 };
 
 
@@ -1524,11 +1524,11 @@ namespace VectorTools
                   normal[d]         = 1.;
                 }
             AssertIndexRange(constrained_index, dim);
-            const std::vector<std::pair<types::global_dof_index, double>>
-              *constrained = no_normal_flux_constraints.get_constraint_entries(
+            const auto constrained =
+              no_normal_flux_constraints.get_constraint_entries(
                 dofs[constrained_index]);
             // find components to which this index is constrained to
-            Assert(constrained != nullptr, ExcInternalError());
+            Assert(constrained.has_value(), ExcInternalError());
             Assert(constrained->size() < dim, ExcInternalError());
             for (const auto &entry : *constrained)
               {
@@ -17,6 +17,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi_large_count.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -126,9 +127,24 @@ namespace
 #  endif
 #endif
 
+  /**
+   * The size, in bytes, of the blocks into which compress_array() splits the
+   * data it is given. The VTK file format allows to store a data array as a
+   * sequence of independently compressed blocks, which we use to compress
+   * (and encode) large arrays in parallel.
+   */
+  constexpr std::size_t vtu_compression_block_size = std::size_t(1) << 20;
+
+
+
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
    * result is then returned as a string object.
+   *
+   * The data is split into blocks of size vtu_compression_block_size that are
+   * compressed concurrently, and the base64 encoding of the result is also
+   * computed in parallel. Arrays that fit into a single block are stored
+   * exactly as if they had been compressed in one piece.
    */
   template <typename T>
   std::string
@@ -139,50 +155,112 @@ namespace
     if (data.size() != 0)
       {
         const std::size_t uncompressed_size = (data.size() * sizeof(T));
-
-        // While zlib's compress2 uses unsigned long (which is 64bits
-        // on Linux), the vtu compression header stores the block size
-        // as an std::uint32_t (see below). While we could implement
-        // writing several smaller blocks, we haven't done that. Let's
-        // trigger an error for the user instead:
-        AssertThrow(uncompressed_size <=
-                      std::numeric_limits<std::uint32_t>::max(),
+        const std::size_t n_blocks =
+          (uncompressed_size + vtu_compression_block_size - 1) /
+          vtu_compression_block_size;
+        const std::size_t last_block_size =
+          uncompressed_size - (n_blocks - 1) * vtu_compression_block_size;
+
+        // The vtu compression header stores all sizes as std::uint32_t (see
+        // below), which is large enough for the size of each block, but
+        // limits the number of blocks.
+        AssertThrow(n_blocks <= std::numeric_limits<std::uint32_t>::max(),
                     ExcNotImplemented());
 
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(uncompressed_size);
-        AssertThrow(compressed_data_length <=
-                      std::numeric_limits<std::uint32_t>::max(),
-                    ExcNotImplemented());
-
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err = compress2(&compressed_data[0],
-                            &compressed_data_length,
-                            reinterpret_cast<const Bytef *>(data.data()),
-                            uncompressed_size,
-                            get_zlib_compression_level(compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
-
-        // now encode the compression header
-        const std::uint32_t compression_header[4] = {
-          1,                                             /* number of blocks */
-          static_cast<std::uint32_t>(uncompressed_size), /* size of block */
-          static_cast<std::uint32_t>(
-            uncompressed_size), /* size of last block */
-          static_cast<std::uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        // Compress all blocks, each into its own buffer
+        const unsigned char *const uncompressed_data =
+          reinterpret_cast<const unsigned char *>(data.data());
+        std::vector<std::vector<unsigned char>> compressed_blocks(n_blocks);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t block = begin; block < end; ++block)
+              {
+                const std::size_t block_size =
+                  (block == n_blocks - 1 ? last_block_size :
+                                           vtu_compression_block_size);
+                auto compressed_block_length = compressBound(block_size);
+                compressed_blocks[block].resize(compressed_block_length);
+
+                int err = compress2(
+                  compressed_blocks[block].data(),
+                  &compressed_block_length,
+                  uncompressed_data + block * vtu_compression_block_size,
+                  block_size,
+                  get_zlib_compression_level(compression_level));
+                (void)err;
+                Assert(err == Z_OK, ExcInternalError());
+
+                // Discard the unnecessary bytes
+                compressed_blocks[block].resize(compressed_block_length);
+              }
+          },
+          1);
+
+        // now encode the compression header, which consists of the number
+        // of blocks, the (uncompressed) size of each block and of the last
+        // block, followed by the list of compressed sizes of all blocks
+        std::vector<std::uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = static_cast<std::uint32_t>(n_blocks);
+        compression_header[1] = static_cast<std::uint32_t>(
+          std::min(uncompressed_size, vtu_compression_block_size));
+        compression_header[2] = static_cast<std::uint32_t>(last_block_size);
+        std::size_t compressed_data_length = 0;
+        for (std::size_t block = 0; block < n_blocks; ++block)
+          {
+            compression_header[3 + block] =
+              static_cast<std::uint32_t>(compressed_blocks[block].size());
+            compressed_data_length += compressed_blocks[block].size();
+          }
 
         const auto *const header_start =
-          reinterpret_cast<const unsigned char *>(&compression_header[0]);
+          reinterpret_cast<const unsigned char *>(compression_header.data());
+        std::string result = Utilities::encode_base64(
+          {header_start,
+           header_start + compression_header.size() * sizeof(std::uint32_t)});
+
+        // Concatenate the compressed blocks and encode them. Since base64
+        // encodes groups of three bytes into four characters, we can encode
+        // pieces whose size is a multiple of three independently, and only
+        // the last one gets padded.
+        std::vector<unsigned char> compressed_data;
+        compressed_data.reserve(compressed_data_length);
+        for (const auto &compressed_block : compressed_blocks)
+          compressed_data.insert(compressed_data.end(),
+                                 compressed_block.begin(),
+                                 compressed_block.end());
+        compressed_blocks.clear();
+
+        const std::size_t encoding_piece_size = 3 * (std::size_t(1) << 18);
+        const std::size_t n_encoding_pieces =
+          (compressed_data_length + encoding_piece_size - 1) /
+          encoding_piece_size;
+        const std::size_t header_length = result.size();
+        result.resize(header_length + 4 * ((compressed_data_length + 2) / 3));
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_encoding_pieces,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t piece = begin; piece < end; ++piece)
+              {
+                const auto piece_begin =
+                  compressed_data.begin() + piece * encoding_piece_size;
+                const auto piece_end =
+                  (piece == n_encoding_pieces - 1 ?
+                     compressed_data.end() :
+                     piece_begin + encoding_piece_size);
+                const std::string encoded_piece =
+                  Utilities::encode_base64({piece_begin, piece_end});
+                std::copy(encoded_piece.begin(),
+                          encoded_piece.end(),
+                          result.begin() + header_length +
+                            piece * (4 * encoding_piece_size / 3));
+              }
+          },
+          1);
 
-        return (Utilities::encode_base64(
-                  {header_start, header_start + 4 * sizeof(std::uint32_t)}) +
-                Utilities::encode_base64(compressed_data));
+        return result;
       }
     else
       return {};
@@ -2404,6 +2482,24 @@ namespace DataOutBase
   {}
 
 
+
+  VtkHdfFlags::VtkHdfFlags(const double           time,
+                           const bool             append_time_step,
+                           const CompressionLevel compression_level,
+                           const unsigned int     chunk_size,
+                           const bool             write_higher_order_cells,
+                           const bool             write_mesh,
+                           const bool             reuse_unchanged_mesh)
+    : time(time)
+    , append_time_step(append_time_step)
+    , compression_level(compression_level)
+    , chunk_size(chunk_size)
+    , write_higher_order_cells(write_higher_order_cells)
+    , write_mesh(write_mesh)
+    , reuse_unchanged_mesh(reuse_unchanged_mesh)
+  {}
+
+
   TecplotFlags::TecplotFlags(const char *zone_name, const double solution_time)
     : zone_name(zone_name)
     , solution_time(solution_time)
@@ -2474,6 +2570,9 @@ namespace DataOutBase
     if (format_name == "hdf5")
       return hdf5;
 
+    if (format_name == "vtkhdf")
+      return vtkhdf;
+
     AssertThrow(false,
                 ExcMessage("The given file format name is not recognized: <" +
                            format_name + ">"));
@@ -2487,7 +2586,7 @@ namespace DataOutBase
   std::string
   get_output_format_names()
   {
-    return "none|dx|ucd|gnuplot|povray|eps|gmv|tecplot|vtk|vtu|hdf5|svg|deal.II intermediate";
+    return "none|dx|ucd|gnuplot|povray|eps|gmv|tecplot|vtk|vtu|hdf5|vtkhdf|svg|deal.II intermediate";
   }
 
 
@@ -2521,6 +2620,8 @@ namespace DataOutBase
           return ".d2";
         case hdf5:
           return ".h5";
+        case vtkhdf:
+          return ".vtkhdf";
         case svg:
           return ".svg";
         default:
@@ -6040,11 +6141,16 @@ namespace DataOutBase
 
     // -----------------------------
     // Now finally get around to actually doing anything. Let's start with
-    // running the first three tasks generating the vertex and cell information:
-    Threads::TaskGroup<std::string> mesh_tasks;
-    mesh_tasks += Threads::new_task(stringize_vertex_information);
-    mesh_tasks += Threads::new_task(stringize_cell_to_vertex_information);
-    mesh_tasks += Threads::new_task(stringize_cell_offset_and_type_information);
+    // running the first three tasks generating the vertex and cell information.
+    // We keep the tasks in the order in which their results have to appear
+    // in the file so that we can write each result as soon as it is available
+    // (see below):
+    std::vector<Threads::Task<std::string>> mesh_tasks;
+    mesh_tasks.emplace_back(Threads::new_task(stringize_vertex_information));
+    mesh_tasks.emplace_back(
+      Threads::new_task(stringize_cell_to_vertex_information));
+    mesh_tasks.emplace_back(
+      Threads::new_task(stringize_cell_offset_and_type_information));
 
     // For what follows, we have to have the reordered data available. So wait
     // for that task to conclude and get the resulting data table:
@@ -6053,7 +6159,7 @@ namespace DataOutBase
 
     // Then create the strings for the actual values of the solution vectors,
     // again on separate tasks:
-    Threads::TaskGroup<std::string> data_tasks;
+    std::vector<Threads::Task<std::string>> data_tasks;
     // When writing, first write out all vector and tensor data
     std::vector<bool> data_set_handled(n_data_sets, false);
     for (const auto &range : nonscalar_data_ranges)
@@ -6064,29 +6170,40 @@ namespace DataOutBase
         for (unsigned int i = first_component; i <= last_component; ++i)
           data_set_handled[i] = true;
 
-        data_tasks += Threads::new_task([&, range]() {
+        data_tasks.emplace_back(Threads::new_task([&, range]() {
           return stringize_nonscalar_data_range(data_vectors, range);
-        });
+        }));
       }
 
     // Now do the left over scalar data sets
     for (unsigned int data_set = 0; data_set < n_data_sets; ++data_set)
       if (data_set_handled[data_set] == false)
         {
-          data_tasks += Threads::new_task([&, data_set]() {
+          data_tasks.emplace_back(Threads::new_task([&, data_set]() {
             return stringize_scalar_data_set(data_vectors, data_set);
-          });
+          }));
         }
 
-    // Alright, all tasks are now running. Wait for their conclusion and output
-    // all of the data they have produced:
+    // Alright, all tasks are now running. Output the data they produce in
+    // order, waiting for each task only once we need its result. This way,
+    // writing the first pieces to the stream overlaps with the encoding and
+    // compression of the later ones. Release the memory of each piece once
+    // it has been written.
     out << "<Piece NumberOfPoints=\"" << n_nodes << "\" NumberOfCells=\""
         << n_cells << "\" >\n";
-    for (const auto &s : mesh_tasks.return_values())
-      out << s;
+    for (auto &task : mesh_tasks)
+      {
+        out << task.return_value();
+        task.return_value().clear();
+        task.return_value().shrink_to_fit();
+      }
     out << "  <PointData Scalars=\"scalars\">\n";
-    for (const auto &s : data_tasks.return_values())
-      out << s;
+    for (auto &task : data_tasks)
+      {
+        out << task.return_value();
+        task.return_value().clear();
+        task.return_value().shrink_to_fit();
+      }
     out << "  </PointData>\n";
     out << " </Piece>\n";
 
@@ -8523,6 +8640,899 @@ namespace
     status = H5Fclose(h5_solution_file_id);
     AssertThrow(status >= 0, ExcIO());
   }
+
+
+
+  /**
+   * Return the property list with which all datasets of a VTKHDF file are
+   * created: Datasets need to be chunked so that they can grow when time
+   * steps are appended, and are compressed chunk by chunk if so requested.
+   */
+  hid_t
+  create_vtkhdf_dataset_properties(const unsigned int              rank,
+                                   const hsize_t                   n_columns,
+                                   const DataOutBase::VtkHdfFlags &flags)
+  {
+    const hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+    AssertThrow(properties >= 0, ExcIO());
+
+    const hsize_t chunk_dims[2] = {std::max<hsize_t>(flags.chunk_size, 1),
+                                   n_columns};
+    herr_t        status        = H5Pset_chunk(properties, rank, chunk_dims);
+    AssertThrow(status >= 0, ExcIO());
+
+#  ifdef DEAL_II_WITH_ZLIB
+    if (flags.compression_level !=
+          DataOutBase::CompressionLevel::no_compression &&
+        flags.compression_level != DataOutBase::CompressionLevel::plain_text)
+      {
+        // H5Pset_deflate() only accepts levels between 0 and 9, which
+        // excludes zlib's constant for the default level
+        const int level = get_zlib_compression_level(flags.compression_level);
+        status          = H5Pset_deflate(properties, level < 0 ? 6 : level);
+        AssertThrow(status >= 0, ExcIO());
+      }
+#  endif
+
+    return properties;
+  }
+
+
+
+  /**
+   * Open the dataset @p name below @p location, or create it as an empty
+   * dataset of the given @p rank that can grow without limit in its first
+   * dimension if @p create is set.
+   */
+  hid_t
+  open_vtkhdf_dataset(const hid_t                     location,
+                      const std::string              &name,
+                      const hid_t                     type,
+                      const unsigned int              rank,
+                      const hsize_t                   n_columns,
+                      const DataOutBase::VtkHdfFlags &flags,
+                      const bool                      create)
+  {
+    hid_t dataset;
+    if (create)
+      {
+        const hsize_t dims[2]     = {0, n_columns};
+        const hsize_t max_dims[2] = {H5S_UNLIMITED, n_columns};
+        const hid_t   dataspace   = H5Screate_simple(rank, dims, max_dims);
+        AssertThrow(dataspace >= 0, ExcIO());
+
+        const hid_t properties =
+          create_vtkhdf_dataset_properties(rank, n_columns, flags);
+        dataset = H5Dcreate2(location,
+                             name.c_str(),
+                             type,
+                             dataspace,
+                             H5P_DEFAULT,
+                             properties,
+                             H5P_DEFAULT);
+
+        herr_t status = H5Pclose(properties);
+        AssertThrow(status >= 0, ExcIO());
+        status = H5Sclose(dataspace);
+        AssertThrow(status >= 0, ExcIO());
+      }
+    else
+      {
+        AssertThrow(H5Lexists(location, name.c_str(), H5P_DEFAULT) > 0,
+                    ExcMessage("The VTKHDF file to which a time step is to be "
+                               "appended does not contain the dataset <" +
+                               name +
+                               ">. All time steps need to provide the same "
+                               "data sets."));
+        dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+      }
+    AssertThrow(dataset >= 0, ExcIO());
+
+    return dataset;
+  }
+
+
+
+  /**
+   * Collectively append @p n_global_rows rows to the given extendible
+   * dataset, of which the calling process writes the @p n_local_rows rows
+   * stored in @p data starting at row @p local_offset of the new block. Return
+   * the number of rows the dataset had before.
+   */
+  template <typename T>
+  std::uint64_t
+  append_to_vtkhdf_dataset(const hid_t         dataset,
+                           const hid_t         type,
+                           const hid_t         transfer_properties,
+                           const T            *data,
+                           const std::uint64_t n_local_rows,
+                           const std::uint64_t local_offset,
+                           const std::uint64_t n_global_rows)
+  {
+    hid_t file_dataspace = H5Dget_space(dataset);
+    AssertThrow(file_dataspace >= 0, ExcIO());
+    hsize_t   dims[2] = {0, 1};
+    const int rank = H5Sget_simple_extent_dims(file_dataspace, dims, nullptr);
+    AssertThrow(rank == 1 || rank == 2, ExcIO());
+    herr_t status = H5Sclose(file_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+
+    const std::uint64_t n_old_rows = dims[0];
+    dims[0] += n_global_rows;
+    status = H5Dset_extent(dataset, dims);
+    AssertThrow(status >= 0, ExcIO());
+
+    file_dataspace = H5Dget_space(dataset);
+    AssertThrow(file_dataspace >= 0, ExcIO());
+
+    const hsize_t offset[2] = {n_old_rows + local_offset, 0};
+    const hsize_t count[2]  = {n_local_rows, dims[1]};
+    const hid_t   memory_dataspace = H5Screate_simple(rank, count, nullptr);
+    AssertThrow(memory_dataspace >= 0, ExcIO());
+
+    // Processes without any rows still need to take part in the collective
+    // write, with empty selections.
+    if (n_local_rows > 0)
+      status = H5Sselect_hyperslab(
+        file_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+    else
+      {
+        status = H5Sselect_none(file_dataspace);
+        AssertThrow(status >= 0, ExcIO());
+        status = H5Sselect_none(memory_dataspace);
+      }
+    AssertThrow(status >= 0, ExcIO());
+
+    const T dummy = {};
+    status        = H5Dwrite(dataset,
+                      type,
+                      memory_dataspace,
+                      file_dataspace,
+                      transfer_properties,
+                      n_local_rows > 0 ? data : &dummy);
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Sclose(memory_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(file_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+
+    return n_old_rows;
+  }
+
+
+
+  /**
+   * Read the entry in row @p row of the given one-column integer dataset of
+   * a VTKHDF file. Only this entry is read from the file, independently of
+   * the other processes.
+   */
+  std::int64_t
+  read_vtkhdf_dataset(const hid_t         location,
+                      const std::string  &name,
+                      const std::uint64_t row)
+  {
+    const hid_t dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+    AssertThrow(dataset >= 0, ExcIO());
+    const hid_t file_dataspace = H5Dget_space(dataset);
+    AssertThrow(file_dataspace >= 0, ExcIO());
+    hsize_t   dims[2] = {0, 1};
+    const int rank = H5Sget_simple_extent_dims(file_dataspace, dims, nullptr);
+    AssertThrow((rank == 1 || rank == 2) && dims[1] == 1, ExcIO());
+    AssertThrow(row < dims[0],
+                ExcMessage("The dataset <" + name +
+                           "> of the VTKHDF file is shorter than expected."));
+
+    const hsize_t offset[2] = {row, 0};
+    const hsize_t count[2]  = {1, 1};
+    herr_t        status    = H5Sselect_hyperslab(
+      file_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+    AssertThrow(status >= 0, ExcIO());
+    const hid_t memory_dataspace = H5Screate_simple(rank, count, nullptr);
+    AssertThrow(memory_dataspace >= 0, ExcIO());
+
+    std::int64_t entry = 0;
+    status             = H5Dread(dataset,
+                     H5T_NATIVE_INT64,
+                     memory_dataspace,
+                     file_dataspace,
+                     H5P_DEFAULT,
+                     &entry);
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Sclose(memory_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(file_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Dclose(dataset);
+    AssertThrow(status >= 0, ExcIO());
+
+    return entry;
+  }
+
+
+
+  /**
+   * Helper function to actually perform the VTKHDF output. The layout of the
+   * file follows the description of the VTKHDF format ("UnstructuredGrid"
+   * with temporal data, version 2.0) in the VTK documentation: Each process
+   * contributes one part per time step, the mesh and point data of all time
+   * steps are concatenated in the datasets below the root group "VTKHDF",
+   * and the group "VTKHDF/Steps" records where each time step starts.
+   *
+   * If @p write_mesh is <tt>false</tt> and the file already exists, the new
+   * time step refers to the mesh of time step @p mesh_time_step of the file,
+   * or of the last time step if @p mesh_time_step equals
+   * numbers::invalid_unsigned_int. Return the index of the time step whose
+   * mesh the new time step uses.
+   */
+  template <int dim, int spacedim>
+  unsigned int
+  do_write_vtkhdf(
+    const std::vector<DataOutBase::Patch<dim, spacedim>> &patches,
+    const std::vector<std::string>                       &data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+                                   &nonscalar_data_ranges,
+    const DataOutBase::VtkHdfFlags &flags,
+    const bool                      write_mesh_if_appending,
+    const unsigned int              mesh_time_step,
+    const std::string              &filename,
+    const MPI_Comm                  comm)
+  {
+    const unsigned int myrank  = Utilities::MPI::this_mpi_process(comm);
+    const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
+
+    // If HDF5 is not parallel and we're using multiple processes, abort:
+#  ifndef H5_HAVE_PARALLEL
+    AssertThrow(
+      n_ranks <= 1,
+      ExcMessage(
+        "Serial HDF5 output on multiple processes is not yet supported."));
+#  endif
+
+    // As in write_hdf5_parallel(), processes without patches are legit if we
+    // run with more than one MPI rank. Unlike there, they still take part in
+    // the collective writes and simply contribute an empty part, so that
+    // the number of parts per time step always equals the number of
+    // processes.
+    Assert((patches.size() > 0) || (n_ranks > 1),
+           DataOutBase::ExcNoPatches());
+
+    // Only append to files that exist, and make sure all processes agree on
+    // that. A new file always gets the mesh.
+    bool create_file = true;
+    if (flags.append_time_step)
+      {
+        if (myrank == 0)
+          create_file = !std::ifstream(filename).good();
+        create_file = Utilities::MPI::broadcast(comm, create_file);
+      }
+    const bool write_mesh = create_file || write_mesh_if_appending;
+
+    // Start the reordering of the data into one table per data set on a
+    // separate task, while we are working on the mesh.
+    Threads::Task<std::unique_ptr<Table<2, float>>>
+      create_global_data_table_task = Threads::new_task([&patches]() {
+        return DataOutBase::create_global_data_table<dim, spacedim, float>(
+          patches);
+      });
+
+    // The coordinates of all nodes. VTK always wants to see three
+    // coordinates, so pad with zeros as appropriate.
+    std::vector<double> points;
+    if (write_mesh)
+      {
+        const std::vector<Point<spacedim>> node_positions =
+          DataOutBase::get_node_positions(patches);
+        points.reserve(node_positions.size() * 3);
+        for (const auto &node_position : node_positions)
+          for (unsigned int d = 0; d < 3; ++d)
+            points.push_back(d < spacedim ? node_position[d] : 0.);
+      }
+    const std::uint64_t n_nodes =
+      (write_mesh ? points.size() / 3 :
+                    std::get<0>(count_nodes_and_cells(patches)));
+
+    // The cells, described by their types, the offsets of each cell into the
+    // connectivity array (starting with zero), and the connectivity array
+    // itself, which refers to the nodes of this process only.
+    std::vector<std::uint8_t> types;
+    std::vector<std::int64_t> offsets(1, 0);
+    std::vector<std::int64_t> connectivity;
+    if (write_mesh)
+      {
+        // VTK order of the vertices of a linear hypercube cell, given as
+        // lexicographic indices
+        static const std::array<unsigned int, 8> vtk_to_lexicographic = {
+          {0, 1, 3, 2, 4, 5, 7, 6}};
+
+        std::int64_t first_node_of_patch = 0;
+        for (const auto &patch : patches)
+          {
+            const std::array<unsigned int, 3> vtk_cell_id =
+              extract_vtk_patch_info(patch, flags.write_higher_order_cells);
+            for (unsigned int i = 0; i < vtk_cell_id[1]; ++i)
+              {
+                types.push_back(vtk_cell_id[0]);
+                offsets.push_back(offsets.back() + vtk_cell_id[2]);
+              }
+
+            const unsigned int n_subdivisions         = patch.n_subdivisions;
+            const unsigned int n_points_per_direction = n_subdivisions + 1;
+
+            // As in write_vtu(), triangles and tetrahedra with two subdivisions
+            // are written as single quadratic cells, and other non-hypercube
+            // cells can not be subdivided.
+            if ((dim >= 2) &&
+                (patch.reference_cell == ReferenceCells::get_simplex<dim>()) &&
+                (n_subdivisions == 2))
+              {
+                for (unsigned int i = 0; i < patch.data.n_cols(); ++i)
+                  connectivity.push_back(first_node_of_patch + i);
+                first_node_of_patch += patch.data.n_cols();
+              }
+            else if (patch.reference_cell !=
+                     ReferenceCells::get_hypercube<dim>())
+              {
+                Assert(n_subdivisions == 1, ExcNotImplemented());
+                for (unsigned int i = 0; i < patch.data.n_cols(); ++i)
+                  connectivity.push_back(
+                    first_node_of_patch +
+                    patch.reference_cell.vtk_vertex_to_deal_vertex(i));
+                first_node_of_patch += patch.data.n_cols();
+              }
+            else if (flags.write_higher_order_cells == false)
+              {
+                const unsigned int stride_y = n_points_per_direction;
+                const unsigned int stride_z =
+                  n_points_per_direction * n_points_per_direction;
+                for (unsigned int i3 = 0; i3 < (dim > 2 ? n_subdivisions : 1);
+                     ++i3)
+                  for (unsigned int i2 = 0; i2 < (dim > 1 ? n_subdivisions : 1);
+                       ++i2)
+                    for (unsigned int i1 = 0;
+                         i1 < (dim > 0 ? n_subdivisions : 1);
+                         ++i1)
+                      {
+                        const unsigned int starting_offset =
+                          i3 * stride_z + i2 * stride_y + i1;
+                        for (unsigned int v = 0;
+                             v < GeometryInfo<dim>::vertices_per_cell;
+                             ++v)
+                          {
+                            const unsigned int corner = vtk_to_lexicographic[v];
+                            connectivity.push_back(
+                              first_node_of_patch + starting_offset +
+                              (corner & 1) + ((corner >> 1) & 1) * stride_y +
+                              ((corner >> 2) & 1) * stride_z);
+                          }
+                      }
+                first_node_of_patch +=
+                  Utilities::fixed_power<dim>(n_points_per_direction);
+              }
+            else
+              {
+                std::vector<unsigned int> local_node_order(
+                  Utilities::fixed_power<dim>(n_points_per_direction));
+                for (unsigned int i3 = 0;
+                     i3 < (dim > 2 ? n_points_per_direction : 1);
+                     ++i3)
+                  for (unsigned int i2 = 0;
+                       i2 < (dim > 1 ? n_points_per_direction : 1);
+                       ++i2)
+                    for (unsigned int i1 = 0; i1 < n_points_per_direction; ++i1)
+                      {
+                        const unsigned int local_index =
+                          (i3 * n_points_per_direction + i2) *
+                            n_points_per_direction +
+                          i1;
+                        unsigned int connectivity_index = 0;
+                        if constexpr (dim == 1)
+                          connectivity_index =
+                            patch.reference_cell
+                              .template vtk_lexicographic_to_node_index<1>(
+                                {{i1}}, {{n_subdivisions}}, false);
+                        else if constexpr (dim == 2)
+                          connectivity_index =
+                            patch.reference_cell
+                              .template vtk_lexicographic_to_node_index<2>(
+                                {{i1, i2}},
+                                {{n_subdivisions, n_subdivisions}},
+                                false);
+                        else if constexpr (dim == 3)
+                          connectivity_index =
+                            patch.reference_cell
+                              .template vtk_lexicographic_to_node_index<3>(
+                                {{i1, i2, i3}},
+                                {{n_subdivisions,
+                                  n_subdivisions,
+                                  n_subdivisions}},
+                                false);
+                        else
+                          Assert(false,
+                                 ExcMessage(
+                                   "Point-like cells should not be possible "
+                                   "when writing higher-order cells."));
+                        local_node_order[connectivity_index] = local_index;
+                      }
+                for (const unsigned int node : local_node_order)
+                  connectivity.push_back(first_node_of_patch + node);
+                first_node_of_patch += local_node_order.size();
+              }
+          }
+        AssertDimension(static_cast<std::uint64_t>(first_node_of_patch),
+                        n_nodes);
+        AssertDimension(static_cast<std::uint64_t>(offsets.back()),
+                        connectivity.size());
+      }
+
+    // The point data. Vectors are padded to three components, tensors to
+    // nine, as VTK expects them.
+    const Table<2, float> data_vectors =
+      std::move(*create_global_data_table_task.return_value());
+    std::vector<std::tuple<std::string, unsigned int, std::vector<float>>>
+      point_data;
+    {
+      const unsigned int n_data_sets = data_names.size();
+      if (patches.size() > 0)
+        AssertDimension(n_data_sets, data_vectors.n_rows());
+
+      std::vector<bool> data_set_handled(n_data_sets, false);
+      for (const auto &range : nonscalar_data_ranges)
+        {
+          const unsigned int first_component = std::get<0>(range);
+          const unsigned int last_component  = std::get<1>(range);
+          const bool         is_tensor =
+            (std::get<3>(range) ==
+             DataComponentInterpretation::component_is_part_of_tensor);
+          const unsigned int n_components = (is_tensor ? 9 : 3);
+          AssertThrow(last_component >= first_component,
+                      ExcLowerRange(last_component, first_component));
+          AssertThrow(last_component < n_data_sets,
+                      ExcIndexRange(last_component, 0, n_data_sets));
+          const unsigned int size = last_component - first_component + 1;
+          AssertThrow((is_tensor && (size == 1 || size == 4 || size == 9)) ||
+                        (!is_tensor && size <= 3),
+                      ExcMessage("VTKHDF output supports vectors with up to "
+                                 "three components and tensors with up to "
+                                 "nine components."));
+
+          // concatenate all the component names with double underscores
+          // unless a vector name has been specified
+          std::string name = std::get<2>(range);
+          if (name.empty())
+            {
+              for (unsigned int i = first_component; i < last_component; ++i)
+                name += data_names[i] + "__";
+              name += data_names[last_component];
+            }
+
+          std::vector<float> data(n_nodes * n_components, 0.f);
+          for (std::uint64_t n = 0; n < n_nodes; ++n)
+            for (unsigned int c = 0; c < size; ++c)
+              {
+                // tensors are stored as 3x3 in row-major order
+                unsigned int position = c;
+                if (is_tensor && size == 4)
+                  {
+                    const auto ind =
+                      Tensor<2, 2>::unrolled_to_component_indices(c);
+                    position = 3 * ind[0] + ind[1];
+                  }
+                data[n * n_components + position] =
+                  data_vectors(first_component + c, n);
+              }
+          point_data.emplace_back(name, n_components, std::move(data));
+
+          for (unsigned int i = first_component; i <= last_component; ++i)
+            data_set_handled[i] = true;
+        }
+
+      for (unsigned int data_set = 0; data_set < n_data_sets; ++data_set)
+        if (data_set_handled[data_set] == false)
+          point_data.emplace_back(
+            data_names[data_set],
+            1,
+            n_nodes > 0 ? std::vector<float>(data_vectors[data_set].begin(),
+                                             data_vectors[data_set].end()) :
+                          std::vector<float>());
+    }
+
+    // Compute the global number of nodes, cells, and connectivity entries as
+    // well as the position of the data of this process within the global
+    // arrays.
+    const std::uint64_t local_counts[3]   = {n_nodes,
+                                             types.size(),
+                                             connectivity.size()};
+    std::uint64_t       global_counts[3]  = {0, 0, 0};
+    std::uint64_t       global_offsets[3] = {0, 0, 0};
+#  ifdef DEAL_II_WITH_MPI
+    int ierr = MPI_Allreduce(
+      local_counts, global_counts, 3, MPI_UINT64_T, MPI_SUM, comm);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Exscan(
+      local_counts, global_offsets, 3, MPI_UINT64_T, MPI_SUM, comm);
+    AssertThrowMPI(ierr);
+    if (myrank == 0)
+      std::fill(std::begin(global_offsets), std::end(global_offsets), 0);
+#  else
+    std::copy(std::begin(local_counts),
+              std::end(local_counts),
+              std::begin(global_counts));
+#  endif
+
+    hid_t file_properties = H5Pcreate(H5P_FILE_ACCESS);
+    AssertThrow(file_properties >= 0, ExcIO());
+    hid_t transfer_properties = H5Pcreate(H5P_DATASET_XFER);
+    AssertThrow(transfer_properties >= 0, ExcIO());
+    herr_t status;
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    status = H5Pset_fapl_mpio(file_properties, comm, MPI_INFO_NULL);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Pset_dxpl_mpio(transfer_properties, H5FD_MPIO_COLLECTIVE);
+    AssertThrow(status >= 0, ExcIO());
+#    endif
+#  endif
+
+    const hid_t file =
+      create_file ?
+        H5Fcreate(
+          filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, file_properties) :
+        H5Fopen(filename.c_str(), H5F_ACC_RDWR, file_properties);
+    AssertThrow(file >= 0, ExcFileNotOpen(filename));
+
+    hid_t root, steps, point_data_group, point_data_offsets_group;
+    if (create_file)
+      {
+        root =
+          H5Gcreate2(file, "VTKHDF", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        AssertThrow(root >= 0, ExcIO());
+
+        // The attributes identifying the file as VTKHDF
+        {
+          const int     version[2] = {2, 0};
+          const hsize_t dims[1]    = {2};
+          const hid_t   dataspace  = H5Screate_simple(1, dims, nullptr);
+          const hid_t   attribute  = H5Acreate2(root,
+                                             "Version",
+                                             H5T_NATIVE_INT,
+                                             dataspace,
+                                             H5P_DEFAULT,
+                                             H5P_DEFAULT);
+          AssertThrow(attribute >= 0, ExcIO());
+          status = H5Awrite(attribute, H5T_NATIVE_INT, version);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Aclose(attribute);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Sclose(dataspace);
+          AssertThrow(status >= 0, ExcIO());
+        }
+        {
+          const std::string type_name = "UnstructuredGrid";
+          const hid_t       string_type = H5Tcopy(H5T_C_S1);
+          status = H5Tset_size(string_type, type_name.size());
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Tset_strpad(string_type, H5T_STR_NULLPAD);
+          AssertThrow(status >= 0, ExcIO());
+          const hid_t dataspace = H5Screate(H5S_SCALAR);
+          const hid_t attribute = H5Acreate2(
+            root, "Type", string_type, dataspace, H5P_DEFAULT, H5P_DEFAULT);
+          AssertThrow(attribute >= 0, ExcIO());
+          status = H5Awrite(attribute, string_type, type_name.c_str());
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Aclose(attribute);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Sclose(dataspace);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Tclose(string_type);
+          AssertThrow(status >= 0, ExcIO());
+        }
+
+        steps =
+          H5Gcreate2(root, "Steps", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        AssertThrow(steps >= 0, ExcIO());
+        {
+          const int   n_steps   = 0;
+          const hid_t dataspace = H5Screate(H5S_SCALAR);
+          const hid_t attribute = H5Acreate2(steps,
+                                             "NSteps",
+                                             H5T_NATIVE_INT,
+                                             dataspace,
+                                             H5P_DEFAULT,
+                                             H5P_DEFAULT);
+          AssertThrow(attribute >= 0, ExcIO());
+          status = H5Awrite(attribute, H5T_NATIVE_INT, &n_steps);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Aclose(attribute);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Sclose(dataspace);
+          AssertThrow(status >= 0, ExcIO());
+        }
+
+        point_data_group = H5Gcreate2(
+          root, "PointData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        point_data_offsets_group = H5Gcreate2(
+          steps, "PointDataOffsets", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      }
+    else
+      {
+        root = H5Gopen2(file, "VTKHDF", H5P_DEFAULT);
+        AssertThrow(root >= 0,
+                    ExcMessage("The file <" + filename +
+                               "> is not a VTKHDF file."));
+        steps                    = H5Gopen2(root, "Steps", H5P_DEFAULT);
+        point_data_group         = H5Gopen2(root, "PointData", H5P_DEFAULT);
+        point_data_offsets_group =
+          H5Gopen2(steps, "PointDataOffsets", H5P_DEFAULT);
+      }
+    AssertThrow(steps >= 0, ExcIO());
+    AssertThrow(point_data_group >= 0, ExcIO());
+    AssertThrow(point_data_offsets_group >= 0, ExcIO());
+
+    int n_steps = 0;
+    {
+      const hid_t attribute = H5Aopen(steps, "NSteps", H5P_DEFAULT);
+      AssertThrow(attribute >= 0, ExcIO());
+      status = H5Aread(attribute, H5T_NATIVE_INT, &n_steps);
+      AssertThrow(status >= 0, ExcIO());
+      status = H5Aclose(attribute);
+      AssertThrow(status >= 0, ExcIO());
+    }
+
+    // Append the mesh and the point data of this time step, and collect the
+    // positions at which they start.
+    const auto append = [&](const hid_t         location,
+                            const std::string  &name,
+                            const hid_t         type,
+                            const unsigned int  rank,
+                            const hsize_t       n_columns,
+                            const auto         *data,
+                            const std::uint64_t n_local_rows,
+                            const std::uint64_t local_offset,
+                            const std::uint64_t n_global_rows) {
+      const hid_t dataset = open_vtkhdf_dataset(
+        location, name, type, rank, n_columns, flags, create_file);
+      const std::uint64_t n_old_rows =
+        append_to_vtkhdf_dataset(dataset,
+                                 type,
+                                 transfer_properties,
+                                 data,
+                                 n_local_rows,
+                                 local_offset,
+                                 n_global_rows);
+      const herr_t status = H5Dclose(dataset);
+      AssertThrow(status >= 0, ExcIO());
+      return static_cast<std::int64_t>(n_old_rows);
+    };
+
+    // If the mesh is written, the new time step refers to the part of the
+    // mesh datasets we append to. Otherwise it refers to the same parts as
+    // the time step whose mesh we reuse.
+    std::int64_t part_offset, point_offset, cell_offset, connectivity_offset;
+    unsigned int used_mesh_time_step = n_steps;
+    if (write_mesh)
+      {
+        const std::int64_t part_counts[3] = {
+          static_cast<std::int64_t>(local_counts[0]),
+          static_cast<std::int64_t>(local_counts[1]),
+          static_cast<std::int64_t>(local_counts[2])};
+        part_offset = append(root,
+                             "NumberOfPoints",
+                             H5T_NATIVE_INT64,
+                             1,
+                             1,
+                             &part_counts[0],
+                             1,
+                             myrank,
+                             n_ranks);
+        append(root,
+               "NumberOfCells",
+               H5T_NATIVE_INT64,
+               1,
+               1,
+               &part_counts[1],
+               1,
+               myrank,
+               n_ranks);
+        append(root,
+               "NumberOfConnectivityIds",
+               H5T_NATIVE_INT64,
+               1,
+               1,
+               &part_counts[2],
+               1,
+               myrank,
+               n_ranks);
+
+        point_offset = append(root,
+                              "Points",
+                              H5T_NATIVE_DOUBLE,
+                              2,
+                              3,
+                              points.data(),
+                              n_nodes,
+                              global_offsets[0],
+                              global_counts[0]);
+        // Each part stores one more offset than it has cells.
+        append(root,
+               "Offsets",
+               H5T_NATIVE_INT64,
+               1,
+               1,
+               offsets.data(),
+               offsets.size(),
+               global_offsets[1] + myrank,
+               global_counts[1] + n_ranks);
+        cell_offset = append(root,
+                             "Types",
+                             H5T_NATIVE_UINT8,
+                             1,
+                             1,
+                             types.data(),
+                             types.size(),
+                             global_offsets[1],
+                             global_counts[1]);
+        connectivity_offset = append(root,
+                                     "Connectivity",
+                                     H5T_NATIVE_INT64,
+                                     1,
+                                     1,
+                                     connectivity.data(),
+                                     connectivity.size(),
+                                     global_offsets[2],
+                                     global_counts[2]);
+      }
+    else
+      {
+        // Every process only reads the entries of the file it needs: the
+        // offsets recorded for the time step whose mesh we reuse, and the
+        // number of points in its own part of that mesh.
+        AssertThrow(n_steps > 0, ExcIO());
+        if (mesh_time_step != numbers::invalid_unsigned_int)
+          {
+            AssertThrow(mesh_time_step < static_cast<unsigned int>(n_steps),
+                        ExcIndexRange(mesh_time_step, 0, n_steps));
+            used_mesh_time_step = mesh_time_step;
+          }
+        else
+          used_mesh_time_step = n_steps - 1;
+
+        AssertThrow(
+          read_vtkhdf_dataset(steps, "NumberOfParts", used_mesh_time_step) ==
+            n_ranks,
+          ExcMessage("A time step can only reuse the mesh of an earlier "
+                     "time step if it is written by the same number of "
+                     "processes."));
+        part_offset =
+          read_vtkhdf_dataset(steps, "PartOffsets", used_mesh_time_step);
+        AssertThrow(read_vtkhdf_dataset(root,
+                                        "NumberOfPoints",
+                                        part_offset + myrank) ==
+                      static_cast<std::int64_t>(n_nodes),
+                    ExcMessage("A time step can only reuse the mesh of an "
+                               "earlier time step if the patches have not "
+                               "changed."));
+
+        point_offset =
+          read_vtkhdf_dataset(steps, "PointOffsets", used_mesh_time_step);
+        cell_offset =
+          read_vtkhdf_dataset(steps, "CellOffsets", used_mesh_time_step);
+        connectivity_offset = read_vtkhdf_dataset(steps,
+                                                  "ConnectivityIdOffsets",
+                                                  used_mesh_time_step);
+      }
+
+    std::vector<std::int64_t> point_data_offsets;
+    for (const auto &[name, n_components, data] : point_data)
+      point_data_offsets.push_back(append(point_data_group,
+                                          name,
+                                          H5T_NATIVE_FLOAT,
+                                          n_components > 1 ? 2 : 1,
+                                          n_components,
+                                          data.data(),
+                                          n_nodes,
+                                          global_offsets[0],
+                                          global_counts[0]));
+
+    // Finally record the new time step. Only the first process provides
+    // these values, but all processes need to take part in the writes.
+    const std::uint64_t n_step_rows = (myrank == 0 ? 1 : 0);
+    const std::int64_t  n_parts     = n_ranks;
+    append(steps,
+           "Values",
+           H5T_NATIVE_DOUBLE,
+           1,
+           1,
+           &flags.time,
+           n_step_rows,
+           0,
+           1);
+    append(steps,
+           "PartOffsets",
+           H5T_NATIVE_INT64,
+           1,
+           1,
+           &part_offset,
+           n_step_rows,
+           0,
+           1);
+    append(steps,
+           "NumberOfParts",
+           H5T_NATIVE_INT64,
+           1,
+           1,
+           &n_parts,
+           n_step_rows,
+           0,
+           1);
+    append(steps,
+           "PointOffsets",
+           H5T_NATIVE_INT64,
+           1,
+           1,
+           &point_offset,
+           n_step_rows,
+           0,
+           1);
+    append(steps,
+           "CellOffsets",
+           H5T_NATIVE_INT64,
+           2,
+           1,
+           &cell_offset,
+           n_step_rows,
+           0,
+           1);
+    append(steps,
+           "ConnectivityIdOffsets",
+           H5T_NATIVE_INT64,
+           2,
+           1,
+           &connectivity_offset,
+           n_step_rows,
+           0,
+           1);
+    for (unsigned int i = 0; i < point_data.size(); ++i)
+      append(point_data_offsets_group,
+             std::get<0>(point_data[i]),
+             H5T_NATIVE_INT64,
+             1,
+             1,
+             &point_data_offsets[i],
+             n_step_rows,
+             0,
+             1);
+
+    {
+      const hid_t attribute = H5Aopen(steps, "NSteps", H5P_DEFAULT);
+      AssertThrow(attribute >= 0, ExcIO());
+      ++n_steps;
+      status = H5Awrite(attribute, H5T_NATIVE_INT, &n_steps);
+      AssertThrow(status >= 0, ExcIO());
+      status = H5Aclose(attribute);
+      AssertThrow(status >= 0, ExcIO());
+    }
+
+    for (const hid_t group :
+         {point_data_offsets_group, point_data_group, steps, root})
+      {
+        status = H5Gclose(group);
+        AssertThrow(status >= 0, ExcIO());
+      }
+    status = H5Pclose(transfer_properties);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Pclose(file_properties);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Fclose(file);
+    AssertThrow(status >= 0, ExcIO());
+
+    return used_mesh_time_step;
+  }
 #endif
 } // namespace
 
@@ -8782,6 +9792,91 @@ DataOutBase::write_hdf5_parallel(
 
 
 
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtkhdf_parallel(
+  const std::string &filename,
+  const MPI_Comm     comm) const
+{
+#ifndef DEAL_II_WITH_HDF5
+  // throw an exception, but first make sure the compiler does not warn about
+  // the now unused function arguments
+  (void)filename;
+  (void)comm;
+  AssertThrow(false, ExcNeedsHDF5());
+#else
+  // Only reuse a mesh this object has written into the same file before,
+  // and only if the geometry has not changed since on any of the processes:
+  // all of them have to agree on whether to write to the mesh datasets
+  const unsigned int revision = patch_geometry_revision();
+  const auto         mesh     = vtkhdf_mesh_time_steps.find(filename);
+  const bool         mesh_unchanged =
+    vtkhdf_flags.reuse_unchanged_mesh && vtkhdf_flags.append_time_step &&
+    (revision != numbers::invalid_unsigned_int) &&
+    (mesh != vtkhdf_mesh_time_steps.end()) && (mesh->second.first == revision);
+  const bool reuse_mesh =
+    vtkhdf_flags.write_mesh &&
+    (Utilities::MPI::logical_or(!mesh_unchanged, comm) == false);
+
+  const unsigned int mesh_time_step = do_write_vtkhdf<dim, spacedim>(
+    get_patches(),
+    get_dataset_names(),
+    get_nonscalar_data_ranges(),
+    vtkhdf_flags,
+    vtkhdf_flags.write_mesh && !reuse_mesh,
+    reuse_mesh ? mesh->second.second : numbers::invalid_unsigned_int,
+    filename,
+    comm);
+
+  // Remember the mesh we have just written, or the one we have reused. If
+  // the mesh was not written because the user said so, we do not know which
+  // geometry the time step it refers to has.
+  if (vtkhdf_flags.write_mesh)
+    vtkhdf_mesh_time_steps[filename] = {revision, mesh_time_step};
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBase::write_vtkhdf_parallel(
+  const std::vector<Patch<dim, spacedim>> &patches,
+  const std::vector<std::string>          &data_names,
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+                                 &nonscalar_data_ranges,
+  const DataOutBase::VtkHdfFlags &flags,
+  const std::string              &filename,
+  const MPI_Comm                  comm)
+{
+#ifndef DEAL_II_WITH_HDF5
+  // throw an exception, but first make sure the compiler does not warn about
+  // the now unused function arguments
+  (void)patches;
+  (void)data_names;
+  (void)nonscalar_data_ranges;
+  (void)flags;
+  (void)filename;
+  (void)comm;
+  AssertThrow(false, ExcNeedsHDF5());
+#else
+  do_write_vtkhdf<dim, spacedim>(patches,
+                                 data_names,
+                                 nonscalar_data_ranges,
+                                 flags,
+                                 flags.write_mesh,
+                                 numbers::invalid_unsigned_int,
+                                 filename,
+                                 comm);
+#endif
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write(
@@ -8878,6 +9973,8 @@ DataOutInterface<dim, spacedim>::set_flags(const FlagType &flags)
     tecplot_flags = flags;
   else if constexpr (std::is_same_v<FlagType, DataOutBase::VtkFlags>)
     vtk_flags = flags;
+  else if constexpr (std::is_same_v<FlagType, DataOutBase::VtkHdfFlags>)
+    vtkhdf_flags = flags;
   else if constexpr (std::is_same_v<FlagType, DataOutBase::SvgFlags>)
     svg_flags = flags;
   else if constexpr (std::is_same_v<FlagType, DataOutBase::GnuplotFlags>)
@@ -9026,6 +10123,7 @@ DataOutInterface<dim, spacedim>::memory_consumption() const
           MemoryConsumption::memory_consumption(hdf5_flags) +
           MemoryConsumption::memory_consumption(tecplot_flags) +
           MemoryConsumption::memory_consumption(vtk_flags) +
+          MemoryConsumption::memory_consumption(vtkhdf_flags) +
           MemoryConsumption::memory_consumption(svg_flags) +
           MemoryConsumption::memory_consumption(deal_II_intermediate_flags));
 }
@@ -9048,6 +10146,24 @@ DataOutInterface<dim, spacedim>::get_nonscalar_data_ranges() const
 }
 
 
+template <int dim, int spacedim>
+bool
+DataOutInterface<dim, spacedim>::patch_geometry_unchanged() const
+{
+  return false;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutInterface<dim, spacedim>::patch_geometry_revision() const
+{
+  return numbers::invalid_unsigned_int;
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::validate_dataset_names() const
@@ -215,7 +215,7 @@ namespace parallel
         for (auto constrained_dof : locally_owned_dofs)
           if (affine_constraints.is_constrained(constrained_dof))
             {
-              auto *constraint =
+              const auto constraint =
                 affine_constraints.get_constraint_entries(constrained_dof);
               const unsigned int line_size = constraint->size();
               bool               add_line  = false;
@@ -2075,7 +2075,8 @@ namespace parallel
       // Save cell attached data.
       this->save_attached_data(parallel_forest->global_first_quadrant[myrank],
                                parallel_forest->global_num_quadrants,
-                               file_basename);
+                               file_basename,
+                               settings & memory_mapped_checkpoint);
 
       dealii::internal::p4est::functions<dim>::save(file_basename.c_str(),
                                                     parallel_forest,
@@ -2176,7 +2177,8 @@ namespace parallel
                                parallel_forest->local_num_quadrants,
                                file_basename,
                                attached_count_fixed,
-                               attached_count_variable);
+                               attached_count_variable,
+                               settings & memory_mapped_checkpoint);
 
       // signal that de-serialization is finished
       this->signals.post_distributed_load();
@@ -0,0 +1,427 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/array_view.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_numbering_transfer.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+
+template <int dim, int spacedim>
+DoFNumberingTransfer<dim, spacedim>::DoFNumberingTransfer(
+  DoFHandler<dim, spacedim> &dof_handler)
+  : dof_handler(&dof_handler, typeid(*this).name())
+  , n_old_dofs(numbers::invalid_dof_index)
+  , dof_maps_computed(false)
+{
+  AssertThrow(
+    (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+       &dof_handler.get_triangulation()) == nullptr),
+    ExcMessage("DoFNumberingTransfer only works for sequential "
+               "triangulations."));
+
+  pre_refinement_connection =
+    dof_handler.get_triangulation().signals.pre_refinement.connect(
+      [this]() { this->record_dof_indices(); });
+}
+
+
+
+template <int dim, int spacedim>
+DoFNumberingTransfer<dim, spacedim>::~DoFNumberingTransfer()
+{
+  pre_refinement_connection.disconnect();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DoFNumberingTransfer<dim, spacedim>::record_dof_indices()
+{
+  n_old_dofs = numbers::invalid_dof_index;
+  old_cells.clear();
+  old_dof_indices.clear();
+  replaced_cells.clear();
+  dof_maps_computed = false;
+  new_of_old.clear();
+  old_of_new.clear();
+  cell_persisted.clear();
+
+  if (dof_handler->has_active_dofs() == false)
+    return;
+  AssertThrow(dof_handler->has_hp_capabilities() == false,
+              ExcNotImplemented());
+
+  const unsigned int dofs_per_cell = dof_handler->get_fe().n_dofs_per_cell();
+  n_old_dofs                       = dof_handler->n_dofs();
+  old_cells.reserve(dof_handler->get_triangulation().n_active_cells());
+  old_dof_indices.resize(dof_handler->get_triangulation().n_active_cells() *
+                         dofs_per_cell);
+
+  // at the time of the pre_refinement signal, the refinement and coarsening
+  // flags are final: a cell persists if it has neither of the two
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  for (const auto &cell : dof_handler->active_cell_iterators())
+    {
+      const bool persists =
+        !cell->refine_flag_set() && !cell->coarsen_flag_set();
+
+      cell->get_dof_indices(dof_indices);
+      std::copy(dof_indices.begin(),
+                dof_indices.end(),
+                old_dof_indices.begin() + old_cells.size() * dofs_per_cell);
+      old_cells.emplace_back(std::make_pair(cell->level(), cell->index()),
+                             persists);
+
+      if (!persists && dofs_per_cell > 0)
+        {
+          // the cell that will cover the domain of this cell after the
+          // refinement
+          typename DoFHandler<dim, spacedim>::cell_iterator replacing_cell =
+            cell;
+          if (cell->coarsen_flag_set())
+            replacing_cell = cell->parent();
+          const types::global_dof_index first_dof =
+            *std::min_element(dof_indices.begin(), dof_indices.end());
+          const auto key =
+            std::make_pair(replacing_cell->level(), replacing_cell->index());
+          const auto position = replaced_cells.find(key);
+          if (position == replaced_cells.end())
+            replaced_cells.emplace(key, first_dof);
+          else
+            position->second = std::min(position->second, first_dof);
+        }
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+DoFNumberingTransfer<dim, spacedim>::compute_dof_maps()
+{
+  AssertThrow(n_old_dofs != numbers::invalid_dof_index,
+              ExcMessage("No degrees of freedom were distributed at the time "
+                         "the mesh was last refined or coarsened, so there is "
+                         "no old numbering to build upon."));
+  Assert(dof_handler->has_active_dofs(),
+         ExcMessage("You need to distribute the degrees of freedom on the "
+                    "new mesh before calling this function."));
+  if (dof_maps_computed)
+    return;
+
+  const Triangulation<dim, spacedim> &triangulation =
+    dof_handler->get_triangulation();
+  const unsigned int dofs_per_cell = dof_handler->get_fe().n_dofs_per_cell();
+
+  new_of_old.assign(n_old_dofs, numbers::invalid_dof_index);
+  old_of_new.assign(dof_handler->n_dofs(), numbers::invalid_dof_index);
+  cell_persisted.assign(triangulation.n_active_cells(), false);
+
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  for (unsigned int c = 0; c < old_cells.size(); ++c)
+    if (old_cells[c].second)
+      {
+        const typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+          &triangulation,
+          old_cells[c].first.first,
+          old_cells[c].first.second,
+          &*dof_handler);
+        Assert(cell->is_active(), ExcInternalError());
+        cell_persisted[cell->active_cell_index()] = true;
+
+        cell->get_dof_indices(dof_indices);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const types::global_dof_index old_index =
+              old_dof_indices[c * dofs_per_cell + i];
+            new_of_old[old_index]     = dof_indices[i];
+            old_of_new[dof_indices[i]] = old_index;
+          }
+      }
+
+  dof_maps_computed = true;
+}
+
+
+
+template <int dim, int spacedim>
+void
+DoFNumberingTransfer<dim, spacedim>::renumber_dofs()
+{
+  compute_dof_maps();
+
+  const types::global_dof_index n_dofs = dof_handler->n_dofs();
+
+  // sort the degrees of freedom by a key: the ones that persisted by their
+  // old index, the new ones behind the old degree of freedom their cell
+  // inherits its position from. ties are broken by the present index
+  std::vector<std::pair<std::uint64_t, types::global_dof_index>> keys(
+    n_dofs, std::make_pair(std::uint64_t(2) * n_old_dofs + 1, 0));
+  std::vector<bool> has_key(n_dofs, false);
+  for (types::global_dof_index i = 0; i < n_dofs; ++i)
+    {
+      keys[i].second = i;
+      if (old_of_new[i] != numbers::invalid_dof_index)
+        {
+          keys[i].first = std::uint64_t(2) * old_of_new[i];
+          has_key[i]    = true;
+        }
+    }
+
+  std::vector<types::global_dof_index> dof_indices(
+    dof_handler->get_fe().n_dofs_per_cell());
+  for (const auto &cell : dof_handler->active_cell_iterators())
+    if (!cell_persisted[cell->active_cell_index()])
+      {
+        // find the cell that replaced the refined or coarsened cells
+        std::uint64_t key = std::uint64_t(2) * n_old_dofs + 1;
+        for (typename DoFHandler<dim, spacedim>::cell_iterator ancestor =
+               cell;
+             ;
+             ancestor = ancestor->parent())
+          {
+            const auto position = replaced_cells.find(
+              std::make_pair(ancestor->level(), ancestor->index()));
+            if (position != replaced_cells.end())
+              {
+                key = std::uint64_t(2) * position->second + 1;
+                break;
+              }
+            if (ancestor->level() == 0)
+              break;
+          }
+
+        cell->get_dof_indices(dof_indices);
+        for (const types::global_dof_index i : dof_indices)
+          if (!has_key[i])
+            {
+              keys[i].first = key;
+              has_key[i]    = true;
+            }
+      }
+
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<types::global_dof_index> new_numbers(n_dofs);
+  for (types::global_dof_index k = 0; k < n_dofs; ++k)
+    new_numbers[keys[k].second] = k;
+  dof_handler->renumber_dofs(new_numbers);
+
+  // update the maps to the new numbering
+  for (types::global_dof_index &i : new_of_old)
+    if (i != numbers::invalid_dof_index)
+      i = new_numbers[i];
+  std::vector<types::global_dof_index> renumbered_old_of_new(n_dofs);
+  for (types::global_dof_index i = 0; i < n_dofs; ++i)
+    renumbered_old_of_new[new_numbers[i]] = old_of_new[i];
+  old_of_new.swap(renumbered_old_of_new);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename number>
+void
+DoFNumberingTransfer<dim, spacedim>::update_sparsity_pattern(
+  const AffineConstraints<number> &old_constraints,
+  const AffineConstraints<number> &new_constraints,
+  SparsityPattern                 &sparsity_pattern,
+  const bool                       keep_constrained_dofs)
+{
+  using size_type = SparsityPattern::size_type;
+
+  compute_dof_maps();
+  AssertDimension(sparsity_pattern.n_rows(), n_old_dofs);
+  AssertDimension(sparsity_pattern.n_cols(), n_old_dofs);
+  Assert(old_constraints.is_closed() && new_constraints.is_closed(),
+         ExcMessage("The constraints must be closed."));
+
+  const types::global_dof_index n_dofs = dof_handler->n_dofs();
+  const unsigned int dofs_per_cell = dof_handler->get_fe().n_dofs_per_cell();
+
+  // the rows that need to be computed anew
+  std::vector<bool> dirty(n_dofs, false);
+  const auto mark_targets =
+    [&](const AffineConstraints<number> &constraints,
+        const types::global_dof_index    dof,
+        const bool                       old_numbering) {
+      if (const auto entries = constraints.get_constraint_entries(dof))
+        for (const auto &entry : *entries)
+          {
+            const types::global_dof_index target =
+              (old_numbering ? new_of_old[entry.first] : entry.first);
+            if (target != numbers::invalid_dof_index)
+              dirty[target] = true;
+          }
+    };
+
+  // degrees of freedom that were located on refined or coarsened cells, as
+  // well as the targets of their constraints, lose the couplings of these
+  // cells
+  for (unsigned int c = 0; c < old_cells.size(); ++c)
+    if (!old_cells[c].second)
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+          const types::global_dof_index old_index =
+            old_dof_indices[c * dofs_per_cell + i];
+          if (new_of_old[old_index] != numbers::invalid_dof_index)
+            dirty[new_of_old[old_index]] = true;
+          mark_targets(old_constraints, old_index, true);
+        }
+
+  // find the degrees of freedom whose constraints changed, in the sense
+  // that the set of degrees of freedom they are constrained to is a
+  // different one
+  std::vector<bool> constraint_changed(n_dofs, false);
+  for (const auto &line : old_constraints.get_lines())
+    {
+      const types::global_dof_index new_index = new_of_old[line.index];
+      if (new_index == numbers::invalid_dof_index)
+        mark_targets(old_constraints, line.index, true);
+      else if (!new_constraints.is_constrained(new_index))
+        {
+          constraint_changed[new_index] = true;
+          mark_targets(old_constraints, line.index, true);
+        }
+    }
+  std::vector<types::global_dof_index> old_targets, new_targets;
+  for (const auto &line : new_constraints.get_lines())
+    {
+      const types::global_dof_index old_index = old_of_new[line.index];
+      if (old_index == numbers::invalid_dof_index)
+        continue;
+
+      bool changed = !old_constraints.is_constrained(old_index);
+      if (!changed)
+        {
+          const auto old_entries =
+            *old_constraints.get_constraint_entries(old_index);
+          old_targets.clear();
+          for (const auto &entry : old_entries)
+            old_targets.push_back(new_of_old[entry.first]);
+          new_targets.clear();
+          for (const auto &entry : line.entries)
+            new_targets.push_back(entry.first);
+          std::sort(old_targets.begin(), old_targets.end());
+          std::sort(new_targets.begin(), new_targets.end());
+          changed = (old_targets != new_targets);
+        }
+      if (changed)
+        {
+          constraint_changed[line.index] = true;
+          mark_targets(old_constraints, old_index, true);
+        }
+    }
+
+  // the cells whose couplings changed are the new ones and the ones with a
+  // degree of freedom whose constraint changed. all of their degrees of
+  // freedom and the targets of their constraints need to be recomputed
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  for (const auto &cell : dof_handler->active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      bool cell_changed = !cell_persisted[cell->active_cell_index()];
+      for (const types::global_dof_index i : dof_indices)
+        if (constraint_changed[i])
+          cell_changed = true;
+      if (cell_changed)
+        for (const types::global_dof_index i : dof_indices)
+          {
+            dirty[i] = true;
+            mark_targets(new_constraints, i, false);
+          }
+    }
+
+  // the unchanged rows are copied from the old pattern with the indices
+  // translated to the new numbering; by the rules above, all of their
+  // entries still exist. the rows that changed are computed the same way as
+  // DoFTools::make_sparsity_pattern() does, but only on the cells that add
+  // entries to them. these cells also add to some of the unchanged rows, but
+  // only entries that are already there
+  DynamicSparsityPattern dsp(n_dofs, n_dofs);
+  std::vector<size_type> columns;
+  for (types::global_dof_index i = 0; i < n_dofs; ++i)
+    if (!dirty[i])
+      {
+        // leave out the diagonal entry, which the old pattern stores first,
+        // and insert it at the right place
+        const types::global_dof_index old_index = old_of_new[i];
+        columns.clear();
+        for (auto entry = sparsity_pattern.begin(old_index);
+             entry != sparsity_pattern.end(old_index);
+             ++entry)
+          if (entry->column() != old_index)
+            {
+              Assert(new_of_old[entry->column()] !=
+                       numbers::invalid_dof_index,
+                     ExcInternalError());
+              columns.push_back(new_of_old[entry->column()]);
+            }
+        if (!std::is_sorted(columns.begin(), columns.end()))
+          std::sort(columns.begin(), columns.end());
+        columns.insert(std::lower_bound(columns.begin(), columns.end(), i),
+                       i);
+        dsp.add_row_entries(i, make_array_view(columns), true);
+      }
+
+  for (const auto &cell : dof_handler->active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      bool adds_to_dirty_rows = false;
+      for (const types::global_dof_index i : dof_indices)
+        {
+          if (dirty[i])
+            adds_to_dirty_rows = true;
+          else if (const auto entries =
+                     new_constraints.get_constraint_entries(i))
+            for (const auto &entry : *entries)
+              if (dirty[entry.first])
+                adds_to_dirty_rows = true;
+          if (adds_to_dirty_rows)
+            break;
+        }
+      if (adds_to_dirty_rows)
+        new_constraints.add_entries_local_to_global(dof_indices,
+                                                    dsp,
+                                                    keep_constrained_dofs);
+    }
+
+  sparsity_pattern.copy_from(dsp);
+}
+
+
+
+/*-------------- Explicit Instantiations -------------------------------*/
+#include "dof_numbering_transfer.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -12,6 +12,8 @@
 //
 // ------------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/types.h>
@@ -1458,6 +1460,184 @@ namespace DoFRenumbering
 
 
 
+  template <int dim, int spacedim>
+  void
+  space_filling_curve(DoFHandler<dim, spacedim> &dof_handler)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs(), numbers::invalid_dof_index);
+    compute_space_filling_curve(renumbering, dof_handler);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_space_filling_curve(
+    std::vector<types::global_dof_index> &new_dof_indices,
+    const DoFHandler<dim, spacedim>      &dof_handler)
+  {
+    const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+    AssertDimension(new_dof_indices.size(), locally_owned.n_elements());
+    const types::global_dof_index n_dofs = locally_owned.n_elements();
+    if (n_dofs == 0)
+      return;
+
+    // find the first locally owned cell every degree of freedom is located
+    // on, together with its index on that cell
+    std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+      cells;
+    std::vector<std::pair<unsigned int, unsigned int>> dof_locations(
+      n_dofs,
+      std::make_pair(numbers::invalid_unsigned_int,
+                     numbers::invalid_unsigned_int));
+    std::vector<types::global_dof_index> local_dof_indices;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          local_dof_indices.resize(cell->get_fe().n_dofs_per_cell());
+          cell->get_dof_indices(local_dof_indices);
+          for (unsigned int i = 0; i < local_dof_indices.size(); ++i)
+            if (locally_owned.is_element(local_dof_indices[i]))
+              {
+                auto &location = dof_locations[locally_owned.index_within_set(
+                  local_dof_indices[i])];
+                if (location.first == numbers::invalid_unsigned_int)
+                  location = std::make_pair(cells.size(), i);
+              }
+          cells.push_back(cell);
+        }
+
+    // the chunks of degrees of freedom the following loops are split into.
+    // the sorting below merges the chunks pairwise, so their number has to
+    // be a power of two
+    unsigned int n_chunks = 1;
+    if (n_dofs >= 4096)
+      while (n_chunks < MultithreadInfo::n_threads())
+        n_chunks *= 2;
+    const auto chunk_begin = [&](const unsigned int chunk) {
+      return n_dofs / n_chunks * chunk +
+             std::min<types::global_dof_index>(chunk, n_dofs % n_chunks);
+    };
+
+    // compute the location of every degree of freedom: the support point,
+    // mapped with the (bi-,tri-)linear mapping of the cell, or the center of
+    // the cell for elements without support points
+    std::vector<Point<spacedim>> points(n_dofs);
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (types::global_dof_index i = chunk_begin(begin);
+             i < chunk_begin(end);
+             ++i)
+          {
+            Assert(dof_locations[i].first != numbers::invalid_unsigned_int,
+                   ExcInternalError());
+            const auto &cell = cells[dof_locations[i].first];
+            const FiniteElement<dim, spacedim> &fe = cell->get_fe();
+            if (fe.has_support_points())
+              {
+                const Point<dim> &unit_point =
+                  fe.unit_support_point(dof_locations[i].second);
+                for (const unsigned int v : cell->vertex_indices())
+                  points[i] +=
+                    cell->reference_cell().d_linear_shape_function(unit_point,
+                                                                   v) *
+                    cell->vertex(v);
+              }
+            else
+              points[i] = cell->center();
+          }
+      },
+      1);
+
+    // convert the points to integer coordinates in the smallest cube around
+    // them, which keeps the aspect ratio of the domain and also works for
+    // domains that are flat in some direction
+    Point<spacedim> lower_left = points[0], upper_right = points[0];
+    for (const Point<spacedim> &point : points)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower_left[d]  = std::min(lower_left[d], point[d]);
+          upper_right[d] = std::max(upper_right[d], point[d]);
+        }
+    double extent = 0.;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      extent = std::max(extent, upper_right[d] - lower_left[d]);
+    if (extent == 0.)
+      extent = 1.;
+
+    // all coordinates need to fit into a single 64-bit integer, and the
+    // conversion from double should not lose digits
+    const int           bits_per_dim = std::min(52, 64 / spacedim);
+    const std::uint64_t max_int      = (std::uint64_t(1) << bits_per_dim) - 1;
+
+    // compute the position of every point along the curve. ties are broken
+    // by the previous index, which makes the sort below deterministic
+    std::vector<std::pair<std::uint64_t, types::global_dof_index>> keys(n_dofs);
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        const types::global_dof_index first = chunk_begin(begin);
+        std::vector<std::array<std::uint64_t, spacedim>> int_points(
+          chunk_begin(end) - first);
+        for (types::global_dof_index i = 0; i < int_points.size(); ++i)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            int_points[i][d] = static_cast<std::uint64_t>(
+              (points[first + i][d] - lower_left[d]) / extent *
+              static_cast<double>(max_int));
+
+        const std::vector<std::array<std::uint64_t, spacedim>> indices =
+          Utilities::inverse_Hilbert_space_filling_curve<spacedim>(
+            int_points, bits_per_dim);
+        for (types::global_dof_index i = 0; i < indices.size(); ++i)
+          keys[first + i] = std::make_pair(
+            Utilities::pack_integers<spacedim>(indices[i], bits_per_dim),
+            first + i);
+      },
+      1);
+
+    // sort the chunks in parallel, and then merge them pairwise
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int chunk = begin; chunk < end; ++chunk)
+          std::sort(keys.begin() + chunk_begin(chunk),
+                    keys.begin() + chunk_begin(chunk + 1));
+      },
+      1);
+    for (unsigned int width = 1; width < n_chunks; width *= 2)
+      parallel::apply_to_subranges(
+        0U,
+        n_chunks / (2 * width),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int pair = begin; pair < end; ++pair)
+            std::inplace_merge(
+              keys.begin() + chunk_begin(2 * width * pair),
+              keys.begin() + chunk_begin(2 * width * pair + width),
+              keys.begin() + chunk_begin(2 * width * (pair + 1)));
+        },
+        1);
+
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (types::global_dof_index k = chunk_begin(begin);
+             k < chunk_begin(end);
+             ++k)
+          new_dof_indices[keys[k].second] = locally_owned.nth_index_in_set(k);
+      },
+      1);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   sort_selected_dofs_back(DoFHandler<dim, spacedim> &dof_handler,
@@ -12,6 +12,8 @@
 //
 // ------------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
@@ -482,13 +484,15 @@ namespace DoFTools
        * It also suppresses very small entries in the AffineConstraints object
        * to avoid making the sparsity pattern fuller than necessary.
        */
-      template <typename number1, typename number2>
+      template <typename number1,
+                typename number2,
+                template <typename> class ConstraintsType>
       void
       filter_constraints(
         const std::vector<types::global_dof_index> &primary_dofs,
         const std::vector<types::global_dof_index> &dependent_dofs,
         const FullMatrix<number1>                  &face_constraints,
-        AffineConstraints<number2>                 &constraints)
+        ConstraintsType<number2>                   &constraints)
       {
         Assert(face_constraints.n() == primary_dofs.size(),
                ExcDimensionMismatch(primary_dofs.size(), face_constraints.n()));
@@ -514,7 +518,7 @@ namespace DoFTools
         // node constraints of Q4 elements in 3d, so covers most
         // common cases. Sort the primary dofs to add a sorted list to the
         // affine constraints, which increases performance there.
-        using size_type = typename AffineConstraints<number2>::size_type;
+        using size_type = typename ConstraintsType<number2>::size_type;
         boost::container::small_vector<std::pair<size_type, size_type>, 25>
           sorted_primary_dofs;
         sorted_primary_dofs.reserve(n_primary_dofs);
@@ -591,6 +595,48 @@ namespace DoFTools
 
 
 
+    /**
+     * A list of constraints that can be filled by filter_constraints(),
+     * used by threads to collect the constraints of a chunk of cells before
+     * they are copied into an AffineConstraints object. The entries of all
+     * constraints are stored in one array, with the constraint of
+     * constrained_dofs[i] in the range [row_starts[i], row_starts[i+1]).
+     *
+     * is_constrained() always returns false, i.e., a DoF may be
+     * constrained more than once. These duplicates are removed when the
+     * constraints are copied into the AffineConstraints object.
+     */
+    template <typename number>
+    struct ConstraintCollector
+    {
+      using size_type = types::global_dof_index;
+
+      bool
+      is_constrained(const size_type) const
+      {
+        return false;
+      }
+
+      template <typename Entries>
+      void
+      add_constraint(const size_type constrained_dof,
+                     const Entries  &dependencies,
+                     const number    inhomogeneity)
+      {
+        (void)inhomogeneity;
+        Assert(inhomogeneity == number(), ExcInternalError());
+        constrained_dofs.push_back(constrained_dof);
+        entries.insert(entries.end(), dependencies.begin(), dependencies.end());
+        row_starts.push_back(entries.size());
+      }
+
+      std::vector<size_type>                    constrained_dofs;
+      std::vector<std::size_t>                  row_starts = {0};
+      std::vector<std::pair<size_type, number>> entries;
+    };
+
+
+
     template <typename number, int spacedim>
     void
     make_hp_hanging_node_constraints(
@@ -2311,6 +2357,113 @@ namespace DoFTools
     }
 
 
+    /**
+     * The part of make_hp_hanging_node_constraints() for DoFHandler objects
+     * without hp-capabilities, where the element on the coarse side of a
+     * refined face always dominates the ones on the children. The cells are
+     * split into chunks whose constraints are computed in parallel and then
+     * added to the AffineConstraints object in the order of the chunks,
+     * which gives the same result as the sequential loop.
+     */
+    template <int dim, int spacedim, typename number>
+    void
+    make_hanging_node_constraints_on_chunks(
+      const DoFHandler<dim, spacedim> &dof_handler,
+      AffineConstraints<number>       &constraints,
+      const unsigned int               cells_per_chunk)
+    {
+      const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+      if (fe.n_dofs_per_face() == 0 ||
+          fe.compare_for_domination(fe, /*codim=*/1) ==
+            FiniteElementDomination::no_requirements)
+        return;
+
+      // compute the subface interpolation matrices up front so that the
+      // threads below only read them
+      std::vector<std::unique_ptr<FullMatrix<double>>>
+        subface_interpolation_matrices(
+          GeometryInfo<dim>::max_children_per_face);
+      for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_face;
+           ++c)
+        ensure_existence_of_subface_matrix(fe,
+                                           fe,
+                                           c,
+                                           subface_interpolation_matrices[c]);
+
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+        cells;
+      cells.reserve(dof_handler.get_triangulation().n_active_cells());
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (!cell->is_artificial())
+          cells.push_back(cell);
+
+      const unsigned int n_chunks =
+        (cells.size() + cells_per_chunk - 1) / cells_per_chunk;
+      std::vector<ConstraintCollector<number>> chunk_constraints(n_chunks);
+
+      parallel::apply_to_subranges(
+        0U,
+        n_chunks,
+        [&](const unsigned int begin, const unsigned int end) {
+          std::vector<types::global_dof_index> primary_dofs;
+          std::vector<types::global_dof_index> dependent_dofs;
+          for (unsigned int chunk = begin; chunk < end; ++chunk)
+            for (unsigned int i = chunk * cells_per_chunk;
+                 i < std::min<std::size_t>(cells.size(),
+                                           (chunk + 1) * cells_per_chunk);
+                 ++i)
+              {
+                const auto &cell = cells[i];
+                for (const unsigned int face : cell->face_indices())
+                  if (cell->face(face)->has_children())
+                    {
+                      Assert(cell->face(face)->refinement_case() ==
+                               RefinementCase<dim - 1>::isotropic_refinement,
+                             ExcNotImplemented());
+
+                      primary_dofs.resize(fe.n_dofs_per_face(face));
+                      cell->face(face)->get_dof_indices(
+                        primary_dofs, cell->active_fe_index());
+
+                      for (unsigned int c = 0;
+                           c < cell->face(face)->n_children();
+                           ++c)
+                        {
+                          if (cell->neighbor_child_on_subface(face, c)
+                                ->is_artificial())
+                            continue;
+
+                          const auto subface = cell->face(face)->child(c);
+                          dependent_dofs.resize(fe.n_dofs_per_face(face, c));
+                          subface->get_dof_indices(
+                            dependent_dofs, subface->nth_active_fe_index(0));
+
+                          filter_constraints(
+                            primary_dofs,
+                            dependent_dofs,
+                            *subface_interpolation_matrices[c],
+                            chunk_constraints[chunk]);
+                        }
+                    }
+              }
+        },
+        1);
+
+      for (const ConstraintCollector<number> &collector : chunk_constraints)
+        for (unsigned int i = 0; i < collector.constrained_dofs.size(); ++i)
+          if (constraints.is_constrained(collector.constrained_dofs[i]) ==
+              false)
+            constraints.add_constraint(
+              collector.constrained_dofs[i],
+              make_array_view(collector.entries.begin() +
+                                collector.row_starts[i],
+                              collector.entries.begin() +
+                                collector.row_starts[i + 1]),
+              /* inhomogeneity= */ 0.);
+    }
+
+
+
     template <int dim, int spacedim, typename number>
     void
     make_hp_hanging_node_constraints(
@@ -2322,6 +2475,22 @@ namespace DoFTools
       // there, so go read the paper before you try to understand what is going
       // on here
 
+      // without hp-capabilities, only the simple case below can happen, and
+      // we can work on the cells in parallel if there are enough of them
+      const unsigned int cells_per_chunk = 256;
+      if (dof_handler.has_hp_capabilities() == false &&
+          dof_handler.get_triangulation()
+            .all_reference_cells_are_hyper_cube() &&
+          MultithreadInfo::n_threads() > 1 &&
+          dof_handler.get_triangulation().n_active_cells() >
+            2 * cells_per_chunk)
+        {
+          make_hanging_node_constraints_on_chunks(dof_handler,
+                                                  constraints,
+                                                  cells_per_chunk);
+          return;
+        }
+
 
       // a matrix to be used for constraints below. declared here and simply
       // resized down below to avoid permanent re-allocation of memory
@@ -3416,7 +3585,7 @@ namespace DoFTools
                   break;
                 }
 
-              const auto &constraint_entries =
+              const auto constraint_entries =
                 *affine_constraints.get_constraint_entries(test_dof);
               if (constraint_entries.size() == 1)
                 {
@@ -12,6 +12,8 @@
 //
 // ------------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -40,6 +42,7 @@
 
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/sparsity_pattern_base.h>
+#include <deal.II/lac/sparsity_pattern_builder.h>
 #include <deal.II/lac/vector.h>
 
 #include <algorithm>
@@ -51,6 +54,251 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace DoFTools
 {
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * Scratch arrays used by the cell loops below.
+       */
+      struct SparsityScratchData
+      {
+        std::vector<types::global_dof_index> dofs_on_this_cell;
+        std::vector<types::global_dof_index> dofs_on_other_cell;
+        std::vector<std::pair<SparsityPatternBase::size_type,
+                              SparsityPatternBase::size_type>>
+          cell_entries;
+      };
+
+
+
+      /**
+       * A "sparsity pattern" that does not store a pattern, but just
+       * records the entries added to it as (row, column) pairs. The pairs
+       * are sorted into buckets by their row index, such that all entries
+       * of one row end up in the same bucket and the buckets of several
+       * collectors can be merged independently of each other.
+       */
+      class EntryCollector : public SparsityPatternBase
+      {
+      public:
+        EntryCollector(const size_type    n_rows,
+                       const size_type    n_cols,
+                       const unsigned int n_buckets)
+          : SparsityPatternBase(n_rows, n_cols)
+          , buckets(n_buckets)
+        {}
+
+        virtual void
+        add_row_entries(const size_type                  &row,
+                        const ArrayView<const size_type> &columns,
+                        const bool indices_are_sorted = false) override
+        {
+          (void)indices_are_sorted;
+          auto &bucket = buckets[row % buckets.size()];
+          for (const size_type column : columns)
+            bucket.emplace_back(row, column);
+        }
+
+        virtual void
+        add_entries(const ArrayView<const std::pair<size_type, size_type>>
+                      &entries) override
+        {
+          for (const auto &entry : entries)
+            buckets[entry.first % buckets.size()].push_back(entry);
+        }
+
+        std::vector<std::vector<std::pair<size_type, size_type>>> buckets;
+      };
+
+
+
+      /**
+       * Call @p cell_worker on all locally owned active cells of @p dof
+       * (restricted to the given subdomain, if any) and let it add its
+       * entries to @p sparsity.
+       *
+       * If several threads are available and the mesh is large enough, the
+       * cells are processed in rounds of contiguous chunks that are worked
+       * on in parallel. Each chunk writes into its own EntryCollector, so
+       * no locks are necessary. At the end of a round, the row buckets of
+       * all chunks are merged, sorted, and made unique in parallel, and
+       * the resulting rows are added to @p sparsity with sorted column
+       * indices. The last step is serial since SparsityPatternBase does
+       * not guarantee that adding to different rows is thread-safe; it is
+       * however cheap compared to the work done on the cells, and rows
+       * arrive with their final, duplicate-free set of columns.
+       *
+       * The rounds bound the memory used for the intermediate pairs: the
+       * number of cells per round is chosen such that the pairs collected
+       * in one round take about 64 MB, independently of the number of
+       * threads. The number of pairs per cell is taken from the previous
+       * round, or estimated from the number of DoFs per cell for the first
+       * round. Merging the buckets needs about the same amount of memory
+       * again.
+       *
+       * If @p sparsity is a SparsityPatternBuilder, which may be filled
+       * concurrently, the cells are simply distributed to the threads.
+       */
+      template <int dim, int spacedim, typename CellWorker>
+      void
+      add_entries_on_cells(const DoFHandler<dim, spacedim> &dof,
+                           const types::subdomain_id        subdomain_id,
+                           SparsityPatternBase             &sparsity,
+                           const CellWorker                &cell_worker)
+      {
+        const auto cell_is_relevant =
+          [subdomain_id](
+            const typename DoFHandler<dim, spacedim>::active_cell_iterator
+              &cell) {
+            return ((subdomain_id == numbers::invalid_subdomain_id) ||
+                    (subdomain_id == cell->subdomain_id())) &&
+                   cell->is_locally_owned();
+          };
+
+        SparsityScratchData scratch_data;
+        scratch_data.dofs_on_this_cell.reserve(
+          dof.get_fe_collection().max_dofs_per_cell());
+        scratch_data.dofs_on_other_cell.reserve(
+          dof.get_fe_collection().max_dofs_per_cell());
+
+        const unsigned int n_threads           = MultithreadInfo::n_threads();
+        const unsigned int cells_per_chunk     = 1024;
+        const unsigned int chunks_per_round    = 4 * n_threads;
+        const std::size_t  max_bytes_per_round = std::size_t(64) << 20;
+
+        // In case we work with a distributed sparsity pattern of Trilinos
+        // type, we only have to do the work if the current cell is owned by
+        // the calling processor. Otherwise, just continue.
+        if (n_threads == 1 ||
+            dof.get_triangulation().n_active_cells() < 2 * cells_per_chunk)
+          {
+            for (const auto &cell : dof.active_cell_iterators())
+              if (cell_is_relevant(cell))
+                cell_worker(cell, scratch_data, sparsity);
+            return;
+          }
+
+        std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+          cells;
+        for (const auto &cell : dof.active_cell_iterators())
+          if (cell_is_relevant(cell))
+            cells.push_back(cell);
+
+        // a SparsityPatternBuilder can be filled from several threads at
+        // once, so the entries do not have to be collected separately
+        if (dynamic_cast<SparsityPatternBuilder *>(&sparsity) != nullptr)
+          {
+            parallel::apply_to_subranges(
+              std::size_t(0),
+              cells.size(),
+              [&](const std::size_t begin, const std::size_t end) {
+                SparsityScratchData range_scratch_data = scratch_data;
+                for (std::size_t c = begin; c < end; ++c)
+                  cell_worker(cells[c], range_scratch_data, sparsity);
+              },
+              cells_per_chunk / 4);
+            return;
+          }
+
+        std::vector<EntryCollector> collectors(
+          chunks_per_round,
+          EntryCollector(sparsity.n_rows(),
+                         sparsity.n_cols(),
+                         chunks_per_round));
+        std::vector<SparsityScratchData> chunk_scratch_data(chunks_per_round,
+                                                            scratch_data);
+        std::vector<std::vector<
+          std::pair<SparsityPatternBase::size_type,
+                    SparsityPatternBase::size_type>>>
+          merged_buckets(chunks_per_round);
+
+        const std::size_t bytes_per_pair =
+          sizeof(std::pair<SparsityPatternBase::size_type,
+                           SparsityPatternBase::size_type>);
+        double pairs_per_cell = Utilities::fixed_power<2>(
+          double(dof.get_fe_collection().max_dofs_per_cell()));
+
+        std::vector<SparsityPatternBase::size_type> columns;
+        for (std::size_t round_begin = 0; round_begin < cells.size();)
+          {
+            const std::size_t cells_per_round = std::max<std::size_t>(
+              max_bytes_per_round /
+                (bytes_per_pair * std::max(pairs_per_cell, 1.)),
+              chunks_per_round);
+            const std::size_t round_end =
+              std::min(round_begin + cells_per_round, cells.size());
+            const std::size_t cells_per_round_chunk =
+              (round_end - round_begin + chunks_per_round - 1) /
+              chunks_per_round;
+
+            parallel::apply_to_subranges(
+              0U,
+              chunks_per_round,
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int chunk = begin; chunk < end; ++chunk)
+                  {
+                    const std::size_t first_cell =
+                      std::min(round_begin + chunk * cells_per_round_chunk,
+                               round_end);
+                    const std::size_t last_cell =
+                      std::min(first_cell + cells_per_round_chunk, round_end);
+                    for (std::size_t c = first_cell; c < last_cell; ++c)
+                      cell_worker(cells[c],
+                                  chunk_scratch_data[chunk],
+                                  collectors[chunk]);
+                  }
+              },
+              1);
+
+            std::size_t n_pairs = 0;
+            for (const EntryCollector &collector : collectors)
+              for (const auto &bucket : collector.buckets)
+                n_pairs += bucket.size();
+            pairs_per_cell = double(n_pairs) / (round_end - round_begin);
+            round_begin    = round_end;
+
+            parallel::apply_to_subranges(
+              0U,
+              chunks_per_round,
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int b = begin; b < end; ++b)
+                  {
+                    auto &entries = merged_buckets[b];
+                    entries.clear();
+                    for (EntryCollector &collector : collectors)
+                      {
+                        entries.insert(entries.end(),
+                                       collector.buckets[b].begin(),
+                                       collector.buckets[b].end());
+                        collector.buckets[b].clear();
+                      }
+                    std::sort(entries.begin(), entries.end());
+                    entries.erase(std::unique(entries.begin(), entries.end()),
+                                  entries.end());
+                  }
+              },
+              1);
+
+            for (const auto &entries : merged_buckets)
+              for (auto entry = entries.begin(); entry != entries.end();)
+                {
+                  const SparsityPatternBase::size_type row = entry->first;
+                  columns.clear();
+                  for (; entry != entries.end() && entry->first == row;
+                       ++entry)
+                    columns.push_back(entry->second);
+                  sparsity.add_row_entries(row,
+                                           make_array_view(columns),
+                                           true);
+                }
+          }
+      }
+    } // namespace
+  } // namespace internal
+
+
+
   template <int dim, int spacedim, typename number>
   void
   make_sparsity_pattern(const DoFHandler<dim, spacedim> &dof,
@@ -82,28 +330,26 @@ namespace DoFTools
                  "locally owned one does not make sense."));
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs);
-        }
+    internal::add_entries_on_cells(
+      dof,
+      subdomain_id,
+      sparsity,
+      [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+          internal::SparsityScratchData &scratch_data,
+          SparsityPatternBase           &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        const unsigned int dofs_per_cell = cell->get_fe().n_dofs_per_cell();
+        dofs_on_this_cell.resize(dofs_per_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs);
+      });
   }
 
 
@@ -167,33 +413,31 @@ namespace DoFTools
               bool_dof_mask[f](i, j) = true;
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell(
-      fe_collection.max_dofs_per_cell());
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const types::fe_index fe_index = cell->active_fe_index();
-          const unsigned int    dofs_per_cell =
-            fe_collection[fe_index].n_dofs_per_cell();
-
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs,
-                                                  bool_dof_mask[fe_index]);
-        }
+    internal::add_entries_on_cells(
+      dof,
+      subdomain_id,
+      sparsity,
+      [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+          internal::SparsityScratchData &scratch_data,
+          SparsityPatternBase           &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        const types::fe_index fe_index = cell->active_fe_index();
+        const unsigned int    dofs_per_cell =
+          fe_collection[fe_index].n_dofs_per_cell();
+
+        dofs_on_this_cell.resize(dofs_per_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs,
+                                                bool_dof_mask[fe_index]);
+      });
   }
 
 
@@ -555,139 +799,137 @@ namespace DoFTools
                  "locally owned one does not make sense."));
       }
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    std::vector<types::global_dof_index> dofs_on_other_cell;
-    dofs_on_this_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-    dofs_on_other_cell.reserve(dof.get_fe_collection().max_dofs_per_cell());
-
     // TODO: in an old implementation, we used user flags before to tag
     // faces that were already touched. this way, we could reduce the work
     // a little bit. now, we instead add only data from one side. this
     // should be OK, but we need to actually verify it.
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (const auto &cell : dof.active_cell_iterators())
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const unsigned int n_dofs_on_this_cell =
-            cell->get_fe().n_dofs_per_cell();
-          dofs_on_this_cell.resize(n_dofs_on_this_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs);
-
-          for (const unsigned int face : cell->face_indices())
-            {
-              typename DoFHandler<dim, spacedim>::face_iterator cell_face =
-                cell->face(face);
-              const bool periodic_neighbor = cell->has_periodic_neighbor(face);
-              if (!cell->at_boundary(face) || periodic_neighbor)
-                {
-                  typename DoFHandler<dim, spacedim>::level_cell_iterator
-                    neighbor = cell->neighbor_or_periodic_neighbor(face);
-
-                  // in 1d, we do not need to worry whether the neighbor
-                  // might have children and then loop over those children.
-                  // rather, we may as well go straight to the cell behind
-                  // this particular cell's most terminal child
-                  if (dim == 1)
-                    while (neighbor->has_children())
-                      neighbor = neighbor->child(face == 0 ? 1 : 0);
-
-                  if (neighbor->has_children())
-                    {
-                      for (unsigned int sub_nr = 0;
-                           sub_nr != cell_face->n_active_descendants();
-                           ++sub_nr)
-                        {
-                          const typename DoFHandler<dim, spacedim>::
-                            level_cell_iterator sub_neighbor =
-                              periodic_neighbor ?
-                                cell->periodic_neighbor_child_on_subface(
-                                  face, sub_nr) :
-                                cell->neighbor_child_on_subface(face, sub_nr);
-
-                          const unsigned int n_dofs_on_neighbor =
-                            sub_neighbor->get_fe().n_dofs_per_cell();
-                          dofs_on_other_cell.resize(n_dofs_on_neighbor);
-                          sub_neighbor->get_dof_indices(dofs_on_other_cell);
-
-                          constraints.add_entries_local_to_global(
-                            dofs_on_this_cell,
-                            dofs_on_other_cell,
-                            sparsity,
-                            keep_constrained_dofs);
+    internal::add_entries_on_cells(
+      dof,
+      subdomain_id,
+      sparsity,
+      [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+          internal::SparsityScratchData &scratch_data,
+          SparsityPatternBase           &cell_sparsity) {
+        std::vector<types::global_dof_index> &dofs_on_this_cell =
+          scratch_data.dofs_on_this_cell;
+        std::vector<types::global_dof_index> &dofs_on_other_cell =
+          scratch_data.dofs_on_other_cell;
+
+        const unsigned int n_dofs_on_this_cell =
+          cell->get_fe().n_dofs_per_cell();
+        dofs_on_this_cell.resize(n_dofs_on_this_cell);
+        cell->get_dof_indices(dofs_on_this_cell);
+
+        // make sparsity pattern for this cell. if no constraints pattern
+        // was given, then the following call acts as if simply no
+        // constraints existed
+        constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                cell_sparsity,
+                                                keep_constrained_dofs);
+
+        for (const unsigned int face : cell->face_indices())
+          {
+            typename DoFHandler<dim, spacedim>::face_iterator cell_face =
+              cell->face(face);
+            const bool periodic_neighbor = cell->has_periodic_neighbor(face);
+            if (!cell->at_boundary(face) || periodic_neighbor)
+              {
+                typename DoFHandler<dim, spacedim>::level_cell_iterator
+                  neighbor = cell->neighbor_or_periodic_neighbor(face);
+
+                // in 1d, we do not need to worry whether the neighbor
+                // might have children and then loop over those children.
+                // rather, we may as well go straight to the cell behind
+                // this particular cell's most terminal child
+                if (dim == 1)
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                if (neighbor->has_children())
+                  {
+                    for (unsigned int sub_nr = 0;
+                         sub_nr != cell_face->n_active_descendants();
+                         ++sub_nr)
+                      {
+                        const typename DoFHandler<dim, spacedim>::
+                          level_cell_iterator sub_neighbor =
+                            periodic_neighbor ?
+                              cell->periodic_neighbor_child_on_subface(
+                                face, sub_nr) :
+                              cell->neighbor_child_on_subface(face, sub_nr);
+
+                        const unsigned int n_dofs_on_neighbor =
+                          sub_neighbor->get_fe().n_dofs_per_cell();
+                        dofs_on_other_cell.resize(n_dofs_on_neighbor);
+                        sub_neighbor->get_dof_indices(dofs_on_other_cell);
+
+                        constraints.add_entries_local_to_global(
+                          dofs_on_this_cell,
+                          dofs_on_other_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        constraints.add_entries_local_to_global(
+                          dofs_on_other_cell,
+                          dofs_on_this_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        // only need to add this when the neighbor is not
+                        // owned by the current processor, otherwise we add
+                        // the entries for the neighbor there
+                        if (sub_neighbor->subdomain_id() !=
+                            cell->subdomain_id())
                           constraints.add_entries_local_to_global(
                             dofs_on_other_cell,
-                            dofs_on_this_cell,
-                            sparsity,
+                            cell_sparsity,
                             keep_constrained_dofs);
-                          // only need to add this when the neighbor is not
-                          // owned by the current processor, otherwise we add
-                          // the entries for the neighbor there
-                          if (sub_neighbor->subdomain_id() !=
-                              cell->subdomain_id())
-                            constraints.add_entries_local_to_global(
-                              dofs_on_other_cell,
-                              sparsity,
-                              keep_constrained_dofs);
-                        }
-                    }
-                  else
-                    {
-                      // Refinement edges are taken care of by coarser
-                      // cells
-                      if ((!periodic_neighbor &&
-                           cell->neighbor_is_coarser(face)) ||
-                          (periodic_neighbor &&
-                           cell->periodic_neighbor_is_coarser(face)))
-                        if (neighbor->subdomain_id() == cell->subdomain_id())
-                          continue;
-
-                      const unsigned int n_dofs_on_neighbor =
-                        neighbor->get_fe().n_dofs_per_cell();
-                      dofs_on_other_cell.resize(n_dofs_on_neighbor);
-
-                      neighbor->get_dof_indices(dofs_on_other_cell);
-
-                      constraints.add_entries_local_to_global(
-                        dofs_on_this_cell,
-                        dofs_on_other_cell,
-                        sparsity,
-                        keep_constrained_dofs);
-
-                      // only need to add these in case the neighbor cell
-                      // is not locally owned - otherwise, we touch each
-                      // face twice and hence put the indices the other way
-                      // around
-                      if (!cell->neighbor_or_periodic_neighbor(face)
-                             ->is_active() ||
-                          (neighbor->subdomain_id() != cell->subdomain_id()))
-                        {
+                      }
+                  }
+                else
+                  {
+                    // Refinement edges are taken care of by coarser
+                    // cells
+                    if ((!periodic_neighbor &&
+                         cell->neighbor_is_coarser(face)) ||
+                        (periodic_neighbor &&
+                         cell->periodic_neighbor_is_coarser(face)))
+                      if (neighbor->subdomain_id() == cell->subdomain_id())
+                        continue;
+
+                    const unsigned int n_dofs_on_neighbor =
+                      neighbor->get_fe().n_dofs_per_cell();
+                    dofs_on_other_cell.resize(n_dofs_on_neighbor);
+
+                    neighbor->get_dof_indices(dofs_on_other_cell);
+
+                    constraints.add_entries_local_to_global(
+                      dofs_on_this_cell,
+                      dofs_on_other_cell,
+                      cell_sparsity,
+                      keep_constrained_dofs);
+
+                    // only need to add these in case the neighbor cell
+                    // is not locally owned - otherwise, we touch each
+                    // face twice and hence put the indices the other way
+                    // around
+                    if (!cell->neighbor_or_periodic_neighbor(face)
+                           ->is_active() ||
+                        (neighbor->subdomain_id() != cell->subdomain_id()))
+                      {
+                        constraints.add_entries_local_to_global(
+                          dofs_on_other_cell,
+                          dofs_on_this_cell,
+                          cell_sparsity,
+                          keep_constrained_dofs);
+                        if (neighbor->subdomain_id() != cell->subdomain_id())
                           constraints.add_entries_local_to_global(
                             dofs_on_other_cell,
-                            dofs_on_this_cell,
-                            sparsity,
+                            cell_sparsity,
                             keep_constrained_dofs);
-                          if (neighbor->subdomain_id() != cell->subdomain_id())
-                            constraints.add_entries_local_to_global(
-                              dofs_on_other_cell,
-                              sparsity,
-                              keep_constrained_dofs);
-                        }
-                    }
-                }
-            }
-        }
+                      }
+                  }
+              }
+          }
+      });
   }
 
 
@@ -864,19 +1106,9 @@ namespace DoFTools
           bool(const typename DoFHandler<dim, spacedim>::active_cell_iterator &,
                const unsigned int)> &face_has_flux_coupling)
       {
-        std::vector<types::global_dof_index> rows;
-        std::vector<std::pair<SparsityPatternBase::size_type,
-                              SparsityPatternBase::size_type>>
-          cell_entries;
-
         const dealii::hp::FECollection<dim, spacedim> &fe =
           dof.get_fe_collection();
 
-        std::vector<types::global_dof_index> dofs_on_this_cell(
-          dof.get_fe_collection().max_dofs_per_cell());
-        std::vector<types::global_dof_index> dofs_on_other_cell(
-          dof.get_fe_collection().max_dofs_per_cell());
-
         const unsigned int n_components = fe.n_components();
         AssertDimension(int_mask.size(0), n_components);
         AssertDimension(int_mask.size(1), n_components);
@@ -912,116 +1144,157 @@ namespace DoFTools
                   bool_int_and_flux_dof_mask[f](i, j) = true;
           }
 
+        // face_has_flux_coupling is provided by the user and need not be
+        // thread-safe, so evaluate it on all interior faces of the cells we
+        // work on before the (possibly parallel) loop over the cells. The
+        // default function always returns true and does not need this.
+        using FaceCouplingFunction =
+          bool (*)(const typename DoFHandler<dim, spacedim>::
+                     active_cell_iterator &,
+                   const unsigned int);
+        const FaceCouplingFunction *const face_coupling_function =
+          face_has_flux_coupling.template target<FaceCouplingFunction>();
+        const bool couple_on_all_faces =
+          (face_coupling_function != nullptr) &&
+          (*face_coupling_function == &always_couple_on_faces<dim, spacedim>);
+
+        Table<2, bool> face_has_coupling;
+        if (couple_on_all_faces == false)
+          {
+            face_has_coupling.reinit(dof.get_triangulation().n_active_cells(),
+                                     GeometryInfo<dim>::faces_per_cell);
+            for (const auto &cell : dof.active_cell_iterators())
+              if (((subdomain_id == numbers::invalid_subdomain_id) ||
+                   (subdomain_id == cell->subdomain_id())) &&
+                  cell->is_locally_owned())
+                for (const unsigned int face : cell->face_indices())
+                  if (!cell->at_boundary(face) ||
+                      cell->has_periodic_neighbor(face))
+                    face_has_coupling(cell->active_cell_index(), face) =
+                      face_has_flux_coupling(cell, face);
+          }
 
-        for (const auto &cell : dof.active_cell_iterators())
-          if (((subdomain_id == numbers::invalid_subdomain_id) ||
-               (subdomain_id == cell->subdomain_id())) &&
-              cell->is_locally_owned())
-            {
-              dofs_on_this_cell.resize(cell->get_fe().n_dofs_per_cell());
-              cell->get_dof_indices(dofs_on_this_cell);
-
-              // make sparsity pattern for this cell also taking into
-              // account the couplings due to face contributions on the same
-              // cell
-              constraints.add_entries_local_to_global(
-                dofs_on_this_cell,
-                sparsity,
-                keep_constrained_dofs,
-                bool_int_and_flux_dof_mask[cell->active_fe_index()]);
-
-              // Loop over interior faces
-              for (const unsigned int face : cell->face_indices())
-                {
-                  const bool periodic_neighbor =
-                    cell->has_periodic_neighbor(face);
-
-                  if ((!cell->at_boundary(face)) || periodic_neighbor)
-                    {
-                      typename DoFHandler<dim, spacedim>::level_cell_iterator
-                        neighbor = cell->neighbor_or_periodic_neighbor(face);
-
-                      // If the cells are on the same level (and both are
-                      // active, locally-owned cells) then only add to the
-                      // sparsity pattern if the current cell is 'greater' in
-                      // the total ordering.
-                      if (neighbor->level() == cell->level() &&
-                          neighbor->index() > cell->index() &&
-                          neighbor->is_active() && neighbor->is_locally_owned())
-                        continue;
-
-                      // If we are more refined then the neighbor, then we
-                      // will automatically find the active neighbor cell when
-                      // we call 'neighbor (face)' above. The opposite is not
-                      // true; if the neighbor is more refined then the call
-                      // 'neighbor (face)' will *not* return an active
-                      // cell. Hence, only add things to the sparsity pattern
-                      // if (when the levels are different) the neighbor is
-                      // coarser than the current cell, except in the case
-                      // when the neighbor is not locally owned.
-                      if (neighbor->level() != cell->level() &&
-                          ((!periodic_neighbor &&
-                            !cell->neighbor_is_coarser(face)) ||
-                           (periodic_neighbor &&
-                            !cell->periodic_neighbor_is_coarser(face))) &&
-                          neighbor->is_locally_owned())
-                        continue; // (the neighbor is finer)
-
-                      if (!face_has_flux_coupling(cell, face))
-                        continue;
+        add_entries_on_cells(
+          dof,
+          subdomain_id,
+          sparsity,
+          [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                                  &cell,
+              SparsityScratchData &scratch_data,
+              SparsityPatternBase &cell_sparsity) {
+            std::vector<types::global_dof_index> &dofs_on_this_cell =
+              scratch_data.dofs_on_this_cell;
+            std::vector<types::global_dof_index> &dofs_on_other_cell =
+              scratch_data.dofs_on_other_cell;
+            std::vector<std::pair<SparsityPatternBase::size_type,
+                                  SparsityPatternBase::size_type>>
+              &cell_entries = scratch_data.cell_entries;
+
+            dofs_on_this_cell.resize(cell->get_fe().n_dofs_per_cell());
+            cell->get_dof_indices(dofs_on_this_cell);
+
+            // make sparsity pattern for this cell also taking into
+            // account the couplings due to face contributions on the same
+            // cell
+            constraints.add_entries_local_to_global(
+              dofs_on_this_cell,
+              cell_sparsity,
+              keep_constrained_dofs,
+              bool_int_and_flux_dof_mask[cell->active_fe_index()]);
+
+            // Loop over interior faces
+            for (const unsigned int face : cell->face_indices())
+              {
+                const bool periodic_neighbor =
+                  cell->has_periodic_neighbor(face);
 
-                      const unsigned int neighbor_face_no =
-                        periodic_neighbor ?
-                          cell->periodic_neighbor_face_no(face) :
-                          cell->neighbor_face_no(face);
-
-                      // In 1d, go straight to the cell behind this
-                      // particular cell's most terminal cell. This makes us
-                      // skip the if (neighbor->has_children()) section
-                      // below. We need to do this since we otherwise
-                      // iterate over the children of the face, which are
-                      // always 0 in 1d.
-                      if (dim == 1)
-                        while (neighbor->has_children())
-                          neighbor = neighbor->child(face == 0 ? 1 : 0);
-
-                      if (neighbor->has_children())
-                        {
-                          for (unsigned int sub_nr = 0;
-                               sub_nr != cell->face(face)->n_children();
-                               ++sub_nr)
-                            {
-                              const typename DoFHandler<dim, spacedim>::
-                                level_cell_iterator sub_neighbor =
-                                  periodic_neighbor ?
-                                    cell->periodic_neighbor_child_on_subface(
-                                      face, sub_nr) :
-                                    cell->neighbor_child_on_subface(face,
-                                                                    sub_nr);
-                              add_cell_entries(cell,
-                                               face,
-                                               sub_neighbor,
-                                               neighbor_face_no,
-                                               flux_mask,
-                                               dofs_on_this_cell,
-                                               dofs_on_other_cell,
-                                               cell_entries);
-                            }
-                        }
-                      else
-                        add_cell_entries(cell,
-                                         face,
-                                         neighbor,
-                                         neighbor_face_no,
-                                         flux_mask,
-                                         dofs_on_this_cell,
-                                         dofs_on_other_cell,
-                                         cell_entries);
-                    }
-                }
-              sparsity.add_entries(make_array_view(cell_entries));
-              cell_entries.clear();
-            }
+                if ((!cell->at_boundary(face)) || periodic_neighbor)
+                  {
+                    typename DoFHandler<dim, spacedim>::level_cell_iterator
+                      neighbor = cell->neighbor_or_periodic_neighbor(face);
+
+                    // If the cells are on the same level (and both are
+                    // active, locally-owned cells) then only add to the
+                    // sparsity pattern if the current cell is 'greater' in
+                    // the total ordering.
+                    if (neighbor->level() == cell->level() &&
+                        neighbor->index() > cell->index() &&
+                        neighbor->is_active() && neighbor->is_locally_owned())
+                      continue;
+
+                    // If we are more refined then the neighbor, then we
+                    // will automatically find the active neighbor cell when
+                    // we call 'neighbor (face)' above. The opposite is not
+                    // true; if the neighbor is more refined then the call
+                    // 'neighbor (face)' will *not* return an active
+                    // cell. Hence, only add things to the sparsity pattern
+                    // if (when the levels are different) the neighbor is
+                    // coarser than the current cell, except in the case
+                    // when the neighbor is not locally owned.
+                    if (neighbor->level() != cell->level() &&
+                        ((!periodic_neighbor &&
+                          !cell->neighbor_is_coarser(face)) ||
+                         (periodic_neighbor &&
+                          !cell->periodic_neighbor_is_coarser(face))) &&
+                        neighbor->is_locally_owned())
+                      continue; // (the neighbor is finer)
+
+                    if (!couple_on_all_faces &&
+                        !face_has_coupling(cell->active_cell_index(), face))
+                      continue;
+
+                    const unsigned int neighbor_face_no =
+                      periodic_neighbor ?
+                        cell->periodic_neighbor_face_no(face) :
+                        cell->neighbor_face_no(face);
+
+                    // In 1d, go straight to the cell behind this
+                    // particular cell's most terminal cell. This makes us
+                    // skip the if (neighbor->has_children()) section
+                    // below. We need to do this since we otherwise
+                    // iterate over the children of the face, which are
+                    // always 0 in 1d.
+                    if (dim == 1)
+                      while (neighbor->has_children())
+                        neighbor = neighbor->child(face == 0 ? 1 : 0);
+
+                    if (neighbor->has_children())
+                      {
+                        for (unsigned int sub_nr = 0;
+                             sub_nr != cell->face(face)->n_children();
+                             ++sub_nr)
+                          {
+                            const typename DoFHandler<dim, spacedim>::
+                              level_cell_iterator sub_neighbor =
+                                periodic_neighbor ?
+                                  cell->periodic_neighbor_child_on_subface(
+                                    face, sub_nr) :
+                                  cell->neighbor_child_on_subface(face,
+                                                                  sub_nr);
+                            add_cell_entries(cell,
+                                             face,
+                                             sub_neighbor,
+                                             neighbor_face_no,
+                                             flux_mask,
+                                             dofs_on_this_cell,
+                                             dofs_on_other_cell,
+                                             cell_entries);
+                          }
+                      }
+                    else
+                      add_cell_entries(cell,
+                                       face,
+                                       neighbor,
+                                       neighbor_face_no,
+                                       flux_mask,
+                                       dofs_on_this_cell,
+                                       dofs_on_other_cell,
+                                       cell_entries);
+                  }
+              }
+            cell_sparsity.add_entries(make_array_view(cell_entries));
+            cell_entries.clear();
+          });
       }
     } // namespace
 
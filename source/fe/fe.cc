@@ -135,16 +135,18 @@ FiniteElement<dim, spacedim>::FiniteElement(
   // constructor of FullMatrix<dim> initializes them with size zero
   prolongation.resize(RefinementCase<dim>::isotropic_refinement);
   restriction.resize(RefinementCase<dim>::isotropic_refinement);
+  prolongation_is_computed.resize(RefinementCase<dim>::isotropic_refinement);
+  restriction_is_computed.resize(RefinementCase<dim>::isotropic_refinement);
   for (const unsigned int ref_case :
        RefinementCase<dim>::all_refinement_cases())
     if (ref_case != RefinementCase<dim>::no_refinement)
       {
-        prolongation[ref_case - 1].resize(this->reference_cell().n_children(
-                                            RefinementCase<dim>(ref_case)),
-                                          FullMatrix<double>());
-        restriction[ref_case - 1].resize(this->reference_cell().n_children(
-                                           RefinementCase<dim>(ref_case)),
-                                         FullMatrix<double>());
+        const unsigned int n_children =
+          this->reference_cell().n_children(RefinementCase<dim>(ref_case));
+        prolongation[ref_case - 1].resize(n_children, FullMatrix<double>());
+        restriction[ref_case - 1].resize(n_children, FullMatrix<double>());
+        prolongation_is_computed[ref_case - 1].resize(n_children);
+        restriction_is_computed[ref_case - 1].resize(n_children);
       }
 
 
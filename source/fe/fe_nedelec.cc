@@ -100,6 +100,25 @@ FE_Nedelec<dim>::FE_Nedelec(const unsigned int order)
   // initialized on demand in get_restriction_matrix and
   // get_prolongation_matrix
 
+  // The matrices of the interface constraints only depend on the degree of
+  // the element, so we take them from the process-wide cache of FETools if
+  // another element of the same degree has computed them before
+  this->interface_constraints =
+    (*FETools::MatrixCache::get_or_compute(
+       FE_Nedelec<dim>::get_name() + ":interface_constraints",
+       this->n_dofs_per_cell(),
+       [this]() {
+         initialize_interface_constraints();
+         return FETools::MatrixCache::MatrixSet{{this->interface_constraints}};
+       }))[0][0];
+}
+
+
+
+template <int dim>
+void
+FE_Nedelec<dim>::initialize_interface_constraints()
+{
 #ifdef DEBUG_NEDELEC
   deallog << "Face Embedding" << std::endl;
 #endif
@@ -119,7 +138,7 @@ FE_Nedelec<dim>::FE_Nedelec(const unsigned int order)
     face_embeddings,
     0,
     0,
-    internal::FE_Nedelec::get_embedding_computation_tolerance(order));
+    internal::FE_Nedelec::get_embedding_computation_tolerance(this->degree - 1));
 
   switch (dim)
     {
@@ -3017,6 +3036,59 @@ FE_Nedelec<dim>::get_subface_interpolation_matrix(
     }
 }
 
+template <int dim>
+void
+FE_Nedelec<dim>::ensure_refinement_matrices_are_computed() const
+{
+  // all prolongation and restriction matrices are computed together the
+  // first time one of them is requested. the check whether this has
+  // happened is lock-free, and concurrent first requests wait for the one
+  // thread that computes the matrices
+  refinement_matrices_are_computed.ensure_initialized([this]() {
+    // now do the work. need to get a non-const version of data in order to
+    // be able to modify them inside a const function
+    FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim> &>(*this);
+
+    // Reinit the vectors of
+    // restriction and prolongation
+    // matrices to the right sizes.
+    // Restriction only for isotropic
+    // refinement
+#ifdef DEBUG_NEDELEC
+    deallog << "Embedding" << std::endl;
+#endif
+    this_nonconst.reinit_restriction_and_prolongation_matrices();
+    // Fill prolongation matrices with embedding operators, unless another
+    // element of the same degree has already put them into the cache
+    this_nonconst.prolongation = *FETools::MatrixCache::get_or_compute(
+      get_name() + ":prolongation",
+      this->n_dofs_per_cell(),
+      [this, &this_nonconst]() {
+        FETools::compute_embedding_matrices(
+          this_nonconst,
+          this_nonconst.prolongation,
+          true,
+          internal::FE_Nedelec::get_embedding_computation_tolerance(
+            this->degree));
+        return this_nonconst.prolongation;
+      });
+#ifdef DEBUG_NEDELEC
+    deallog << "Restriction" << std::endl;
+#endif
+    this_nonconst.restriction = *FETools::MatrixCache::get_or_compute(
+      get_name() + ":restriction",
+      this->n_dofs_per_cell(),
+      [&this_nonconst]() {
+        this_nonconst.initialize_restriction();
+        return this_nonconst.restriction;
+      });
+
+    return true;
+  });
+}
+
+
+
 template <int dim>
 const FullMatrix<double> &
 FE_Nedelec<dim>::get_prolongation_matrix(
@@ -3031,40 +3103,7 @@ FE_Nedelec<dim>::get_prolongation_matrix(
   AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
 
   // initialization upon first request
-  if (this->prolongation[refinement_case - 1][child].n() == 0)
-    {
-      std::lock_guard<std::mutex> lock(prolongation_matrix_mutex);
-
-      // if matrix got updated while waiting for the lock
-      if (this->prolongation[refinement_case - 1][child].n() ==
-          this->n_dofs_per_cell())
-        return this->prolongation[refinement_case - 1][child];
-
-      // now do the work. need to get a non-const version of data in order to
-      // be able to modify them inside a const function
-      FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim> &>(*this);
-
-      // Reinit the vectors of
-      // restriction and prolongation
-      // matrices to the right sizes.
-      // Restriction only for isotropic
-      // refinement
-#ifdef DEBUG_NEDELEC
-      deallog << "Embedding" << std::endl;
-#endif
-      this_nonconst.reinit_restriction_and_prolongation_matrices();
-      // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices(
-        this_nonconst,
-        this_nonconst.prolongation,
-        true,
-        internal::FE_Nedelec::get_embedding_computation_tolerance(
-          this->degree));
-#ifdef DEBUG_NEDELEC
-      deallog << "Restriction" << std::endl;
-#endif
-      this_nonconst.initialize_restriction();
-    }
+  ensure_refinement_matrices_are_computed();
 
   // we use refinement_case-1 here. the -1 takes care of the origin of the
   // vector, as for RefinementCase<dim>::no_refinement (=0) there is no data
@@ -3087,40 +3126,7 @@ FE_Nedelec<dim>::get_restriction_matrix(
     child, GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)));
 
   // initialization upon first request
-  if (this->restriction[refinement_case - 1][child].n() == 0)
-    {
-      std::lock_guard<std::mutex> lock(restriction_matrix_mutex);
-
-      // if matrix got updated while waiting for the lock...
-      if (this->restriction[refinement_case - 1][child].n() ==
-          this->n_dofs_per_cell())
-        return this->restriction[refinement_case - 1][child];
-
-      // now do the work. need to get a non-const version of data in order to
-      // be able to modify them inside a const function
-      FE_Nedelec<dim> &this_nonconst = const_cast<FE_Nedelec<dim> &>(*this);
-
-      // Reinit the vectors of
-      // restriction and prolongation
-      // matrices to the right sizes.
-      // Restriction only for isotropic
-      // refinement
-#ifdef DEBUG_NEDELEC
-      deallog << "Embedding" << std::endl;
-#endif
-      this_nonconst.reinit_restriction_and_prolongation_matrices();
-      // Fill prolongation matrices with embedding operators
-      FETools::compute_embedding_matrices(
-        this_nonconst,
-        this_nonconst.prolongation,
-        true,
-        internal::FE_Nedelec::get_embedding_computation_tolerance(
-          this->degree));
-#ifdef DEBUG_NEDELEC
-      deallog << "Restriction" << std::endl;
-#endif
-      this_nonconst.initialize_restriction();
-    }
+  ensure_refinement_matrices_are_computed();
 
   // we use refinement_case-1 here. the -1 takes care of the origin of the
   // vector, as for RefinementCase<dim>::no_refinement (=0) there is no data
@@ -1253,15 +1253,8 @@ FE_Q_Base<dim, spacedim>::get_prolongation_matrix(
   AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
 
   // initialization upon first request
-  if (this->prolongation[refinement_case - 1][child].n() == 0)
-    {
-      std::lock_guard<std::mutex> lock(prolongation_matrix_mutex);
-
-      // if matrix got updated while waiting for the lock
-      if (this->prolongation[refinement_case - 1][child].n() ==
-          this->n_dofs_per_cell())
-        return this->prolongation[refinement_case - 1][child];
-
+  return this->get_or_compute_prolongation_matrix(
+    child, refinement_case, [&]() {
       // distinguish q/q_dg0 case: only treat Q dofs first
       const unsigned int q_dofs_per_cell =
         Utilities::fixed_power<dim>(q_degree + 1);
@@ -1427,13 +1420,8 @@ FE_Q_Base<dim, spacedim>::get_prolongation_matrix(
         }
 #  endif
 
-      // move result into place
-      const_cast<FullMatrix<double> &>(
-        this->prolongation[refinement_case - 1][child]) = std::move(prolongate);
-    }
-
-  // finally return the matrix
-  return this->prolongation[refinement_case - 1][child];
+      return prolongate;
+    });
 }
 
 
@@ -1452,15 +1440,8 @@ FE_Q_Base<dim, spacedim>::get_restriction_matrix(
   AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
 
   // initialization upon first request
-  if (this->restriction[refinement_case - 1][child].n() == 0)
-    {
-      std::lock_guard<std::mutex> lock(restriction_matrix_mutex);
-
-      // if matrix got updated while waiting for the lock...
-      if (this->restriction[refinement_case - 1][child].n() ==
-          this->n_dofs_per_cell())
-        return this->restriction[refinement_case - 1][child];
-
+  return this->get_or_compute_restriction_matrix(
+    child, refinement_case, [&]() {
       FullMatrix<double> my_restriction(this->n_dofs_per_cell(),
                                         this->n_dofs_per_cell());
       // distinguish q/q_dg0 case
@@ -1567,13 +1548,8 @@ FE_Q_Base<dim, spacedim>::get_restriction_matrix(
                      RefinementCase<dim>(refinement_case));
         }
 
-      // move result into place
-      const_cast<FullMatrix<double> &>(
-        this->restriction[refinement_case - 1][child]) =
-        std::move(my_restriction);
-    }
-
-  return this->restriction[refinement_case - 1][child];
+      return my_restriction;
+    });
 }
 
 
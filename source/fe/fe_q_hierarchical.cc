@@ -107,9 +107,11 @@ FE_Q_Hierarchical<dim>::FE_Q_Hierarchical(const unsigned int degree)
   build_dofs_cell(dofs_cell, dofs_subcell);
 
   // then use them to initialize
-  // other fields
+  // other fields. the embedding and
+  // restriction matrices are only
+  // computed when they are first
+  // requested
   initialize_constraints(dofs_subcell);
-  initialize_embedding_and_restriction(dofs_cell, dofs_subcell);
 
   // finally fill in support points
   // on cell and face
@@ -204,14 +206,42 @@ FE_Q_Hierarchical<dim>::get_prolongation_matrix(
   const unsigned int         child,
   const RefinementCase<dim> &refinement_case) const
 {
-  Assert(
-    refinement_case == RefinementCase<dim>::isotropic_refinement,
-    ExcMessage(
-      "Prolongation matrices are only available for isotropic refinement!"));
+  AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
+
+  // only isotropic prolongation matrices are implemented; the ones for
+  // anisotropic refinement remain empty
+  if (refinement_case != RefinementCase<dim>::isotropic_refinement)
+    return this->prolongation[refinement_case - 1][child];
+
+  return this->get_or_compute_prolongation_matrix(
+    child, refinement_case, [this, child]() {
+      std::vector<FullMatrix<double>> dofs_cell, dofs_subcell;
+      build_dofs_cell(dofs_cell, dofs_subcell);
+      return compute_embedding_or_restriction(dofs_subcell, child);
+    });
+}
+
 
+
+template <int dim>
+const FullMatrix<double> &
+FE_Q_Hierarchical<dim>::get_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
   AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
 
-  return this->prolongation[refinement_case - 1][child];
+  // only isotropic restriction matrices are implemented; the ones for
+  // anisotropic refinement remain empty
+  if (refinement_case != RefinementCase<dim>::isotropic_refinement)
+    return this->restriction[refinement_case - 1][child];
+
+  return this->get_or_compute_restriction_matrix(
+    child, refinement_case, [this, child]() {
+      std::vector<FullMatrix<double>> dofs_cell, dofs_subcell;
+      build_dofs_cell(dofs_cell, dofs_subcell);
+      return compute_embedding_or_restriction(dofs_cell, child);
+    });
 }
 
 
@@ -673,140 +703,55 @@ FE_Q_Hierarchical<dim>::initialize_constraints(
 
 
 template <int dim>
-void
-FE_Q_Hierarchical<dim>::initialize_embedding_and_restriction(
-  const std::vector<FullMatrix<double>> &dofs_cell,
-  const std::vector<FullMatrix<double>> &dofs_subcell)
+FullMatrix<double>
+FE_Q_Hierarchical<dim>::compute_embedding_or_restriction(
+  const std::vector<FullMatrix<double>> &matrices_1d,
+  const unsigned int                     child) const
 {
-  unsigned int iso = RefinementCase<dim>::isotropic_refinement - 1;
-
-  const unsigned int dofs_1d =
-    2 * this->n_dofs_per_vertex() + this->n_dofs_per_line();
-  TensorProductPolynomials<dim> *poly_space_derived_ptr =
-    dynamic_cast<TensorProductPolynomials<dim> *>(this->poly_space.get());
-  const std::vector<unsigned int> &renumber =
-    poly_space_derived_ptr->get_numbering();
-
-  for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell; ++c)
-    {
-      this->prolongation[iso][c].reinit(this->n_dofs_per_cell(),
-                                        this->n_dofs_per_cell());
-      this->restriction[iso][c].reinit(this->n_dofs_per_cell(),
-                                       this->n_dofs_per_cell());
-    }
-
   // the 1d case is particularly
   // simple, so special case it:
   if (dim == 1)
-    {
-      for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell;
-           ++c)
-        {
-          this->prolongation[iso][c].fill(dofs_subcell[c]);
-          this->restriction[iso][c].fill(dofs_cell[c]);
-        }
-      return;
-    }
-
-  // for higher dimensions, things
-  // are a little more tricky:
-
+    return matrices_1d[child];
+
+  // for higher dimensions, the
+  // matrix is the tensor product of
+  // the 1d matrices of the left or
+  // right subcell in each direction,
+  // as given by the bits of the
+  // child index.
+  //
   // j loops over dofs in the
-  // subcell.  These are the rows in
+  // subcell. These are the rows in
   // the embedding matrix.
   //
   // i loops over the dofs in the
   // parent cell. These are the
   // columns in the embedding matrix.
+  const unsigned int dofs_1d =
+    2 * this->n_dofs_per_vertex() + this->n_dofs_per_line();
+  const TensorProductPolynomials<dim> *poly_space_derived_ptr =
+    dynamic_cast<const TensorProductPolynomials<dim> *>(
+      this->poly_space.get());
+  const std::vector<unsigned int> &renumber =
+    poly_space_derived_ptr->get_numbering();
+
+  FullMatrix<double> matrix(this->n_dofs_per_cell(), this->n_dofs_per_cell());
   for (unsigned int j = 0; j < this->n_dofs_per_cell(); ++j)
     for (unsigned int i = 0; i < this->n_dofs_per_cell(); ++i)
-      switch (dim)
-        {
-          case 2:
-            {
-              for (unsigned int c = 0;
-                   c < GeometryInfo<2>::max_children_per_cell;
-                   ++c)
-                {
-                  // left/right line: 0/1
-                  const unsigned int c0 = c % 2;
-                  // bottom/top line: 0/1
-                  const unsigned int c1 = c / 2;
-
-                  this->prolongation[iso][c](j, i) =
-                    dofs_subcell[c0](renumber[j] % dofs_1d,
-                                     renumber[i] % dofs_1d) *
-                    dofs_subcell[c1]((renumber[j] - (renumber[j] % dofs_1d)) /
-                                       dofs_1d,
-                                     (renumber[i] - (renumber[i] % dofs_1d)) /
-                                       dofs_1d);
-
-                  this->restriction[iso][c](j, i) =
-                    dofs_cell[c0](renumber[j] % dofs_1d,
-                                  renumber[i] % dofs_1d) *
-                    dofs_cell[c1]((renumber[j] - (renumber[j] % dofs_1d)) /
-                                    dofs_1d,
-                                  (renumber[i] - (renumber[i] % dofs_1d)) /
-                                    dofs_1d);
-                }
-              break;
-            }
-
-          case 3:
-            {
-              for (unsigned int c = 0;
-                   c < GeometryInfo<3>::max_children_per_cell;
-                   ++c)
-                {
-                  // left/right face: 0/1
-                  const unsigned int c0 = c % 2;
-                  // front/back face: 0/1
-                  const unsigned int c1 = (c % 4) / 2;
-                  // bottom/top face: 0/1
-                  const unsigned int c2 = c / 4;
-
-                  this->prolongation[iso][c](j, i) =
-                    dofs_subcell[c0](renumber[j] % dofs_1d,
-                                     renumber[i] % dofs_1d) *
-                    dofs_subcell[c1](
-                      ((renumber[j] - (renumber[j] % dofs_1d)) / dofs_1d) %
-                        dofs_1d,
-                      ((renumber[i] - (renumber[i] % dofs_1d)) / dofs_1d) %
-                        dofs_1d) *
-                    dofs_subcell[c2](
-                      ((renumber[j] - (renumber[j] % dofs_1d)) / dofs_1d -
-                       (((renumber[j] - (renumber[j] % dofs_1d)) / dofs_1d) %
-                        dofs_1d)) /
-                        dofs_1d,
-                      ((renumber[i] - (renumber[i] % dofs_1d)) / dofs_1d -
-                       (((renumber[i] - (renumber[i] % dofs_1d)) / dofs_1d) %
-                        dofs_1d)) /
-                        dofs_1d);
-
-                  this->restriction[iso][c](j, i) =
-                    dofs_cell[c0](renumber[j] % dofs_1d,
-                                  renumber[i] % dofs_1d) *
-                    dofs_cell[c1](
-                      ((renumber[j] - (renumber[j] % dofs_1d)) / dofs_1d) %
-                        dofs_1d,
-                      ((renumber[i] - (renumber[i] % dofs_1d)) / dofs_1d) %
-                        dofs_1d) *
-                    dofs_cell[c2](
-                      ((renumber[j] - (renumber[j] % dofs_1d)) / dofs_1d -
-                       (((renumber[j] - (renumber[j] % dofs_1d)) / dofs_1d) %
-                        dofs_1d)) /
-                        dofs_1d,
-                      ((renumber[i] - (renumber[i] % dofs_1d)) / dofs_1d -
-                       (((renumber[i] - (renumber[i] % dofs_1d)) / dofs_1d) %
-                        dofs_1d)) /
-                        dofs_1d);
-                }
-              break;
-            }
-
-          default:
-            DEAL_II_NOT_IMPLEMENTED();
-        }
+      {
+        unsigned int index_j = renumber[j];
+        unsigned int index_i = renumber[i];
+        double       value   = 1.;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            value *= matrices_1d[(child >> d) & 1](index_j % dofs_1d,
+                                                   index_i % dofs_1d);
+            index_j /= dofs_1d;
+            index_i /= dofs_1d;
+          }
+        matrix(j, i) = value;
+      }
+  return matrix;
 }
 
 
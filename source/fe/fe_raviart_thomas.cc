@@ -65,12 +65,24 @@ FE_RaviartThomas<dim>::FE_RaviartThomas(const unsigned int deg)
   // are required for interpolation.
   initialize_support_points(deg);
 
+  // The matrices computed below only depend on the degree of the element,
+  // so we take them from the process-wide cache of FETools if another
+  // element of the same degree has computed them before
+  const std::string name = FE_RaviartThomas<dim>::get_name();
+
   // Now compute the inverse node matrix, generating the correct
   // basis functions from the raw ones. For a discussion of what
   // exactly happens here, see FETools::compute_node_matrix.
-  const FullMatrix<double> M = FETools::compute_node_matrix(*this);
-  this->inverse_node_matrix.reinit(n_dofs, n_dofs);
-  this->inverse_node_matrix.invert(M);
+  this->inverse_node_matrix =
+    (*FETools::MatrixCache::get_or_compute(
+       name + ":inverse_node_matrix",
+       n_dofs,
+       [this, n_dofs]() {
+         const FullMatrix<double> M = FETools::compute_node_matrix(*this);
+         FullMatrix<double>       inverse(n_dofs, n_dofs);
+         inverse.invert(M);
+         return FETools::MatrixCache::MatrixSet{{inverse}};
+       }))[0][0];
   // From now on, the shape functions provided by FiniteElement::shape_value
   // and similar functions will be the correct ones, not
   // the raw shape functions from the polynomial space anymore.
@@ -82,35 +94,55 @@ FE_RaviartThomas<dim>::FE_RaviartThomas(const unsigned int deg)
   // refinement
   this->reinit_restriction_and_prolongation_matrices(true);
   // Fill prolongation matrices with embedding operators
-  FETools::compute_embedding_matrices(*this, this->prolongation);
-  initialize_restriction();
+  this->prolongation = *FETools::MatrixCache::get_or_compute(
+    name + ":prolongation", n_dofs, [this]() {
+      FETools::compute_embedding_matrices(*this, this->prolongation);
+      return this->prolongation;
+    });
+  this->restriction = *FETools::MatrixCache::get_or_compute(
+    name + ":restriction", n_dofs, [this]() {
+      initialize_restriction();
+      return this->restriction;
+    });
 
   // TODO: the implementation makes the assumption that all faces have the
   // same number of dofs
   AssertDimension(this->n_unique_faces(), 1);
-  const unsigned int face_no = 0;
 
-  // TODO[TL]: for anisotropic refinement we will probably need a table of
-  // submatrices with an array for each refine case
-  FullMatrix<double> face_embeddings[GeometryInfo<dim>::max_children_per_face];
-  for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face; ++i)
-    face_embeddings[i].reinit(this->n_dofs_per_face(face_no),
-                              this->n_dofs_per_face(face_no));
-  FETools::compute_face_embedding_matrices<dim, double>(*this,
-                                                        face_embeddings,
-                                                        0,
-                                                        0);
-  this->interface_constraints.reinit((1 << (dim - 1)) *
-                                       this->n_dofs_per_face(face_no),
+  this->interface_constraints =
+    (*FETools::MatrixCache::get_or_compute(
+       name + ":interface_constraints",
+       n_dofs,
+       [this]() {
+         const unsigned int face_no = 0;
+
+         // TODO[TL]: for anisotropic refinement we will probably need a
+         // table of submatrices with an array for each refine case
+         FullMatrix<double>
+           face_embeddings[GeometryInfo<dim>::max_children_per_face];
+         for (unsigned int i = 0; i < GeometryInfo<dim>::max_children_per_face;
+              ++i)
+           face_embeddings[i].reinit(this->n_dofs_per_face(face_no),
                                      this->n_dofs_per_face(face_no));
-  unsigned int target_row = 0;
-  for (unsigned int d = 0; d < GeometryInfo<dim>::max_children_per_face; ++d)
-    for (unsigned int i = 0; i < face_embeddings[d].m(); ++i)
-      {
-        for (unsigned int j = 0; j < face_embeddings[d].n(); ++j)
-          this->interface_constraints(target_row, j) = face_embeddings[d](i, j);
-        ++target_row;
-      }
+         FETools::compute_face_embedding_matrices<dim, double>(*this,
+                                                               face_embeddings,
+                                                               0,
+                                                               0);
+         FullMatrix<double> interface_constraints(
+           (1 << (dim - 1)) * this->n_dofs_per_face(face_no),
+           this->n_dofs_per_face(face_no));
+         unsigned int target_row = 0;
+         for (unsigned int d = 0; d < GeometryInfo<dim>::max_children_per_face;
+              ++d)
+           for (unsigned int i = 0; i < face_embeddings[d].m(); ++i)
+             {
+               for (unsigned int j = 0; j < face_embeddings[d].n(); ++j)
+                 interface_constraints(target_row, j) =
+                   face_embeddings[d](i, j);
+               ++target_row;
+             }
+         return FETools::MatrixCache::MatrixSet{{interface_constraints}};
+       }))[0][0];
 
   // We need to initialize the dof permutation table and the one for the sign
   // change.
@@ -226,6 +226,46 @@ namespace internal
                 base_data.shape_3rd_derivatives[offset.in_index + s][q];
       }
   }
+
+  /**
+   * Distribute the matrices of the base elements, such as restriction or
+   * prolongation matrices, to a matrix of the system element.
+   *
+   * By the definition of a base element, the base elements are independent,
+   * i.e., they do not couple. Only DoFs that belong to the same instance of
+   * a base element may couple, so rather than looping over all pairs of DoFs
+   * of the system element, we first collect the DoFs of each instance of a
+   * base element and then only loop over pairs of DoFs within an instance.
+   */
+  template <int dim, int spacedim>
+  FullMatrix<double>
+  assemble_from_base_matrices(
+    const FESystem<dim, spacedim>                 &fe,
+    const std::vector<const FullMatrix<double> *> &base_matrices)
+  {
+    // the DoFs of the system element that belong to each instance of each
+    // base element, in the order of the DoFs of the base element
+    std::vector<std::vector<std::vector<unsigned int>>> instance_dofs(
+      fe.n_base_elements());
+    for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+      instance_dofs[b].resize(fe.element_multiplicity(b),
+                              std::vector<unsigned int>(
+                                fe.base_element(b).n_dofs_per_cell()));
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      {
+        const auto &base_index = fe.system_to_base_index(i);
+        instance_dofs[base_index.first.first][base_index.first.second]
+                     [base_index.second] = i;
+      }
+
+    FullMatrix<double> matrix(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+    for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+      for (const std::vector<unsigned int> &dofs : instance_dofs[b])
+        for (unsigned int i = 0; i < dofs.size(); ++i)
+          for (unsigned int j = 0; j < dofs.size(); ++j)
+            matrix(dofs[i], dofs[j]) = (*base_matrices[b])(i, j);
+    return matrix;
+  }
 } // namespace internal
 
 /* ----------------------- FESystem::InternalData ------------------- */
@@ -847,18 +887,9 @@ FESystem<dim, spacedim>::get_restriction_matrix(
            "Restriction matrices are only available for refined cells!"));
   AssertIndexRange(child, this->reference_cell().n_children(refinement_case));
 
-
-
   // initialization upon first request
-  if (this->restriction[refinement_case - 1][child].n() == 0)
-    {
-      std::lock_guard<std::mutex> lock(restriction_matrix_mutex);
-
-      // check if updated while waiting for lock
-      if (this->restriction[refinement_case - 1][child].n() ==
-          this->n_dofs_per_cell())
-        return this->restriction[refinement_case - 1][child];
-
+  return this->get_or_compute_restriction_matrix(
+    child, refinement_case, [&]() {
       // shortcut for accessing local restrictions further down
       std::vector<const FullMatrix<double> *> base_matrices(
         this->n_base_elements());
@@ -872,48 +903,8 @@ FESystem<dim, spacedim>::get_restriction_matrix(
                  (typename FiniteElement<dim, spacedim>::ExcProjectionVoid()));
         }
 
-      FullMatrix<double> restriction(this->n_dofs_per_cell(),
-                                     this->n_dofs_per_cell());
-
-      // distribute the matrices of the base finite elements to the
-      // matrices of this object. for this, loop over all degrees of
-      // freedom and take the respective entry of the underlying base
-      // element.
-      //
-      // note that we by definition of a base element, they are
-      // independent, i.e. do not couple. only DoFs that belong to the
-      // same instance of a base element may couple
-      for (unsigned int i = 0; i < this->n_dofs_per_cell(); ++i)
-        for (unsigned int j = 0; j < this->n_dofs_per_cell(); ++j)
-          {
-            // first find out to which base element indices i and j
-            // belong, and which instance thereof in case the base element
-            // has a multiplicity greater than one. if they should not
-            // happen to belong to the same instance of a base element,
-            // then they cannot couple, so go on with the next index
-            if (this->system_to_base_table[i].first !=
-                this->system_to_base_table[j].first)
-              continue;
-
-            // so get the common base element and the indices therein:
-            const unsigned int base = this->system_to_base_table[i].first.first;
-
-            const unsigned int base_index_i =
-                                 this->system_to_base_table[i].second,
-                               base_index_j =
-                                 this->system_to_base_table[j].second;
-
-            // if we are sure that DoFs i and j may couple, then copy
-            // entries of the matrices:
-            restriction(i, j) =
-              (*base_matrices[base])(base_index_i, base_index_j);
-          }
-
-      const_cast<FullMatrix<double> &>(
-        this->restriction[refinement_case - 1][child]) = std::move(restriction);
-    }
-
-  return this->restriction[refinement_case - 1][child];
+      return internal::assemble_from_base_matrices(*this, base_matrices);
+    });
 }
 
 
@@ -933,14 +924,8 @@ FESystem<dim, spacedim>::get_prolongation_matrix(
 
   // initialization upon first request, construction completely analogous to
   // restriction matrix
-  if (this->prolongation[refinement_case - 1][child].n() == 0)
-    {
-      std::lock_guard<std::mutex> lock(prolongation_matrix_mutex);
-
-      if (this->prolongation[refinement_case - 1][child].n() ==
-          this->n_dofs_per_cell())
-        return this->prolongation[refinement_case - 1][child];
-
+  return this->get_or_compute_prolongation_matrix(
+    child, refinement_case, [&]() {
       std::vector<const FullMatrix<double> *> base_matrices(
         this->n_base_elements());
       for (unsigned int i = 0; i < this->n_base_elements(); ++i)
@@ -952,30 +937,8 @@ FESystem<dim, spacedim>::get_prolongation_matrix(
                  (typename FiniteElement<dim, spacedim>::ExcEmbeddingVoid()));
         }
 
-      FullMatrix<double> prolongate(this->n_dofs_per_cell(),
-                                    this->n_dofs_per_cell());
-
-      for (unsigned int i = 0; i < this->n_dofs_per_cell(); ++i)
-        for (unsigned int j = 0; j < this->n_dofs_per_cell(); ++j)
-          {
-            if (this->system_to_base_table[i].first !=
-                this->system_to_base_table[j].first)
-              continue;
-            const unsigned int base = this->system_to_base_table[i].first.first;
-
-            const unsigned int base_index_i =
-                                 this->system_to_base_table[i].second,
-                               base_index_j =
-                                 this->system_to_base_table[j].second;
-            prolongate(i, j) =
-              (*base_matrices[base])(base_index_i, base_index_j);
-          }
-
-      const_cast<FullMatrix<double> &>(
-        this->prolongation[refinement_case - 1][child]) = std::move(prolongate);
-    }
-
-  return this->prolongation[refinement_case - 1][child];
+      return internal::assemble_from_base_matrices(*this, base_matrices);
+    });
 }
 
 
@@ -0,0 +1,309 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+#include <deal.II/base/revision.h>
+
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <sstream>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace FETools
+{
+  namespace MatrixCache
+  {
+    namespace
+    {
+      // The first line of every file written by the cache. Files that do not
+      // start with it, e.g. those of an older format or written by another
+      // version of the library, whose elements may compute their matrices
+      // differently, are ignored.
+      const std::string file_header =
+        "deal.II FE matrix cache 1, version " DEAL_II_PACKAGE_VERSION
+        ", revision " DEAL_II_GIT_SHORTREV;
+
+
+
+      // The state of the cache: the matrices in memory and the directory
+      // for the files, both protected by the same lock
+      struct CacheData
+      {
+        CacheData()
+        {
+          if (const char *penv =
+                std::getenv("DEAL_II_FE_MATRIX_CACHE_DIRECTORY"))
+            directory = penv;
+        }
+
+        std::shared_mutex                                       mutex;
+        std::map<std::string, std::shared_ptr<const MatrixSet>> entries;
+        std::string                                             directory;
+      };
+
+
+
+      CacheData &
+      get_cache_data()
+      {
+        static CacheData cache_data;
+        return cache_data;
+      }
+
+
+
+      // Return the name of the file for the given key. All characters that
+      // might not be allowed in file names are replaced, so different keys
+      // may share a file name; the key is therefore also stored in the file.
+      std::string
+      get_filename(const std::string &directory, const std::string &key)
+      {
+        std::string name = key;
+        for (char &c : name)
+          if (!std::isalnum(static_cast<unsigned char>(c)))
+            c = '_';
+        return directory + "/" + name + ".matrices";
+      }
+
+
+
+      // Read the matrices stored for the given key. Files that are damaged
+      // or do not fit the element, i.e., whose sizes exceed the number of
+      // degrees of freedom per cell or the length of the file, are treated
+      // as if they did not exist.
+      std::shared_ptr<const MatrixSet>
+      read_file(const std::string &filename,
+                const std::string &key,
+                const unsigned int dofs_per_cell)
+      {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in)
+          return nullptr;
+
+        std::string header, stored_key;
+        std::getline(in, header);
+        std::getline(in, stored_key);
+        if (!in || header != file_header || stored_key != key)
+          return nullptr;
+
+        // the number of bytes left in the file, which bounds all sizes read
+        // below before any memory is allocated for them
+        const std::streampos start = in.tellg();
+        in.seekg(0, std::ios::end);
+        const std::streampos end = in.tellg();
+        in.seekg(start);
+        if (!in || end < start)
+          return nullptr;
+        std::uint64_t bytes_left = end - start;
+
+        // read a size, and return false if it does not fit into the rest of
+        // the file when every object counted by it needs at least the given
+        // number of bytes
+        const auto read_size = [&in, &bytes_left](std::uint64_t &size,
+                                                  const std::uint64_t bytes) {
+          if (bytes_left < sizeof(size))
+            return false;
+          in.read(reinterpret_cast<char *>(&size), sizeof(size));
+          bytes_left -= sizeof(size);
+          return static_cast<bool>(in) && size <= bytes_left / bytes;
+        };
+
+        std::uint64_t n_groups = 0;
+        if (!read_size(n_groups, sizeof(std::uint64_t)))
+          return nullptr;
+        auto matrices = std::make_shared<MatrixSet>(n_groups);
+        for (std::vector<FullMatrix<double>> &group : *matrices)
+          {
+            std::uint64_t n_matrices = 0;
+            if (!read_size(n_matrices, 2 * sizeof(std::uint64_t)))
+              return nullptr;
+            group.resize(n_matrices);
+            for (FullMatrix<double> &matrix : group)
+              {
+                std::uint64_t m = 0, n = 0;
+                if (!read_size(m, 1) || !read_size(n, 1) ||
+                    m > dofs_per_cell || n > dofs_per_cell ||
+                    m * n > bytes_left / sizeof(double))
+                  return nullptr;
+                matrix.reinit(m, n);
+                if (m * n > 0)
+                  in.read(reinterpret_cast<char *>(&matrix(0, 0)),
+                          m * n * sizeof(double));
+                bytes_left -= m * n * sizeof(double);
+              }
+          }
+
+        if (!in || bytes_left != 0)
+          return nullptr;
+        return matrices;
+      }
+
+
+
+      // Write the matrices into a temporary file with a random name first
+      // and rename it afterwards, so that other processes that write or read
+      // the same file at the same time never see an incomplete file. Errors
+      // are ignored, since the file is only an optimization.
+      void
+      write_file(const std::string &filename,
+                 const std::string &key,
+                 const MatrixSet   &matrices)
+      {
+        std::ostringstream tmp_filename;
+        tmp_filename << filename << ".tmp." << std::random_device()();
+
+        {
+          std::ofstream out(tmp_filename.str(), std::ios::binary);
+          if (!out)
+            return;
+
+          out << file_header << '\n' << key << '\n';
+
+          const auto write_size = [&out](const std::uint64_t size) {
+            out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+          };
+
+          write_size(matrices.size());
+          for (const std::vector<FullMatrix<double>> &group : matrices)
+            {
+              write_size(group.size());
+              for (const FullMatrix<double> &matrix : group)
+                {
+                  write_size(matrix.m());
+                  write_size(matrix.n());
+                  if (matrix.m() * matrix.n() > 0)
+                    out.write(reinterpret_cast<const char *>(&matrix(0, 0)),
+                              matrix.m() * matrix.n() * sizeof(double));
+                }
+            }
+
+          if (!out)
+            {
+              out.close();
+              std::error_code error;
+              std::filesystem::remove(tmp_filename.str(), error);
+              return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tmp_filename.str(), filename, error);
+        if (error)
+          std::filesystem::remove(tmp_filename.str(), error);
+      }
+    } // namespace
+
+
+
+    std::shared_ptr<const MatrixSet>
+    get_or_compute(const std::string                &key,
+                   const unsigned int                dofs_per_cell,
+                   const std::function<MatrixSet()> &compute)
+    {
+      if (key.find("QUnknownNodes") != std::string::npos)
+        return std::make_shared<const MatrixSet>(compute());
+
+      CacheData  &cache_data = get_cache_data();
+      std::string directory;
+      {
+        std::shared_lock<std::shared_mutex> lock(cache_data.mutex);
+        const auto entry = cache_data.entries.find(key);
+        if (entry != cache_data.entries.end())
+          return entry->second;
+        directory = cache_data.directory;
+      }
+
+      // not in memory: read the matrices from their file or compute them
+      // without holding the lock
+      std::shared_ptr<const MatrixSet> matrices;
+      if (!directory.empty())
+        matrices = read_file(get_filename(directory, key), key, dofs_per_cell);
+      if (matrices == nullptr)
+        {
+          matrices = std::make_shared<const MatrixSet>(compute());
+          if (!directory.empty())
+            write_file(get_filename(directory, key), key, *matrices);
+        }
+
+      std::unique_lock<std::shared_mutex> lock(cache_data.mutex);
+      return cache_data.entries.emplace(key, matrices).first->second;
+    }
+
+
+
+    void
+    set_directory(const std::string &directory)
+    {
+      if (!directory.empty())
+        {
+          std::error_code error;
+          std::filesystem::create_directories(directory, error);
+          AssertThrow(std::filesystem::is_directory(directory),
+                      ExcMessage("The directory <" + directory +
+                                 "> for the finite element matrix cache "
+                                 "does not exist and could not be created."));
+        }
+
+      CacheData                          &cache_data = get_cache_data();
+      std::unique_lock<std::shared_mutex> lock(cache_data.mutex);
+      cache_data.directory = directory;
+    }
+
+
+
+    std::string
+    get_directory()
+    {
+      CacheData                          &cache_data = get_cache_data();
+      std::shared_lock<std::shared_mutex> lock(cache_data.mutex);
+      return cache_data.directory;
+    }
+
+
+
+    void
+    clear()
+    {
+      CacheData                          &cache_data = get_cache_data();
+      std::unique_lock<std::shared_mutex> lock(cache_data.mutex);
+      cache_data.entries.clear();
+    }
+
+
+
+    std::size_t
+    n_entries()
+    {
+      CacheData                          &cache_data = get_cache_data();
+      std::shared_lock<std::shared_mutex> lock(cache_data.mutex);
+      return cache_data.entries.size();
+    }
+  } // namespace MatrixCache
+} // namespace FETools
+
+
+DEAL_II_NAMESPACE_CLOSE
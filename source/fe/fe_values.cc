@@ -26,6 +26,7 @@
 
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_tensor_product.h>
 #include <deal.II/fe/mapping.h>
 
 #include <deal.II/grid/tria_accessor.h>
@@ -230,6 +231,18 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
 
   const UpdateFlags flags = this->compute_update_flags(update_flags);
 
+  // if the element and the quadrature formula allow it, evaluate finite
+  // element functions by sum factorization. the gradients on the reference
+  // cell are transformed with the inverse Jacobians of the mapping, so
+  // gradients only take this path if the user requested the inverse
+  // Jacobians
+  if ((flags & (update_values | update_gradients)) &&
+      internal::FEValuesImplementation::TensorProductEvaluator<dim, spacedim>::
+        is_applicable(*this->fe, quadrature))
+    this->tensor_product_evaluator = std::make_unique<
+      internal::FEValuesImplementation::TensorProductEvaluator<dim, spacedim>>(
+      *this->fe, quadrature);
+
   // initialize the base classes
   if (flags & update_mapping)
     this->mapping_output.initialize(this->max_n_quadrature_points, flags);
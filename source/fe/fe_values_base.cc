@@ -26,6 +26,7 @@
 
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_tensor_product.h>
 #include <deal.II/fe/mapping.h>
 
 #include <deal.II/grid/tria_accessor.h>
@@ -254,6 +255,28 @@ FEValuesBase<dim, spacedim>::always_allow_check_for_cell_similarity(
 
 namespace internal
 {
+  // return whether the given object for evaluation by sum factorization
+  // exists and can evaluate all of the first n_components vector components
+  // for the given number type
+  template <typename Number, int dim, int spacedim>
+  bool
+  use_tensor_product_evaluator(
+    const std::unique_ptr<
+      const FEValuesImplementation::TensorProductEvaluator<dim, spacedim>>
+                      &tensor_product_evaluator,
+    const unsigned int n_components)
+  {
+    if (tensor_product_evaluator == nullptr)
+      return false;
+    for (unsigned int c = 0; c < n_components; ++c)
+      if (tensor_product_evaluator->template is_applicable_to_component<Number>(
+            c) == false)
+        return false;
+    return true;
+  }
+
+
+
   // put shape function part of get_function_xxx methods into separate
   // internal functions. this allows us to reuse the same code for several
   // functions (e.g. both the versions with and without indices) as well as
@@ -726,6 +749,14 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (internal::use_tensor_product_evaluator<Number>(tensor_product_evaluator,
+                                                     1))
+    {
+      AssertDimension(values.size(), n_quadrature_points);
+      tensor_product_evaluator->template evaluate_values<Number>(
+        0, make_array_view(dof_values), make_array_view(values));
+      return;
+    }
   internal::do_function_values(make_array_view(dof_values.begin(),
                                                dof_values.end()),
                                this->finite_element_output.shape_values,
@@ -750,6 +781,14 @@ FEValuesBase<dim, spacedim>::get_function_values(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   fe_function.extract_subvector_to(indices, view);
+  if (internal::use_tensor_product_evaluator<Number>(tensor_product_evaluator,
+                                                     1))
+    {
+      AssertDimension(values.size(), n_quadrature_points);
+      tensor_product_evaluator->template evaluate_values<Number>(
+        0, view, make_array_view(values));
+      return;
+    }
   internal::do_function_values(view,
                                this->finite_element_output.shape_values,
                                values);
@@ -773,6 +812,23 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (internal::use_tensor_product_evaluator<Number>(tensor_product_evaluator,
+                                                     fe->n_components()))
+    {
+      AssertDimension(values.size(), n_quadrature_points);
+      std::vector<Number> component_values(n_quadrature_points);
+      for (unsigned int c = 0; c < fe->n_components(); ++c)
+        {
+          tensor_product_evaluator->template evaluate_values<Number>(
+            c, make_array_view(dof_values), make_array_view(component_values));
+          for (unsigned int q = 0; q < n_quadrature_points; ++q)
+            {
+              AssertDimension(values[q].size(), fe->n_components());
+              values[q][c] = component_values[q];
+            }
+        }
+      return;
+    }
   internal::do_function_values(
     make_array_view(dof_values.begin(), dof_values.end()),
     this->finite_element_output.shape_values,
@@ -861,6 +917,18 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if ((this->update_flags & update_inverse_jacobians) &&
+      internal::use_tensor_product_evaluator<Number>(tensor_product_evaluator,
+                                                     1))
+    {
+      AssertDimension(gradients.size(), n_quadrature_points);
+      tensor_product_evaluator->template evaluate_gradients<Number>(
+        0,
+        make_array_view(dof_values),
+        this->mapping_output.inverse_jacobians,
+        make_array_view(gradients));
+      return;
+    }
   internal::do_function_derivatives(make_array_view(dof_values.begin(),
                                                     dof_values.end()),
                                     this->finite_element_output.shape_gradients,
@@ -885,6 +953,18 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   fe_function.extract_subvector_to(indices, view);
+  if ((this->update_flags & update_inverse_jacobians) &&
+      internal::use_tensor_product_evaluator<Number>(tensor_product_evaluator,
+                                                     1))
+    {
+      AssertDimension(gradients.size(), n_quadrature_points);
+      tensor_product_evaluator->template evaluate_gradients<Number>(
+        0,
+        view,
+        this->mapping_output.inverse_jacobians,
+        make_array_view(gradients));
+      return;
+    }
   internal::do_function_derivatives(view,
                                     this->finite_element_output.shape_gradients,
                                     gradients);
@@ -907,6 +987,28 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if ((this->update_flags & update_inverse_jacobians) &&
+      internal::use_tensor_product_evaluator<Number>(tensor_product_evaluator,
+                                                     fe->n_components()))
+    {
+      AssertDimension(gradients.size(), n_quadrature_points);
+      std::vector<Tensor<1, spacedim, Number>> component_gradients(
+        n_quadrature_points);
+      for (unsigned int c = 0; c < fe->n_components(); ++c)
+        {
+          tensor_product_evaluator->template evaluate_gradients<Number>(
+            c,
+            make_array_view(dof_values),
+            this->mapping_output.inverse_jacobians,
+            make_array_view(component_gradients));
+          for (unsigned int q = 0; q < n_quadrature_points; ++q)
+            {
+              AssertDimension(gradients[q].size(), fe->n_components());
+              gradients[q][c] = component_gradients[q];
+            }
+        }
+      return;
+    }
   internal::do_function_derivatives(
     make_array_view(dof_values.begin(), dof_values.end()),
     this->finite_element_output.shape_gradients,
@@ -1322,7 +1424,10 @@ FEValuesBase<dim, spacedim>::memory_consumption() const
           MemoryConsumption::memory_consumption(fe) +
           MemoryConsumption::memory_consumption(fe_data) +
           MemoryConsumption::memory_consumption(*fe_data) +
-          MemoryConsumption::memory_consumption(finite_element_output));
+          MemoryConsumption::memory_consumption(finite_element_output) +
+          (tensor_product_evaluator != nullptr ?
+             tensor_product_evaluator->memory_consumption() :
+             0));
 }
 
 
@@ -0,0 +1,216 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_values_batch.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace
+{
+  /**
+   * Return the update flags the FEValues object computing the geometry of
+   * the cells of an FEValuesBatch object needs for the given flags.
+   */
+  UpdateFlags
+  mapping_update_flags(const UpdateFlags update_flags)
+  {
+    UpdateFlags flags =
+      update_flags & (update_JxW_values | update_quadrature_points);
+    if (update_flags & update_gradients)
+      flags |= update_inverse_jacobians;
+    return flags;
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+FEValuesBatch<dim, spacedim>::FEValuesBatch(
+  const Mapping<dim, spacedim>       &mapping,
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim>              &quadrature,
+  const UpdateFlags                   update_flags)
+  : dofs_per_cell(fe.n_dofs_per_cell())
+  , n_quadrature_points(quadrature.size())
+  , fe(&fe)
+  , update_flags(update_flags)
+  , mapping_values(mapping,
+                   fe,
+                   quadrature,
+                   mapping_update_flags(update_flags))
+{
+  Assert((update_flags & ~(update_values | update_gradients |
+                           update_JxW_values | update_quadrature_points)) ==
+           update_default,
+         ExcMessage("FEValuesBatch only supports the flags update_values, "
+                    "update_gradients, update_JxW_values and "
+                    "update_quadrature_points."));
+  Assert(fe.is_primitive(),
+         ExcMessage("FEValuesBatch only supports primitive elements."));
+  for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+    Assert((dynamic_cast<const FE_Poly<dim, spacedim> *>(
+              &fe.base_element(b)) != nullptr),
+           ExcMessage("FEValuesBatch only supports elements whose base "
+                      "elements are derived from FE_Poly."));
+
+  if (update_flags & update_values)
+    {
+      reference_values.reinit(dofs_per_cell, n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          reference_values(i, q) = fe.shape_value(i, quadrature.point(q));
+    }
+
+  if (update_flags & update_gradients)
+    {
+      reference_gradients.reinit(dofs_per_cell, n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          reference_gradients(i, q) = fe.shape_grad(i, quadrature.point(q));
+      shape_gradients.resize(dofs_per_cell * n_quadrature_points);
+      inverse_jacobians.resize(n_quadrature_points);
+    }
+
+  if (update_flags & update_JxW_values)
+    JxW_values.resize(n_quadrature_points);
+
+  if (update_flags & update_quadrature_points)
+    quadrature_points.resize(n_quadrature_points);
+}
+
+
+
+template <int dim, int spacedim>
+FEValuesBatch<dim, spacedim>::FEValuesBatch(
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim>              &quadrature,
+  const UpdateFlags                   update_flags)
+  : FEValuesBatch(fe.reference_cell()
+                    .template get_default_linear_mapping<dim, spacedim>(),
+                  fe,
+                  quadrature,
+                  update_flags)
+{}
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesBatch<dim, spacedim>::reinit(
+  const ArrayView<const active_cell_iterator> &cells)
+{
+  Assert(cells.size() > 0, ExcMessage("At least one cell must be given."));
+  AssertIndexRange(cells.size(), n_lanes + 1);
+
+  this->cells.assign(cells.begin(), cells.end());
+  dof_indices_of_cells.resize(cells.size() * dofs_per_cell);
+
+  // compute the geometry of one cell after the other and put the results
+  // into the lanes of the vectorized arrays
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  for (unsigned int l = 0; l < cells.size(); ++l)
+    {
+      cells[l]->get_dof_indices(dof_indices);
+      std::copy(dof_indices.begin(),
+                dof_indices.end(),
+                dof_indices_of_cells.begin() + l * dofs_per_cell);
+
+      if (mapping_values.get_update_flags() == update_default)
+        continue;
+
+      mapping_values.reinit(cells[l]);
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        {
+          if (update_flags & update_gradients)
+            {
+              const DerivativeForm<1, spacedim, dim> &inverse_jacobian =
+                mapping_values.inverse_jacobian(q);
+              for (unsigned int e = 0; e < dim; ++e)
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  inverse_jacobians[q][e][d][l] = inverse_jacobian[e][d];
+            }
+          if (update_flags & update_JxW_values)
+            JxW_values[q][l] = mapping_values.JxW(q);
+          if (update_flags & update_quadrature_points)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              quadrature_points[q][d][l] =
+                mapping_values.quadrature_point(q)[d];
+        }
+    }
+
+  // fill the unused lanes with the data of the first cell, such that
+  // computations on all lanes give valid numbers
+  for (unsigned int l = cells.size(); l < n_lanes; ++l)
+    for (unsigned int q = 0; q < n_quadrature_points; ++q)
+      {
+        if (update_flags & update_gradients)
+          for (unsigned int e = 0; e < dim; ++e)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              inverse_jacobians[q][e][d][l] = inverse_jacobians[q][e][d][0];
+        if (update_flags & update_JxW_values)
+          JxW_values[q][l] = JxW_values[q][0];
+        if (update_flags & update_quadrature_points)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            quadrature_points[q][d][l] = quadrature_points[q][d][0];
+      }
+
+  // transform the gradients on the reference cell to all cells at once,
+  // i.e., multiply them by the transpose of the inverse Jacobian
+  if (update_flags & update_gradients)
+    for (unsigned int q = 0; q < n_quadrature_points; ++q)
+      {
+        const DerivativeForm<1, spacedim, dim, VectorizedArrayType>
+          &inverse_jacobian = inverse_jacobians[q];
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const Tensor<1, dim> &reference_gradient =
+              reference_gradients(i, q);
+            Tensor<1, spacedim, VectorizedArrayType> &gradient =
+              shape_gradients[i * n_quadrature_points + q];
+            for (unsigned int d = 0; d < spacedim; ++d)
+              {
+                VectorizedArrayType sum =
+                  reference_gradient[0] * inverse_jacobian[0][d];
+                for (unsigned int e = 1; e < dim; ++e)
+                  sum += reference_gradient[e] * inverse_jacobian[e][d];
+                gradient[d] = sum;
+              }
+          }
+      }
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+FEValuesBatch<dim, spacedim>::memory_consumption() const
+{
+  return (sizeof(*this) + mapping_values.memory_consumption() +
+          MemoryConsumption::memory_consumption(reference_values) +
+          MemoryConsumption::memory_consumption(reference_gradients) +
+          MemoryConsumption::memory_consumption(shape_gradients) +
+          MemoryConsumption::memory_consumption(inverse_jacobians) +
+          MemoryConsumption::memory_consumption(JxW_values) +
+          MemoryConsumption::memory_consumption(quadrature_points) +
+          MemoryConsumption::memory_consumption(cells) +
+          MemoryConsumption::memory_consumption(dof_indices_of_cells));
+}
+
+
+#include "fe_values_batch.inst"
+
+DEAL_II_NAMESPACE_CLOSE
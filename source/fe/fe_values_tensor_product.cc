@@ -0,0 +1,155 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_values_tensor_product.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace FEValuesImplementation
+  {
+    namespace
+    {
+      /**
+       * Return the polynomial space of @p fe if it is an FE_Poly element
+       * with a tensor product polynomial space, and a null pointer
+       * otherwise.
+       */
+      template <int dim, int spacedim>
+      const TensorProductPolynomials<dim> *
+      get_tensor_product_polynomials(const FiniteElement<dim, spacedim> &fe)
+      {
+        if (const auto fe_poly =
+              dynamic_cast<const FE_Poly<dim, spacedim> *>(&fe))
+          return dynamic_cast<const TensorProductPolynomials<dim> *>(
+            &fe_poly->get_poly_space());
+        return nullptr;
+      }
+
+
+
+      /**
+       * Return whether @p quadrature is the tensor product of the same
+       * one-dimensional quadrature formula in all directions.
+       */
+      template <int dim>
+      bool
+      is_isotropic_tensor_product(const Quadrature<dim> &quadrature)
+      {
+        if (quadrature.is_tensor_product() == false)
+          return false;
+
+        const std::array<Quadrature<1>, dim> &basis =
+          quadrature.get_tensor_basis();
+        for (unsigned int d = 1; d < dim; ++d)
+          if (basis[d].get_points() != basis[0].get_points() ||
+              basis[d].get_weights() != basis[0].get_weights())
+            return false;
+        return true;
+      }
+    } // namespace
+
+
+
+    template <int dim, int spacedim>
+    bool
+    TensorProductEvaluator<dim, spacedim>::is_applicable(
+      const FiniteElement<dim, spacedim> &fe,
+      const Quadrature<dim>              &quadrature)
+    {
+      if (fe.reference_cell().is_hyper_cube() == false ||
+          fe.is_primitive() == false ||
+          is_isotropic_tensor_product(quadrature) == false)
+        return false;
+
+      for (unsigned int b = 0; b < fe.n_base_elements(); ++b)
+        if (get_tensor_product_polynomials(fe.base_element(b)) != nullptr)
+          return true;
+      return false;
+    }
+
+
+
+    template <int dim, int spacedim>
+    TensorProductEvaluator<dim, spacedim>::TensorProductEvaluator(
+      const FiniteElement<dim, spacedim> &fe,
+      const Quadrature<dim>              &quadrature)
+      : n_q_points_1d(quadrature.get_tensor_basis()[0].size())
+      , component_data(fe.n_components())
+    {
+      Assert(is_applicable(fe, quadrature), ExcInternalError());
+
+      const Quadrature<1> quadrature_1d = quadrature.get_tensor_basis()[0];
+      for (unsigned int c = 0; c < fe.n_components(); ++c)
+        {
+          const FiniteElement<dim, spacedim> &base_element =
+            fe.base_element(fe.component_to_base_index(c).first);
+          const TensorProductPolynomials<dim> *polynomial_space =
+            get_tensor_product_polynomials(base_element);
+          if (polynomial_space == nullptr)
+            continue;
+
+          ComponentData &data = component_data[c];
+          const std::vector<Polynomials::Polynomial<double>> polynomials =
+            polynomial_space->get_underlying_polynomials();
+          data.n_dofs_1d = polynomials.size();
+          data.shape_values.resize(data.n_dofs_1d * n_q_points_1d);
+          data.shape_gradients.resize(data.n_dofs_1d * n_q_points_1d);
+          std::vector<double> values(2);
+          for (unsigned int i = 0; i < data.n_dofs_1d; ++i)
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              {
+                polynomials[i].value(quadrature_1d.point(q)[0], values);
+                data.shape_values[i * n_q_points_1d + q]    = values[0];
+                data.shape_gradients[i * n_q_points_1d + q] = values[1];
+              }
+
+          // the lexicographic numbering of the polynomial space refers to
+          // the shape functions of the base element, which we translate to
+          // the numbering of the shape functions of the whole element
+          const std::vector<unsigned int> &lexicographic =
+            polynomial_space->get_numbering_inverse();
+          data.dof_indices.resize(lexicographic.size());
+          for (unsigned int i = 0; i < lexicographic.size(); ++i)
+            data.dof_indices[i] =
+              fe.component_to_system_index(c, lexicographic[i]);
+        }
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    TensorProductEvaluator<dim, spacedim>::memory_consumption() const
+    {
+      std::size_t memory = sizeof(*this);
+      for (const ComponentData &data : component_data)
+        memory += MemoryConsumption::memory_consumption(data.shape_values) +
+                  MemoryConsumption::memory_consumption(data.shape_gradients) +
+                  MemoryConsumption::memory_consumption(data.dof_indices);
+      return memory;
+    }
+  } // namespace FEValuesImplementation
+} // namespace internal
+
+
+#include "fe_values_tensor_product.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -19,6 +19,7 @@
 
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/fe_values_base.h>
+#include <deal.II/fe/fe_values_tensor_product.h>
 #include <deal.II/fe/fe_values_views.h>
 #include <deal.II/fe/fe_values_views_internal.h>
 
@@ -374,6 +375,15 @@ namespace FEValuesViews
     dealii::Vector<Number> dof_values(fe_values->dofs_per_cell);
     fe_values->present_cell.get_interpolated_dof_values(fe_function,
                                                         dof_values);
+    if (fe_values->tensor_product_evaluator != nullptr &&
+        fe_values->tensor_product_evaluator
+          ->template is_applicable_to_component<
+            solution_value_type<Number>>(component))
+      {
+        fe_values->tensor_product_evaluator->template evaluate_values<Number>(
+          component, make_array_view(dof_values), make_array_view(values));
+        return;
+      }
     internal::do_function_values<dim, spacedim>(
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_values,
@@ -428,6 +438,20 @@ namespace FEValuesViews
     dealii::Vector<Number> dof_values(fe_values->dofs_per_cell);
     fe_values->present_cell.get_interpolated_dof_values(fe_function,
                                                         dof_values);
+    if (fe_values->tensor_product_evaluator != nullptr &&
+        (fe_values->update_flags & update_inverse_jacobians) &&
+        fe_values->tensor_product_evaluator
+          ->template is_applicable_to_component<
+            solution_value_type<Number>>(component))
+      {
+        fe_values->tensor_product_evaluator
+          ->template evaluate_gradients<Number>(
+            component,
+            make_array_view(dof_values),
+            fe_values->mapping_output.inverse_jacobians,
+            make_array_view(gradients));
+        return;
+      }
     internal::do_function_derivatives<1, dim, spacedim>(
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_gradients,
@@ -644,6 +668,29 @@ namespace FEValuesViews
     dealii::Vector<Number> dof_values(fe_values->dofs_per_cell);
     fe_values->present_cell.get_interpolated_dof_values(fe_function,
                                                         dof_values);
+    using OutputNumber = typename ProductType<Number, double>::type;
+    bool use_tensor_product_evaluator =
+      (fe_values->tensor_product_evaluator != nullptr);
+    for (unsigned int d = 0; d < spacedim && use_tensor_product_evaluator; ++d)
+      use_tensor_product_evaluator =
+        fe_values->tensor_product_evaluator
+          ->template is_applicable_to_component<OutputNumber>(
+            first_vector_component + d);
+    if (use_tensor_product_evaluator)
+      {
+        std::vector<OutputNumber> component_values(values.size());
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            fe_values->tensor_product_evaluator
+              ->template evaluate_values<Number>(
+                first_vector_component + d,
+                make_array_view(dof_values),
+                make_array_view(component_values));
+            for (unsigned int q = 0; q < values.size(); ++q)
+              values[q][d] = component_values[q];
+          }
+        return;
+      }
     internal::do_function_values<dim, spacedim>(
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_values,
@@ -698,6 +745,32 @@ namespace FEValuesViews
     dealii::Vector<Number> dof_values(fe_values->dofs_per_cell);
     fe_values->present_cell.get_interpolated_dof_values(fe_function,
                                                         dof_values);
+    using OutputNumber = typename ProductType<Number, double>::type;
+    bool use_tensor_product_evaluator =
+      (fe_values->tensor_product_evaluator != nullptr &&
+       (fe_values->update_flags & update_inverse_jacobians));
+    for (unsigned int d = 0; d < spacedim && use_tensor_product_evaluator; ++d)
+      use_tensor_product_evaluator =
+        fe_values->tensor_product_evaluator
+          ->template is_applicable_to_component<OutputNumber>(
+            first_vector_component + d);
+    if (use_tensor_product_evaluator)
+      {
+        std::vector<dealii::Tensor<1, spacedim, OutputNumber>>
+          component_gradients(gradients.size());
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            fe_values->tensor_product_evaluator
+              ->template evaluate_gradients<Number>(
+                first_vector_component + d,
+                make_array_view(dof_values),
+                fe_values->mapping_output.inverse_jacobians,
+                make_array_view(component_gradients));
+            for (unsigned int q = 0; q < gradients.size(); ++q)
+              gradients[q][d] = component_gradients[q];
+          }
+        return;
+      }
     internal::do_function_derivatives<1, dim, spacedim>(
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_gradients,
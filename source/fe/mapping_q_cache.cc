@@ -1,7 +1,7 @@
 // ------------------------------------------------------------------------
 //
 // SPDX-License-Identifier: LGPL-2.1-or-later
-// Copyright (C) 2019 - 2024 by the deal.II authors
+// Copyright (C) 2019 - 2025 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -13,8 +13,8 @@
 // ------------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
-#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_tools.h>
 
@@ -33,10 +33,36 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+template <int dim, int spacedim>
+std::size_t
+MappingQCache<dim, spacedim>::SupportPointCache::offset(
+  const unsigned int level,
+  const unsigned int index) const
+{
+  AssertIndexRange(level, level_offsets.size() - 1);
+  AssertIndexRange(index, level_offsets[level + 1] - level_offsets[level]);
+  return (level_offsets[level] + index) * n_points_per_cell;
+}
+
+
+
+template <int dim, int spacedim>
+std::size_t
+MappingQCache<dim, spacedim>::SupportPointCache::memory_consumption() const
+{
+  return MemoryConsumption::memory_consumption(level_offsets) +
+         MemoryConsumption::memory_consumption(points) +
+         MemoryConsumption::memory_consumption(points_single);
+}
+
+
+
 template <int dim, int spacedim>
 MappingQCache<dim, spacedim>::MappingQCache(
-  const unsigned int polynomial_degree)
+  const unsigned int polynomial_degree,
+  const bool         store_in_single_precision)
   : MappingQ<dim, spacedim>(polynomial_degree)
+  , store_in_single_precision(store_in_single_precision)
   , uses_level_info(false)
 {}
 
@@ -47,6 +73,7 @@ MappingQCache<dim, spacedim>::MappingQCache(
   const MappingQCache<dim, spacedim> &mapping)
   : MappingQ<dim, spacedim>(mapping)
   , support_point_cache(mapping.support_point_cache)
+  , store_in_single_precision(mapping.store_in_single_precision)
   , uses_level_info(mapping.uses_level_info)
 {}
 
@@ -145,35 +172,100 @@ MappingQCache<dim, spacedim>::initialize(
   clear_signal = triangulation.signals.any_change.connect(
     [&]() -> void { this->support_point_cache.reset(); });
 
-  support_point_cache =
-    std::make_shared<std::vector<std::vector<std::vector<Point<spacedim>>>>>(
-      triangulation.n_levels());
+  // set up the cache for all cells on all levels, including unused cell
+  // indices, so that the support points of a cell can be found by its level
+  // and index
+  auto cache = std::make_shared<SupportPointCache>();
+  cache->n_points_per_cell =
+    Utilities::pow<unsigned int>(this->get_degree() + 1, dim);
+  cache->level_offsets.resize(triangulation.n_levels() + 1);
+  cache->level_offsets[0] = 0;
   for (unsigned int l = 0; l < triangulation.n_levels(); ++l)
-    (*support_point_cache)[l].resize(triangulation.n_raw_cells(l));
-
-  WorkStream::run(
-    triangulation.begin(),
-    triangulation.end(),
-    [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell,
-        void *,
-        void *) {
-      (*support_point_cache)[cell->level()][cell->index()] =
-        compute_points_on_cell(cell);
-      AssertDimension(
-        (*support_point_cache)[cell->level()][cell->index()].size(),
-        Utilities::pow(this->get_degree() + 1, dim));
-    },
-    /* copier */ std::function<void(void *)>(),
-    /* scratch_data */ nullptr,
-    /* copy_data */ nullptr,
-    2 * MultithreadInfo::n_threads(),
-    /* chunk_size = */ 1);
+    cache->level_offsets[l + 1] =
+      cache->level_offsets[l] + triangulation.n_raw_cells(l);
+
+  const std::size_t n_points =
+    cache->level_offsets.back() * cache->n_points_per_cell;
+  if (store_in_single_precision)
+    cache->points_single.resize(n_points);
+  else
+    cache->points.resize(n_points);
+  support_point_cache = std::move(cache);
+
+  std::vector<typename Triangulation<dim, spacedim>::cell_iterator> cells;
+  cells.reserve(triangulation.n_cells());
+  for (const auto &cell : triangulation.cell_iterators())
+    cells.push_back(cell);
+  compute_support_points(cells, compute_points_on_cell);
 
   uses_level_info = true;
 }
 
 
 
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::update(
+  const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+    &cells,
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &compute_points_on_cell)
+{
+  Assert(support_point_cache.get() != nullptr,
+         ExcMessage("Must call MappingQCache::initialize() before "
+                    "updating the support points of some cells!"));
+
+  compute_support_points(cells, compute_points_on_cell);
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingQCache<dim, spacedim>::compute_support_points(
+  const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+    &cells,
+  const std::function<std::vector<Point<spacedim>>(
+    const typename Triangulation<dim, spacedim>::cell_iterator &)>
+    &compute_points_on_cell)
+{
+  SupportPointCache &cache = *support_point_cache;
+
+  // every cell writes into its own part of the contiguous array, so the
+  // cells can be worked on in parallel without synchronization. the
+  // function provided by the user is typically expensive (e.g., it
+  // evaluates an FEValues object), so choose a small grain size.
+  parallel::apply_to_subranges(
+    std::size_t(0),
+    cells.size(),
+    [&](const std::size_t begin, const std::size_t end) {
+      for (std::size_t c = begin; c < end; ++c)
+        {
+          const auto &cell = cells[c];
+
+          const std::vector<Point<spacedim>> points =
+            compute_points_on_cell(cell);
+          AssertDimension(points.size(), cache.n_points_per_cell);
+
+          const std::size_t offset =
+            cache.offset(cell->level(), cell->index());
+          if (store_in_single_precision)
+            for (unsigned int i = 0; i < cache.n_points_per_cell; ++i)
+              for (unsigned int d = 0; d < spacedim; ++d)
+                cache.points_single[offset + i][d] =
+                  static_cast<float>(points[i][d]);
+          else
+            std::copy(points.begin(),
+                      points.end(),
+                      cache.points.begin() + offset);
+        }
+    },
+    8);
+}
+
+
+
 template <int dim, int spacedim>
 void
 MappingQCache<dim, spacedim>::initialize(
@@ -700,8 +792,7 @@ std::size_t
 MappingQCache<dim, spacedim>::memory_consumption() const
 {
   if (support_point_cache.get() != nullptr)
-    return sizeof(*this) +
-           MemoryConsumption::memory_consumption(*support_point_cache);
+    return sizeof(*this) + support_point_cache->memory_consumption();
   else
     return sizeof(*this);
 }
@@ -719,9 +810,20 @@ MappingQCache<dim, spacedim>::compute_mapping_support_points(
 
   Assert(uses_level_info || cell->is_active(), ExcInternalError());
 
-  AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  return (*support_point_cache)[cell->level()][cell->index()];
+  const SupportPointCache &cache = *support_point_cache;
+  const std::size_t        offset = cache.offset(cell->level(), cell->index());
+  if (store_in_single_precision)
+    {
+      std::vector<Point<spacedim>> points(cache.n_points_per_cell);
+      for (unsigned int i = 0; i < cache.n_points_per_cell; ++i)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          points[i][d] = cache.points_single[offset + i][d];
+      return points;
+    }
+  else
+    return std::vector<Point<spacedim>>(cache.points.begin() + offset,
+                                        cache.points.begin() + offset +
+                                          cache.n_points_per_cell);
 }
 
 
@@ -738,12 +840,17 @@ MappingQCache<dim, spacedim>::get_vertices(
 
   Assert(uses_level_info || cell->is_active(), ExcInternalError());
 
-  AssertIndexRange(cell->level(), support_point_cache->size());
-  AssertIndexRange(cell->index(), (*support_point_cache)[cell->level()].size());
-  const auto ptr = (*support_point_cache)[cell->level()][cell->index()].begin();
-  return boost::container::small_vector<Point<spacedim>,
-                                        GeometryInfo<dim>::vertices_per_cell>(
-    ptr, ptr + cell->n_vertices());
+  const SupportPointCache &cache = *support_point_cache;
+  const std::size_t        offset = cache.offset(cell->level(), cell->index());
+  boost::container::small_vector<Point<spacedim>,
+                                 GeometryInfo<dim>::vertices_per_cell>
+    vertices(cell->n_vertices());
+  for (unsigned int v = 0; v < cell->n_vertices(); ++v)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      vertices[v][d] = store_in_single_precision ?
+                         cache.points_single[offset + v][d] :
+                         cache.points[offset + v][d];
+  return vertices;
 }
 
 
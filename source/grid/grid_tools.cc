@@ -16,6 +16,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_consensus_algorithms.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -3494,6 +3495,120 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+  find_active_cell_around_points(const Cache<dim, spacedim>         &cache,
+                                 const std::vector<Point<spacedim>> &points,
+                                 const double                        tolerance)
+  {
+    Assert((dim == spacedim),
+           ExcMessage("Only implemented for dim==spacedim."));
+
+    // Alias
+    namespace bgi = boost::geometry::index;
+
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+    const auto &mesh    = cache.get_triangulation();
+    const auto &mapping = cache.get_mapping();
+
+    std::vector<std::pair<active_cell_iterator, Point<dim>>> cells_and_points(
+      points.size(), std::make_pair(mesh.end(), Point<dim>()));
+    if (points.empty())
+      return cells_and_points;
+
+    // Get the tree here, as the cache builds it on first access
+    const auto &b_tree = cache.get_cell_bounding_boxes_rtree();
+
+    // For every point, the distance of its reference coordinates to the
+    // reference cell of the cell stored in cells_and_points, or a negative
+    // number if no cell has been found yet
+    std::vector<double> distances(points.size(), -1.);
+
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(points.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        // Collect the candidate cells of all points of this batch, sorted by
+        // the active cell index such that all points of a cell are next to
+        // each other
+        std::vector<
+          std::tuple<unsigned int, unsigned int, active_cell_iterator>>
+          candidates;
+        for (unsigned int i = begin; i < end; ++i)
+          for (const auto &leaf :
+               b_tree | bgi::adaptors::queried(bgi::intersects(points[i])))
+            if (!leaf.second->is_artificial())
+              candidates.emplace_back(leaf.second->active_cell_index(),
+                                      i,
+                                      leaf.second);
+        std::sort(candidates.begin(),
+                  candidates.end(),
+                  [](const auto &a, const auto &b) {
+                    return std::make_pair(std::get<0>(a), std::get<1>(a)) <
+                           std::make_pair(std::get<0>(b), std::get<1>(b));
+                  });
+
+        std::vector<Point<spacedim>> real_points;
+        std::vector<Point<dim>>      unit_points;
+        for (unsigned int c = 0; c < candidates.size();)
+          {
+            const active_cell_iterator &cell = std::get<2>(candidates[c]);
+
+            real_points.clear();
+            unsigned int next_c = c;
+            for (; next_c < candidates.size() &&
+                   std::get<2>(candidates[next_c]) == cell;
+                 ++next_c)
+              real_points.push_back(points[std::get<1>(candidates[next_c])]);
+
+            unit_points.resize(real_points.size());
+            mapping.transform_points_real_to_unit_cell(
+              cell, make_array_view(real_points), make_array_view(unit_points));
+
+            for (unsigned int j = 0; j < unit_points.size(); ++j)
+              if (numbers::is_finite(unit_points[j][0]) &&
+                  cell->reference_cell().contains_point(unit_points[j],
+                                                        tolerance))
+                {
+                  const unsigned int i = std::get<1>(candidates[c + j]);
+                  const double       distance = unit_points[j].distance(
+                    cell->reference_cell().closest_point(unit_points[j]));
+                  if (distances[i] < 0. || distance < distances[i])
+                    {
+                      distances[i] = distance;
+                      cells_and_points[i] =
+                        std::make_pair(cell, unit_points[j]);
+                    }
+                }
+
+            c = next_c;
+          }
+      },
+      256);
+
+    // Fall back to the search through the neighbors of the closest vertex for
+    // the points we did not find, using the last cell found as a hint
+    active_cell_iterator cell_hint;
+    for (unsigned int i = 0; i < points.size(); ++i)
+      if (distances[i] < 0.)
+        {
+          cells_and_points[i] = find_active_cell_around_point(
+            cache, points[i], cell_hint, std::vector<bool>(), tolerance);
+          if (cells_and_points[i].first != mesh.end())
+            cell_hint = cells_and_points[i].first;
+        }
+      else
+        cell_hint = cells_and_points[i].first;
+
+    return cells_and_points;
+  }
+
+
+
   template <int dim, int spacedim>
 #ifndef DOXYGEN
   std::tuple<
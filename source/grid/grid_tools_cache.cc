@@ -14,6 +14,7 @@
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi_stub.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
@@ -359,6 +360,91 @@ namespace GridTools
     return vertices_with_ghost_neighbors;
   }
 
+
+
+  template <int dim, int spacedim>
+  const CellGeometryData<dim, spacedim> &
+  Cache<dim, spacedim>::get_cell_geometry() const
+  {
+    // In the following, we will first check whether the data structure
+    // in question needs to be updated (in which case we update it, and
+    // reset the flag that indices that this needs to happen to zero), and
+    // then return it. Make this thread-safe by using a mutex to guard
+    // all of this:
+    std::lock_guard<std::mutex> lock(cell_geometry_mutex);
+
+    if (update_flags & update_cell_geometry)
+      {
+        const unsigned int n_cells = tria->n_active_cells();
+
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+          cells;
+        cells.reserve(n_cells);
+        for (const auto &cell : tria->active_cell_iterators())
+          cells.push_back(cell);
+        AssertDimension(cells.size(), n_cells);
+
+        unsigned int n_vertices_per_cell = 0;
+        for (const auto &reference_cell : tria->get_reference_cells())
+          n_vertices_per_cell =
+            std::max(n_vertices_per_cell, reference_cell.n_vertices());
+
+        CellGeometryData<dim, spacedim> &data = cell_geometry;
+        data.n_vertices_per_cell              = n_vertices_per_cell;
+        data.n_vertices.resize(n_cells);
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            data.vertices[d].resize(n_cells * n_vertices_per_cell);
+            data.centers[d].resize(n_cells);
+            data.lower_corners[d].resize(n_cells);
+            data.upper_corners[d].resize(n_cells);
+          }
+        data.diameters.resize(n_cells);
+        data.measures.resize(n_cells);
+
+        // the cells write to disjoint parts of the arrays, so we can fill
+        // them in parallel
+        parallel::apply_to_subranges(
+          0U,
+          n_cells,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int c = begin; c < end; ++c)
+              {
+                const auto &cell = cells[c];
+                Assert(cell->active_cell_index() == c, ExcInternalError());
+
+                data.n_vertices[c] = cell->n_vertices();
+                for (unsigned int v = 0; v < n_vertices_per_cell; ++v)
+                  {
+                    const Point<spacedim> &vertex =
+                      cell->vertex(v < cell->n_vertices() ? v : 0);
+                    for (unsigned int d = 0; d < spacedim; ++d)
+                      data.vertices[d][c * n_vertices_per_cell + v] =
+                        vertex[d];
+                  }
+
+                const Point<spacedim> center = cell->center();
+                const auto corners = cell->bounding_box().get_boundary_points();
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  {
+                    data.centers[d][c]       = center[d];
+                    data.lower_corners[d][c] = corners.first[d];
+                    data.upper_corners[d][c] = corners.second[d];
+                  }
+                data.diameters[c] = cell->diameter();
+                data.measures[c]  = cell->measure();
+              }
+          },
+          256);
+
+        // Atomically clear the flag that indicates that this data member
+        // needs to be updated:
+        update_flags &= ~update_cell_geometry;
+      }
+
+    return cell_geometry;
+  }
+
 #include "grid_tools_cache.inst"
 
 } // namespace GridTools
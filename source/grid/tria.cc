@@ -18,6 +18,7 @@
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/mpi_large_count.h>
 #include <deal.II/base/mpi_stub.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
@@ -41,6 +42,7 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <limits>
@@ -49,6 +51,12 @@
 #include <memory>
 #include <numeric>
 
+#if defined(DEAL_II_HAVE_UNISTD_H) && !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -130,6 +138,108 @@ namespace internal
   } // namespace TriangulationImplementation
 
 
+
+#if defined(DEAL_II_HAVE_UNISTD_H) && !defined(_WIN32)
+  namespace
+  {
+    /**
+     * Create (or truncate) the file @p filename and resize it to
+     * @p file_size bytes, so that all processes can subsequently map their
+     * own section of it via MappedFileSection.
+     */
+    void
+    create_file_of_size(const std::string &filename,
+                        const std::uint64_t file_size)
+    {
+      const int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+      AssertThrow(fd != -1,
+                  ExcMessage("Could not create the file <" + filename +
+                             "> for memory-mapped output."));
+      const int ierr = ::ftruncate(fd, static_cast<off_t>(file_size));
+      ::close(fd);
+      AssertThrow(ierr == 0,
+                  ExcMessage("Could not resize the file <" + filename +
+                             "> for memory-mapped output."));
+    }
+
+
+
+    /**
+     * A mapping of the byte range [offset, offset+size) of a file into
+     * memory. Since mmap() requires the file offset to be a multiple of the
+     * page size, the mapping starts at the preceding page boundary and
+     * data() points into it at the requested position. The mapping is
+     * released upon destruction.
+     */
+    class MappedFileSection
+    {
+    public:
+      MappedFileSection(const std::string  &filename,
+                        const std::uint64_t offset,
+                        const std::uint64_t size,
+                        const bool          writable)
+        : base(nullptr)
+        , mapped_size(0)
+        , shift(0)
+      {
+        if (size == 0)
+          return;
+
+        const int fd = ::open(filename.c_str(), writable ? O_RDWR : O_RDONLY);
+        AssertThrow(fd != -1,
+                    ExcMessage("Could not open the file <" + filename +
+                               "> for memory-mapped I/O."));
+
+        const std::uint64_t page_size = ::sysconf(_SC_PAGESIZE);
+        shift                         = offset % page_size;
+        mapped_size                   = size + shift;
+        base = ::mmap(nullptr,
+                      mapped_size,
+                      writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                      MAP_SHARED,
+                      fd,
+                      static_cast<off_t>(offset - shift));
+        // the mapping holds its own reference to the file
+        ::close(fd);
+        AssertThrow(base != MAP_FAILED,
+                    ExcMessage("Could not map the file <" + filename +
+                               "> into memory."));
+
+        // we run through the section exactly once from front to back
+        if (!writable)
+          {
+            ::madvise(base, mapped_size, MADV_SEQUENTIAL);
+            ::madvise(base, mapped_size, MADV_WILLNEED);
+          }
+      }
+
+      ~MappedFileSection()
+      {
+        if (base != nullptr)
+          ::munmap(base, mapped_size);
+      }
+
+      MappedFileSection(const MappedFileSection &) = delete;
+
+      MappedFileSection &
+      operator=(const MappedFileSection &) = delete;
+
+      char *
+      data() const
+      {
+        return static_cast<char *>(base) + shift;
+      }
+
+    private:
+      void       *base;
+      std::size_t mapped_size;
+      std::size_t shift;
+    };
+  } // namespace
+#endif
+
+
+
   template <int dim, int spacedim>
   DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
   CellAttachedDataSerializer<dim, spacedim>::CellAttachedDataSerializer()
@@ -1121,6 +1231,228 @@ namespace internal
   }
 
 
+  template <int dim, int spacedim>
+  DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+  void CellAttachedDataSerializer<dim, spacedim>::save_memory_mapped(
+    const unsigned int global_first_cell,
+    const unsigned int global_num_cells,
+    const std::string &file_basename,
+    const MPI_Comm    &mpi_communicator) const
+  {
+#if defined(DEAL_II_HAVE_UNISTD_H) && !defined(_WIN32)
+    Assert(sizes_fixed_cumulative.size() > 0,
+           ExcMessage("No data has been packed!"));
+
+    const unsigned int myrank =
+      Utilities::MPI::this_mpi_process(mpi_communicator);
+
+    const std::string fname_fixed = std::string(file_basename) + "_fixed.data";
+    const std::string fname_variable =
+      std::string(file_basename) + "_variable.data";
+
+    // The layout is the same as the one written by save(): the fixed size
+    // file starts with the cumulative sizes, followed by the packed data of
+    // all cells in the global order. The variable size file starts with the
+    // sizes of all cells, followed by the packed data of all cells. Make sure
+    // we do all of the following computations in 64bit integers to be able to
+    // handle 4GB+ files.
+    const unsigned int  bytes_per_cell = sizes_fixed_cumulative.back();
+    const std::uint64_t size_header =
+      sizes_fixed_cumulative.size() * sizeof(unsigned int);
+
+    const auto [prefix_sum, total_size_variable] =
+      Utilities::MPI::partial_and_total_sum(
+        variable_size_data_stored ?
+          static_cast<std::uint64_t>(src_data_variable.size()) :
+          std::uint64_t(0),
+        mpi_communicator);
+
+    // The files need to exist with their final size before any process can
+    // map its section, so let the first process create them and wait for it.
+    if (myrank == 0)
+      {
+        create_file_of_size(fname_fixed,
+                            size_header +
+                              static_cast<std::uint64_t>(global_num_cells) *
+                                bytes_per_cell);
+        if (variable_size_data_stored)
+          create_file_of_size(fname_variable,
+                              static_cast<std::uint64_t>(global_num_cells) *
+                                  sizeof(unsigned int) +
+                                total_size_variable);
+      }
+#  ifdef DEAL_II_WITH_MPI
+    const int ierr = MPI_Barrier(mpi_communicator);
+    AssertThrowMPI(ierr);
+#  endif
+
+    //
+    // ---------- Fixed size data ----------
+    //
+    if (myrank == 0)
+      {
+        const MappedFileSection header(fname_fixed, 0, size_header, true);
+        std::memcpy(header.data(), sizes_fixed_cumulative.data(), size_header);
+      }
+
+    if (src_data_fixed.size() > 0)
+      {
+        const MappedFileSection section(
+          fname_fixed,
+          size_header +
+            static_cast<std::uint64_t>(global_first_cell) * bytes_per_cell,
+          src_data_fixed.size(),
+          true);
+        std::memcpy(section.data(),
+                    src_data_fixed.data(),
+                    src_data_fixed.size());
+      }
+
+    //
+    // ---------- Variable size data ----------
+    //
+    if (variable_size_data_stored)
+      {
+        if (src_sizes_variable.size() > 0)
+          {
+            const MappedFileSection sizes(
+              fname_variable,
+              static_cast<std::uint64_t>(global_first_cell) *
+                sizeof(unsigned int),
+              src_sizes_variable.size() * sizeof(int),
+              true);
+            std::memcpy(sizes.data(),
+                        src_sizes_variable.data(),
+                        src_sizes_variable.size() * sizeof(int));
+          }
+
+        if (src_data_variable.size() > 0)
+          {
+            const MappedFileSection section(
+              fname_variable,
+              static_cast<std::uint64_t>(global_num_cells) *
+                  sizeof(unsigned int) +
+                prefix_sum,
+              src_data_variable.size(),
+              true);
+            std::memcpy(section.data(),
+                        src_data_variable.data(),
+                        src_data_variable.size());
+          }
+      }
+#else
+    save(global_first_cell, global_num_cells, file_basename, mpi_communicator);
+#endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
+  void CellAttachedDataSerializer<dim, spacedim>::load_memory_mapped(
+    const unsigned int global_first_cell,
+    const unsigned int global_num_cells,
+    const unsigned int local_num_cells,
+    const std::string &file_basename,
+    const unsigned int n_attached_deserialize_fixed,
+    const unsigned int n_attached_deserialize_variable,
+    const MPI_Comm    &mpi_communicator)
+  {
+#if defined(DEAL_II_HAVE_UNISTD_H) && !defined(_WIN32)
+    Assert(dest_data_fixed.empty(),
+           ExcMessage("Previously loaded data has not been released yet!"));
+
+    variable_size_data_stored = (n_attached_deserialize_variable > 0);
+
+    //
+    // ---------- Fixed size data ----------
+    //
+    {
+      const std::string fname_fixed =
+        std::string(file_basename) + "_fixed.data";
+
+      // Read cumulative sizes from the header that all processors share.
+      sizes_fixed_cumulative.resize(1 + n_attached_deserialize_fixed +
+                                    (variable_size_data_stored ? 1 : 0));
+      const std::uint64_t size_header =
+        sizes_fixed_cumulative.size() * sizeof(unsigned int);
+      {
+        const MappedFileSection header(fname_fixed, 0, size_header, false);
+        std::memcpy(sizes_fixed_cumulative.data(), header.data(), size_header);
+      }
+
+      // Copy this processor's packed data straight out of the mapping into
+      // the buffer used by unpack_data().
+      const unsigned int  bytes_per_cell = sizes_fixed_cumulative.back();
+      const std::uint64_t local_size =
+        static_cast<std::uint64_t>(local_num_cells) * bytes_per_cell;
+      const MappedFileSection section(
+        fname_fixed,
+        size_header +
+          static_cast<std::uint64_t>(global_first_cell) * bytes_per_cell,
+        local_size,
+        false);
+      if (local_size > 0)
+        dest_data_fixed.assign(section.data(), section.data() + local_size);
+    }
+
+    //
+    // ---------- Variable size data ----------
+    //
+    if (variable_size_data_stored)
+      {
+        const std::string fname_variable =
+          std::string(file_basename) + "_variable.data";
+
+        // Read sizes of all locally owned cells.
+        dest_sizes_variable.resize(local_num_cells);
+        {
+          const MappedFileSection sizes(fname_variable,
+                                        static_cast<std::uint64_t>(
+                                          global_first_cell) *
+                                          sizeof(unsigned int),
+                                        dest_sizes_variable.size() *
+                                          sizeof(int),
+                                        false);
+          if (local_num_cells > 0)
+            std::memcpy(dest_sizes_variable.data(),
+                        sizes.data(),
+                        dest_sizes_variable.size() * sizeof(int));
+        }
+
+        // Compute my data size in bytes and the prefix sum to find the
+        // position of my data within the file.
+        const std::uint64_t size_on_proc =
+          std::accumulate(dest_sizes_variable.begin(),
+                          dest_sizes_variable.end(),
+                          0ULL);
+        const std::uint64_t prefix_sum =
+          Utilities::MPI::partial_and_total_sum(size_on_proc, mpi_communicator)
+            .first;
+
+        const MappedFileSection section(
+          fname_variable,
+          static_cast<std::uint64_t>(global_num_cells) * sizeof(unsigned int) +
+            prefix_sum,
+          size_on_proc,
+          false);
+        if (size_on_proc > 0)
+          dest_data_variable.assign(section.data(),
+                                    section.data() + size_on_proc);
+      }
+#else
+    load(global_first_cell,
+         global_num_cells,
+         local_num_cells,
+         file_basename,
+         n_attached_deserialize_fixed,
+         n_attached_deserialize_variable,
+         mpi_communicator);
+#endif
+  }
+
+
+
   template <int dim, int spacedim>
   DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
   void CellAttachedDataSerializer<dim, spacedim>::clear()
@@ -1640,6 +1972,63 @@ namespace
   }
 
 
+
+  /**
+   * Set the locations of the vertices created during refinement: the vertex
+   * with index <tt>new_vertices[i].first</tt> is placed at the center of the
+   * object <tt>new_vertices[i].second</tt>, respecting its manifold and, if
+   * @p interpolate_from_surrounding is true, taking into account the new
+   * vertices on its bounding objects. The centers only depend on vertices
+   * that exist already, so they are computed in parallel.
+   */
+  template <typename Iterator, int spacedim>
+  void
+  compute_new_vertex_locations(
+    const std::vector<std::pair<unsigned int, Iterator>> &new_vertices,
+    const bool                    interpolate_from_surrounding,
+    std::vector<Point<spacedim>> &vertices)
+  {
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(new_vertices.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          vertices[new_vertices[i].first] =
+            new_vertices[i].second->center(true, interpolate_from_surrounding);
+      },
+      /* grainsize = */ 64);
+  }
+
+
+
+  /**
+   * Check the children of the cells that were refined for distortion, in
+   * parallel, and add the ones with distorted children to @p distorted_cells
+   * in the order given.
+   */
+  template <int dim, int spacedim, typename Iterator>
+  void
+  collect_cells_with_distorted_children(
+    const std::vector<Iterator> &refined_cells,
+    typename Triangulation<dim, spacedim>::DistortedCellList &distorted_cells)
+  {
+    std::vector<std::uint8_t> is_distorted(refined_cells.size(), 0);
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(refined_cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          is_distorted[i] =
+            has_distorted_children<dim, spacedim>(refined_cells[i]);
+      },
+      /* grainsize = */ 64);
+
+    for (unsigned int i = 0; i < refined_cells.size(); ++i)
+      if (is_distorted[i])
+        distorted_cells.distorted_cells.push_back(refined_cells[i]);
+  }
+
+
   template <int dim, int spacedim>
   void
   update_periodic_face_map_recursively(
@@ -5023,6 +5412,10 @@ namespace internal
           typename Triangulation<dim, spacedim>::active_line_iterator
             line = triangulation.begin_active_line(),
             endl = triangulation.end_line();
+          std::vector<std::pair<
+            unsigned int,
+            typename Triangulation<dim, spacedim>::active_line_iterator>>
+            new_vertices;
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
@@ -5040,8 +5433,7 @@ namespace internal
                          "but it turns out that the array is not large "
                          "enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
-
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_vertices.emplace_back(next_unused_vertex, line);
 
                 bool pair_found = false;
                 (void)pair_found;
@@ -5082,6 +5474,10 @@ namespace internal
 
                 line->clear_user_flag();
               }
+
+          compute_new_vertex_locations(new_vertices,
+                                       false,
+                                       triangulation.vertices);
         }
 
         reserve_space(triangulation.faces->lines, 0, n_single_lines);
@@ -5092,11 +5488,99 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
-        const auto create_children = [](auto         &triangulation,
-                                        unsigned int &next_unused_vertex,
-                                        auto         &next_unused_line,
-                                        auto         &next_unused_cell,
-                                        const auto   &cell) {
+        // the objects that are created when refining a cell, in addition to
+        // the children of its lines: the vertex at its center (only for
+        // quadrilaterals), the lines in its interior, and its children
+        struct NewObjects
+        {
+          unsigned int vertex = numbers::invalid_unsigned_int;
+          std::array<typename Triangulation<dim, spacedim>::raw_line_iterator,
+                     4>
+            lines;
+          std::array<typename Triangulation<dim, spacedim>::raw_cell_iterator,
+                     GeometryInfo<dim>::max_children_per_cell>
+            children;
+        };
+
+        // Find the unused objects for the refinement of a cell and mark them
+        // as used. This determines the indices of the new objects and has
+        // to happen sequentially, in the order of the cells. It also sets
+        // the user flags of the new objects since they are stored in a
+        // std::vector<bool>, which can not be written to concurrently.
+        const auto assign_new_objects = [](auto         &triangulation,
+                                           unsigned int &next_unused_vertex,
+                                           auto         &next_unused_line,
+                                           auto         &next_unused_cell,
+                                           const auto   &cell) {
+          NewObjects new_objects;
+
+          if (cell->reference_cell() == ReferenceCells::Quadrilateral)
+            {
+              while (triangulation.vertices_used[next_unused_vertex] == true)
+                ++next_unused_vertex;
+              Assert(
+                next_unused_vertex < triangulation.vertices.size(),
+                ExcMessage(
+                  "Internal error: During refinement, the triangulation wants "
+                  "to access an element of the 'vertices' array but it turns "
+                  "out that the array is not large enough."));
+              triangulation.vertices_used[next_unused_vertex] = true;
+
+              new_objects.vertex = next_unused_vertex;
+            }
+
+          unsigned int n_new_lines = 0;
+          if (cell->reference_cell() == ReferenceCells::Triangle)
+            n_new_lines = 3;
+          else if (cell->reference_cell() == ReferenceCells::Quadrilateral)
+            n_new_lines = 4;
+          else
+            AssertThrow(false, ExcNotImplemented());
+
+          for (unsigned int l = 0; l < n_new_lines; ++l)
+            {
+              while (next_unused_line->used() == true)
+                ++next_unused_line;
+              new_objects.lines[l] = next_unused_line;
+              ++next_unused_line;
+
+              AssertIsNotUsed(new_objects.lines[l]);
+            }
+          for (unsigned int l = 0; l < n_new_lines; ++l)
+            {
+              new_objects.lines[l]->set_used_flag();
+              new_objects.lines[l]->clear_user_flag();
+            }
+
+          while (next_unused_cell->used() == true)
+            ++next_unused_cell;
+
+          const unsigned int n_children =
+            cell->reference_cell().n_isotropic_children();
+          for (unsigned int i = 0; i < n_children; ++i)
+            {
+              AssertIsNotUsed(next_unused_cell);
+              new_objects.children[i] = next_unused_cell;
+              ++next_unused_cell;
+              if (i % 2 == 1 && i < n_children - 1)
+                while (next_unused_cell->used() == true)
+                  ++next_unused_cell;
+            }
+          for (unsigned int i = 0; i < n_children; ++i)
+            {
+              new_objects.children[i]->set_used_flag();
+              new_objects.children[i]->clear_user_flag();
+            }
+
+          return new_objects;
+        };
+
+        // Set up the children of a cell and the lines in its interior. This
+        // only writes to the cell and the objects assigned to it, so it can
+        // be done for several cells concurrently.
+        const auto create_children = [](auto             &triangulation,
+                                        const NewObjects &new_objects,
+                                        const auto       &cell) {
           const auto ref_case = cell->refine_flag_set();
           cell->clear_refine_flag();
 
@@ -5121,19 +5605,9 @@ namespace internal
 
           if (cell->reference_cell() == ReferenceCells::Quadrilateral)
             {
-              while (triangulation.vertices_used[next_unused_vertex] == true)
-                ++next_unused_vertex;
-              Assert(
-                next_unused_vertex < triangulation.vertices.size(),
-                ExcMessage(
-                  "Internal error: During refinement, the triangulation wants "
-                  "to access an element of the 'vertices' array but it turns "
-                  "out that the array is not large enough."));
-              triangulation.vertices_used[next_unused_vertex] = true;
+              new_vertices[8] = new_objects.vertex;
 
-              new_vertices[8] = next_unused_vertex;
-
-              triangulation.vertices[next_unused_vertex] =
+              triangulation.vertices[new_objects.vertex] =
                 cell->center(true, true);
             }
 
@@ -5168,14 +5642,7 @@ namespace internal
             }
 
           for (unsigned int l = lmin; l < lmax; ++l)
-            {
-              while (next_unused_line->used() == true)
-                ++next_unused_line;
-              new_lines[l] = next_unused_line;
-              ++next_unused_line;
-
-              AssertIsNotUsed(new_lines[l]);
-            }
+            new_lines[l] = new_objects.lines[l - lmin];
 
           // set up lines which have parents:
           for (const unsigned int face_no : cell->face_indices())
@@ -5231,8 +5698,6 @@ namespace internal
 
           for (unsigned int l = lmin; l < lmax; ++l)
             {
-              new_lines[l]->set_used_flag();
-              new_lines[l]->clear_user_flag();
               new_lines[l]->clear_user_data();
               new_lines[l]->clear_children();
               // new lines are always internal.
@@ -5241,28 +5706,9 @@ namespace internal
               new_lines[l]->set_manifold_id(cell->manifold_id());
             }
 
-          typename Triangulation<dim, spacedim>::raw_cell_iterator
-            subcells[GeometryInfo<dim>::max_children_per_cell];
-          while (next_unused_cell->used() == true)
-            ++next_unused_cell;
-
-          unsigned int n_children = 0;
-          if (cell->reference_cell() == ReferenceCells::Triangle)
-            n_children = 4;
-          else if (cell->reference_cell() == ReferenceCells::Quadrilateral)
-            n_children = 4;
-          else
-            AssertThrow(false, ExcNotImplemented());
-
-          for (unsigned int i = 0; i < n_children; ++i)
-            {
-              AssertIsNotUsed(next_unused_cell);
-              subcells[i] = next_unused_cell;
-              ++next_unused_cell;
-              if (i % 2 == 1 && i < n_children - 1)
-                while (next_unused_cell->used() == true)
-                  ++next_unused_cell;
-            }
+          auto               subcells = new_objects.children;
+          const unsigned int n_children =
+            cell->reference_cell().n_isotropic_children();
 
           // Assign lines to child cells:
           constexpr unsigned int X = numbers::invalid_unsigned_int;
@@ -5293,9 +5739,7 @@ namespace internal
                    new_lines[child_lines[i][2]]->index(),
                    new_lines[child_lines[i][3]]->index()});
 
-              subcells[i]->set_used_flag();
               subcells[i]->clear_refine_flag();
-              subcells[i]->clear_user_flag();
               subcells[i]->clear_user_data();
               subcells[i]->clear_children();
               // inherit material properties
@@ -5327,10 +5771,6 @@ namespace internal
             cell->set_children(2 * i, subcells[2 * i]->index());
 
           cell->set_refinement_case(ref_case);
-
-          if (dim == spacedim - 1)
-            for (unsigned int c = 0; c < n_children; ++c)
-              cell->child(c)->set_direction_flag(cell->direction_flag());
         };
 
         for (int level = 0;
@@ -5340,24 +5780,51 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+                                    refined_cells;
+            std::vector<NewObjects> new_objects;
             for (const auto &cell :
                  triangulation.active_cell_iterators_on_level(level))
               if (cell->refine_flag_set())
                 {
+                  refined_cells.push_back(cell);
+                  new_objects.push_back(assign_new_objects(triangulation,
+                                                           next_unused_vertex,
+                                                           next_unused_line,
+                                                           next_unused_cell,
+                                                           cell));
+                }
+
+            dealii::parallel::apply_to_subranges(
+              0U,
+              static_cast<unsigned int>(refined_cells.size()),
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int i = begin; i < end; ++i)
                   create_children(triangulation,
-                                  next_unused_vertex,
-                                  next_unused_line,
-                                  next_unused_cell,
-                                  cell);
+                                  new_objects[i],
+                                  refined_cells[i]);
+              },
+              /* grainsize = */ 64);
 
-                  if (cell->reference_cell() == ReferenceCells::Quadrilateral &&
-                      check_for_distorted_cells &&
-                      has_distorted_children<dim, spacedim>(cell))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      cell);
+            if (dim == spacedim - 1)
+              for (const auto &cell : refined_cells)
+                for (unsigned int c = 0; c < cell->n_children(); ++c)
+                  cell->child(c)->set_direction_flag(cell->direction_flag());
 
-                  triangulation.signals.post_refinement_on_cell(cell);
-                }
+            if (check_for_distorted_cells)
+              {
+                std::vector<
+                  typename Triangulation<dim, spacedim>::cell_iterator>
+                  refined_quadrilaterals;
+                for (const auto &cell : refined_cells)
+                  if (cell->reference_cell() == ReferenceCells::Quadrilateral)
+                    refined_quadrilaterals.push_back(cell);
+                collect_cells_with_distorted_children<dim, spacedim>(
+                  refined_quadrilaterals, cells_with_distorted_children);
+              }
+
+            for (const auto &cell : refined_cells)
+              triangulation.signals.post_refinement_on_cell(cell);
           }
 
         return cells_with_distorted_children;
@@ -6147,6 +6614,10 @@ namespace internal
             line = triangulation.begin_active_line(),
             endl = triangulation.end_line();
           raw_line_iterator next_unused_line = triangulation.begin_raw_line();
+          std::vector<std::pair<
+            unsigned int,
+            typename Triangulation<dim, spacedim>::active_line_iterator>>
+            new_vertices;
 
           for (; line != endl; ++line)
             {
@@ -6173,7 +6644,7 @@ namespace internal
               current_vertex =
                 get_next_unused_vertex(current_vertex,
                                        triangulation.vertices_used);
-              triangulation.vertices[current_vertex] = line->center(true);
+              new_vertices.emplace_back(current_vertex, line);
 
               children[0]->set_bounding_object_indices(
                 {line->vertex_index(0), current_vertex});
@@ -6194,6 +6665,10 @@ namespace internal
 
               line->clear_user_flag();
             }
+
+          compute_new_vertex_locations(new_vertices,
+                                       false,
+                                       triangulation.vertices);
         }
 
         // QUADS
@@ -6201,6 +6676,10 @@ namespace internal
           typename Triangulation<dim, spacedim>::quad_iterator
             quad = triangulation.begin_quad(),
             endq = triangulation.end_quad();
+          std::vector<
+            std::pair<unsigned int,
+                      typename Triangulation<dim, spacedim>::quad_iterator>>
+            new_vertices;
 
           for (; quad != endq; ++quad)
             {
@@ -6282,8 +6761,7 @@ namespace internal
                                            triangulation.vertices_used);
                   vertex_indices[k++] = current_vertex;
 
-                  triangulation.vertices[current_vertex] =
-                    quad->center(true, true);
+                  new_vertices.emplace_back(current_vertex, quad);
                 }
 
               // 4) set new lines on quads and their properties
@@ -6471,11 +6949,24 @@ namespace internal
 
               quad->clear_user_flag();
             }
+
+          compute_new_vertex_locations(new_vertices,
+                                       true,
+                                       triangulation.vertices);
         }
 
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        // the cells that are refined, and the vertices at the centers of
+        // hexahedra, which are placed once all cells are refined
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+        std::vector<std::pair<
+          unsigned int,
+          typename Triangulation<dim, spacedim>::cell_iterator>>
+          new_vertices;
+
         typename Triangulation<dim, spacedim>::active_hex_iterator hex =
           triangulation.begin_active_hex(0);
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
@@ -6660,8 +7151,7 @@ namespace internal
                                                  triangulation.vertices_used);
                         vertex_indices[k++] = current_vertex;
 
-                        triangulation.vertices[current_vertex] =
-                          hex->center(true, true);
+                        new_vertices.emplace_back(current_vertex, hex);
                       }
                   }
 
@@ -7090,14 +7580,21 @@ namespace internal
                   }
                 }
 
-                if (check_for_distorted_cells &&
-                    has_distorted_children<dim, spacedim>(hex))
-                  cells_with_distorted_children.distorted_cells.push_back(hex);
-
-                triangulation.signals.post_refinement_on_cell(hex);
+                refined_cells.push_back(hex);
               }
           }
 
+        compute_new_vertex_locations(new_vertices,
+                                     true,
+                                     triangulation.vertices);
+
+        if (check_for_distorted_cells)
+          collect_cells_with_distorted_children<dim, spacedim>(
+            refined_cells, cells_with_distorted_children);
+
+        for (const auto &cell : refined_cells)
+          triangulation.signals.post_refinement_on_cell(cell);
+
         triangulation.faces->quads.clear_user_data();
 
         return cells_with_distorted_children;
@@ -16231,7 +16728,8 @@ DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 void Triangulation<dim, spacedim>::save_attached_data(
   const unsigned int global_first_cell,
   const unsigned int global_num_cells,
-  const std::string &file_basename) const
+  const std::string &file_basename,
+  const bool         memory_mapped) const
 {
   // cast away constness
   auto tria = const_cast<Triangulation<dim, spacedim> *>(this);
@@ -16255,10 +16753,16 @@ void Triangulation<dim, spacedim>::save_attached_data(
         this->get_communicator());
 
       // then store buffers in file
-      tria->data_serializer.save(global_first_cell,
-                                 global_num_cells,
-                                 file_basename,
-                                 this->get_communicator());
+      if (memory_mapped)
+        tria->data_serializer.save_memory_mapped(global_first_cell,
+                                                 global_num_cells,
+                                                 file_basename,
+                                                 this->get_communicator());
+      else
+        tria->data_serializer.save(global_first_cell,
+                                   global_num_cells,
+                                   file_basename,
+                                   this->get_communicator());
 
       // and release the memory afterwards
       tria->data_serializer.clear();
@@ -16282,18 +16786,29 @@ void Triangulation<dim, spacedim>::load_attached_data(
   const unsigned int local_num_cells,
   const std::string &file_basename,
   const unsigned int n_attached_deserialize_fixed,
-  const unsigned int n_attached_deserialize_variable)
+  const unsigned int n_attached_deserialize_variable,
+  const bool         memory_mapped)
 {
   // load saved data, if any was stored
   if (this->cell_attached_data.n_attached_deserialize > 0)
     {
-      this->data_serializer.load(global_first_cell,
-                                 global_num_cells,
-                                 local_num_cells,
-                                 file_basename,
-                                 n_attached_deserialize_fixed,
-                                 n_attached_deserialize_variable,
-                                 this->get_communicator());
+      if (memory_mapped)
+        this->data_serializer.load_memory_mapped(
+          global_first_cell,
+          global_num_cells,
+          local_num_cells,
+          file_basename,
+          n_attached_deserialize_fixed,
+          n_attached_deserialize_variable,
+          this->get_communicator());
+      else
+        this->data_serializer.load(global_first_cell,
+                                   global_num_cells,
+                                   local_num_cells,
+                                   file_basename,
+                                   n_attached_deserialize_fixed,
+                                   n_attached_deserialize_variable,
+                                   this->get_communicator());
 
       this->data_serializer.unpack_cell_status(this->local_cell_relations);
 
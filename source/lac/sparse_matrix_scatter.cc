@@ -0,0 +1,356 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_scatter.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+
+template <typename number>
+void
+SparseMatrixScatter<number>::reinit(
+  const AffineConstraints<number> &constraints,
+  const SparsityPattern           &sparsity_pattern,
+  const unsigned int               n_cells)
+{
+  Assert(sparsity_pattern.n_rows() == sparsity_pattern.n_cols(),
+         ExcNotQuadratic());
+  Assert(constraints.is_closed(),
+         ExcMessage("The constraints must be closed before they can be used "
+                    "to set up a SparseMatrixScatter object."));
+
+  this->constraints      = &constraints;
+  this->sparsity_pattern = &sparsity_pattern;
+
+  cell_plans.clear();
+  cell_plans.resize(n_cells);
+}
+
+
+
+template <typename number>
+void
+SparseMatrixScatter<number>::add_cell(
+  const unsigned int                cell_index,
+  const ArrayView<const size_type> &local_dof_indices)
+{
+  AssertIndexRange(cell_index, cell_plans.size());
+  Assert(sparsity_pattern != nullptr, ExcNotInitialized());
+
+  const SparsityPattern &sparsity = *sparsity_pattern;
+  const unsigned int     n_dofs   = local_dof_indices.size();
+
+  CellPlan &plan = cell_plans[cell_index];
+  plan           = CellPlan();
+  plan.n_dofs    = n_dofs;
+
+  // the degrees of freedom a row or column of the cell matrix ends up in
+  // after resolving the constraints, with their weights
+  std::vector<std::vector<std::pair<size_type, number>>> targets(n_dofs);
+  std::vector<bool> is_constrained(n_dofs, false);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    {
+      AssertIndexRange(local_dof_indices[i], sparsity.n_rows());
+      const auto entries =
+        constraints->get_constraint_entries(local_dof_indices[i]);
+      if (!entries.has_value())
+        {
+          plan.unconstrained_dofs.push_back(i);
+          targets[i].emplace_back(local_dof_indices[i], number(1.));
+        }
+      else
+        {
+          is_constrained[i] = true;
+          targets[i].assign(entries->begin(), entries->end());
+          plan.constrained_diagonals.emplace_back(
+            i, sparsity(local_dof_indices[i], local_dof_indices[i]));
+        }
+    }
+
+  const unsigned int n_unconstrained = plan.unconstrained_dofs.size();
+  plan.direct_positions.resize(n_unconstrained * n_unconstrained);
+  for (unsigned int a = 0; a < n_unconstrained; ++a)
+    {
+      const size_type row = local_dof_indices[plan.unconstrained_dofs[a]];
+      for (unsigned int b = 0; b < n_unconstrained; ++b)
+        {
+          const std::size_t position =
+            sparsity(row, local_dof_indices[plan.unconstrained_dofs[b]]);
+          plan.direct_positions[a * n_unconstrained + b] = position;
+          if (position == SparsityPattern::invalid_entry)
+            plan.all_direct_positions_valid = false;
+        }
+    }
+
+  if (n_unconstrained < n_dofs)
+    for (unsigned int i = 0; i < n_dofs; ++i)
+      for (unsigned int j = 0; j < n_dofs; ++j)
+        {
+          // entries coupling two unconstrained degrees of freedom are
+          // treated above
+          if (is_constrained[i] == false && is_constrained[j] == false)
+            continue;
+
+          for (const auto &row : targets[i])
+            for (const auto &column : targets[j])
+              plan.indirect_entries.push_back(
+                {sparsity(row.first, column.first),
+                 row.second * column.second,
+                 i * n_dofs + j});
+        }
+
+  // sort the indirect entries by their position, so that the matrix values
+  // are accessed in order
+  std::sort(plan.indirect_entries.begin(),
+            plan.indirect_entries.end(),
+            [](const IndirectEntry &a, const IndirectEntry &b) {
+              return a.position < b.position;
+            });
+}
+
+
+
+template <typename number>
+bool
+SparseMatrixScatter<number>::has_cell(const unsigned int cell_index) const
+{
+  AssertIndexRange(cell_index, cell_plans.size());
+  return cell_plans[cell_index].n_dofs != numbers::invalid_unsigned_int;
+}
+
+
+
+template <typename number>
+void
+SparseMatrixScatter<number>::add_cell_matrix(
+  const CellPlan           &plan,
+  const FullMatrix<number> &cell_matrix,
+  const std::size_t         begin,
+  const std::size_t         end,
+  number                   *values) const
+{
+  Assert(plan.n_dofs != numbers::invalid_unsigned_int,
+         ExcMessage("No plan has been computed for this cell. You need to "
+                    "call add_cell() first."));
+  AssertDimension(cell_matrix.m(), plan.n_dofs);
+  AssertDimension(cell_matrix.n(), plan.n_dofs);
+  if (plan.n_dofs == 0)
+    return;
+
+  const unsigned int  n_dofs          = plan.n_dofs;
+  const unsigned int  n_unconstrained = plan.unconstrained_dofs.size();
+  const unsigned int *unconstrained   = plan.unconstrained_dofs.data();
+  const number       *local_values    = &cell_matrix(0, 0);
+
+  // the couplings between unconstrained degrees of freedom. every row of the
+  // sparsity pattern lies completely within the range we work on or not at
+  // all, so it suffices to check the position of the diagonal entry
+  for (unsigned int a = 0; a < n_unconstrained; ++a)
+    {
+      const std::size_t *positions =
+        plan.direct_positions.data() + a * n_unconstrained;
+      if (positions[a] < begin || positions[a] >= end)
+        continue;
+
+      const number *row = local_values + unconstrained[a] * n_dofs;
+      if (plan.all_direct_positions_valid)
+        {
+          if (n_unconstrained == n_dofs)
+            for (unsigned int b = 0; b < n_dofs; ++b)
+              values[positions[b]] += row[b];
+          else
+            for (unsigned int b = 0; b < n_unconstrained; ++b)
+              values[positions[b]] += row[unconstrained[b]];
+        }
+      else
+        for (unsigned int b = 0; b < n_unconstrained; ++b)
+          if (positions[b] != SparsityPattern::invalid_entry)
+            values[positions[b]] += row[unconstrained[b]];
+          else
+            Assert(row[unconstrained[b]] == number(),
+                   ExcMessage("You are trying to add a nonzero entry to a "
+                              "position that is not part of the sparsity "
+                              "pattern."));
+    }
+
+  if (plan.constrained_diagonals.empty())
+    return;
+
+  for (const IndirectEntry &entry : plan.indirect_entries)
+    if (entry.position >= begin && entry.position < end)
+      values[entry.position] += entry.weight * local_values[entry.local_index];
+    else
+      Assert(entry.position != SparsityPattern::invalid_entry || begin > 0 ||
+               local_values[entry.local_index] == number(),
+             ExcMessage("You are trying to add a nonzero entry to a "
+                        "position that is not part of the sparsity "
+                        "pattern."));
+
+  // the diagonal entries of constrained rows, computed the same way as in
+  // AffineConstraints::distribute_local_to_global()
+  number average_diagonal = number();
+  for (const auto &[local_dof, position] : plan.constrained_diagonals)
+    if (position >= begin && position < end)
+      {
+        const number diagonal = local_values[local_dof * n_dofs + local_dof];
+        if (diagonal != number())
+          values[position] += std::abs(diagonal);
+        else
+          {
+            if (average_diagonal == number())
+              {
+                for (unsigned int i = 0; i < n_dofs; ++i)
+                  average_diagonal += std::abs(local_values[i * n_dofs + i]);
+                average_diagonal /= static_cast<number>(n_dofs);
+
+                if (average_diagonal == number())
+                  {
+                    average_diagonal =
+                      static_cast<number>(cell_matrix.l1_norm()) /
+                      static_cast<number>(n_dofs);
+                    if (average_diagonal == number())
+                      average_diagonal = number(1.);
+                  }
+              }
+            values[position] += average_diagonal;
+          }
+      }
+}
+
+
+
+template <typename number>
+void
+SparseMatrixScatter<number>::distribute_local_to_global(
+  const unsigned int        cell_index,
+  const FullMatrix<number> &cell_matrix,
+  SparseMatrix<number>     &global_matrix) const
+{
+  AssertIndexRange(cell_index, cell_plans.size());
+  Assert(&global_matrix.get_sparsity_pattern() == sparsity_pattern,
+         ExcMessage("The matrix must be based on the sparsity pattern given "
+                    "to reinit()."));
+
+  add_cell_matrix(cell_plans[cell_index],
+                  cell_matrix,
+                  0,
+                  sparsity_pattern->n_nonzero_elements(),
+                  global_matrix.val.get());
+}
+
+
+
+template <typename number>
+void
+SparseMatrixScatter<number>::distribute_local_to_global(
+  const ArrayView<const unsigned int>       &cell_indices,
+  const ArrayView<const FullMatrix<number>> &cell_matrices,
+  SparseMatrix<number>                      &global_matrix) const
+{
+  AssertDimension(cell_indices.size(), cell_matrices.size());
+  Assert(&global_matrix.get_sparsity_pattern() == sparsity_pattern,
+         ExcMessage("The matrix must be based on the sparsity pattern given "
+                    "to reinit()."));
+
+  const SparsityPattern &sparsity = *sparsity_pattern;
+  const std::size_t      n_values = sparsity.n_nonzero_elements();
+  number                *values   = global_matrix.val.get();
+
+  std::size_t n_entries = 0;
+  for (const unsigned int cell_index : cell_indices)
+    {
+      AssertIndexRange(cell_index, cell_plans.size());
+      n_entries += cell_plans[cell_index].n_dofs *
+                   std::size_t(cell_plans[cell_index].n_dofs);
+    }
+
+  // every thread needs to look at the rows of all cells of the batch, so
+  // only go parallel if there is enough work to amortize this
+  const unsigned int n_ranges =
+    std::min<std::size_t>(MultithreadInfo::n_threads(), sparsity.n_rows());
+  if (n_ranges < 2 || n_entries < 16384)
+    {
+      for (unsigned int c = 0; c < cell_indices.size(); ++c)
+        add_cell_matrix(
+          cell_plans[cell_indices[c]], cell_matrices[c], 0, n_values, values);
+      return;
+    }
+
+  // split the array of values into ranges of whole rows of about equal size.
+  // the pattern is square, so the diagonal is the first entry of each row
+  std::vector<std::size_t> range_begin(n_ranges + 1, n_values);
+  range_begin[0] = 0;
+  for (unsigned int r = 1; r < n_ranges; ++r)
+    {
+      const std::size_t target = n_values / n_ranges * r;
+      size_type         lower = 0, upper = sparsity.n_rows();
+      while (lower < upper)
+        {
+          const size_type middle = lower + (upper - lower) / 2;
+          if (sparsity(middle, middle) < target)
+            lower = middle + 1;
+          else
+            upper = middle;
+        }
+      range_begin[r] =
+        (lower < sparsity.n_rows() ? sparsity(lower, lower) : n_values);
+    }
+
+  parallel::apply_to_subranges(
+    0U,
+    n_ranges,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int r = begin; r < end; ++r)
+        for (unsigned int c = 0; c < cell_indices.size(); ++c)
+          add_cell_matrix(cell_plans[cell_indices[c]],
+                          cell_matrices[c],
+                          range_begin[r],
+                          range_begin[r + 1],
+                          values);
+    },
+    1);
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixScatter<number>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this);
+  for (const CellPlan &plan : cell_plans)
+    memory += sizeof(CellPlan) +
+              MemoryConsumption::memory_consumption(plan.unconstrained_dofs) +
+              MemoryConsumption::memory_consumption(plan.direct_positions) +
+              plan.indirect_entries.capacity() * sizeof(IndirectEntry) +
+              plan.constrained_diagonals.capacity() *
+                sizeof(std::pair<unsigned int, std::size_t>);
+  return memory;
+}
+
+
+
+template class SparseMatrixScatter<double>;
+template class SparseMatrixScatter<float>;
+
+DEAL_II_NAMESPACE_CLOSE
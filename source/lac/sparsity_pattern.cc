@@ -13,11 +13,13 @@
 // ------------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern_builder.h>
 #include <deal.II/lac/sparsity_tools.h>
 
 #include <algorithm>
@@ -539,6 +541,98 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 
 
 
+void
+SparsityPattern::copy_from(const SparsityPatternBuilder &builder)
+{
+  const size_type n_rows           = builder.n_rows();
+  const size_type n_cols           = builder.n_cols();
+  const bool      do_diag_optimize = (n_rows == n_cols);
+
+  // sort the lists of columns recorded by the builder by the row they were
+  // added to, by counting the lists of each row, computing offsets, and
+  // filling the array
+  std::vector<std::size_t> row_entries_start(n_rows + 1, 0);
+  for (const auto &data : builder.thread_data)
+    for (const auto &row_entries : data->row_entries)
+      ++row_entries_start[row_entries.row + 1];
+  std::partial_sum(row_entries_start.begin(),
+                   row_entries_start.end(),
+                   row_entries_start.begin());
+
+  std::vector<ArrayView<const size_type>> row_entries_by_row(
+    row_entries_start.back());
+  {
+    std::vector<std::size_t> next_index(row_entries_start.begin(),
+                                        row_entries_start.end() - 1);
+    for (const auto &data : builder.thread_data)
+      for (const auto &row_entries : data->row_entries)
+        row_entries_by_row[next_index[row_entries.row]++] =
+          make_array_view(data->columns.data() + row_entries.first_column,
+                          data->columns.data() + row_entries.first_column +
+                            row_entries.n_columns);
+  }
+
+  // merge all lists of a row into a sorted list without duplicates
+  const auto merge_row = [&](const size_type         row,
+                             std::vector<size_type> &columns) {
+    columns.clear();
+    for (std::size_t i = row_entries_start[row];
+         i < row_entries_start[row + 1];
+         ++i)
+      columns.insert(columns.end(),
+                     row_entries_by_row[i].begin(),
+                     row_entries_by_row[i].end());
+    std::sort(columns.begin(), columns.end());
+    columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+  };
+
+  // first pass: determine the exact length of each row, including the
+  // diagonal entry for square patterns
+  std::vector<unsigned int> row_lengths(n_rows);
+  parallel::apply_to_subranges(
+    size_type(0),
+    n_rows,
+    [&](const size_type begin, const size_type end) {
+      std::vector<size_type> columns;
+      for (size_type row = begin; row < end; ++row)
+        {
+          merge_row(row, columns);
+          row_lengths[row] = columns.size();
+          if (do_diag_optimize &&
+              !std::binary_search(columns.begin(), columns.end(), row))
+            ++row_lengths[row];
+        }
+    },
+    256);
+
+  reinit(n_rows, n_cols, row_lengths);
+
+  // second pass: write the column indices into the space allocated for each
+  // row. note that if the matrix is quadratic, then we already have the
+  // diagonal element preallocated
+  if (n_rows != 0 && n_cols != 0)
+    parallel::apply_to_subranges(
+      size_type(0),
+      n_rows,
+      [&](const size_type begin, const size_type end) {
+        std::vector<size_type> columns;
+        for (size_type row = begin; row < end; ++row)
+          {
+            merge_row(row, columns);
+            size_type *cols =
+              &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
+            for (const size_type col : columns)
+              if ((col != row) || !do_diag_optimize)
+                *cols++ = col;
+          }
+      },
+      256);
+
+  compressed = true;
+}
+
+
+
 template <typename number>
 void
 SparsityPattern::copy_from(const FullMatrix<number> &matrix)
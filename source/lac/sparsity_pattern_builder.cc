@@ -0,0 +1,121 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/lac/sparsity_pattern_builder.h>
+
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+
+SparsityPatternBuilder::SparsityPatternBuilder(const size_type n_rows,
+                                               const size_type n_cols)
+  : SparsityPatternBase(n_rows, n_cols)
+{}
+
+
+
+void
+SparsityPatternBuilder::reinit(const size_type n_rows, const size_type n_cols)
+{
+  resize(n_rows, n_cols);
+  thread_data.clear();
+  thread_data_pointer.clear();
+}
+
+
+
+SparsityPatternBuilder::ThreadData &
+SparsityPatternBuilder::get_thread_data()
+{
+  ThreadData *&data = thread_data_pointer.get();
+  if (data == nullptr)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      thread_data.push_back(std::make_unique<ThreadData>());
+      data = thread_data.back().get();
+    }
+  return *data;
+}
+
+
+
+void
+SparsityPatternBuilder::add_row_entries(
+  const size_type                  &row,
+  const ArrayView<const size_type> &columns,
+  const bool                        indices_are_sorted)
+{
+  (void)indices_are_sorted;
+  AssertIndexRange(row, n_rows());
+  if (columns.empty())
+    return;
+
+  ThreadData &data = get_thread_data();
+
+  // callers typically add the same list of columns to several rows in a
+  // row, so check whether the list is the one stored last and only store it
+  // if not
+  const std::size_t n_columns = columns.size();
+  if (data.columns.size() < n_columns ||
+      !std::equal(columns.begin(),
+                  columns.end(),
+                  data.columns.end() - n_columns))
+    {
+      for (const size_type column : columns)
+        AssertIndexRange(column, n_cols());
+      data.columns.insert(data.columns.end(), columns.begin(), columns.end());
+    }
+
+  data.row_entries.push_back({data.columns.size() - n_columns,
+                              row,
+                              static_cast<unsigned int>(n_columns)});
+}
+
+
+
+void
+SparsityPatternBuilder::add_entries(
+  const ArrayView<const std::pair<size_type, size_type>> &entries)
+{
+  if (entries.empty())
+    return;
+
+  ThreadData &data = get_thread_data();
+  for (const auto &entry : entries)
+    {
+      AssertIndexRange(entry.first, n_rows());
+      AssertIndexRange(entry.second, n_cols());
+      data.columns.push_back(entry.second);
+      data.row_entries.push_back({data.columns.size() - 1, entry.first, 1});
+    }
+}
+
+
+
+std::size_t
+SparsityPatternBuilder::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this);
+  for (const auto &data : thread_data)
+    memory += sizeof(ThreadData) +
+              MemoryConsumption::memory_consumption(data->columns) +
+              data->row_entries.capacity() * sizeof(RowEntries);
+  return memory;
+}
+
+DEAL_II_NAMESPACE_CLOSE
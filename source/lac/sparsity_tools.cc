@@ -14,6 +14,8 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparsity_pattern.h>
@@ -631,29 +633,83 @@ namespace SparsityTools
     std::vector<std::pair<unsigned int, DynamicSparsityPattern::size_type>>
       dofs_by_coordination;
 
+    // the neighbors found by each task when searching large levels in
+    // parallel
+    std::vector<std::vector<DynamicSparsityPattern::size_type>>
+      neighbors_of_chunks;
+
     // now do as many steps as needed to renumber all dofs
     while (true)
       {
         next_round_dofs.clear();
 
         // find all neighbors of the dofs numbered in the last round
-        for (const auto dof : last_round_dofs)
+        const unsigned int n_chunks =
+          (last_round_dofs.size() < 2048 ? 1 : MultithreadInfo::n_threads());
+        if (n_chunks == 1)
+          for (const auto dof : last_round_dofs)
+            {
+              const unsigned int row_length = sparsity.row_length(dof);
+              for (unsigned int i = 0; i < row_length; ++i)
+                {
+                  // skip dofs which are already numbered
+                  const auto column = sparsity.column_number(dof, i);
+                  if (new_indices[column] == numbers::invalid_size_type)
+                    {
+                      next_round_dofs.push_back(column);
+
+                      // assign a dummy value to 'new_indices' to avoid adding
+                      // the same index again; those will get the right number
+                      // at the end of the outer 'while' loop
+                      new_indices[column] = 0;
+                    }
+                }
+            }
+        else
           {
-            const unsigned int row_length = sparsity.row_length(dof);
-            for (unsigned int i = 0; i < row_length; ++i)
-              {
-                // skip dofs which are already numbered
-                const auto column = sparsity.column_number(dof, i);
+            // for large levels, let every task collect the unnumbered
+            // neighbors of a part of the level without writing to
+            // 'new_indices', and remove the duplicates between the tasks
+            // afterwards
+            neighbors_of_chunks.resize(n_chunks);
+            parallel::apply_to_subranges(
+              0U,
+              n_chunks,
+              [&](const unsigned int begin, const unsigned int end) {
+                for (unsigned int chunk = begin; chunk < end; ++chunk)
+                  {
+                    std::vector<DynamicSparsityPattern::size_type> &neighbors =
+                      neighbors_of_chunks[chunk];
+                    neighbors.clear();
+                    const std::size_t chunk_size =
+                      (last_round_dofs.size() + n_chunks - 1) / n_chunks;
+                    const std::size_t first = chunk * chunk_size;
+                    const std::size_t last =
+                      std::min(first + chunk_size, last_round_dofs.size());
+                    for (std::size_t d = first; d < last; ++d)
+                      {
+                        const auto         dof = last_round_dofs[d];
+                        const unsigned int row_length =
+                          sparsity.row_length(dof);
+                        for (unsigned int i = 0; i < row_length; ++i)
+                          {
+                            const auto column = sparsity.column_number(dof, i);
+                            if (new_indices[column] ==
+                                numbers::invalid_size_type)
+                              neighbors.push_back(column);
+                          }
+                      }
+                  }
+              },
+              1);
+
+            for (const auto &neighbors : neighbors_of_chunks)
+              for (const auto column : neighbors)
                 if (new_indices[column] == numbers::invalid_size_type)
                   {
                     next_round_dofs.push_back(column);
-
-                    // assign a dummy value to 'new_indices' to avoid adding
-                    // the same index again; those will get the right number
-                    // at the end of the outer 'while' loop
                     new_indices[column] = 0;
                   }
-              }
           }
 
         // check whether there are any new dofs in the list. if there are
@@ -18,6 +18,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parallel.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
@@ -35,7 +36,13 @@
 #  endif
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <set>
 
 //
@@ -49,7 +56,8 @@
 // years and is (presumably) not used that often.
 //
 // In case of detected oneAPI backend we simply disable threading in the
-// matrix free backend for now.
+// matrix free backend for now. The exception is the partition_dynamic
+// scheme, which schedules its tasks on top of Threads::new_task().
 //
 // Matthias Maier, Martin Kronbichler, 2021
 //
@@ -346,6 +354,123 @@ namespace internal
 
 
 
+    namespace dynamic
+    {
+      // Queue of ready tasks of one worker in the partition_dynamic
+      // scheme. The owner adds and takes tasks at the back, such that the
+      // successors of the task just completed are worked on while their data
+      // is still in cache, whereas idle workers steal from the front.
+      class WorkQueue
+      {
+      public:
+        void
+        push(const unsigned int task)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          tasks.push_back(task);
+        }
+
+        bool
+        pop(unsigned int &task)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (tasks.empty())
+            return false;
+          task = tasks.back();
+          tasks.pop_back();
+          return true;
+        }
+
+        bool
+        steal(unsigned int &task)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (tasks.empty())
+            return false;
+          task = tasks.front();
+          tasks.pop_front();
+          return true;
+        }
+
+      private:
+        std::mutex               mutex;
+        std::deque<unsigned int> tasks;
+      };
+
+
+
+      // Lets the workers of the partition_dynamic scheme that find no ready
+      // task sleep until another worker makes a task ready or the loop is
+      // done. The lock is only taken on the producer side when some worker
+      // actually sleeps, so the common case of busy workers costs two atomic
+      // operations per task.
+      class IdleWorkers
+      {
+      public:
+        IdleWorkers()
+          : n_ready(0)
+          , n_sleeping(0)
+          , done(false)
+        {}
+
+        // to be called after a task has been added to one of the queues
+        void
+        task_added()
+        {
+          ++n_ready;
+          if (n_sleeping > 0)
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              wake_up.notify_one();
+            }
+        }
+
+        // to be called after a task has been taken from one of the queues
+        void
+        task_taken()
+        {
+          --n_ready;
+        }
+
+        // wake up all workers and let them leave the loop, either because
+        // all tasks are done or because of an exception
+        void
+        finish()
+        {
+          done = true;
+          std::lock_guard<std::mutex> lock(mutex);
+          wake_up.notify_all();
+        }
+
+        bool
+        is_done() const
+        {
+          return done;
+        }
+
+        // block until a task has been added since the last check or the loop
+        // is done
+        void
+        wait()
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          ++n_sleeping;
+          wake_up.wait(lock, [this]() { return n_ready > 0 || done; });
+          --n_sleeping;
+        }
+
+      private:
+        // signed, as a task might be taken before its addition is counted
+        std::atomic<int>          n_ready;
+        std::atomic<unsigned int> n_sleeping;
+        std::atomic<bool>         done;
+        std::mutex                mutex;
+        std::condition_variable   wake_up;
+      };
+    } // namespace dynamic
+
+
+
     void
     TaskInfo::loop(MFWorkerInterface &funct) const
     {
@@ -361,9 +486,13 @@ namespace internal
 
       funct.vector_update_ghosts_start();
 
+      if (scheme == partition_dynamic)
+        {
+          funct.zero_dst_vector_range(numbers::invalid_unsigned_int);
+          loop_dynamic(funct);
+        }
 #if defined(DEAL_II_WITH_TBB) && !defined(DEAL_II_TBB_WITH_ONEAPI)
-
-      if (scheme != none)
+      else if (scheme != none)
         {
           funct.zero_dst_vector_range(numbers::invalid_unsigned_int);
           if (scheme == partition_partition && evens > 0)
@@ -600,8 +729,8 @@ namespace internal
                 }
             }
         }
-      else
 #endif
+      else
         // serial loop, go through up to three times and do the MPI transfer at
         // the beginning/end of the second part
         {
@@ -649,6 +778,125 @@ namespace internal
 
 
 
+    void
+    TaskInfo::loop_dynamic(MFWorkerInterface &funct) const
+    {
+      const unsigned int n_tasks = dependency_n_predecessors.size();
+      if (n_tasks == 0)
+        {
+          // catch the case of empty partition list: we still need to call the
+          // vector communication routines to clean up and initiate things
+          funct.vector_update_ghosts_finish();
+          funct.vector_compress_start();
+          return;
+        }
+
+      // the last two tasks are the MPI communication around the first
+      // partition, the others are the ranges of cell_partition_data
+      const unsigned int n_ranges = n_tasks - 2;
+      AssertDimension(dependency_successors_ptr.size(), n_tasks + 1);
+
+      std::unique_ptr<std::atomic<unsigned int>[]> n_missing(
+        new std::atomic<unsigned int>[n_tasks]);
+      for (unsigned int task = 0; task < n_tasks; ++task)
+        n_missing[task] = dependency_n_predecessors[task];
+
+      // distribute the tasks that are ready from the start in contiguous
+      // chunks, which gives each worker a set of neighboring cells to begin
+      // with, and let the calling thread start with the MPI communication
+      const unsigned int n_workers =
+        std::max(1U, std::min(MultithreadInfo::n_threads(), n_ranges));
+      std::vector<dynamic::WorkQueue> queues(n_workers);
+      dynamic::IdleWorkers            idle_workers;
+      for (unsigned int task = 0; task < n_tasks; ++task)
+        if (dependency_n_predecessors[task] == 0)
+          {
+            queues[task < n_ranges ? task * n_workers / n_ranges : 0].push(
+              task);
+            idle_workers.task_added();
+          }
+
+      std::atomic<unsigned int> n_finished(0);
+
+      const auto work = [&](const unsigned int my_id) {
+        try
+          {
+            unsigned int task = 0;
+            while (idle_workers.is_done() == false)
+              {
+                // take from the own queue first, otherwise steal from the
+                // other workers starting with the next one, and sleep until
+                // new tasks become ready if all queues are empty
+                bool found = queues[my_id].pop(task);
+                for (unsigned int i = 1; i < n_workers && found == false; ++i)
+                  found = queues[(my_id + i) % n_workers].steal(task);
+                if (found == false)
+                  {
+                    idle_workers.wait();
+                    continue;
+                  }
+                idle_workers.task_taken();
+
+                if (task < n_ranges)
+                  {
+                    // as in the serial loop, skip the cell, face and
+                    // boundary work of empty ranges
+                    if (cell_partition_data[task + 1] >
+                        cell_partition_data[task])
+                      funct.cell(task);
+                    if (face_partition_data.empty() == false)
+                      {
+                        if (face_partition_data[task + 1] >
+                            face_partition_data[task])
+                          funct.face(task);
+                        if (boundary_partition_data[task + 1] >
+                            boundary_partition_data[task])
+                          funct.boundary(task);
+                      }
+                  }
+                else if (task == n_ranges)
+                  funct.vector_update_ghosts_finish();
+                else
+                  funct.vector_compress_start();
+
+                for (unsigned int j = dependency_successors_ptr[task];
+                     j < dependency_successors_ptr[task + 1];
+                     ++j)
+                  if (--n_missing[dependency_successors[j]] == 0)
+                    {
+                      queues[my_id].push(dependency_successors[j]);
+                      idle_workers.task_added();
+                    }
+                if (++n_finished == n_tasks)
+                  idle_workers.finish();
+              }
+          }
+        catch (...)
+          {
+            idle_workers.finish();
+            throw;
+          }
+      };
+
+      // the calling thread acts as the first worker, which also makes this
+      // function work when tasks are executed right away without threading
+      Threads::TaskGroup<> workers;
+      for (unsigned int w = 1; w < n_workers; ++w)
+        workers += Threads::new_task([&work, w]() { work(w); });
+      try
+        {
+          work(0);
+        }
+      catch (...)
+        {
+          workers.join_all();
+          throw;
+        }
+      workers.join_all();
+    }
+
+
+
     TaskInfo::TaskInfo()
     {
       clear();
@@ -678,6 +926,9 @@ namespace internal
       partition_odds.clear();
       partition_n_blocked_workers.clear();
       partition_n_workers.clear();
+      dependency_n_predecessors.clear();
+      dependency_successors_ptr.clear();
+      dependency_successors.clear();
       communicator = MPI_COMM_SELF;
       my_pid       = 0;
       n_procs      = 1;
@@ -713,7 +964,10 @@ namespace internal
         MemoryConsumption::memory_consumption(partition_evens) +
         MemoryConsumption::memory_consumption(partition_odds) +
         MemoryConsumption::memory_consumption(partition_n_blocked_workers) +
-        MemoryConsumption::memory_consumption(partition_n_workers));
+        MemoryConsumption::memory_consumption(partition_n_workers) +
+        MemoryConsumption::memory_consumption(dependency_n_predecessors) +
+        MemoryConsumption::memory_consumption(dependency_successors_ptr) +
+        MemoryConsumption::memory_consumption(dependency_successors));
     }
 
 
@@ -1437,7 +1691,7 @@ namespace internal
       // make_partitioning defines that the no. of cells in each partition
       // should be a multiple of cluster_size.
       unsigned int cluster_size = 1;
-      if (scheme == partition_partition)
+      if (scheme == partition_partition || scheme == partition_dynamic)
         cluster_size = block_size * vectorization_length;
 
       // Make the partitioning of the first layer of the blocks of cells.
@@ -1457,7 +1711,7 @@ namespace internal
                           partition);
 
       // Partition or color second layer
-      if (scheme == partition_partition)
+      if (scheme == partition_partition || scheme == partition_dynamic)
 
         {
           // Partition within partitions.
@@ -1496,7 +1750,8 @@ namespace internal
       // Set the new renumbering
       std::vector<unsigned int> renumbering_in(n_active_cells, 0);
       renumbering_in.swap(renumbering);
-      if (scheme == partition_partition) // blocking_connectivity == false
+      if (scheme == partition_partition ||
+          scheme == partition_dynamic) // blocking_connectivity == false
         {
           // This is the simple case. The renumbering is just a combination of
           // the renumbering that we were given as an input and the
@@ -1578,6 +1833,11 @@ namespace internal
 
       // Update the task_info with the more information for the thread graph.
       update_task_info(partition);
+
+      if (scheme == partition_dynamic)
+        make_dependency_graph(connectivity,
+                              partition_2layers_list,
+                              irregular_cells);
     }
 
 
@@ -2346,6 +2606,102 @@ namespace internal
                                       partition_n_blocked_workers[part];
         }
     }
+
+
+    void
+    TaskInfo::make_dependency_graph(
+      const DynamicSparsityPattern     &connectivity,
+      const std::vector<unsigned int>  &cell_list,
+      const std::vector<unsigned char> &irregular_cells)
+    {
+      const unsigned int n_partitions = partition_row_index.size() - 1;
+      const unsigned int n_ranges     = partition_row_index.back();
+      AssertIndexRange(n_ranges, cell_partition_data.size());
+      AssertDimension(cell_list.size(), n_active_cells);
+
+      // The two tasks after the ranges finish the import of ghost values,
+      // needed before the first partition with the cells at the MPI
+      // boundary, and start the export of ghost contributions once that
+      // partition is done.
+      const unsigned int ghosts_finish  = n_ranges;
+      const unsigned int compress_start = n_ranges + 1;
+
+      // Tasks in odd partitions run before the ones in even partitions on
+      // both the outer and inner level, like for partition_partition. The
+      // dependencies always point from lower to higher priority (with the
+      // task index breaking ties), which keeps the graph acyclic.
+      std::vector<unsigned int> priority(n_ranges);
+      for (unsigned int part = 0; part < n_partitions; ++part)
+        for (unsigned int i = partition_row_index[part];
+             i < partition_row_index[part + 1];
+             ++i)
+          priority[i] = 2 * (part % 2 == 0 ? 1 : 0) +
+                        ((i - partition_row_index[part]) % 2 == 0 ? 1 : 0);
+
+      // find the task of each cell by going through the cell batches in the
+      // new order
+      std::vector<unsigned int> cell_to_task(n_active_cells);
+      unsigned int              cell  = 0;
+      unsigned int              range = 0;
+      for (unsigned int batch = 0; batch < cell_partition_data[n_ranges];
+           ++batch)
+        {
+          while (cell_partition_data[range + 1] <= batch)
+            ++range;
+          const unsigned int n_lanes = irregular_cells[batch] > 0 ?
+                                         irregular_cells[batch] :
+                                         vectorization_length;
+          for (unsigned int v = 0; v < n_lanes; ++v, ++cell)
+            cell_to_task[cell_list[cell]] = range;
+        }
+      AssertDimension(cell, n_active_cells);
+
+      std::vector<std::vector<unsigned int>> successors(n_ranges + 2);
+      for (unsigned int row = 0; row < n_active_cells; ++row)
+        for (DynamicSparsityPattern::iterator it = connectivity.begin(row);
+             it != connectivity.end(row);
+             ++it)
+          {
+            const unsigned int task_a = cell_to_task[row];
+            const unsigned int task_b = cell_to_task[it->column()];
+            if (task_a == task_b)
+              continue;
+            if (priority[task_a] < priority[task_b] ||
+                (priority[task_a] == priority[task_b] && task_a < task_b))
+              successors[task_a].push_back(task_b);
+            else
+              successors[task_b].push_back(task_a);
+          }
+
+      if (n_partitions > 0)
+        for (unsigned int i = partition_row_index[0];
+             i < partition_row_index[1];
+             ++i)
+          {
+            successors[ghosts_finish].push_back(i);
+            successors[i].push_back(compress_start);
+          }
+
+      // compress the lists and count the predecessors of each task
+      dependency_n_predecessors.clear();
+      dependency_n_predecessors.resize(n_ranges + 2, 0);
+      dependency_successors_ptr.resize(n_ranges + 3);
+      dependency_successors_ptr[0] = 0;
+      dependency_successors.clear();
+      for (unsigned int task = 0; task < n_ranges + 2; ++task)
+        {
+          std::sort(successors[task].begin(), successors[task].end());
+          successors[task].erase(std::unique(successors[task].begin(),
+                                             successors[task].end()),
+                                 successors[task].end());
+          for (const unsigned int successor : successors[task])
+            {
+              dependency_successors.push_back(successor);
+              ++dependency_n_predecessors[successor];
+            }
+          dependency_successors_ptr[task + 1] = dependency_successors.size();
+        }
+    }
   } // namespace MatrixFreeFunctions
 } // namespace internal
 
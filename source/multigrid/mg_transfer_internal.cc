@@ -652,10 +652,10 @@ namespace internal
 
               for (const auto dof : constraints.get_local_lines())
                 {
-                  const auto *entries_ptr =
+                  const auto entries_ptr =
                     constraints.get_constraint_entries(dof);
 
-                  if (entries_ptr == nullptr)
+                  if (!entries_ptr.has_value())
                     continue;
 
                   // only homogeneous or identity constraints are supported
@@ -1020,9 +1020,8 @@ namespace internal
                          .get_constraint_entries(ind)
                          ->size() == 1,
                      ExcInternalError());
-              ind = mg_constrained_dofs->get_level_constraints(level)
-                      .get_constraint_entries(ind)
-                      ->front()
+              ind = (*mg_constrained_dofs->get_level_constraints(level)
+                        .get_constraint_entries(ind))[0]
                       .first;
             }
     }
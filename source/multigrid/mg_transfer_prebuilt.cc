@@ -137,9 +137,8 @@ namespace
                        .get_constraint_entries(ind)
                        ->size() == 1,
                    ExcInternalError());
-            ind = mg_constrained_dofs->get_level_constraints(level)
-                    .get_constraint_entries(ind)
-                    ->front()
+            ind = (*mg_constrained_dofs->get_level_constraints(level)
+                      .get_constraint_entries(ind))[0]
                     .first;
           }
   }
@@ -21,6 +21,7 @@
 #include <deal.II/fe/fe_dgq.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping.h>
+#include <deal.II/fe/mapping_q.h>
 
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_iterator.h>
@@ -65,6 +66,9 @@ namespace internal
 
 template <int dim, int spacedim>
 DataOut<dim, spacedim>::DataOut()
+  : cache_patch_geometry(false)
+  , patch_geometry_reused(false)
+  , n_patch_geometry_changes(0)
 {
   set_cell_selection(
     [this](const Triangulation<dim, spacedim> &) {
@@ -96,7 +100,8 @@ DataOut<dim, spacedim>::build_one_patch(
   const std::pair<cell_iterator, unsigned int>                 *cell_and_index,
   internal::DataOutImplementation::ParallelData<dim, spacedim> &scratch_data,
   const unsigned int                                            n_subdivisions,
-  const CurvedCellRegion curved_cell_region)
+  const CurvedCellRegion curved_cell_region,
+  const bool             reuse_geometry)
 {
   // first create the output object that we will write into
 
@@ -104,15 +109,32 @@ DataOut<dim, spacedim>::build_one_patch(
   patch.n_subdivisions = n_subdivisions;
   patch.reference_cell = cell_and_index->first->reference_cell();
 
+  const unsigned int patch_idx =
+    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
+                                           [cell_and_index->first->index()];
+  // did we mess up the indices?
+  Assert(patch_idx < this->patches.size(), ExcInternalError());
+  patch.patch_index = patch_idx;
+
+  // if we can, take the geometric information from the patch built for this
+  // cell the last time around
+  const ::dealii::DataOutBase::Patch<dim, spacedim> *const cached_patch =
+    (reuse_geometry ? &patch_geometry_cache.patches[patch_idx] : nullptr);
+
   // initialize FEValues
   scratch_data.reinit_all_fe_values(this->dof_data, cell_and_index->first);
 
   const FEValuesBase<dim, spacedim> &fe_patch_values =
     scratch_data.get_present_fe_values(0);
 
-  const auto vertices =
-    fe_patch_values.get_mapping().get_vertices(cell_and_index->first);
-  std::copy(vertices.begin(), vertices.end(), std::begin(patch.vertices));
+  if (cached_patch != nullptr)
+    patch.vertices = cached_patch->vertices;
+  else
+    {
+      const auto vertices =
+        fe_patch_values.get_mapping().get_vertices(cell_and_index->first);
+      std::copy(vertices.begin(), vertices.end(), std::begin(patch.vertices));
+    }
 
   const unsigned int n_q_points = fe_patch_values.n_quadrature_points;
 
@@ -139,11 +161,16 @@ DataOut<dim, spacedim>::build_one_patch(
   // want to produce curved cells everywhere
   //
   // note: a cell is *always* at the boundary if dim<spacedim
-  if (curved_cell_region == curved_inner_cells ||
-      (curved_cell_region == curved_boundary &&
-       (cell_and_index->first->at_boundary() || (dim != spacedim))) ||
-      (cell_and_index->first->reference_cell() !=
-       ReferenceCells::get_hypercube<dim>()))
+  //
+  // if we reuse the geometry of the previous patch, then both the decision
+  // and the points are taken from there
+  if ((cached_patch != nullptr) ?
+        cached_patch->points_are_available :
+        (curved_cell_region == curved_inner_cells ||
+         (curved_cell_region == curved_boundary &&
+          (cell_and_index->first->at_boundary() || (dim != spacedim))) ||
+         (cell_and_index->first->reference_cell() !=
+          ReferenceCells::get_hypercube<dim>())))
     {
       Assert(patch.space_dim == spacedim, ExcInternalError());
 
@@ -153,13 +180,24 @@ DataOut<dim, spacedim>::build_one_patch(
 
       // then size the patch.data member in order to have enough memory for
       // the quadrature points as well, and copy the quadrature points there
-      const std::vector<Point<spacedim>> &q_points =
-        fe_patch_values.get_quadrature_points();
-
       patch.data.reinit(scratch_data.n_datasets + spacedim, n_q_points);
-      for (unsigned int i = 0; i < spacedim; ++i)
-        for (unsigned int q = 0; q < n_q_points; ++q)
-          patch.data(patch.data.size(0) - spacedim + i, q) = q_points[q][i];
+      if (cached_patch != nullptr)
+        {
+          AssertDimension(cached_patch->data.n_cols(), n_q_points);
+          for (unsigned int i = 0; i < spacedim; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              patch.data(patch.data.size(0) - spacedim + i, q) =
+                cached_patch->data(i, q);
+        }
+      else
+        {
+          const std::vector<Point<spacedim>> &q_points =
+            fe_patch_values.get_quadrature_points();
+          for (unsigned int i = 0; i < spacedim; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              patch.data(patch.data.size(0) - spacedim + i, q) =
+                q_points[q][i];
+        }
     }
   else
     {
@@ -1042,12 +1080,28 @@ DataOut<dim, spacedim>::build_one_patch(
             .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
     }
 
-  const unsigned int patch_idx =
-    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
-  // did we mess up the indices?
-  Assert(patch_idx < this->patches.size(), ExcInternalError());
-  patch.patch_index = patch_idx;
+  // if requested, remember the geometric information of the patch for the
+  // next call of build_patches()
+  if (cache_patch_geometry && (cached_patch == nullptr))
+    {
+      ::dealii::DataOutBase::Patch<dim, spacedim> &geometry =
+        patch_geometry_cache.patches[patch_idx];
+      geometry.vertices             = patch.vertices;
+      geometry.patch_index          = patch.patch_index;
+      geometry.n_subdivisions       = patch.n_subdivisions;
+      geometry.reference_cell       = patch.reference_cell;
+      geometry.points_are_available = patch.points_are_available;
+      if (patch.points_are_available)
+        {
+          geometry.data.reinit(spacedim, n_q_points);
+          for (unsigned int i = 0; i < spacedim; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              geometry.data(i, q) =
+                patch.data(patch.data.size(0) - spacedim + i, q);
+        }
+      else
+        geometry.data.reinit(0, 0);
+    }
 
   // Put the patch into the patches vector. instead of copying the data,
   // simply swap the contents to avoid the penalty of writing into another
@@ -1079,7 +1133,10 @@ DataOut<dim, spacedim>::build_patches(const Mapping<dim, spacedim> &mapping,
 {
   hp::MappingCollection<dim, spacedim> mapping_collection(mapping);
 
-  build_patches(mapping_collection, n_subdivisions_, curved_region);
+  build_patches_for_mappings(mapping_collection,
+                             n_subdivisions_,
+                             curved_region,
+                             {&mapping});
 }
 
 
@@ -1090,6 +1147,23 @@ DataOut<dim, spacedim>::build_patches(
   const hp::MappingCollection<dim, spacedim> &mapping,
   const unsigned int                          n_subdivisions_,
   const CurvedCellRegion                      curved_region)
+{
+  std::vector<const Mapping<dim, spacedim> *> mappings;
+  for (unsigned int i = 0; i < mapping.size(); ++i)
+    mappings.push_back(&mapping[i]);
+
+  build_patches_for_mappings(mapping, n_subdivisions_, curved_region, mappings);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOut<dim, spacedim>::build_patches_for_mappings(
+  const hp::MappingCollection<dim, spacedim>        &mapping,
+  const unsigned int                                 n_subdivisions_,
+  const CurvedCellRegion                             curved_region,
+  const std::vector<const Mapping<dim, spacedim> *> &mappings)
 {
   // Check consistency of redundant template parameter
   Assert(dim == dim, ExcDimensionMismatch(dim, dim));
@@ -1105,80 +1179,130 @@ DataOut<dim, spacedim>::build_patches(
 
   this->validate_dataset_names();
 
-  // First count the cells we want to create patches of. Also fill the object
-  // that maps the cell indices to the patch numbers, as this will be needed
-  // for generation of neighborship information.
-  // Note, there is a confusing mess of different indices here at play:
-  // - patch_index: the index of a patch in all_cells
-  // - cell->index: only unique on each level, used in cell_to_patch_index_map
-  // - active_index: index for a cell when counting from begin_active() using
-  //   ++cell (identical to cell->active_cell_index())
-  // - cell_index: unique index of a cell counted using
-  //   next_cell_function() starting from first_cell_function()
-  //
-  // It turns out that we create one patch for each selected cell, so
-  // patch_index==cell_index.
-  //
-  // Now construct the map such that
-  // cell_to_patch_index_map[cell->level][cell->index] = patch_index
-  std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
-  cell_to_patch_index_map.resize(this->triangulation->n_levels());
-  for (unsigned int l = 0; l < this->triangulation->n_levels(); ++l)
-    {
-      // max_index is the largest cell->index on level l
-      unsigned int max_index = 0;
-      for (cell_iterator cell = first_cell_function(*this->triangulation);
-           cell != this->triangulation->end();
-           cell = next_cell_function(*this->triangulation, cell))
-        if (static_cast<unsigned int>(cell->level()) == l)
-          max_index =
-            std::max(max_index, static_cast<unsigned int>(cell->index()));
+  const CurvedCellRegion curved_cell_region =
+    (n_subdivisions < 2 ? no_curved_cells : curved_region);
 
-      cell_to_patch_index_map[l].resize(
-        max_index + 1, dealii::DataOutBase::Patch<dim, spacedim>::no_neighbor);
+  // Find out whether we can reuse the geometry of the patches built the last
+  // time around, see set_patch_geometry_caching(). This requires that
+  // neither the triangulation, nor the mappings, nor the way we subdivide
+  // cells have changed.
+  std::vector<std::pair<const Mapping<dim, spacedim> *, unsigned int>>
+    mapping_keys;
+  for (const Mapping<dim, spacedim> *m : mappings)
+    {
+      const auto *mapping_q = dynamic_cast<const MappingQ<dim, spacedim> *>(m);
+      mapping_keys.emplace_back(m,
+                                mapping_q != nullptr ?
+                                  mapping_q->get_degree() :
+                                  numbers::invalid_unsigned_int);
     }
 
+  const bool reuse_geometry =
+    cache_patch_geometry &&
+    (patch_geometry_cache.triangulation == &*this->triangulation) &&
+    (patch_geometry_cache.mappings == mapping_keys) &&
+    (patch_geometry_cache.n_subdivisions == n_subdivisions) &&
+    (patch_geometry_cache.curved_cell_region == curved_cell_region) &&
+    (*patch_geometry_cache.triangulation_changed == false);
+  patch_geometry_reused = reuse_geometry;
+  if (reuse_geometry == false)
+    ++n_patch_geometry_changes;
+
+  // will be cell_to_patch_index_map[cell->level][cell->index] = patch_index
+  std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
+
   // will be all_cells[patch_index] = pair(cell, active_index)
   std::vector<std::pair<cell_iterator, unsigned int>> all_cells;
-  {
-    // important: we need to compute the active_index of the cell in the range
-    // 0..n_active_cells() because this is where we need to look up cell
-    // data from (cell data vectors do not have the length distance computed by
-    // first_cell_function/next_cell_function because this might skip
-    // some values (FilteredIterator).
-    auto          active_cell  = this->triangulation->begin_active();
-    unsigned int  active_index = 0;
-    cell_iterator cell         = first_cell_function(*this->triangulation);
-    for (; cell != this->triangulation->end();
-         cell = next_cell_function(*this->triangulation, cell))
-      {
-        // move forward until active_cell points at the cell (cell) we are
-        // looking at to compute the current active_index
-        while (active_cell != this->triangulation->end() && cell->is_active() &&
-               decltype(active_cell)(cell) != active_cell)
-          {
-            ++active_cell;
-            ++active_index;
-          }
-
-        Assert(static_cast<unsigned int>(cell->level()) <
-                 cell_to_patch_index_map.size(),
-               ExcInternalError());
-        Assert(static_cast<unsigned int>(cell->index()) <
-                 cell_to_patch_index_map[cell->level()].size(),
-               ExcInternalError());
-        Assert(active_index < this->triangulation->n_active_cells(),
-               ExcInternalError());
-        cell_to_patch_index_map[cell->level()][cell->index()] =
-          all_cells.size();
-
-        all_cells.emplace_back(cell, active_index);
-      }
-  }
+
+  if (reuse_geometry)
+    {
+      cell_to_patch_index_map.swap(
+        patch_geometry_cache.cell_to_patch_index_map);
+      all_cells.swap(patch_geometry_cache.cells);
+    }
+  else
+    {
+      // First count the cells we want to create patches of. Also fill the
+      // object that maps the cell indices to the patch numbers, as this will
+      // be needed for generation of neighborship information.
+      // Note, there is a confusing mess of different indices here at play:
+      // - patch_index: the index of a patch in all_cells
+      // - cell->index: only unique on each level, used in
+      //   cell_to_patch_index_map
+      // - active_index: index for a cell when counting from begin_active()
+      //   using ++cell (identical to cell->active_cell_index())
+      // - cell_index: unique index of a cell counted using
+      //   next_cell_function() starting from first_cell_function()
+      //
+      // It turns out that we create one patch for each selected cell, so
+      // patch_index==cell_index.
+      //
+      // Now construct the map such that
+      // cell_to_patch_index_map[cell->level][cell->index] = patch_index
+      cell_to_patch_index_map.resize(this->triangulation->n_levels());
+      for (unsigned int l = 0; l < this->triangulation->n_levels(); ++l)
+        {
+          // max_index is the largest cell->index on level l
+          unsigned int max_index = 0;
+          for (cell_iterator cell = first_cell_function(*this->triangulation);
+               cell != this->triangulation->end();
+               cell = next_cell_function(*this->triangulation, cell))
+            if (static_cast<unsigned int>(cell->level()) == l)
+              max_index =
+                std::max(max_index, static_cast<unsigned int>(cell->index()));
+
+          cell_to_patch_index_map[l].resize(
+            max_index + 1,
+            dealii::DataOutBase::Patch<dim, spacedim>::no_neighbor);
+        }
+
+      // important: we need to compute the active_index of the cell in the
+      // range 0..n_active_cells() because this is where we need to look up
+      // cell data from (cell data vectors do not have the length distance
+      // computed by first_cell_function/next_cell_function because this might
+      // skip some values (FilteredIterator).
+      auto          active_cell  = this->triangulation->begin_active();
+      unsigned int  active_index = 0;
+      cell_iterator cell         = first_cell_function(*this->triangulation);
+      for (; cell != this->triangulation->end();
+           cell = next_cell_function(*this->triangulation, cell))
+        {
+          // move forward until active_cell points at the cell (cell) we are
+          // looking at to compute the current active_index
+          while (active_cell != this->triangulation->end() &&
+                 cell->is_active() &&
+                 decltype(active_cell)(cell) != active_cell)
+            {
+              ++active_cell;
+              ++active_index;
+            }
+
+          Assert(static_cast<unsigned int>(cell->level()) <
+                   cell_to_patch_index_map.size(),
+                 ExcInternalError());
+          Assert(static_cast<unsigned int>(cell->index()) <
+                   cell_to_patch_index_map[cell->level()].size(),
+                 ExcInternalError());
+          Assert(active_index < this->triangulation->n_active_cells(),
+                 ExcInternalError());
+          cell_to_patch_index_map[cell->level()][cell->index()] =
+            all_cells.size();
+
+          all_cells.emplace_back(cell, active_index);
+        }
+    }
 
   this->patches.clear();
   this->patches.resize(all_cells.size());
 
+  if (cache_patch_geometry == false)
+    patch_geometry_cache = PatchGeometryCache();
+  else if (reuse_geometry == false)
+    {
+      patch_geometry_cache.patches.clear();
+      patch_geometry_cache.patches.resize(all_cells.size());
+    }
+
   // Now create a default object for the WorkStream object to work with. The
   // first step is to count how many output data sets there will be. This is,
   // in principle, just the number of components of each data set, but we
@@ -1206,11 +1330,8 @@ DataOut<dim, spacedim>::build_patches(
     else
       n_postprocessor_outputs[dataset] = 0;
 
-  const CurvedCellRegion curved_cell_region =
-    (n_subdivisions < 2 ? no_curved_cells : curved_region);
-
   UpdateFlags update_flags = update_values;
-  if (curved_cell_region != no_curved_cells)
+  if ((curved_cell_region != no_curved_cells) && (reuse_geometry == false))
     update_flags |= update_quadrature_points;
 
   for (unsigned int i = 0; i < this->dof_data.size(); ++i)
@@ -1234,7 +1355,7 @@ DataOut<dim, spacedim>::build_patches(
     update_flags,
     cell_to_patch_index_map);
 
-  auto worker = [this, n_subdivisions, curved_cell_region](
+  auto worker = [this, n_subdivisions, curved_cell_region, reuse_geometry](
                   const std::pair<cell_iterator, unsigned int> *cell_and_index,
                   internal::DataOutImplementation::ParallelData<dim, spacedim>
                     &scratch_data,
@@ -1244,7 +1365,8 @@ DataOut<dim, spacedim>::build_patches(
     this->build_one_patch(cell_and_index,
                           scratch_data,
                           n_subdivisions,
-                          curved_cell_region);
+                          curved_cell_region,
+                          reuse_geometry);
   };
 
   // now build the patches in parallel
@@ -1264,6 +1386,33 @@ DataOut<dim, spacedim>::build_patches(
                     // @ref workstream_paper, on 32 cores) and if
                     8 * MultithreadInfo::n_threads(),
                     64);
+
+  // Finally keep what we need to reuse the geometry of the patches in the
+  // next call, and start listening to changes of the triangulation
+  if (cache_patch_geometry)
+    {
+      if (reuse_geometry == false)
+        {
+          patch_geometry_cache.triangulation      = &*this->triangulation;
+          patch_geometry_cache.mappings           = mapping_keys;
+          patch_geometry_cache.n_subdivisions     = n_subdivisions;
+          patch_geometry_cache.curved_cell_region = curved_cell_region;
+
+          patch_geometry_cache.triangulation_changed =
+            std::make_shared<bool>(false);
+          patch_geometry_cache.tria_listener =
+            std::make_shared<boost::signals2::scoped_connection>(
+              this->triangulation->signals.any_change.connect(
+                [triangulation_changed =
+                   patch_geometry_cache.triangulation_changed]() {
+                  *triangulation_changed = true;
+                }));
+        }
+
+      patch_geometry_cache.cell_to_patch_index_map.swap(
+        cell_to_patch_index_map);
+      patch_geometry_cache.cells.swap(all_cells);
+    }
 }
 
 
@@ -1278,6 +1427,9 @@ DataOut<dim, spacedim>::set_cell_selection(
 {
   first_cell_function = first_cell;
   next_cell_function  = next_cell;
+
+  // the patches built so far may be for a different selection of cells
+  patch_geometry_cache = PatchGeometryCache();
 }
 
 
@@ -1333,6 +1485,35 @@ DataOut<dim, spacedim>::get_cell_selection() const
 
 
 
+template <int dim, int spacedim>
+void
+DataOut<dim, spacedim>::set_patch_geometry_caching(
+  const bool cache_patch_geometry)
+{
+  this->cache_patch_geometry = cache_patch_geometry;
+  patch_geometry_cache       = PatchGeometryCache();
+}
+
+
+
+template <int dim, int spacedim>
+bool
+DataOut<dim, spacedim>::patch_geometry_unchanged() const
+{
+  return patch_geometry_reused;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOut<dim, spacedim>::patch_geometry_revision() const
+{
+  return n_patch_geometry_changes;
+}
+
+
+
 // explicit instantiations
 #include "data_out.inst"
 
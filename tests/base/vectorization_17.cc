@@ -0,0 +1,79 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// test VectorizedArray::load() and VectorizedArray::store() with a pointer
+// to a different floating point type, i.e., the conversion between float and
+// double
+
+#include <deal.II/base/vectorization.h>
+
+#include "../tests.h"
+
+
+template <typename Number, typename OtherNumber, int width>
+void
+do_test()
+{
+  std::vector<OtherNumber> values(2 * width + 1);
+  for (unsigned int i = 0; i < values.size(); ++i)
+    values[i] = 0.25 * i - 3.;
+
+  // use unaligned addresses by starting at index 1
+  VectorizedArray<Number, width> vec;
+  vec.load(values.data() + 1);
+  for (unsigned int v = 0; v < width; ++v)
+    AssertThrow(vec[v] == static_cast<Number>(values[v + 1]),
+                ExcInternalError());
+
+  std::vector<OtherNumber> stored(2 * width + 1, OtherNumber(-1.));
+  vec.store(stored.data() + 1);
+  AssertThrow(stored[0] == OtherNumber(-1.), ExcInternalError());
+  for (unsigned int v = 0; v < width; ++v)
+    AssertThrow(stored[v + 1] == values[v + 1], ExcInternalError());
+  for (unsigned int v = width + 1; v < stored.size(); ++v)
+    AssertThrow(stored[v] == OtherNumber(-1.), ExcInternalError());
+}
+
+
+template <int width_float, int width_double>
+void
+do_test()
+{
+  do_test<float, double, width_float>();
+  do_test<double, float, width_double>();
+}
+
+
+int
+main()
+{
+  initlog();
+
+#if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 512
+  do_test<16, 8>();
+#endif
+
+#if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 256
+  do_test<8, 4>();
+#endif
+
+#if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128
+  do_test<4, 2>();
+#endif
+
+  do_test<1, 1>();
+
+  deallog << "OK!" << std::endl;
+}
@@ -0,0 +1,195 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// write_vtu() splits data arrays larger than 1 MiB into several
+// independently compressed blocks. Write a patch with arrays of several MiB,
+// then decode the block header of each array, inflate the blocks and compare
+// the result with the data that was written, for two compression levels.
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/utilities.h>
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+
+// Decode the base64 encoded compression header and blocks of one data array
+// and return the uncompressed data, or an empty vector if the header is
+// inconsistent or a block cannot be inflated
+std::vector<unsigned char>
+decode_array(const std::string &encoded, unsigned int &n_blocks)
+{
+  // the first three entries of the header, the number of blocks and the
+  // sizes of a full and the last block, are encoded without padding
+  std::vector<unsigned char> decoded =
+    Utilities::decode_base64(encoded.substr(0, 16));
+  std::uint32_t header_start[3];
+  std::memcpy(header_start, decoded.data(), sizeof(header_start));
+  n_blocks = header_start[0];
+
+  const std::size_t header_bytes = (3 + n_blocks) * sizeof(std::uint32_t);
+  const std::size_t header_chars = 4 * ((header_bytes + 2) / 3);
+  const std::vector<unsigned char> header =
+    Utilities::decode_base64(encoded.substr(0, header_chars));
+  std::vector<std::uint32_t> compressed_sizes(n_blocks);
+  std::memcpy(compressed_sizes.data(),
+              header.data() + 3 * sizeof(std::uint32_t),
+              n_blocks * sizeof(std::uint32_t));
+
+  const std::vector<unsigned char> compressed =
+    Utilities::decode_base64(encoded.substr(header_chars));
+
+  std::vector<unsigned char> result(
+    (n_blocks - 1) * std::size_t(header_start[1]) + header_start[2]);
+  std::size_t compressed_offset = 0;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      const uLongf expected_size =
+        (block == n_blocks - 1 ? header_start[2] : header_start[1]);
+      uLongf uncompressed_size = expected_size;
+      if (compressed_offset + compressed_sizes[block] > compressed.size() ||
+          uncompress(result.data() + block * std::size_t(header_start[1]),
+                     &uncompressed_size,
+                     compressed.data() + compressed_offset,
+                     compressed_sizes[block]) != Z_OK ||
+          uncompressed_size != expected_size)
+        return {};
+      compressed_offset += compressed_sizes[block];
+    }
+  if (compressed_offset != compressed.size())
+    return {};
+
+  return result;
+}
+
+
+
+// Extract the uncompressed content of all binary data arrays of the given
+// vtu file, using the name of the array or "Points" for the point array
+std::map<std::string, std::vector<unsigned char>>
+extract_arrays(const std::string &vtu)
+{
+  std::map<std::string, std::vector<unsigned char>> arrays;
+
+  const std::string tag_end = "format=\"binary\">\n";
+  for (std::size_t pos = vtu.find(tag_end); pos != std::string::npos;
+       pos             = vtu.find(tag_end, pos))
+    {
+      const std::size_t tag_begin = vtu.rfind("<DataArray", pos);
+      const std::size_t name_pos  = vtu.find("Name=\"", tag_begin);
+      const std::size_t name_end  = vtu.find('"', name_pos + 6);
+      const std::string name =
+        name_pos < pos ? vtu.substr(name_pos + 6, name_end - name_pos - 6) :
+                         "Points";
+
+      const std::size_t data_begin = pos + tag_end.size();
+      const std::size_t data_end   = vtu.find('\n', data_begin);
+
+      unsigned int n_blocks = 0;
+      arrays[name] =
+        decode_array(vtu.substr(data_begin, data_end - data_begin), n_blocks);
+      if (name == "data")
+        deallog << "Array 'data' with " << arrays[name].size()
+                << " bytes in " << n_blocks << " blocks" << std::endl;
+
+      pos = data_end;
+    }
+
+  return arrays;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // one patch with 1001^2 points, such that the coordinates take more than
+  // 11 blocks and the data array more than 3 blocks
+  const unsigned int n_subdivisions = 1000;
+  const unsigned int n_points = Utilities::pow(n_subdivisions + 1, 2);
+
+  std::vector<DataOutBase::Patch<2, 2>> patches(1);
+  DataOutBase::Patch<2, 2>             &patch = patches[0];
+  patch.n_subdivisions = n_subdivisions;
+  patch.reference_cell = ReferenceCells::get_hypercube<2>();
+  for (const unsigned int v : GeometryInfo<2>::vertex_indices())
+    patch.vertices[v] = Point<2>(v % 2, v / 2);
+  patch.data.reinit(1, n_points);
+  for (unsigned int i = 0; i < n_points; ++i)
+    patch.data(0, i) = 0.5f * i;
+
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  std::map<std::string, std::vector<unsigned char>> reference_arrays;
+  for (const auto level : {DataOutBase::CompressionLevel::best_speed,
+                           DataOutBase::CompressionLevel::default_compression})
+    {
+      DataOutBase::VtkFlags flags;
+      flags.compression_level = level;
+
+      std::ostringstream out;
+      DataOutBase::write_vtu(patches, {"data"}, vectors, flags, out);
+
+      const std::map<std::string, std::vector<unsigned char>> arrays =
+        extract_arrays(out.str());
+
+      bool all_decoded = true;
+      for (const auto &array : arrays)
+        if (array.second.empty())
+          all_decoded = false;
+      deallog << "All " << arrays.size()
+              << " arrays decoded: " << all_decoded << std::endl;
+
+      const std::vector<unsigned char> &points = arrays.at("Points");
+      const std::vector<unsigned char> &data   = arrays.at("data");
+      deallog << "Points size ok: "
+              << (points.size() == 3 * n_points * sizeof(float)) << std::endl;
+
+      bool data_ok = (data.size() == n_points * sizeof(float));
+      for (unsigned int i = 0; i < n_points && data_ok; ++i)
+        {
+          float value;
+          std::memcpy(&value, data.data() + i * sizeof(float), sizeof(float));
+          if (value != patch.data(0, i))
+            data_ok = false;
+        }
+      deallog << "Data values ok: " << data_ok << std::endl;
+
+      // all arrays must decode to the same content for both compression
+      // levels
+      if (reference_arrays.empty())
+        reference_arrays = arrays;
+      else
+        deallog << "Same arrays as with best_speed: "
+                << (arrays == reference_arrays) << std::endl;
+    }
+}
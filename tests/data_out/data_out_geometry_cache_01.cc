@@ -0,0 +1,166 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+// Test DataOut::set_patch_geometry_caching(): Building patches for new data
+// on an unchanged mesh reuses the geometry of the previous patches, the
+// result is the same as without the cache, and refining the mesh or
+// changing the mapping or the number of subdivisions invalidates the cache.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+class TimeDependentFunction : public Function<dim>
+{
+public:
+  TimeDependentFunction(const double time)
+    : Function<dim>()
+    , time(time)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int) const override
+  {
+    return std::sin(p[0] + time) * (1. + p.norm_square());
+  }
+
+private:
+  const double time;
+};
+
+
+
+// Build patches with and without cache for the given data and compare the
+// output generated from them
+template <int dim>
+void
+build_and_compare(DataOut<dim>          &cached_data_out,
+                  const DoFHandler<dim> &dof_handler,
+                  const Vector<double>  &solution,
+                  const Mapping<dim>    &mapping,
+                  const unsigned int     n_subdivisions,
+                  const std::string     &label)
+{
+  cached_data_out.clear_data_vectors();
+  cached_data_out.add_data_vector(solution, "solution");
+  cached_data_out.build_patches(mapping,
+                                n_subdivisions,
+                                DataOut<dim>::curved_inner_cells);
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.build_patches(mapping,
+                         n_subdivisions,
+                         DataOut<dim>::curved_inner_cells);
+
+  std::ostringstream cached_output, output;
+  cached_data_out.write_deal_II_intermediate(cached_output);
+  data_out.write_deal_II_intermediate(output);
+
+  deallog << label << ": geometry reused = "
+          << cached_data_out.patch_geometry_unchanged()
+          << ", same output = " << (cached_output.str() == output.str())
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const FE_Q<dim>     fe(2);
+  const MappingQ<dim> mapping(2);
+  DoFHandler<dim>     dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.set_patch_geometry_caching(true);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      VectorTools::interpolate(mapping,
+                               dof_handler,
+                               TimeDependentFunction<dim>(0.1 * step),
+                               solution);
+      build_and_compare(data_out,
+                        dof_handler,
+                        solution,
+                        mapping,
+                        2,
+                        "step " + std::to_string(step));
+    }
+
+  // a different number of subdivisions requires new patches
+  build_and_compare(data_out, dof_handler, solution, mapping, 3, "3 subdiv");
+  build_and_compare(data_out, dof_handler, solution, mapping, 3, "3 subdiv");
+
+  // as does a different mapping
+  const MappingQ<dim> mapping_3(3);
+  build_and_compare(data_out, dof_handler, solution, mapping_3, 3, "mapping");
+  build_and_compare(data_out, dof_handler, solution, mapping_3, 3, "mapping");
+  build_and_compare(data_out, dof_handler, solution, mapping, 3, "mapping");
+
+  // as does a change of the mesh
+  tria.refine_global(1);
+  dof_handler.distribute_dofs(fe);
+  solution.reinit(dof_handler.n_dofs());
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           TimeDependentFunction<dim>(0.5),
+                           solution);
+  build_and_compare(data_out, dof_handler, solution, mapping, 3, "refined");
+  build_and_compare(data_out, dof_handler, solution, mapping, 3, "refined");
+
+  // and disabling the cache
+  data_out.set_patch_geometry_caching(false);
+  build_and_compare(data_out, dof_handler, solution, mapping, 3, "disabled");
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>();
+  check<3>();
+}
@@ -0,0 +1,205 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+// tests DataOutBase::write_vtkhdf_parallel() by writing two time steps into
+// the same file and reading back the structure of the file
+
+#include <deal.II/base/data_out_base.h>
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+double cell_coordinates[3][8] = {{0, 1, 0, 1, 0, 1, 0, 1},
+                                 {0, 0, 1, 1, 0, 0, 1, 1},
+                                 {0, 0, 0, 0, 1, 1, 1, 1}};
+
+
+// This function is a copy from tests/base/patches.h, included here
+// to not introduce dependencies between different test targets
+template <int dim, int spacedim>
+void
+create_patches(std::vector<DataOutBase::Patch<dim, spacedim>> &patches)
+{
+  for (unsigned int p = 0; p < patches.size(); ++p)
+    {
+      DataOutBase::Patch<dim, spacedim> &patch = patches[p];
+
+      const unsigned int nsub  = p + 1;
+      const unsigned int nsubp = nsub + 1;
+
+      patch.n_subdivisions = nsub;
+      patch.reference_cell = ReferenceCells::get_hypercube<dim>();
+      for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+        for (unsigned int d = 0; d < spacedim; ++d)
+          patch.vertices[v](d) =
+            p + cell_coordinates[d][v] + ((d >= dim) ? v : 0);
+
+      unsigned int n1 = (dim > 0) ? nsubp : 1;
+      unsigned int n2 = (dim > 1) ? nsubp : 1;
+      unsigned int n3 = (dim > 2) ? nsubp : 1;
+      patch.data.reinit(3, n1 * n2 * n3);
+
+      for (unsigned int i3 = 0; i3 < n3; ++i3)
+        for (unsigned int i2 = 0; i2 < n2; ++i2)
+          for (unsigned int i1 = 0; i1 < n1; ++i1)
+            {
+              const unsigned int i = i1 + nsubp * (i2 + nsubp * i3);
+
+              patch.data(0, i) = p + 1. * i1 / nsub;
+              patch.data(1, i) = p + 1. * i2 / nsub;
+              patch.data(2, i) = i;
+            }
+      patch.patch_index = p;
+    }
+}
+
+
+
+void
+print_dataset(const hid_t location, const std::string &name)
+{
+  const hid_t dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+  AssertThrow(dataset >= 0, ExcIO());
+  const hid_t dataspace = H5Dget_space(dataset);
+  hsize_t     dims[2]   = {0, 1};
+  const int   rank      = H5Sget_simple_extent_dims(dataspace, dims, nullptr);
+
+  std::vector<double> values(dims[0] * dims[1]);
+  H5Dread(dataset,
+          H5T_NATIVE_DOUBLE,
+          H5S_ALL,
+          H5S_ALL,
+          H5P_DEFAULT,
+          values.data());
+
+  deallog << name << " [" << dims[0];
+  if (rank == 2)
+    deallog << 'x' << dims[1];
+  deallog << "]:";
+  for (unsigned int i = 0; i < std::min<std::size_t>(values.size(), 12); ++i)
+    deallog << ' ' << values[i];
+  deallog << std::endl;
+
+  H5Sclose(dataspace);
+  H5Dclose(dataset);
+}
+
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << std::endl;
+
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(2);
+  create_patches(patches);
+
+  const std::vector<std::string> names = {"x1", "x2", "i"};
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors = {{0,
+                1,
+                "x",
+                DataComponentInterpretation::component_is_part_of_vector}};
+
+  const std::string filename =
+    "output_" + std::to_string(dim) + std::to_string(spacedim) + ".vtkhdf";
+
+  // write two time steps into the same file
+  DataOutBase::VtkHdfFlags flags;
+  DataOutBase::write_vtkhdf_parallel(
+    patches, names, vectors, flags, filename, MPI_COMM_SELF);
+
+  flags.time             = 0.5;
+  flags.append_time_step = true;
+  DataOutBase::write_vtkhdf_parallel(
+    patches, names, vectors, flags, filename, MPI_COMM_SELF);
+
+  const hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  AssertThrow(file >= 0, ExcIO());
+  const hid_t root = H5Gopen2(file, "VTKHDF", H5P_DEFAULT);
+  AssertThrow(root >= 0, ExcIO());
+
+  {
+    int         version[2];
+    const hid_t attribute = H5Aopen(root, "Version", H5P_DEFAULT);
+    H5Aread(attribute, H5T_NATIVE_INT, version);
+    H5Aclose(attribute);
+    deallog << "Version: " << version[0] << '.' << version[1] << std::endl;
+  }
+  {
+    const hid_t attribute = H5Aopen(root, "Type", H5P_DEFAULT);
+    const hid_t type      = H5Aget_type(attribute);
+    std::string type_name(H5Tget_size(type), '\0');
+    H5Aread(attribute, type, type_name.data());
+    H5Tclose(type);
+    H5Aclose(attribute);
+    deallog << "Type: " << type_name << std::endl;
+  }
+
+  for (const std::string name : {"NumberOfPoints",
+                                 "NumberOfCells",
+                                 "NumberOfConnectivityIds",
+                                 "Points",
+                                 "Offsets",
+                                 "Types",
+                                 "Connectivity",
+                                 "PointData/x",
+                                 "PointData/i"})
+    print_dataset(root, name);
+
+  const hid_t steps = H5Gopen2(root, "Steps", H5P_DEFAULT);
+  {
+    int         n_steps   = 0;
+    const hid_t attribute = H5Aopen(steps, "NSteps", H5P_DEFAULT);
+    H5Aread(attribute, H5T_NATIVE_INT, &n_steps);
+    H5Aclose(attribute);
+    deallog << "NSteps: " << n_steps << std::endl;
+  }
+  for (const std::string name : {"Values",
+                                 "PartOffsets",
+                                 "NumberOfParts",
+                                 "PointOffsets",
+                                 "CellOffsets",
+                                 "ConnectivityIdOffsets",
+                                 "PointDataOffsets/x",
+                                 "PointDataOffsets/i"})
+    print_dataset(steps, name);
+
+  H5Gclose(steps);
+  H5Gclose(root);
+  H5Fclose(file);
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  initlog();
+
+  check<1, 2>();
+  check<2, 2>();
+  check<2, 3>();
+  check<3, 3>();
+}
@@ -0,0 +1,243 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+// Test DataOutBase::VtkHdfFlags::reuse_unchanged_mesh: DataOut writes time
+// steps alternately into two files, and only every few time steps into one
+// of them, while the mesh is refined in between. Time steps without a mesh
+// have to refer to the time step that last wrote the current mesh into the
+// same file. Check this, and that every time step of the files describes a
+// valid mesh with point data, as a reader would need it.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+
+template <typename T>
+std::vector<T>
+read_dataset(const hid_t location, const std::string &name, const hid_t type)
+{
+  const hid_t dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+  AssertThrow(dataset >= 0, ExcIO());
+  const hid_t dataspace = H5Dget_space(dataset);
+  AssertThrow(dataspace >= 0, ExcIO());
+
+  std::vector<T> values(H5Sget_simple_extent_npoints(dataspace));
+  const herr_t   status =
+    H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+  AssertThrow(status >= 0, ExcIO());
+
+  H5Sclose(dataspace);
+  H5Dclose(dataset);
+  return values;
+}
+
+
+
+std::vector<std::int64_t>
+read_and_print(const hid_t location, const std::string &name)
+{
+  const std::vector<std::int64_t> values =
+    read_dataset<std::int64_t>(location, name, H5T_NATIVE_INT64);
+  deallog << name << ':';
+  for (const std::int64_t value : values)
+    deallog << ' ' << value;
+  deallog << std::endl;
+  return values;
+}
+
+
+
+void
+check_file(const std::string &filename)
+{
+  deallog << "file " << filename << std::endl;
+
+  const hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  AssertThrow(file >= 0, ExcIO());
+  const hid_t root = H5Gopen2(file, "VTKHDF", H5P_DEFAULT);
+  AssertThrow(root >= 0, ExcIO());
+  const hid_t steps = H5Gopen2(root, "Steps", H5P_DEFAULT);
+  AssertThrow(steps >= 0, ExcIO());
+
+  int n_steps = 0;
+  {
+    const hid_t attribute = H5Aopen(steps, "NSteps", H5P_DEFAULT);
+    H5Aread(attribute, H5T_NATIVE_INT, &n_steps);
+    H5Aclose(attribute);
+  }
+  deallog << "NSteps: " << n_steps << std::endl;
+
+  const std::vector<double> times =
+    read_dataset<double>(steps, "Values", H5T_NATIVE_DOUBLE);
+  const std::vector<std::int64_t> n_points =
+    read_and_print(root, "NumberOfPoints");
+  const std::vector<std::int64_t> n_cells =
+    read_and_print(root, "NumberOfCells");
+  const std::vector<std::int64_t> n_connectivity_ids =
+    read_and_print(root, "NumberOfConnectivityIds");
+  const std::vector<std::int64_t> part_offsets =
+    read_and_print(steps, "PartOffsets");
+  const std::vector<std::int64_t> n_parts =
+    read_and_print(steps, "NumberOfParts");
+  const std::vector<std::int64_t> point_offsets =
+    read_and_print(steps, "PointOffsets");
+  const std::vector<std::int64_t> cell_offsets =
+    read_and_print(steps, "CellOffsets");
+  const std::vector<std::int64_t> connectivity_offsets =
+    read_and_print(steps, "ConnectivityIdOffsets");
+  const std::vector<std::int64_t> point_data_offsets =
+    read_and_print(steps, "PointDataOffsets/solution");
+
+  const std::vector<double> points =
+    read_dataset<double>(root, "Points", H5T_NATIVE_DOUBLE);
+  const std::vector<std::int64_t> offsets =
+    read_dataset<std::int64_t>(root, "Offsets", H5T_NATIVE_INT64);
+  const std::vector<std::int64_t> connectivity =
+    read_dataset<std::int64_t>(root, "Connectivity", H5T_NATIVE_INT64);
+  const std::vector<float> solution =
+    read_dataset<float>(root, "PointData/solution", H5T_NATIVE_FLOAT);
+
+  // Assemble the mesh of each time step the way a reader does, and check
+  // that it refers to existing points and data
+  for (int step = 0; step < n_steps; ++step)
+    {
+      std::int64_t point_offset        = point_offsets[step];
+      std::int64_t cell_offset         = cell_offsets[step];
+      std::int64_t connectivity_offset = connectivity_offsets[step];
+      std::int64_t data_offset         = point_data_offsets[step];
+      std::int64_t step_points = 0, step_cells = 0;
+      bool         valid = true;
+      for (std::int64_t p = 0; p < n_parts[step]; ++p)
+        {
+          const std::int64_t part = part_offsets[step] + p;
+          valid = valid && (point_offset + n_points[part]) * 3 <=
+                             static_cast<std::int64_t>(points.size());
+          valid = valid && data_offset + n_points[part] <=
+                             static_cast<std::int64_t>(solution.size());
+
+          // each part stores one more offset than it has cells
+          const std::int64_t first_offset = cell_offset + part;
+          valid = valid && offsets[first_offset] == 0 &&
+                  offsets[first_offset + n_cells[part]] ==
+                    n_connectivity_ids[part];
+          for (std::int64_t i = 0; i < n_connectivity_ids[part]; ++i)
+            valid = valid && connectivity[connectivity_offset + i] >= 0 &&
+                    connectivity[connectivity_offset + i] < n_points[part];
+
+          step_points += n_points[part];
+          step_cells += n_cells[part];
+          point_offset += n_points[part];
+          cell_offset += n_cells[part];
+          connectivity_offset += n_connectivity_ids[part];
+          data_offset += n_points[part];
+        }
+      deallog << "step " << step << ": time " << times[step] << ", "
+              << step_points << " points, " << step_cells << " cells, "
+              << (valid ? "ok" : "invalid") << std::endl;
+    }
+
+  H5Gclose(steps);
+  H5Gclose(root);
+  H5Fclose(file);
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  const FE_Q<dim>     fe(1);
+  const MappingQ<dim> mapping(1);
+  DoFHandler<dim>     dof_handler(tria);
+  Vector<double>      solution;
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.set_patch_geometry_caching(true);
+
+  DataOutBase::VtkHdfFlags flags;
+  flags.reuse_unchanged_mesh = true;
+
+  const std::string filenames[2] = {"output_a_" + std::to_string(dim) +
+                                      ".vtkhdf",
+                                    "output_b_" + std::to_string(dim) +
+                                      ".vtkhdf"};
+
+  // The first file gets all time steps but the fourth one, the second
+  // file only every third time step. The mesh is refined before the third
+  // time step.
+  for (unsigned int step = 0; step < 5; ++step)
+    {
+      if (step == 2)
+        tria.refine_global(1);
+      if (step == 0 || step == 2)
+        {
+          dof_handler.distribute_dofs(fe);
+          solution.reinit(dof_handler.n_dofs());
+        }
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution[i] = step + i;
+
+      data_out.clear_data_vectors();
+      data_out.add_data_vector(solution, "solution");
+      data_out.build_patches(mapping, 1);
+
+      flags.time             = step;
+      flags.append_time_step = (step > 0);
+      data_out.set_flags(flags);
+      if (step != 3)
+        data_out.write_vtkhdf_parallel(filenames[0], MPI_COMM_SELF);
+      if (step % 3 == 0)
+        data_out.write_vtkhdf_parallel(filenames[1], MPI_COMM_SELF);
+    }
+
+  for (const std::string &filename : filenames)
+    check_file(filename);
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,146 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+// test parallel DataOut with VTKHDF: all processes write into the same
+// file, the first time step with the mesh, the second one reusing it.
+//
+// As in data_out_hdf5_03, some of the ranks have no cells. They still
+// contribute an (empty) part to every time step.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+
+// print the number of rows of a dataset, and its entries if they are
+// integers that do not depend on the partitioning of the points
+void
+print_dataset(const hid_t        location,
+              const std::string &name,
+              const bool         print_entries)
+{
+  const hid_t dataset = H5Dopen2(location, name.c_str(), H5P_DEFAULT);
+  AssertThrow(dataset >= 0, ExcIO());
+  const hid_t dataspace = H5Dget_space(dataset);
+  hsize_t     dims[2]   = {0, 1};
+  H5Sget_simple_extent_dims(dataspace, dims, nullptr);
+
+  std::vector<std::int64_t> values(dims[0] * dims[1]);
+  H5Dread(dataset,
+          H5T_NATIVE_INT64,
+          H5S_ALL,
+          H5S_ALL,
+          H5P_DEFAULT,
+          values.data());
+
+  deallog << name << " [" << dims[0] << "]:";
+  if (print_entries)
+    for (const std::int64_t value : values)
+      deallog << ' ' << value;
+  deallog << std::endl;
+
+  H5Sclose(dataspace);
+  H5Dclose(dataset);
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  parallel::distributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  FE_Q<dim> fe(1);
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  Vector<double> v1(dof.n_dofs());
+  for (unsigned int i = 0; i < v1.size(); ++i)
+    v1(i) = i;
+
+  DataOut<dim> data_out;
+  data_out.add_data_vector(dof, v1, "bla");
+  data_out.build_patches(1);
+  deallog << "n_patches on my rank: " << data_out.get_patches().size()
+          << std::endl;
+
+  const std::string filename = "output_" + std::to_string(dim) + ".vtkhdf";
+
+  DataOutBase::VtkHdfFlags flags;
+  flags.reuse_unchanged_mesh = true;
+  data_out.set_flags(flags);
+  data_out.write_vtkhdf_parallel(filename, MPI_COMM_WORLD);
+
+  flags.time             = 1.;
+  flags.append_time_step = true;
+  data_out.set_flags(flags);
+  data_out.write_vtkhdf_parallel(filename, MPI_COMM_WORLD);
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      const hid_t file =
+        H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+      AssertThrow(file >= 0, ExcIO());
+      const hid_t root = H5Gopen2(file, "VTKHDF", H5P_DEFAULT);
+      AssertThrow(root >= 0, ExcIO());
+
+      print_dataset(root, "Points", false);
+      print_dataset(root, "PointData/bla", false);
+      for (const std::string name : {"NumberOfPoints",
+                                     "NumberOfCells",
+                                     "NumberOfConnectivityIds",
+                                     "Offsets",
+                                     "Steps/PartOffsets",
+                                     "Steps/NumberOfParts",
+                                     "Steps/PointOffsets",
+                                     "Steps/CellOffsets",
+                                     "Steps/ConnectivityIdOffsets",
+                                     "Steps/PointDataOffsets/bla"})
+        print_dataset(root, name, true);
+
+      H5Gclose(root);
+      H5Fclose(file);
+    }
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,129 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// Check that DoFTools::make_hanging_node_constraints() and
+// AffineConstraints::close() give the same constraints when run with one
+// and with several threads, on meshes that are refined several times at
+// random places so that there are chains of constraints in 3d. Also check
+// the resolution of chains of constraints in close() on a small example.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+
+bool
+operator==(const AffineConstraints<double> &constraints_1,
+           const AffineConstraints<double> &constraints_2)
+{
+  const auto lines_1 = constraints_1.get_lines();
+  const auto lines_2 = constraints_2.get_lines();
+  if (lines_1.size() != lines_2.size())
+    return false;
+  for (auto line_1 = lines_1.begin(), line_2 = lines_2.begin();
+       line_1 != lines_1.end();
+       ++line_1, ++line_2)
+    if (line_1->index != line_2->index ||
+        !std::equal(line_1->entries.begin(),
+                    line_1->entries.end(),
+                    line_2->entries.begin(),
+                    line_2->entries.end()) ||
+        line_1->inhomogeneity != line_2->inhomogeneity)
+      return false;
+  return true;
+}
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe)
+{
+  deallog << fe.get_name() << std::endl;
+
+  Triangulation<dim> tria(Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (random_value<double>() < 0.3)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> reference;
+  MultithreadInfo::set_thread_limit(1);
+  DoFTools::make_hanging_node_constraints(dof, reference);
+  reference.close();
+
+  MultithreadInfo::set_thread_limit(4);
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  deallog << "n_dofs=" << dof.n_dofs()
+          << ", n_constraints=" << reference.n_constraints() << " -- "
+          << (constraints == reference ? "ok" : "failed") << std::endl;
+}
+
+
+
+void
+check_chain()
+{
+  // x5 = x4/2 + x3/2 + 1, x4 = x3/2 + x2/2 + 2, x3 = x0 + x1, x2 = 3:
+  // after closing, x5 = 3/4 x0 + 3/4 x1 + 11/4 and x4 = x0/2 + x1/2 + 7/2
+  AffineConstraints<double> constraints;
+  constraints.add_constraint(5, {{4, 0.5}, {3, 0.5}}, 1.);
+  constraints.add_constraint(4, {{3, 0.5}, {2, 0.5}}, 2.);
+  constraints.add_constraint(3, {{0, 1.}, {1, 1.}});
+  constraints.add_constraint(2, {}, 3.);
+  constraints.close();
+  constraints.print(deallog.get_file_stream());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>(FE_Q<2>(1));
+  check<2>(FE_Q<2>(3));
+  check<2>(FESystem<2>(FE_Q<2>(2), 2));
+  check<3>(FE_Q<3>(1));
+  check<3>(FE_Q<3>(2));
+
+  check_chain();
+}
@@ -0,0 +1,186 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check DoFNumberingTransfer over a number of cycles of random refinement
+// and coarsening: the sparsity pattern it updates must be the same as the
+// one created by DoFTools::make_sparsity_pattern() on the new mesh, and the
+// degrees of freedom on cells that were neither refined nor coarsened must
+// keep their relative order when renumbering. Half of the cases store the
+// constraints in compact form, see AffineConstraints::set_compact_storage().
+
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_numbering_transfer.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+make_pattern(const DoFHandler<dim>           &dof_handler,
+             const AffineConstraints<double> &constraints,
+             const bool                       keep_constrained_dofs,
+             SparsityPattern                 &sparsity_pattern)
+{
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler,
+                                  dsp,
+                                  constraints,
+                                  keep_constrained_dofs);
+  sparsity_pattern.copy_from(dsp);
+}
+
+
+
+template <int dim>
+void
+check(const unsigned int degree,
+      const bool         keep_constrained_dofs,
+      const bool         renumber,
+      const bool         compact_storage)
+{
+  deallog << "dim=" << dim << ", degree=" << degree
+          << ", keep_constrained_dofs=" << keep_constrained_dofs
+          << ", renumber=" << renumber
+          << ", compact_storage=" << compact_storage << std::endl;
+
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 3 : 2);
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+
+  DoFNumberingTransfer<dim> numbering_transfer(dof_handler);
+
+  AffineConstraints<double> constraints;
+  constraints.set_compact_storage(compact_storage);
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+  SparsityPattern sparsity_pattern;
+  make_pattern(dof_handler,
+               constraints,
+               keep_constrained_dofs,
+               sparsity_pattern);
+
+  for (unsigned int cycle = 0; cycle < 6; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          const unsigned int r = Testing::rand() % 16;
+          if (r == 0 && cell->level() < (dim == 2 ? 5 : 4))
+            cell->set_refine_flag();
+          else if (r < 8 && cell->level() > 1)
+            cell->set_coarsen_flag();
+        }
+      tria.prepare_coarsening_and_refinement();
+
+      // remember the degrees of freedom on the cells that stay
+      std::map<std::pair<int, int>, std::vector<types::global_dof_index>>
+        unchanged_cells;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (!cell->refine_flag_set() && !cell->coarsen_flag_set())
+          {
+            std::vector<types::global_dof_index> dof_indices(
+              fe.n_dofs_per_cell());
+            cell->get_dof_indices(dof_indices);
+            unchanged_cells[std::make_pair(cell->level(), cell->index())] =
+              dof_indices;
+          }
+
+      tria.execute_coarsening_and_refinement();
+      dof_handler.distribute_dofs(fe);
+      if (renumber)
+        numbering_transfer.renumber_dofs();
+
+      AffineConstraints<double> new_constraints;
+      new_constraints.set_compact_storage(compact_storage);
+      DoFTools::make_hanging_node_constraints(dof_handler, new_constraints);
+      new_constraints.close();
+
+      numbering_transfer.update_sparsity_pattern(constraints,
+                                                 new_constraints,
+                                                 sparsity_pattern,
+                                                 keep_constrained_dofs);
+      constraints.copy_from(new_constraints);
+
+      SparsityPattern reference;
+      make_pattern(dof_handler, constraints, keep_constrained_dofs, reference);
+
+      // the old and new indices of the degrees of freedom on the unchanged
+      // cells, which must be in the same order if renumbered
+      std::map<types::global_dof_index, types::global_dof_index> new_of_old;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          const auto old_cell = unchanged_cells.find(
+            std::make_pair(cell->level(), cell->index()));
+          if (old_cell != unchanged_cells.end())
+            {
+              std::vector<types::global_dof_index> dof_indices(
+                fe.n_dofs_per_cell());
+              cell->get_dof_indices(dof_indices);
+              for (unsigned int i = 0; i < dof_indices.size(); ++i)
+                new_of_old[old_cell->second[i]] = dof_indices[i];
+            }
+        }
+      bool order_kept = true;
+      for (auto it = new_of_old.begin(), next = std::next(it);
+           next != new_of_old.end();
+           ++it, ++next)
+        if (it->second > next->second)
+          order_kept = false;
+
+      deallog << "cycle " << cycle << ": " << tria.n_active_cells()
+              << " cells, " << dof_handler.n_dofs() << " dofs, "
+              << sparsity_pattern.n_nonzero_elements() << " entries -- "
+              << (sparsity_pattern == reference ? "ok" : "failed");
+      if (renumber)
+        deallog << ", order " << (order_kept ? "kept" : "changed");
+      deallog << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>(1, true, false, false);
+  check<2>(1, false, true, true);
+  check<2>(2, true, true, false);
+  check<2>(3, false, false, true);
+  check<3>(1, false, true, false);
+  check<3>(2, true, true, true);
+}
@@ -0,0 +1,131 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check DoFRenumbering::space_filling_curve() for elements with and without
+// support points, and check that it as well as DoFRenumbering::Cuthill_McKee()
+// produce the same numbering with one and with four threads, on meshes that
+// are large enough to use the parallel code paths
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgp.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+// Renumber with one and with four threads, check that the result is a
+// permutation, and print the bandwidth of the resulting matrix
+template <int dim, typename Function>
+void
+compare(const std::string    &name,
+        const DoFHandler<dim> &dof_handler,
+        const Function        &renumber)
+{
+  std::vector<types::global_dof_index> new_indices[2];
+  for (unsigned int run = 0; run < 2; ++run)
+    {
+      MultithreadInfo::set_thread_limit(run == 0 ? 1 : 4);
+      new_indices[run].resize(dof_handler.n_dofs());
+      renumber(new_indices[run]);
+    }
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  std::vector<bool> used(dof_handler.n_dofs(), false);
+  for (const types::global_dof_index i : new_indices[0])
+    {
+      AssertIndexRange(i, used.size());
+      AssertThrow(used[i] == false, ExcInternalError());
+      used[i] = true;
+    }
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  types::global_dof_index bandwidth = 0;
+  for (const auto &entry : dsp)
+    bandwidth = std::max(bandwidth,
+                         std::max(new_indices[0][entry.row()],
+                                  new_indices[0][entry.column()]) -
+                           std::min(new_indices[0][entry.row()],
+                                    new_indices[0][entry.column()]));
+
+  deallog << name << ": bandwidth " << bandwidth << " -- "
+          << (new_indices[0] == new_indices[1] ? "ok" : "failed")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe, const unsigned int n_refinements)
+{
+  deallog << "dim=" << dim << ", " << fe.get_name() << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  deallog << "n_dofs: " << dof_handler.n_dofs() << std::endl;
+
+  compare("space_filling_curve",
+          dof_handler,
+          [&](std::vector<types::global_dof_index> &new_indices) {
+            DoFRenumbering::compute_space_filling_curve(new_indices,
+                                                        dof_handler);
+          });
+
+  compare("Cuthill_McKee",
+          dof_handler,
+          [&](std::vector<types::global_dof_index> &new_indices) {
+            DoFRenumbering::compute_Cuthill_McKee(new_indices, dof_handler);
+          });
+
+  // renumbering the DoFHandler along the curve gives the same bandwidth
+  DoFRenumbering::space_filling_curve(dof_handler);
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  deallog << "bandwidth after renumbering: " << dsp.bandwidth() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check(FE_Q<2>(2), 6);
+  check(FE_DGP<2>(1), 6);
+  check(FESystem<2>(FE_Q<2>(1), 2), 6);
+  // in 3d, the fronts of the Cuthill-McKee algorithm grow large enough to
+  // be processed in parallel
+  check(FE_Q<3>(1), 5);
+}
@@ -158,12 +158,12 @@ test()
         auto       local_vector_begin  = local_rhs.begin();
         const auto local_vector_end    = local_rhs.end();
         auto       local_indices_begin = local_dof_indices.begin();
-        const std::vector<std::pair<types::global_dof_index, double>> *line_ptr;
         for (; local_vector_begin != local_vector_end;
              ++local_vector_begin, ++local_indices_begin)
           {
-            line_ptr = cm.get_constraint_entries(*local_indices_begin);
-            if (line_ptr == NULL) // unconstrained
+            const auto line_ptr =
+              cm.get_constraint_entries(*local_indices_begin);
+            if (!line_ptr.has_value()) // unconstrained
               {
                 if (support.is_element(*local_indices_begin))
                   sparse_rhs(*local_indices_begin) += *local_vector_begin;
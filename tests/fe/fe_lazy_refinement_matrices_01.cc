@@ -0,0 +1,118 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Request the lazily computed prolongation and restriction matrices of
+// several elements from many tasks at the same time, in different orders
+// of the children, and check that the result is the same as when the
+// matrices are requested one after the other.
+
+
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_nedelec.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_q_hierarchical.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+request_matrices(const FiniteElement<dim> &fe, const unsigned int offset)
+{
+  const unsigned int n_children = GeometryInfo<dim>::max_children_per_cell;
+  for (unsigned int c = 0; c < n_children; ++c)
+    {
+      const unsigned int child = (c + offset) % n_children;
+      fe.get_prolongation_matrix(child);
+      fe.get_restriction_matrix(child);
+    }
+}
+
+
+
+bool
+equal(const FullMatrix<double> &a, const FullMatrix<double> &b)
+{
+  if (a.m() != b.m() || a.n() != b.n())
+    return false;
+  for (unsigned int i = 0; i < a.m(); ++i)
+    for (unsigned int j = 0; j < a.n(); ++j)
+      if (a(i, j) != b(i, j))
+        return false;
+  return true;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe_parallel, const FiniteElement<dim> &fe_serial)
+{
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int t = 0; t < 16; ++t)
+    tasks += Threads::new_task([&fe_parallel, t]() {
+      request_matrices(fe_parallel, t);
+    });
+  tasks.join_all();
+
+  bool equal_matrices = true;
+  for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell; ++c)
+    {
+      const FullMatrix<double> &prolongation =
+        fe_serial.get_prolongation_matrix(c);
+      const FullMatrix<double> &restriction =
+        fe_serial.get_restriction_matrix(c);
+      if (prolongation.m() != fe_serial.n_dofs_per_cell() ||
+          !equal(prolongation, fe_parallel.get_prolongation_matrix(c)) ||
+          !equal(restriction, fe_parallel.get_restriction_matrix(c)))
+        equal_matrices = false;
+    }
+
+  deallog << fe_parallel.get_name() << ": equal matrices: " << equal_matrices
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_all()
+{
+  test<dim>(FE_Q<dim>(3), FE_Q<dim>(3));
+  test<dim>(FE_Q_Hierarchical<dim>(3), FE_Q_Hierarchical<dim>(3));
+  test<dim>(FESystem<dim>(FE_Q<dim>(2), dim, FE_DGQ<dim>(1), 1),
+            FESystem<dim>(FE_Q<dim>(2), dim, FE_DGQ<dim>(1), 1));
+  if constexpr (dim > 1)
+    test<dim>(FE_Nedelec<dim>(1), FE_Nedelec<dim>(1));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_all<1>();
+  test_all<2>();
+  test_all<3>();
+}
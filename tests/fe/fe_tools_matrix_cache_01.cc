@@ -0,0 +1,167 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check FETools::MatrixCache: matrices are computed once per key, are read
+// back from files after the cache in memory has been cleared unless the
+// files do not fit the element or are damaged, and elements that take their
+// matrices from the cache have the same matrices as elements that computed
+// them.
+
+
+#include <deal.II/fe/fe_nedelec.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+#include <filesystem>
+
+#include "../tests.h"
+
+
+
+FETools::MatrixCache::MatrixSet
+compute_matrices(unsigned int &n_calls)
+{
+  ++n_calls;
+  FullMatrix<double> matrix(2, 3);
+  for (unsigned int i = 0; i < matrix.m(); ++i)
+    for (unsigned int j = 0; j < matrix.n(); ++j)
+      matrix(i, j) = 1. / (i + j + 1);
+  return {{matrix, FullMatrix<double>()}, {matrix}};
+}
+
+
+
+bool
+equal(const FETools::MatrixCache::MatrixSet &a,
+      const FETools::MatrixCache::MatrixSet &b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (unsigned int i = 0; i < a.size(); ++i)
+    {
+      if (a[i].size() != b[i].size())
+        return false;
+      for (unsigned int j = 0; j < a[i].size(); ++j)
+        {
+          if (a[i][j].m() != b[i][j].m() || a[i][j].n() != b[i][j].n())
+            return false;
+          for (unsigned int k = 0; k < a[i][j].m(); ++k)
+            for (unsigned int l = 0; l < a[i][j].n(); ++l)
+              if (a[i][j](k, l) != b[i][j](k, l))
+                return false;
+        }
+    }
+  return true;
+}
+
+
+
+void
+test_cache()
+{
+  unsigned int n_calls = 0;
+  const auto   compute = [&n_calls]() { return compute_matrices(n_calls); };
+
+  const auto first  = FETools::MatrixCache::get_or_compute("test", 3, compute);
+  const auto second = FETools::MatrixCache::get_or_compute("test", 3, compute);
+  deallog << "computed " << n_calls << " time(s), same object: "
+          << (first == second) << std::endl;
+
+  // elements that are not described by their name are not cached
+  FETools::MatrixCache::get_or_compute("FE_Q<2>(QUnknownNodes(2))",
+                                       3,
+                                       compute);
+  FETools::MatrixCache::get_or_compute("FE_Q<2>(QUnknownNodes(2))",
+                                       3,
+                                       compute);
+  deallog << "computed " << n_calls << " time(s), "
+          << FETools::MatrixCache::n_entries() << " entries" << std::endl;
+
+  // store in files, clear the cache in memory and read the matrices back
+  FETools::MatrixCache::set_directory("matrix_cache");
+  FETools::MatrixCache::get_or_compute("test file", 3, compute);
+  FETools::MatrixCache::clear();
+  const auto from_file =
+    FETools::MatrixCache::get_or_compute("test file", 3, compute);
+  deallog << "computed " << n_calls
+          << " time(s), equal: " << equal(*first, *from_file) << std::endl;
+
+  // matrices larger than the number of degrees of freedom per cell and
+  // truncated files are not read, but computed again
+  FETools::MatrixCache::clear();
+  FETools::MatrixCache::get_or_compute("test file", 2, compute);
+  deallog << "computed " << n_calls << " time(s)" << std::endl;
+  FETools::MatrixCache::clear();
+  std::filesystem::resize_file(
+    "matrix_cache/test_file.matrices",
+    std::filesystem::file_size("matrix_cache/test_file.matrices") - 1);
+  const auto from_truncated_file =
+    FETools::MatrixCache::get_or_compute("test file", 3, compute);
+  deallog << "computed " << n_calls << " time(s), equal: "
+          << equal(*first, *from_truncated_file) << std::endl;
+  FETools::MatrixCache::set_directory("");
+  FETools::MatrixCache::clear();
+}
+
+
+
+template <int dim, typename FEType>
+void
+test_element(const unsigned int degree)
+{
+  const FEType fe1(degree);
+  const FEType fe2(degree);
+
+  bool equal_matrices =
+    (fe1.constraints().m() == fe2.constraints().m() &&
+     fe1.constraints().n() == fe2.constraints().n());
+  for (unsigned int i = 0; i < fe1.constraints().m() && equal_matrices; ++i)
+    for (unsigned int j = 0; j < fe1.constraints().n(); ++j)
+      if (fe1.constraints()(i, j) != fe2.constraints()(i, j))
+        equal_matrices = false;
+
+  for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell; ++c)
+    {
+      const FullMatrix<double> &p1 = fe1.get_prolongation_matrix(c);
+      const FullMatrix<double> &p2 = fe2.get_prolongation_matrix(c);
+      const FullMatrix<double> &r1 = fe1.get_restriction_matrix(c);
+      const FullMatrix<double> &r2 = fe2.get_restriction_matrix(c);
+      for (unsigned int i = 0; i < fe1.n_dofs_per_cell(); ++i)
+        for (unsigned int j = 0; j < fe1.n_dofs_per_cell(); ++j)
+          if (p1(i, j) != p2(i, j) || r1(i, j) != r2(i, j))
+            equal_matrices = false;
+    }
+
+  deallog << fe1.get_name() << ": equal matrices: " << equal_matrices
+          << ", entries in cache: " << FETools::MatrixCache::n_entries()
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_cache();
+  test_element<2, FE_RaviartThomas<2>>(1);
+  test_element<3, FE_RaviartThomas<3>>(1);
+  test_element<2, FE_Nedelec<2>>(2);
+  test_element<3, FE_Nedelec<3>>(1);
+}
@@ -0,0 +1,184 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check that FEValuesBatch computes the same shape values, shape gradients,
+// JxW values, quadrature points and function values and gradients as
+// FEValues on each of the cells of a batch, including a last batch with
+// fewer cells than lanes
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_batch.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int spacedim>
+void
+test(const Triangulation<dim, spacedim> &tria,
+     const Mapping<dim, spacedim>       &mapping,
+     const FiniteElement<dim, spacedim> &fe,
+     const Quadrature<dim>              &quadrature)
+{
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << ", "
+          << fe.get_name() << std::endl;
+
+  DoFHandler<dim, spacedim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = random_value<double>();
+
+  const UpdateFlags flags = update_values | update_gradients |
+                            update_JxW_values | update_quadrature_points;
+  FEValues<dim, spacedim>      fe_values(mapping, fe, quadrature, flags);
+  FEValuesBatch<dim, spacedim> fe_batch(mapping, fe, quadrature, flags);
+
+  const bool scalar = (fe.n_components() == 1);
+
+  std::vector<double>              values(quadrature.size());
+  std::vector<Tensor<1, spacedim>> gradients(quadrature.size());
+
+  std::vector<VectorizedArray<double>>                       batch_values;
+  std::vector<Tensor<1, spacedim, VectorizedArray<double>>> batch_gradients;
+
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  double max_difference = 0;
+
+  std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator> cells;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cells.push_back(cell);
+      if (cells.size() < fe_batch.n_lanes &&
+          cell->active_cell_index() + 1 < tria.n_active_cells())
+        continue;
+
+      fe_batch.reinit(cells);
+      if (scalar)
+        {
+          fe_batch.get_function_values(solution, batch_values);
+          fe_batch.get_function_gradients(solution, batch_gradients);
+        }
+
+      for (unsigned int l = 0; l < cells.size(); ++l)
+        {
+          fe_values.reinit(cells[l]);
+          cells[l]->get_dof_indices(dof_indices);
+          for (unsigned int i = 0; i < dof_indices.size(); ++i)
+            AssertThrow(dof_indices[i] == fe_batch.get_dof_indices(l)[i],
+                        ExcInternalError());
+
+          for (const unsigned int q : fe_batch.quadrature_point_indices())
+            {
+              for (const unsigned int i : fe_batch.dof_indices())
+                {
+                  max_difference =
+                    std::max(max_difference,
+                             std::abs(fe_values.shape_value(i, q) -
+                                      fe_batch.shape_value(i, q)));
+                  for (unsigned int d = 0; d < spacedim; ++d)
+                    max_difference =
+                      std::max(max_difference,
+                               std::abs(fe_values.shape_grad(i, q)[d] -
+                                        fe_batch.shape_grad(i, q)[d][l]));
+                }
+              max_difference =
+                std::max(max_difference,
+                         std::abs(fe_values.JxW(q) - fe_batch.JxW(q)[l]));
+              for (unsigned int d = 0; d < spacedim; ++d)
+                max_difference =
+                  std::max(max_difference,
+                           std::abs(fe_values.quadrature_point(q)[d] -
+                                    fe_batch.quadrature_point(q)[d][l]));
+            }
+
+          if (scalar)
+            {
+              fe_values.get_function_values(solution, values);
+              fe_values.get_function_gradients(solution, gradients);
+              for (const unsigned int q : fe_batch.quadrature_point_indices())
+                {
+                  max_difference =
+                    std::max(max_difference,
+                             std::abs(values[q] - batch_values[q][l]));
+                  for (unsigned int d = 0; d < spacedim; ++d)
+                    max_difference =
+                      std::max(max_difference,
+                               std::abs(gradients[q][d] -
+                                        batch_gradients[q][d][l]));
+                }
+            }
+        }
+      cells.clear();
+    }
+
+  deallog << tria.n_active_cells() << " cells, differences to FEValues "
+          << (max_difference < 1e-12 ? "ok" : "failed") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_cube(tria, 5);
+    GridTools::distort_random(0.2, tria, false, 42);
+    test(tria, MappingQ<2>(1), FE_Q<2>(2), QGauss<2>(3));
+    test(tria, MappingQ<2>(1), FESystem<2>(FE_Q<2>(2), 2), QGauss<2>(3));
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 3);
+    test(tria,
+         MappingFE<2>(FE_SimplexP<2>(1)),
+         FE_SimplexP<2>(2),
+         QGaussSimplex<2>(3));
+  }
+  {
+    Triangulation<2, 3> tria;
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(1);
+    test(tria, MappingQ<2, 3>(2), FE_Q<2, 3>(1), QGauss<2>(2));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_ball(tria);
+    test(tria, MappingQ<3>(2), FE_Q<3>(2), QGauss<3>(3));
+    test(tria, MappingQ<3>(2), FESystem<3>(FE_Q<3>(1), 3), QGauss<3>(2));
+  }
+}
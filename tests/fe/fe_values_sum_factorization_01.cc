@@ -0,0 +1,223 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// FEValues evaluates finite element functions by sum factorization for
+// FE_Q and FE_DGQ elements with tensor product quadrature formulas. Check
+// that get_function_values() and get_function_gradients(), also through
+// FEValuesViews and for vector-valued elements, give the same results as
+// summing over the shape functions on a curved mesh, and that quadrature
+// formulas that are no tensor product of a single formula still work.
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe, const Quadrature<dim> &quadrature)
+{
+  Triangulation<dim> tria;
+  if constexpr (dim == 1)
+    {
+      GridGenerator::hyper_cube(tria, -1., 1.);
+      tria.refine_global(2);
+    }
+  else
+    GridGenerator::hyper_ball(tria);
+  MappingQ<dim> mapping(3);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution[i] = random_value<double>(-1., 1.);
+
+  // gradients are only evaluated by sum factorization if the inverse
+  // Jacobians are computed
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_values | update_gradients |
+                            update_inverse_jacobians);
+
+  const unsigned int n_components = fe.n_components();
+  const unsigned int n_q_points   = quadrature.size();
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  double max_value_error = 0, max_gradient_error = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+
+      // the reference values, computed from the shape functions
+      std::vector<Vector<double>> reference_values(
+        n_q_points, Vector<double>(n_components));
+      std::vector<std::vector<Tensor<1, dim>>> reference_gradients(
+        n_q_points, std::vector<Tensor<1, dim>>(n_components));
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          const unsigned int c = fe.system_to_component_index(i).first;
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              reference_values[q][c] +=
+                solution[dof_indices[i]] * fe_values.shape_value(i, q);
+              reference_gradients[q][c] +=
+                solution[dof_indices[i]] * fe_values.shape_grad(i, q);
+            }
+        }
+
+      if (n_components == 1)
+        {
+          std::vector<double>         values(n_q_points);
+          std::vector<Tensor<1, dim>> gradients(n_q_points);
+          fe_values.get_function_values(solution, values);
+          fe_values.get_function_gradients(solution, gradients);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              max_value_error =
+                std::max(max_value_error,
+                         std::abs(values[q] - reference_values[q][0]));
+              max_gradient_error =
+                std::max(max_gradient_error,
+                         (gradients[q] - reference_gradients[q][0]).norm());
+            }
+
+          fe_values.get_function_values(solution,
+                                        make_array_view(dof_indices),
+                                        values);
+          fe_values.get_function_gradients(solution,
+                                           make_array_view(dof_indices),
+                                           gradients);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              max_value_error =
+                std::max(max_value_error,
+                         std::abs(values[q] - reference_values[q][0]));
+              max_gradient_error =
+                std::max(max_gradient_error,
+                         (gradients[q] - reference_gradients[q][0]).norm());
+            }
+
+          const FEValuesExtractors::Scalar scalar(0);
+          fe_values[scalar].get_function_values(solution, values);
+          fe_values[scalar].get_function_gradients(solution, gradients);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            {
+              max_value_error =
+                std::max(max_value_error,
+                         std::abs(values[q] - reference_values[q][0]));
+              max_gradient_error =
+                std::max(max_gradient_error,
+                         (gradients[q] - reference_gradients[q][0]).norm());
+            }
+        }
+      else
+        {
+          std::vector<Vector<double>> values(n_q_points,
+                                             Vector<double>(n_components));
+          std::vector<std::vector<Tensor<1, dim>>> gradients(
+            n_q_points, std::vector<Tensor<1, dim>>(n_components));
+          fe_values.get_function_values(solution, values);
+          fe_values.get_function_gradients(solution, gradients);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int c = 0; c < n_components; ++c)
+              {
+                max_value_error =
+                  std::max(max_value_error,
+                           std::abs(values[q][c] - reference_values[q][c]));
+                max_gradient_error = std::max(
+                  max_gradient_error,
+                  (gradients[q][c] - reference_gradients[q][c]).norm());
+              }
+
+          const FEValuesExtractors::Vector vector(0);
+          std::vector<Tensor<1, dim>>      vector_values(n_q_points);
+          std::vector<Tensor<2, dim>>      vector_gradients(n_q_points);
+          fe_values[vector].get_function_values(solution, vector_values);
+          fe_values[vector].get_function_gradients(solution,
+                                                   vector_gradients);
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int c = 0; c < dim; ++c)
+              {
+                max_value_error = std::max(
+                  max_value_error,
+                  std::abs(vector_values[q][c] - reference_values[q][c]));
+                max_gradient_error = std::max(
+                  max_gradient_error,
+                  (vector_gradients[q][c] - reference_gradients[q][c]).norm());
+              }
+        }
+    }
+
+  deallog << fe.get_name() << " with " << n_q_points << " points: "
+          << (max_value_error < 1e-12 ? "values ok" : "values failed") << ", "
+          << (max_gradient_error < 1e-10 ? "gradients ok" : "gradients failed")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  for (unsigned int degree = 1; degree < (dim == 2 ? 7 : 5); ++degree)
+    {
+      check(FE_Q<dim>(degree), QGauss<dim>(degree + 1));
+      check(FE_DGQ<dim>(degree), QGauss<dim>(degree + 2));
+    }
+  check(FE_Q<dim>(2), QIterated<dim>(QTrapezoid<1>(), 3));
+  check(FESystem<dim>(FE_Q<dim>(3), dim), QGauss<dim>(4));
+  check(FESystem<dim>(FE_Q<dim>(2), dim, FE_DGQ<dim>(1), 1), QGauss<dim>(3));
+
+  // not a tensor product of a single formula, so the shape functions are
+  // summed up
+  if constexpr (dim == 2)
+    check(FE_Q<dim>(2), QAnisotropic<dim>(QGauss<1>(3), QGauss<1>(4)));
+  else if constexpr (dim == 3)
+    check(FE_Q<dim>(2),
+          QAnisotropic<dim>(QGauss<1>(3), QGauss<1>(4), QGauss<1>(3)));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>();
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,115 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check GridTools::find_active_cell_around_points() for random points inside
+// and outside of meshes with curved and with simplex cells: every point must
+// be found on a cell that maps the returned reference point back to it, the
+// same points must be found as with GridTools::find_active_cell_around_point(),
+// and the result must not depend on the number of threads
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test(const Triangulation<dim> &tria, const Mapping<dim> &mapping)
+{
+  GridTools::Cache<dim> cache(tria, mapping);
+
+  // random points in a box somewhat larger than the mesh
+  const BoundingBox<dim>  box = GridTools::compute_bounding_box(tria);
+  std::vector<Point<dim>> points(2000);
+  for (Point<dim> &p : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = box.lower_bound(d) +
+             (1.2 * random_value<double>() - 0.1) * box.side_length(d);
+
+  MultithreadInfo::set_thread_limit(1);
+  const auto result = GridTools::find_active_cell_around_points(cache, points);
+  MultithreadInfo::set_thread_limit(4);
+  const auto result_threads =
+    GridTools::find_active_cell_around_points(cache, points);
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  unsigned int n_found = 0, n_wrong = 0, n_different = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      const auto reference =
+        GridTools::find_active_cell_around_point(cache, points[i]);
+      if ((result[i].first == tria.end()) != (reference.first == tria.end()))
+        ++n_different;
+
+      if (result[i].first != tria.end())
+        {
+          ++n_found;
+          if (!result[i].first->reference_cell().contains_point(
+                result[i].second, 1e-10) ||
+              mapping.transform_unit_to_real_cell(result[i].first,
+                                                  result[i].second)
+                  .distance(points[i]) > 1e-10)
+            ++n_wrong;
+        }
+    }
+
+  deallog << "dim=" << dim << ", " << tria.n_active_cells() << " cells, "
+          << n_found << " of " << points.size() << " points found, " << n_wrong
+          << " wrong, " << n_different << " different from single search -- "
+          << (result == result_threads ? "ok" : "failed") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  {
+    Triangulation<2> tria;
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(3);
+    test(tria, MappingQ<2>(3));
+  }
+  {
+    Triangulation<2> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 8);
+    test(tria, MappingFE<2>(FE_SimplexP<2>(1)));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1., 6);
+    tria.refine_global(1);
+    test(tria, MappingQ<3>(2));
+  }
+  {
+    Triangulation<3> tria;
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 3);
+    test(tria, MappingFE<3>(FE_SimplexP<3>(1)));
+  }
+}
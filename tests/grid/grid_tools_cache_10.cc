@@ -0,0 +1,129 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check that GridTools::Cache::get_cell_geometry() returns the same values as
+// the cell accessors, also after the mesh has been refined and after vertices
+// have been moved and the cache has been marked for update manually
+
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int spacedim>
+void
+compare(const GridTools::Cache<dim, spacedim> &cache)
+{
+  const Triangulation<dim, spacedim> &tria = cache.get_triangulation();
+  const auto                         &data = cache.get_cell_geometry();
+
+  AssertDimension(data.size(), tria.n_active_cells());
+
+  bool equal = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      const unsigned int c = cell->active_cell_index();
+      if (data.n_vertices[c] != cell->n_vertices())
+        equal = false;
+      for (const unsigned int v : cell->vertex_indices())
+        if (data.vertex(c, v) != cell->vertex(v))
+          equal = false;
+      if (data.center(c) != cell->center() ||
+          data.diameter(c) != cell->diameter() ||
+          data.measure(c) != cell->measure() ||
+          data.bounding_box(c).get_boundary_points() !=
+            cell->bounding_box().get_boundary_points())
+        equal = false;
+    }
+
+  double volume = 0;
+  for (unsigned int c = 0; c < data.size(); ++c)
+    volume += data.measures[c];
+
+  deallog << tria.n_active_cells() << " cells, volume " << volume << " -- "
+          << (equal ? "ok" : "failed") << std::endl;
+}
+
+
+
+template <int dim, int spacedim, typename CreateFunction>
+void
+test(const CreateFunction &create)
+{
+  deallog << "dim: " << dim << ", spacedim: " << spacedim << std::endl;
+
+  Triangulation<dim, spacedim> tria;
+  create(tria);
+
+  GridTools::Cache<dim, spacedim> cache(tria);
+  compare(cache);
+
+  // the cache is invalidated by the refinement
+  unsigned int counter = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (counter++ % 3 == 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  compare(cache);
+
+  // but not by moving vertices directly
+  std::vector<bool> moved(tria.n_vertices(), false);
+  for (const auto &cell : tria.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      if (moved[cell->vertex_index(v)] == false)
+        {
+          cell->vertex(v) *= 1. + 0.01 * (cell->vertex_index(v) % 5);
+          moved[cell->vertex_index(v)] = true;
+        }
+  cache.mark_for_update(GridTools::update_cell_geometry);
+  compare(cache);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1, 1>([](auto &tria) { GridGenerator::hyper_cube(tria, -1, 2); });
+  test<1, 2>([](auto &tria) {
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(2);
+  });
+  test<2, 2>([](auto &tria) {
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(2);
+  });
+  test<2, 2>([](auto &tria) {
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 4);
+  });
+  test<2, 3>([](auto &tria) {
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(1);
+  });
+  test<3, 3>([](auto &tria) {
+    GridGenerator::hyper_shell(tria, Point<3>(), 0.5, 1.);
+    tria.refine_global(1);
+  });
+  test<3, 3>([](auto &tria) {
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+  });
+}
@@ -0,0 +1,142 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Refine meshes with one and with four threads, with enough cells to use the
+// parallel code paths in Triangulation::execute_coarsening_and_refinement(),
+// and check that the resulting triangulations are the same, including the
+// numbering of vertices, lines and cells and the locations of the vertices
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+// Collect the indices of the children, vertices, lines, and faces of all
+// cells, and the locations of all vertices
+template <int dim, int spacedim>
+std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>
+describe(const Triangulation<dim, spacedim> &tria)
+{
+  std::vector<unsigned int> indices;
+  for (const auto &cell : tria.cell_iterators())
+    {
+      indices.push_back(cell->level());
+      indices.push_back(cell->index());
+      indices.push_back(cell->has_children() ? cell->child_index(0) : -1);
+      for (const unsigned int v : cell->vertex_indices())
+        indices.push_back(cell->vertex_index(v));
+      for (const unsigned int l : cell->line_indices())
+        indices.push_back(cell->line_index(l));
+      if (dim == 3)
+        for (const unsigned int f : cell->face_indices())
+          indices.push_back(cell->face_index(f));
+    }
+  return {indices, tria.get_vertices()};
+}
+
+
+
+template <int dim, int spacedim, typename CreateFunction>
+std::pair<std::vector<unsigned int>, std::vector<Point<spacedim>>>
+refine(const CreateFunction &create, const unsigned int n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  Triangulation<dim, spacedim> tria;
+  create(tria);
+  tria.refine_global(dim == 2 ? 3 : 1);
+
+  // refine some cells locally, and coarsen some others, so that new objects
+  // are created in the gaps left by coarsening
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      unsigned int counter = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          if (counter % 3 == cycle)
+            cell->set_refine_flag();
+          else if (counter % 7 == 0 && cell->level() > 1)
+            cell->set_coarsen_flag();
+          ++counter;
+        }
+      tria.execute_coarsening_and_refinement();
+    }
+
+  deallog << "n_active_cells: " << tria.n_active_cells()
+          << ", n_vertices: " << tria.n_vertices() << std::endl;
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  return describe(tria);
+}
+
+
+
+template <int dim, int spacedim = dim, typename CreateFunction>
+void
+check(const std::string &name, const CreateFunction &create)
+{
+  deallog << name << std::endl;
+  const auto serial   = refine<dim, spacedim>(create, 1);
+  const auto parallel = refine<dim, spacedim>(create, 4);
+
+  // print a hash of the numbering, so that it is also compared to the one
+  // in the output file
+  std::uint64_t hash = 0;
+  for (const unsigned int i : serial.first)
+    hash = (hash * 31 + i) % 1000000007;
+  deallog << "hash: " << hash << " -- "
+          << (serial == parallel ? "ok" : "failed") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>("hyper_cube", [](Triangulation<2> &tria) {
+    GridGenerator::subdivided_hyper_cube(tria, 8);
+  });
+  check<2>("hyper_ball", [](Triangulation<2> &tria) {
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(2);
+  });
+  check<2>("simplex", [](Triangulation<2> &tria) {
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 8);
+  });
+  check<2, 3>("hyper_sphere", [](Triangulation<2, 3> &tria) {
+    GridGenerator::hyper_sphere(tria);
+    tria.refine_global(2);
+  });
+  check<3>("hyper_cube", [](Triangulation<3> &tria) {
+    GridGenerator::subdivided_hyper_cube(tria, 4);
+  });
+  check<3>("hyper_ball", [](Triangulation<3> &tria) {
+    GridGenerator::hyper_ball(tria);
+    tria.refine_global(1);
+  });
+  check<3>("simplex", [](Triangulation<3> &tria) {
+    GridGenerator::subdivided_hyper_cube_with_simplices(tria, 3);
+  });
+}
@@ -0,0 +1,233 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that AffineConstraints::set_compact_storage() does not change the
+// results of the functions that use the constraints, and that modifying a
+// closed object with compact storage works
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+void
+fill_constraints(AffineConstraints<double> &constraints, const unsigned int n)
+{
+  // every third dof is constrained to its two neighbors, some with
+  // inhomogeneities, and some of the constraints form chains that close()
+  // has to resolve
+  for (unsigned int i = 3; i < n - 3; i += 3)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, i - 1, 0.5);
+      constraints.add_entry(i, i + 1, 0.5);
+      if (i % 9 == 0)
+        constraints.set_inhomogeneity(i, 0.1 * i);
+    }
+  for (unsigned int i = 10; i < n - 10; i += 15)
+    {
+      constraints.add_line(i);
+      constraints.add_entry(i, i + 2, 1.);
+    }
+  constraints.add_line(n - 1);
+}
+
+
+
+template <typename T1, typename T2>
+double
+difference(const T1 &a, const T2 &b)
+{
+  double result = 0;
+  for (unsigned int i = 0; i < a.size(); ++i)
+    result = std::max(result, std::abs(a(i) - b(i)));
+  return result;
+}
+
+
+
+void
+test()
+{
+  const unsigned int n = 200;
+
+  AffineConstraints<double> constraints, compact_constraints;
+  fill_constraints(constraints, n);
+  fill_constraints(compact_constraints, n);
+  compact_constraints.set_compact_storage(true);
+  constraints.close();
+  compact_constraints.close();
+
+  deallog << "n_constraints: " << compact_constraints.n_constraints()
+          << ", n_identities: " << compact_constraints.n_identities()
+          << ", max indirections: "
+          << compact_constraints.max_constraint_indirections() << std::endl;
+  AssertThrow(compact_constraints.n_identities() == constraints.n_identities(),
+              ExcInternalError());
+  AssertThrow(compact_constraints.max_constraint_indirections() ==
+                constraints.max_constraint_indirections(),
+              ExcInternalError());
+  for (unsigned int i = 0; i < n; ++i)
+    AssertThrow(compact_constraints.is_identity_constrained(i) ==
+                    constraints.is_identity_constrained(i) &&
+                  compact_constraints.get_inhomogeneity(i) ==
+                    constraints.get_inhomogeneity(i),
+                ExcInternalError());
+
+  {
+    std::ostringstream out, compact_out;
+    constraints.print(out);
+    compact_constraints.print(compact_out);
+    AssertThrow(out.str() == compact_out.str(), ExcInternalError());
+  }
+
+  // distribute() and set_zero()
+  Vector<double> vector(n);
+  for (unsigned int i = 0; i < n; ++i)
+    vector(i) = 1. + std::sin(1. * i);
+  Vector<double> compact_vector(vector);
+  constraints.distribute(vector);
+  compact_constraints.distribute(compact_vector);
+  deallog << "distribute: " << difference(vector, compact_vector)
+          << std::endl;
+  LinearAlgebra::distributed::Vector<double> parallel_vector(n);
+  for (unsigned int i = 0; i < n; ++i)
+    parallel_vector(i) = 1. + std::sin(1. * i);
+  compact_constraints.distribute(parallel_vector);
+  deallog << "distribute parallel vector: "
+          << difference(vector, parallel_vector) << std::endl;
+  constraints.set_zero(vector);
+  compact_constraints.set_zero(compact_vector);
+  deallog << "set_zero: " << difference(vector, compact_vector) << std::endl;
+
+  // assemble a 1d Laplace-like matrix with distribute_local_to_global()
+  DynamicSparsityPattern dsp(n, n);
+  for (unsigned int i = 0; i < n - 1; ++i)
+    {
+      dsp.add(i, i);
+      dsp.add(i, i + 1);
+      dsp.add(i + 1, i);
+      dsp.add(i + 1, i + 1);
+    }
+  constraints.condense(dsp);
+  DynamicSparsityPattern compact_dsp(n, n);
+  for (unsigned int i = 0; i < n - 1; ++i)
+    {
+      compact_dsp.add(i, i);
+      compact_dsp.add(i, i + 1);
+      compact_dsp.add(i + 1, i);
+      compact_dsp.add(i + 1, i + 1);
+    }
+  compact_constraints.condense(compact_dsp);
+  AssertThrow(dsp.n_nonzero_elements() == compact_dsp.n_nonzero_elements(),
+              ExcInternalError());
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  SparseMatrix<double> matrix(sparsity), compact_matrix(sparsity);
+  Vector<double>       rhs(n), compact_rhs(n);
+  FullMatrix<double>   cell_matrix(2, 2);
+  Vector<double>       cell_rhs(2);
+  std::vector<types::global_dof_index> local_dof_indices(2);
+  for (unsigned int i = 0; i < n - 1; ++i)
+    {
+      cell_matrix(0, 0) = cell_matrix(1, 1) = 1. + 0.01 * i;
+      cell_matrix(0, 1) = cell_matrix(1, 0) = -1. - 0.01 * i;
+      cell_rhs(0)                           = 1.;
+      cell_rhs(1)                           = 0.5;
+      local_dof_indices[0]                  = i;
+      local_dof_indices[1]                  = i + 1;
+      constraints.distribute_local_to_global(
+        cell_matrix, cell_rhs, local_dof_indices, matrix, rhs);
+      compact_constraints.distribute_local_to_global(
+        cell_matrix, cell_rhs, local_dof_indices, compact_matrix, compact_rhs);
+    }
+  compact_matrix.add(-1., matrix);
+  deallog << "distribute_local_to_global: "
+          << compact_matrix.frobenius_norm() << ' '
+          << difference(rhs, compact_rhs) << std::endl;
+
+  // condense() on an assembled matrix and vector
+  matrix.reinit(sparsity);
+  compact_matrix.reinit(sparsity);
+  for (unsigned int i = 0; i < n; ++i)
+    for (auto entry = matrix.begin(i); entry != matrix.end(i); ++entry)
+      {
+        entry->value() = 1. + (entry->column() == i ? i : 0.);
+        compact_matrix.set(i, entry->column(), entry->value());
+      }
+  for (unsigned int i = 0; i < n; ++i)
+    rhs(i) = compact_rhs(i) = 1. + std::cos(1. * i);
+  constraints.condense(matrix, rhs);
+  compact_constraints.condense(compact_matrix, compact_rhs);
+  compact_matrix.add(-1., matrix);
+  deallog << "condense: " << compact_matrix.frobenius_norm() << ' '
+          << difference(rhs, compact_rhs) << std::endl;
+
+  // modify the closed objects: they need to be expanded and compacted again
+  AffineConstraints<double> other;
+  other.add_line(n + 1);
+  other.add_entry(n + 1, 1, 2.);
+  other.close();
+  constraints.merge(other,
+                    AffineConstraints<double>::no_conflicts_allowed,
+                    true);
+  compact_constraints.merge(other,
+                            AffineConstraints<double>::no_conflicts_allowed,
+                            true);
+  constraints.shift(5);
+  compact_constraints.shift(5);
+  {
+    std::ostringstream out, compact_out;
+    constraints.print(out);
+    compact_constraints.print(compact_out);
+    AssertThrow(out.str() == compact_out.str(), ExcInternalError());
+  }
+
+  // copy into an object without compact storage, and finally switch off
+  // compact storage
+  AffineConstraints<double> copy;
+  copy.copy_from(compact_constraints);
+  {
+    std::ostringstream out, copy_out;
+    constraints.print(out);
+    copy.print(copy_out);
+    AssertThrow(out.str() == copy_out.str(), ExcInternalError());
+  }
+  compact_constraints.set_compact_storage(false);
+  AssertThrow(compact_constraints.get_lines().size() ==
+                constraints.n_constraints(),
+              ExcInternalError());
+
+  deallog << "OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
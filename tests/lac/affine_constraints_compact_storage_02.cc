@@ -0,0 +1,94 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check that AffineConstraints::get_lines() and
+// AffineConstraints::get_constraint_entries() return the entries stored in
+// compact form, both on the compacted object and after switching the compact
+// storage off, and compare with an object that never used compact storage
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+
+void
+fill_constraints(AffineConstraints<double> &constraints)
+{
+  constraints.add_line(1);
+  constraints.add_entry(1, 0, 0.5);
+  constraints.add_entry(1, 2, 0.5);
+  constraints.add_line(4);
+  constraints.add_entry(4, 1, 2.);
+  constraints.add_line(6);
+  constraints.set_inhomogeneity(6, 1.5);
+}
+
+
+
+void
+print_entries(const AffineConstraints<double> &constraints)
+{
+  deallog << "get_lines() with " << constraints.get_lines().size()
+          << " lines" << std::endl;
+  for (const auto &line : constraints.get_lines())
+    {
+      deallog << line.index << ':';
+      for (const auto &entry : line.entries)
+        deallog << ' ' << entry.first << " (" << entry.second << ')';
+      deallog << " - " << line.inhomogeneity << std::endl;
+    }
+
+  deallog << "get_constraint_entries():" << std::endl;
+  for (unsigned int i = 0; i < 8; ++i)
+    if (const auto entries = constraints.get_constraint_entries(i))
+      {
+        deallog << i << ':';
+        for (const auto &entry : *entries)
+          deallog << ' ' << entry.first << " (" << entry.second << ')';
+        deallog << std::endl;
+      }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  AffineConstraints<double> constraints;
+  fill_constraints(constraints);
+  constraints.set_compact_storage(true);
+  constraints.close();
+
+  deallog.push("compact");
+  print_entries(constraints);
+  deallog.pop();
+
+  constraints.set_compact_storage(false);
+  deallog.push("expanded");
+  print_entries(constraints);
+  deallog.pop();
+
+  // compare with an object that never used compact storage
+  AffineConstraints<double> reference;
+  fill_constraints(reference);
+  reference.close();
+  deallog.push("reference");
+  print_entries(reference);
+  deallog.pop();
+}
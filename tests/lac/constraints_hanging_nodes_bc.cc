@@ -114,7 +114,7 @@ test()
                     library_constraints.is_constrained(i),
                   ExcInternalError());
       using constraint_format =
-        const std::vector<std::pair<types::global_dof_index, double>> &;
+        const ArrayView<const std::pair<types::global_dof_index, double>>;
       if (correct_constraints.is_constrained(i))
         {
           constraint_format correct =
@@ -0,0 +1,72 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// check LinearAlgebra::distributed::Vector::copy_locally_owned_data_from()
+// and LinearAlgebra::distributed::Vector::add_locally_owned_data_from() with
+// different number types, using vector sizes that are not multiples of the
+// SIMD width
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "../tests.h"
+
+
+template <typename Number, typename Number2>
+void
+test(const unsigned int size)
+{
+  LinearAlgebra::distributed::Vector<Number2> src(size);
+  LinearAlgebra::distributed::Vector<Number>  dst(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      src.local_element(i) = 0.5 * i - 7.;
+      dst.local_element(i) = i;
+    }
+
+  dst.add_locally_owned_data_from(-2., src);
+  for (unsigned int i = 0; i < size; ++i)
+    AssertThrow(dst.local_element(i) == Number(14.), ExcInternalError());
+
+  dst.copy_locally_owned_data_from(src);
+  for (unsigned int i = 0; i < size; ++i)
+    AssertThrow(dst.local_element(i) == Number(src.local_element(i)),
+                ExcInternalError());
+
+  deallog << "OK size " << size << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  initlog();
+
+  for (const unsigned int size : {1U, 7U, 16U, 37U, 1000U})
+    {
+      deallog.push("float<-double");
+      test<float, double>(size);
+      deallog.pop();
+      deallog.push("double<-float");
+      test<double, float>(size);
+      deallog.pop();
+      deallog.push("double<-double");
+      test<double, double>(size);
+      deallog.pop();
+    }
+}
@@ -0,0 +1,166 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+// Check that SparseMatrixScatter gives the same matrix as
+// AffineConstraints::distribute_local_to_global() on a mesh with hanging
+// nodes and boundary constraints, both cell by cell and for batches of cells
+// with one and several threads. Some of the cell matrices have zero diagonal
+// entries or are zero altogether, to check the treatment of the diagonal
+// entries of constrained rows.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_scatter.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "../tests.h"
+
+
+
+double
+max_difference(const SparseMatrix<double> &reference,
+               const SparseMatrix<double> &matrix)
+{
+  double difference = 0;
+  for (const auto &entry : reference)
+    difference = std::max(difference,
+                          std::abs(entry.value() -
+                                   matrix(entry.row(), entry.column())));
+  return difference / reference.linfty_norm();
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(dim == 2 ? 4 : 2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  DoFTools::make_zero_boundary_constraints(dof, 0, constraints);
+  constraints.close();
+  deallog << "n_dofs=" << dof.n_dofs()
+          << ", n_constraints=" << constraints.n_constraints() << std::endl;
+
+  DynamicSparsityPattern dsp(dof.n_dofs());
+  DoFTools::make_sparsity_pattern(dof, dsp, constraints, false);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+
+  std::vector<FullMatrix<double>> cell_matrices(
+    tria.n_active_cells(),
+    FullMatrix<double>(fe.n_dofs_per_cell(), fe.n_dofs_per_cell()));
+  std::vector<unsigned int> cell_indices(tria.n_active_cells());
+  for (unsigned int c = 0; c < cell_matrices.size(); ++c)
+    {
+      cell_indices[c] = c;
+      if (c % 7 == 3)
+        continue;
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        for (unsigned int j = 0; j < fe.n_dofs_per_cell(); ++j)
+          cell_matrices[c](i, j) = random_value<double>(-1., 1.);
+      if (c % 3 == 1)
+        for (unsigned int i = 0; i < fe.n_dofs_per_cell(); i += 2)
+          cell_matrices[c](i, i) = 0;
+    }
+
+  SparseMatrix<double> reference(sparsity);
+  std::vector<types::global_dof_index> local_dof_indices(
+    fe.n_dofs_per_cell());
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      cell->get_dof_indices(local_dof_indices);
+      constraints.distribute_local_to_global(
+        cell_matrices[cell->active_cell_index()],
+        local_dof_indices,
+        reference);
+    }
+
+  SparseMatrixScatter<double> scatter;
+  scatter.reinit(constraints, sparsity, tria.n_active_cells());
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      cell->get_dof_indices(local_dof_indices);
+      scatter.add_cell(cell->active_cell_index(), local_dof_indices);
+    }
+
+  SparseMatrix<double> matrix(sparsity);
+  for (const unsigned int c : cell_indices)
+    scatter.distribute_local_to_global(c, cell_matrices[c], matrix);
+  deallog << "cell by cell: "
+          << (max_difference(reference, matrix) < 1e-14 ? "ok" : "failed")
+          << std::endl;
+
+  for (const unsigned int n_threads : {1, 4})
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+
+      SparseMatrix<double> matrix(sparsity);
+      const unsigned int   batch_size = 64;
+      for (unsigned int c = 0; c < cell_indices.size(); c += batch_size)
+        {
+          const unsigned int n =
+            std::min<unsigned int>(batch_size, cell_indices.size() - c);
+          scatter.distribute_local_to_global(
+            make_array_view(cell_indices.data() + c,
+                            cell_indices.data() + c + n),
+            make_array_view(cell_matrices.data() + c,
+                            cell_matrices.data() + c + n),
+            matrix);
+        }
+      deallog << "batches, " << n_threads << " threads: "
+              << (max_difference(reference, matrix) < 1e-14 ? "ok" : "failed")
+              << std::endl;
+    }
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>();
+  check<3>();
+}
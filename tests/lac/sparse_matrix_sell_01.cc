@@ -0,0 +1,163 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check SparseMatrixSELL::vmult, Tvmult, vmult_add, Tvmult_add and
+// precondition_Jacobi against the respective functions of SparseMatrix, for
+// a nine-point stencil and a matrix with rows of very different length,
+// including empty rows
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename number, typename number2>
+void
+check(const SparseMatrix<number> &A, const unsigned int sorting_scope)
+{
+  const SparseMatrixSELL<number> B(A, sorting_scope);
+  AssertDimension(A.m(), B.m());
+  AssertDimension(A.n(), B.n());
+  AssertDimension(A.n_nonzero_elements(), B.n_nonzero_elements());
+  AssertThrow(B.n_stored_elements() >= B.n_nonzero_elements(),
+              ExcInternalError());
+
+  const double tolerance =
+    (std::is_same_v<number, float> || std::is_same_v<number2, float>) ? 1e-5 :
+                                                                       1e-12;
+
+  Vector<number2> src(A.n()), src_t(A.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<number2>();
+  for (unsigned int i = 0; i < src_t.size(); ++i)
+    src_t(i) = random_value<number2>();
+
+  Vector<number2> dst_ref(A.m()), dst(A.m());
+  A.vmult(dst_ref, src);
+  B.vmult(dst, src);
+  dst -= dst_ref;
+  deallog << "vmult:      "
+          << (dst.linfty_norm() <= tolerance * dst_ref.linfty_norm() ? "OK" :
+                                                                        "FAILED")
+          << std::endl;
+
+  dst = 1.;
+  dst_ref = 1.;
+  A.vmult_add(dst_ref, src);
+  B.vmult_add(dst, src);
+  dst -= dst_ref;
+  deallog << "vmult_add:  "
+          << (dst.linfty_norm() <= tolerance * dst_ref.linfty_norm() ? "OK" :
+                                                                        "FAILED")
+          << std::endl;
+
+  Vector<number2> dst_t_ref(A.n()), dst_t(A.n());
+  A.Tvmult(dst_t_ref, src_t);
+  B.Tvmult(dst_t, src_t);
+  dst_t -= dst_t_ref;
+  deallog << "Tvmult:     "
+          << (dst_t.linfty_norm() <= tolerance * dst_t_ref.linfty_norm() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+
+  dst_t     = 1.;
+  dst_t_ref = 1.;
+  A.Tvmult_add(dst_t_ref, src_t);
+  B.Tvmult_add(dst_t, src_t);
+  dst_t -= dst_t_ref;
+  deallog << "Tvmult_add: "
+          << (dst_t.linfty_norm() <= tolerance * dst_t_ref.linfty_norm() ?
+                "OK" :
+                "FAILED")
+          << std::endl;
+}
+
+
+
+template <typename number>
+void
+test()
+{
+  deallog << "Nine-point stencil" << std::endl;
+  {
+    FDMatrix        testproblem(7, 9);
+    SparsityPattern structure((7 - 1) * (9 - 1), (7 - 1) * (9 - 1), 9);
+    testproblem.nine_point_structure(structure);
+    structure.compress();
+    SparseMatrix<number> A(structure);
+    testproblem.nine_point(A, true);
+
+    for (const unsigned int sorting_scope : {1U, 16U, 1000U})
+      {
+        deallog << "Sorting scope " << sorting_scope << std::endl;
+        check<number, double>(A, sorting_scope);
+        check<number, float>(A, sorting_scope);
+      }
+
+    const SparseMatrixSELL<number> B(A);
+    Vector<double>                 src(A.m()), dst(A.m()), dst_ref(A.m());
+    for (unsigned int i = 0; i < src.size(); ++i)
+      src(i) = random_value<double>();
+    A.precondition_Jacobi(dst_ref, src, 0.8);
+    B.precondition_Jacobi(dst, src, 0.8);
+    dst -= dst_ref;
+    deallog << "Jacobi:     " << (dst.linfty_norm() < 1e-5 ? "OK" : "FAILED")
+            << std::endl;
+  }
+
+  deallog << "Rows of different length" << std::endl;
+  {
+    const unsigned int m = 37, n = 29;
+    SparsityPattern    structure(m, n, n);
+    for (unsigned int i = 0; i < m; ++i)
+      if (i % 5 != 3)
+        for (unsigned int j = 0; j < n; ++j)
+          if ((i * 7 + j * 3) % (2 + i % 9) == 0)
+            structure.add(i, j);
+    structure.compress();
+    SparseMatrix<number> A(structure);
+    for (unsigned int i = 0; i < m; ++i)
+      for (auto entry = A.begin(i); entry != A.end(i); ++entry)
+        entry->value() = random_value<number>();
+
+    for (const unsigned int sorting_scope : {1U, 16U, 1000U})
+      {
+        deallog << "Sorting scope " << sorting_scope << std::endl;
+        check<number, double>(A, sorting_scope);
+      }
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("double");
+  test<double>();
+  deallog.pop();
+  deallog.push("float");
+  test<float>();
+  deallog.pop();
+}
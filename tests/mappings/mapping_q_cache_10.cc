@@ -0,0 +1,172 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Test MappingQCache with support points stored in single precision and the
+// update of the support points of a subset of the cells
+
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+// Give access to the support points of MappingQ
+template <int dim>
+class MappingQWithSupportPoints : public MappingQ<dim>
+{
+public:
+  using MappingQ<dim>::MappingQ;
+  using MappingQ<dim>::compute_mapping_support_points;
+};
+
+
+
+template <int dim>
+double
+max_difference(const MappingQCache<dim>      &mapping_1,
+               const MappingQCache<dim>      &mapping_2,
+               const Triangulation<dim>      &tria,
+               const std::set<CellId>        &cells,
+               const bool                     in_set,
+               const std::vector<Point<dim>> &unit_points)
+{
+  double difference = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if ((cells.find(cell->id()) != cells.end()) == in_set)
+      for (const auto &p : unit_points)
+        difference =
+          std::max(difference,
+                   (mapping_1.transform_unit_to_real_cell(cell, p) -
+                    mapping_2.transform_unit_to_real_cell(cell, p))
+                     .norm());
+  return difference;
+}
+
+
+
+template <int dim>
+void
+do_test(const unsigned int degree)
+{
+  Triangulation<dim> tria;
+  if (dim > 1)
+    GridGenerator::hyper_ball(tria);
+  else
+    GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(1);
+
+  std::vector<Point<dim>> unit_points(2);
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      unit_points[0][d] = 0.2 + d * 0.15;
+      unit_points[1][d] = 0.5;
+    }
+
+  MappingQWithSupportPoints<dim> mapping(degree);
+  MappingQCache<dim>             mapping_double(degree);
+  MappingQCache<dim>             mapping_single(degree, true);
+  mapping_double.initialize(mapping, tria);
+  mapping_single.initialize(mapping, tria);
+
+  deallog << "Testing degree " << degree << " in " << dim << 'D' << std::endl;
+  deallog << "single vs double precision below 1e-6: "
+          << (max_difference(mapping_double,
+                             mapping_single,
+                             tria,
+                             {},
+                             false,
+                             unit_points) < 1e-6)
+          << std::endl;
+  deallog << "memory of single less than double: "
+          << (mapping_single.memory_consumption() <
+              mapping_double.memory_consumption())
+          << std::endl;
+
+  // move every other active cell, as in a mesh deformation where only
+  // some cells move
+  std::vector<typename Triangulation<dim>::cell_iterator> moving_cells;
+  std::set<CellId>                                        moving_cell_ids;
+  unsigned int                                            counter = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (counter++ % 2 == 0)
+      {
+        moving_cells.push_back(cell);
+        moving_cell_ids.insert(cell->id());
+      }
+
+  Tensor<1, dim> shift;
+  shift[0] = 0.1;
+  const auto shifted_points =
+    [&](const typename Triangulation<dim>::cell_iterator &cell) {
+      std::vector<Point<dim>> points =
+        mapping.compute_mapping_support_points(cell);
+      for (auto &p : points)
+        p += shift;
+      return points;
+    };
+
+  MappingQCache<dim> mapping_reference(degree);
+  mapping_reference.initialize(
+    tria,
+    [&](const typename Triangulation<dim>::cell_iterator &cell) {
+      if (moving_cell_ids.find(cell->id()) != moving_cell_ids.end())
+        return shifted_points(cell);
+      else
+        return mapping.compute_mapping_support_points(cell);
+    });
+
+  MappingQCache<dim> mapping_copy(mapping_double);
+  mapping_double.update(moving_cells, shifted_points);
+  mapping_single.update(moving_cells, shifted_points);
+
+  for (const bool moved : {true, false})
+    deallog << (moved ? "moved" : "fixed") << " cells equal reference: "
+            << (max_difference(mapping_double,
+                               mapping_reference,
+                               tria,
+                               moving_cell_ids,
+                               moved,
+                               unit_points) < 1e-12)
+            << ", single precision: "
+            << (max_difference(mapping_single,
+                               mapping_reference,
+                               tria,
+                               moving_cell_ids,
+                               moved,
+                               unit_points) < 1e-6)
+            << ", copy: "
+            << (max_difference(mapping_copy,
+                               mapping_reference,
+                               tria,
+                               moving_cell_ids,
+                               moved,
+                               unit_points) < 1e-12)
+            << std::endl;
+  deallog << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+  do_test<1>(3);
+  do_test<2>(1);
+  do_test<2>(4);
+  do_test<3>(2);
+}
@@ -0,0 +1,170 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// tests that MatrixFree::AdditionalData::compute_jacobians_on_the_fly only
+// keeps the mapping support points for general cells and that the Laplace
+// operator evaluated with the Jacobians computed on the fly gives the same
+// result as with the stored Jacobians, also with reinit() on a set of cell
+// ids and for float numbers
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+apply_laplace(const MatrixFree<dim, Number>                    &mf,
+              LinearAlgebra::distributed::Vector<Number>       &dst,
+              const LinearAlgebra::distributed::Vector<Number> &src,
+              const bool                                        use_cell_ids)
+{
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::size();
+  mf.template cell_loop<LinearAlgebra::distributed::Vector<Number>,
+                        LinearAlgebra::distributed::Vector<Number>>(
+    [&](const auto &, auto &dst, const auto &src, const auto &range) {
+      FEEvaluation<dim, fe_degree, fe_degree + 1, 1, Number> phi(mf);
+      for (unsigned int cell = range.first; cell < range.second; ++cell)
+        {
+          if (use_cell_ids)
+            {
+              // go through the lanes in reverse order
+              std::array<unsigned int, n_lanes> cell_ids;
+              const unsigned int                n_filled =
+                mf.n_active_entries_per_cell_batch(cell);
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                cell_ids[v] = v < n_filled ?
+                                cell * n_lanes + n_filled - 1 - v :
+                                numbers::invalid_unsigned_int;
+              phi.reinit(cell_ids);
+            }
+          else
+            phi.reinit(cell);
+          phi.gather_evaluate(src, EvaluationFlags::gradients);
+          for (const unsigned int q : phi.quadrature_point_indices())
+            phi.submit_gradient(phi.get_gradient(q), q);
+          phi.integrate_scatter(EvaluationFlags::gradients, dst);
+        }
+    },
+    dst,
+    src,
+    true);
+}
+
+
+
+template <int dim, int fe_degree, typename Number>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 2 * dim);
+  tria.refine_global(1);
+
+  FE_Q<dim>       fe(fe_degree);
+  MappingQ<dim>   mapping(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, Number>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim, Number>::AdditionalData::none;
+
+  MatrixFree<dim, Number> mf_stored;
+  mf_stored.reinit(mapping, dof, constraints, QGauss<1>(fe_degree + 1), data);
+
+  data.compute_jacobians_on_the_fly = true;
+  MatrixFree<dim, Number> mf_on_the_fly;
+  mf_on_the_fly.reinit(
+    mapping, dof, constraints, QGauss<1>(fe_degree + 1), data);
+
+  const auto &info_stored     = mf_stored.get_mapping_info();
+  const auto &info_on_the_fly = mf_on_the_fly.get_mapping_info();
+  AssertDimension(info_stored.cell_support_points.size(), 0);
+  Assert(info_on_the_fly.cell_support_points.size() > 0, ExcInternalError());
+  Assert(info_on_the_fly.cell_data[0].jacobians[0].size() <
+           info_stored.cell_data[0].jacobians[0].size(),
+         ExcInternalError());
+  for (unsigned int cell = 0; cell < mf_on_the_fly.n_cell_batches(); ++cell)
+    AssertThrow(info_on_the_fly.has_cell_geometry_on_the_fly(cell) ==
+                  (info_on_the_fly.get_cell_type(cell) >
+                   internal::MatrixFreeFunctions::affine),
+                ExcInternalError());
+  deallog << "Memory reduction: "
+          << (info_on_the_fly.memory_consumption() <
+              info_stored.memory_consumption() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<Number> src, dst_stored, dst_on_the_fly;
+  mf_stored.initialize_dof_vector(src);
+  mf_stored.initialize_dof_vector(dst_stored);
+  mf_stored.initialize_dof_vector(dst_on_the_fly);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = random_value<Number>();
+
+  for (const bool use_cell_ids : {false, true})
+    {
+      apply_laplace<dim, fe_degree>(mf_stored, dst_stored, src, use_cell_ids);
+      apply_laplace<dim, fe_degree>(mf_on_the_fly,
+                                    dst_on_the_fly,
+                                    src,
+                                    use_cell_ids);
+      dst_on_the_fly -= dst_stored;
+      const double tolerance = std::is_same_v<Number, float> ? 1e-5 : 1e-12;
+      deallog << "Relative difference "
+              << (use_cell_ids ? "reinit(cell_ids): " : "reinit(cell): ")
+              << (dst_on_the_fly.linfty_norm() <
+                      tolerance * dst_stored.linfty_norm() ?
+                    "ok" :
+                    "wrong")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2, 3, double>();
+  test<2, 4, float>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3, 3, double>();
+  test<3, 2, float>();
+  deallog.pop();
+}
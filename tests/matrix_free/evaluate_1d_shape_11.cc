@@ -0,0 +1,180 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check the correctness of the 1d evaluation functions used in FEEvaluation,
+// path evaluate_evenodd_partial, for matrices where only some of the pairs
+// of columns (quadrature points) are symmetric, with both templated and
+// run-time sizes
+
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <iostream>
+
+#include "../tests.h"
+
+
+template <int M, int N, int type, bool add, bool templated>
+void
+test(const std::vector<unsigned char> &symmetric_pairs)
+{
+  deallog << "Test " << M << " x " << N << std::endl;
+  AlignedVector<double> shape(M * N);
+  for (unsigned int i = 0; i < M; ++i)
+    for (unsigned int j = 0; j < N; ++j)
+      shape[i * N + j] = -1. + 2. * random_value<double>();
+
+  // make the selected pairs of columns symmetric (values, Hessians) or
+  // skew-symmetric (gradients)
+  for (unsigned int j = 0; j < N / 2; ++j)
+    if (symmetric_pairs[j])
+      for (unsigned int i = 0; i < M; ++i)
+        shape[(M - 1 - i) * N + N - 1 - j] =
+          (type == 1 ? -1. : 1.) * shape[i * N + j];
+
+  // convert to the partial even-odd format
+  AlignedVector<double> shape_eo(M * N);
+  for (unsigned int i = 0; i < M / 2; ++i)
+    for (unsigned int j = 0; j < N; ++j)
+      {
+        shape_eo[i * N + j] =
+          0.5 * (shape[i * N + j] + shape[(M - 1 - i) * N + j]);
+        shape_eo[(M - 1 - i) * N + j] =
+          0.5 * (shape[i * N + j] - shape[(M - 1 - i) * N + j]);
+      }
+  if (M % 2 == 1)
+    for (unsigned int j = 0; j < N; ++j)
+      shape_eo[M / 2 * N + j] = shape[M / 2 * N + j];
+
+  double x[N], x_ref[N], y[M], y_ref[M];
+  for (unsigned int i = 0; i < N; ++i)
+    x[i] = random_value<double>();
+
+  // compute reference
+  for (unsigned int i = 0; i < M; ++i)
+    {
+      y[i]     = 1.;
+      y_ref[i] = add ? y[i] : 0.;
+      for (unsigned int j = 0; j < N; ++j)
+        y_ref[i] += shape[i * N + j] * x[j];
+    }
+
+  // apply function for tensor product
+  internal::EvaluatorTensorProductPartialEvenOdd<1,
+                                                 templated ? M : 0,
+                                                 templated ? N : 0,
+                                                 double>
+    evaluator(shape_eo, shape_eo, shape_eo, symmetric_pairs, M, N);
+  if (type == 0)
+    evaluator.template values<0, false, add>(x, y);
+  if (type == 1)
+    evaluator.template gradients<0, false, add>(x, y);
+  if (type == 2)
+    evaluator.template hessians<0, false, add>(x, y);
+
+  deallog << "Errors no transpose: ";
+  for (unsigned int i = 0; i < M; ++i)
+    deallog << filter_out_small_numbers(y[i] - y_ref[i], 1e-12) << ' ';
+  deallog << std::endl;
+
+
+  for (unsigned int i = 0; i < M; ++i)
+    y[i] = random_value<double>();
+
+  // compute reference
+  for (unsigned int i = 0; i < N; ++i)
+    {
+      x[i]     = 2.;
+      x_ref[i] = add ? x[i] : 0.;
+      for (unsigned int j = 0; j < M; ++j)
+        x_ref[i] += shape[j * N + i] * y[j];
+    }
+
+  // apply function for tensor product
+  if (type == 0)
+    evaluator.template values<0, true, add>(y, x);
+  if (type == 1)
+    evaluator.template gradients<0, true, add>(y, x);
+  if (type == 2)
+    evaluator.template hessians<0, true, add>(y, x);
+
+  deallog << "Errors transpose:    ";
+  for (unsigned int i = 0; i < N; ++i)
+    deallog << filter_out_small_numbers(x[i] - x_ref[i], 1e-12) << ' ';
+  deallog << std::endl;
+}
+
+
+
+template <int type, bool add, bool templated>
+void
+test_all()
+{
+  test<4, 4, type, add, templated>({1, 0});
+  test<3, 3, type, add, templated>({1});
+  test<4, 5, type, add, templated>({0, 1});
+  test<3, 6, type, add, templated>({1, 0, 1});
+  test<5, 7, type, add, templated>({0, 1, 1});
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("values");
+  test_all<0, false, true>();
+  deallog.pop();
+
+  deallog.push("gradients");
+  test_all<1, false, true>();
+  deallog.pop();
+
+  deallog.push("hessians");
+  test_all<2, false, true>();
+  deallog.pop();
+
+  deallog.push("add");
+
+  deallog.push("values");
+  test_all<0, true, true>();
+  deallog.pop();
+
+  deallog.push("gradients");
+  test_all<1, true, true>();
+  deallog.pop();
+
+  deallog.push("hessians");
+  test_all<2, true, true>();
+  deallog.pop();
+
+  deallog.pop();
+
+  deallog.push("runtime");
+
+  deallog.push("values");
+  test_all<0, false, false>();
+  deallog.pop();
+
+  deallog.push("gradients");
+  test_all<1, true, false>();
+  deallog.pop();
+
+  deallog.pop();
+
+  return 0;
+}
@@ -0,0 +1,236 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check FEEvaluation::evaluate() and FEEvaluation::integrate() for a
+// quadrature formula that is only partly symmetric, which selects the
+// partial even-odd kernels, against FEValues. Both the variant with the
+// polynomial degree as template argument and the one with the degree given
+// at run time are tested. Furthermore, check that ShapeInfo falls back to
+// the general kernel for sizes that the partial even-odd kernel with sizes
+// given at run time does not support.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include "../tests.h"
+
+
+
+// QGauss formula where the innermost pair of points is moved off the
+// symmetric position
+Quadrature<1>
+create_quadrature(const unsigned int n_points)
+{
+  QGauss<1>             gauss(n_points);
+  std::vector<Point<1>> points = gauss.get_points();
+  const unsigned int    index  = n_points / 2 - 1;
+  points[index][0] += 0.25 * (points[index + 1][0] - points[index][0]);
+  return Quadrature<1>(points, gauss.get_weights());
+}
+
+
+
+template <int dim, int fe_degree, int n_q_points_1d>
+void
+evaluate_and_integrate(const Mapping<dim>            &mapping,
+                       const MatrixFree<dim, double> &matrix_free,
+                       const Vector<double>          &src,
+                       Vector<double>                &dst,
+                       Vector<double>                &dst_reference,
+                       double                        &error_values,
+                       double                        &error_gradients)
+{
+  const FiniteElement<dim> &fe = matrix_free.get_dof_handler().get_fe();
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          Quadrature<dim>(matrix_free.get_quadrature(0)),
+                          update_values | update_gradients | update_JxW_values);
+
+  FEEvaluation<dim, fe_degree, n_q_points_1d, 1, double> phi(matrix_free);
+
+  std::vector<double>         values(fe_values.n_quadrature_points);
+  std::vector<Tensor<1, dim>> gradients(fe_values.n_quadrature_points);
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  dst           = 0;
+  dst_reference = 0;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        {
+          const auto dof_cell = matrix_free.get_cell_iterator(cell, v);
+          fe_values.reinit(dof_cell);
+          fe_values.get_function_values(src, values);
+          fe_values.get_function_gradients(src, gradients);
+          dof_cell->get_dof_indices(dof_indices);
+
+          for (const unsigned int q : fe_values.quadrature_point_indices())
+            {
+              error_values =
+                std::max(error_values,
+                         std::abs(phi.get_value(q)[v] - values[q]));
+              for (unsigned int d = 0; d < dim; ++d)
+                error_gradients =
+                  std::max(error_gradients,
+                           std::abs(phi.get_gradient(q)[d][v] -
+                                    gradients[q][d]));
+            }
+
+          // test the function values and gradients against the test
+          // functions
+          for (const unsigned int i : fe_values.dof_indices())
+            {
+              double sum = 0;
+              for (const unsigned int q : fe_values.quadrature_point_indices())
+                sum += (values[q] * fe_values.shape_value(i, q) +
+                        gradients[q] * fe_values.shape_grad(i, q)) *
+                       fe_values.JxW(q);
+              dst_reference(dof_indices[i]) += sum;
+            }
+        }
+
+      for (const unsigned int q : phi.quadrature_point_indices())
+        {
+          phi.submit_value(phi.get_value(q), q);
+          phi.submit_gradient(phi.get_gradient(q), q);
+        }
+      phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, int n_q_points_1d>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(dim == 2 ? 2 : 1);
+  GridTools::distort_random(0.15, tria, false, 42);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  MatrixFree<dim, double>                          matrix_free;
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_JxW_values;
+  const MappingQ<dim> mapping(1);
+  matrix_free.reinit(mapping,
+                     dof_handler,
+                     constraints,
+                     create_quadrature(n_q_points_1d),
+                     additional_data);
+
+  Vector<double> src(dof_handler.n_dofs());
+  for (auto &value : src)
+    value = random_value<double>();
+
+  deallog << fe.get_name() << " with " << n_q_points_1d << " points, "
+          << "element type "
+          << static_cast<unsigned int>(
+               matrix_free.get_shape_info().element_type)
+          << std::endl;
+
+  Vector<double> dst(src.size()), dst_reference(src.size());
+  for (const bool runtime_degree : {false, true})
+    {
+      double error_values = 0, error_gradients = 0;
+      if (runtime_degree)
+        evaluate_and_integrate<dim, -1, 0>(mapping,
+                                           matrix_free,
+                                           src,
+                                           dst,
+                                           dst_reference,
+                                           error_values,
+                                           error_gradients);
+      else
+        evaluate_and_integrate<dim, fe_degree, n_q_points_1d>(mapping,
+                                                              matrix_free,
+                                                              src,
+                                                              dst,
+                                                              dst_reference,
+                                                              error_values,
+                                                              error_gradients);
+      dst -= dst_reference;
+      deallog << (runtime_degree ? "run time degree: " : "template degree: ")
+              << "values ok: " << (error_values < 1e-12)
+              << ", gradients ok: " << (error_gradients < 1e-10)
+              << ", integrate ok: "
+              << (dst.linfty_norm() < 1e-11 * dst_reference.linfty_norm())
+              << std::endl;
+    }
+}
+
+
+
+void
+test_fallback(const unsigned int degree)
+{
+  internal::MatrixFreeFunctions::ShapeInfo<double> shape_info;
+  shape_info.reinit(create_quadrature(degree + 2), FE_DGQ<1>(degree));
+  deallog << "FE_DGQ<1>(" << degree << ") with " << degree + 2
+          << " points, element type "
+          << static_cast<unsigned int>(shape_info.element_type) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 2, 4>(FE_Q<2>(2));
+  test<2, 3, 5>(FE_Q<2>(3));
+  test<2, 4, 6>(FE_DGQ<2>(4));
+  test<3, 2, 4>(FE_Q<3>(2));
+  test<3, 3, 5>(FE_DGQ<3>(3));
+
+  // the temporary arrays of the partial even-odd kernel hold 16 pairs, so
+  // degree 31 with 33 points is the largest case that can use it
+  test_fallback(31);
+  test_fallback(32);
+}
@@ -0,0 +1,345 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// check the vmult() of MatrixFreeOperators::Base with operations before and
+// after the matrix-vector product against a plain vmult() with the vector
+// operations run separately, on a mesh with hanging nodes and for the serial
+// and the threaded loop. The operators are MassOperator and LaplaceOperator
+// as well as a user operator with and without an override of
+// apply_interleaved(). Furthermore, compare SolverCG with the interleaved
+// vector updates against SolverCG with separate vector updates.
+
+#include <deal.II/base/function.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_cg.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+
+// A Helmholtz operator that only implements apply_add(), such that vmult()
+// with the vector operations uses the default implementation of
+// apply_interleaved()
+template <int dim, int fe_degree>
+class HelmholtzOperator : public MatrixFreeOperators::Base<dim, VectorType>
+{
+public:
+  virtual void
+  compute_diagonal() override
+  {
+    this->inverse_diagonal_entries =
+      std::make_shared<DiagonalMatrix<VectorType>>();
+    VectorType &inverse_diagonal =
+      this->inverse_diagonal_entries->get_vector();
+    this->initialize_dof_vector(inverse_diagonal);
+
+    const std::function<void(FEEvaluation<dim, fe_degree> &)> quadrature =
+      &HelmholtzOperator::do_quadrature;
+    MatrixFreeTools::compute_diagonal(*this->data,
+                                      inverse_diagonal,
+                                      quadrature,
+                                      this->selected_rows[0]);
+    this->set_constrained_entries_to_one(inverse_diagonal);
+    for (double &entry : inverse_diagonal)
+      entry = 1. / entry;
+  }
+
+  void
+  local_apply_cell(
+    const MatrixFree<dim, double>               &data,
+    VectorType                                  &dst,
+    const VectorType                            &src,
+    const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree> phi(data, this->selected_rows[0]);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        do_quadrature(phi);
+        phi.distribute_local_to_global(dst);
+      }
+  }
+
+protected:
+  virtual void
+  apply_add(VectorType &dst, const VectorType &src) const override
+  {
+    this->data->cell_loop(&HelmholtzOperator::local_apply_cell, this, dst, src);
+  }
+
+  static void
+  do_quadrature(FEEvaluation<dim, fe_degree> &phi)
+  {
+    phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+    for (const unsigned int q : phi.quadrature_point_indices())
+      {
+        phi.submit_value(phi.get_value(q), q);
+        phi.submit_gradient(phi.get_gradient(q), q);
+      }
+    phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+  }
+};
+
+
+
+// The same operator with the vector operations interleaved with the cell
+// loop
+template <int dim, int fe_degree>
+class HelmholtzOperatorInterleaved : public HelmholtzOperator<dim, fe_degree>
+{
+protected:
+  virtual void
+  apply_interleaved(
+    VectorType       &dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const override
+  {
+    this->data->cell_loop(
+      &HelmholtzOperator<dim, fe_degree>::local_apply_cell,
+      static_cast<const HelmholtzOperator<dim, fe_degree> *>(this),
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+};
+
+
+
+// Hide the vmult() with the vector operations of the operator, such that
+// SolverCG runs the vector updates separately
+template <typename OperatorType>
+class NonInterleavedOperator
+{
+public:
+  NonInterleavedOperator(const OperatorType &op)
+    : op(op)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+private:
+  const OperatorType &op;
+};
+
+
+
+template <typename OperatorType>
+void
+check_operator(const std::string &name, OperatorType &op)
+{
+  op.compute_diagonal();
+
+  VectorType src, y, dst, result;
+  op.initialize_dof_vector(src);
+  op.initialize_dof_vector(y);
+  op.initialize_dof_vector(dst);
+  op.initialize_dof_vector(result);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    {
+      src.local_element(i) = random_value<double>();
+      y.local_element(i)   = random_value<double>();
+    }
+
+  // reference: update the source vector, run the plain vmult() and combine
+  // the result with the updated source vector
+  VectorType src_reference(src), dst_reference(dst), result_reference(dst);
+  src_reference.sadd(0.5, 1., y);
+  op.vmult(dst_reference, src_reference);
+  result_reference = dst_reference;
+  result_reference.add(-2., src_reference);
+
+  std::vector<unsigned int> n_calls_before(src.locally_owned_size());
+  std::vector<unsigned int> n_calls_after(src.locally_owned_size());
+  op.vmult(
+    dst,
+    src,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          src.local_element(i) =
+            0.5 * src.local_element(i) + y.local_element(i);
+          ++n_calls_before[i];
+        }
+    },
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          result.local_element(i) =
+            dst.local_element(i) - 2. * src.local_element(i);
+          ++n_calls_after[i];
+        }
+    });
+
+  bool all_entries_once = true;
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    if (n_calls_before[i] != 1 || n_calls_after[i] != 1)
+      all_entries_once = false;
+
+  src -= src_reference;
+  dst -= dst_reference;
+  result -= result_reference;
+  deallog << name << ": entries visited once: " << all_entries_once
+          << ", src ok: " << (src.linfty_norm() < 1e-14)
+          << ", dst ok: "
+          << (dst.linfty_norm() < 1e-12 * dst_reference.linfty_norm())
+          << ", result ok: "
+          << (result.linfty_norm() < 1e-12 * result_reference.linfty_norm())
+          << std::endl;
+
+  // compare the fused and the separate conjugate gradient iteration
+  VectorType rhs, solution, solution_reference;
+  op.initialize_dof_vector(rhs);
+  op.initialize_dof_vector(solution);
+  op.initialize_dof_vector(solution_reference);
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    rhs.local_element(i) = random_value<double>();
+
+  const DiagonalMatrix<VectorType> &preconditioner =
+    *op.get_matrix_diagonal_inverse();
+
+  SolverControl        control(200, 1e-10 * rhs.l2_norm(), false, false);
+  SolverCG<VectorType> solver(control);
+  solver.solve(op, solution, rhs, preconditioner);
+  const unsigned int n_iterations = control.last_step();
+
+  solver.solve(NonInterleavedOperator<OperatorType>(op),
+               solution_reference,
+               rhs,
+               preconditioner);
+
+  solution -= solution_reference;
+  deallog << name << ": CG same iterations: "
+          << (n_iterations == control.last_step()) << ", solution ok: "
+          << (solution.linfty_norm() <
+              1e-8 * solution_reference.linfty_norm())
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim>      fe(fe_degree);
+  const MappingQ1<dim> mapping;
+  DoFHandler<dim>      dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(
+    mapping, dof_handler, 0, Functions::ZeroFunction<dim>(), constraints);
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  for (const auto scheme :
+       {MatrixFree<dim, double>::AdditionalData::none,
+        MatrixFree<dim, double>::AdditionalData::partition_partition})
+    {
+      typename MatrixFree<dim, double>::AdditionalData additional_data;
+      additional_data.tasks_parallel_scheme = scheme;
+      additional_data.tasks_block_size      = 2;
+      additional_data.mapping_update_flags =
+        update_values | update_gradients | update_JxW_values;
+
+      const auto matrix_free = std::make_shared<MatrixFree<dim, double>>();
+      matrix_free->reinit(mapping,
+                          dof_handler,
+                          constraints,
+                          QGauss<1>(fe_degree + 1),
+                          additional_data);
+
+      deallog.push(scheme == MatrixFree<dim, double>::AdditionalData::none ?
+                     "serial" :
+                     "threaded");
+
+      MatrixFreeOperators::
+        MassOperator<dim, fe_degree, fe_degree + 1, 1, VectorType>
+          mass;
+      mass.initialize(matrix_free);
+      check_operator("MassOperator", mass);
+
+      MatrixFreeOperators::
+        LaplaceOperator<dim, fe_degree, fe_degree + 1, 1, VectorType>
+          laplace;
+      laplace.initialize(matrix_free);
+      check_operator("LaplaceOperator", laplace);
+
+      HelmholtzOperator<dim, fe_degree> helmholtz;
+      helmholtz.initialize(matrix_free);
+      check_operator("HelmholtzOperator", helmholtz);
+
+      HelmholtzOperatorInterleaved<dim, fe_degree> helmholtz_interleaved;
+      helmholtz_interleaved.initialize(matrix_free);
+      check_operator("HelmholtzOperatorInterleaved", helmholtz_interleaved);
+
+      deallog.pop();
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 2>();
+  test<2, 3>();
+  test<3, 2>();
+}
@@ -0,0 +1,154 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// test the detection of quadrature formulas that are only partly symmetric
+// in internal::MatrixFreeFunctions::ShapeInfo, and check that the
+// evaluate_evenodd_partial kernels give the same result as the
+// evaluate_general kernels in 3d
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <iostream>
+
+#include "../tests.h"
+
+
+
+// QGauss formula where the innermost pair of points is moved off the
+// symmetric position
+Quadrature<1>
+create_quadrature(const unsigned int n_points)
+{
+  QGauss<1>             gauss(n_points);
+  std::vector<Point<1>> points = gauss.get_points();
+  const unsigned int    index  = n_points / 2 - 1;
+  points[index][0] += 0.25 * (points[index + 1][0] - points[index][0]);
+  return Quadrature<1>(points, gauss.get_weights());
+}
+
+
+
+template <int n_rows, int n_columns, typename Evaluator1, typename Evaluator2>
+void
+compare(const Evaluator1 &eval_general, const Evaluator2 &eval_partial)
+{
+  constexpr int dim = 3;
+  constexpr int size =
+    Utilities::pow(n_rows > n_columns ? n_rows : n_columns, dim);
+  std::array<double, size> in, tmp1, tmp2, out1, out2;
+  for (unsigned int i = 0; i < size; ++i)
+    in[i] = random_value<double>();
+
+  // interpolate values and gradients in the three directions
+  eval_general.template values<0, true, false>(in.data(), tmp1.data());
+  eval_general.template gradients<1, true, false>(tmp1.data(), tmp2.data());
+  eval_general.template values<2, true, false>(tmp2.data(), out1.data());
+  eval_partial.template values<0, true, false>(in.data(), tmp1.data());
+  eval_partial.template gradients<1, true, false>(tmp1.data(), tmp2.data());
+  eval_partial.template values<2, true, false>(tmp2.data(), out2.data());
+
+  double error = 0;
+  double norm  = 0;
+  for (unsigned int i = 0; i < Utilities::pow(n_columns, dim); ++i)
+    {
+      error = std::max(error, std::abs(out1[i] - out2[i]));
+      norm  = std::max(norm, std::abs(out1[i]));
+    }
+  deallog << "Error evaluate:  "
+          << filter_out_small_numbers(error / norm, 1e-14) << std::endl;
+
+  // integrate
+  eval_general.template gradients<2, false, false>(in.data(), tmp1.data());
+  eval_general.template values<1, false, false>(tmp1.data(), tmp2.data());
+  eval_general.template hessians<0, false, false>(tmp2.data(), out1.data());
+  eval_partial.template gradients<2, false, false>(in.data(), tmp1.data());
+  eval_partial.template values<1, false, false>(tmp1.data(), tmp2.data());
+  eval_partial.template hessians<0, false, false>(tmp2.data(), out2.data());
+
+  error = 0;
+  norm  = 0;
+  for (unsigned int i = 0; i < Utilities::pow(n_rows, dim); ++i)
+    {
+      error = std::max(error, std::abs(out1[i] - out2[i]));
+      norm  = std::max(norm, std::abs(out1[i]));
+    }
+  deallog << "Error integrate: "
+          << filter_out_small_numbers(error / norm, 1e-14) << std::endl;
+}
+
+
+
+template <int degree, int n_q_points>
+void
+test(const FiniteElement<3> &fe)
+{
+  internal::MatrixFreeFunctions::ShapeInfo<double> shape_info;
+  shape_info.reinit(create_quadrature(n_q_points), fe);
+  deallog << "Detected shape info type for " << fe.get_name() << " with "
+          << n_q_points << " points: "
+          << static_cast<unsigned int>(shape_info.element_type) << std::endl;
+
+  const auto &data = shape_info.data.front();
+  deallog << "Symmetric pairs: ";
+  for (const unsigned char i : data.symmetric_point_pairs)
+    deallog << static_cast<unsigned int>(i) << ' ';
+  deallog << std::endl;
+
+  const internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                         3,
+                                         degree + 1,
+                                         n_q_points,
+                                         double>
+    eval_general(data.shape_values,
+                 data.shape_gradients,
+                 data.shape_hessians);
+  const internal::
+    EvaluatorTensorProductPartialEvenOdd<3, degree + 1, n_q_points, double>
+      eval_partial(data.shape_values_eo_partial,
+                   data.shape_gradients_eo_partial,
+                   data.shape_hessians_eo_partial,
+                   data.symmetric_point_pairs);
+  compare<degree + 1, n_q_points>(eval_general, eval_partial);
+
+  const internal::EvaluatorTensorProductPartialEvenOdd<3, 0, 0, double>
+    eval_partial_runtime(data.shape_values_eo_partial,
+                         data.shape_gradients_eo_partial,
+                         data.shape_hessians_eo_partial,
+                         data.symmetric_point_pairs,
+                         degree + 1,
+                         n_q_points);
+  compare<degree + 1, n_q_points>(eval_general, eval_partial_runtime);
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 4>(FE_Q<3>(2));
+  test<2, 5>(FE_DGQ<3>(2));
+  test<3, 5>(FE_Q<3>(3));
+  test<3, 6>(FE_DGQ<3>(3));
+  test<4, 7>(FE_DGQ<3>(4));
+  test<5, 7>(FE_Q<3>(5));
+}
@@ -0,0 +1,141 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// this function tests the correctness of the thread parallelization of the
+// matrix-free class with the dependency-driven partition_dynamic scheme
+
+#include <deal.II/base/function.h>
+
+#include "../tests.h"
+
+#include "create_mesh.h"
+#include "matrix_vector_common.h"
+
+
+template <int dim, int fe_degree, typename number>
+void
+sub_test()
+{
+  Triangulation<dim> tria;
+  create_mesh(tria);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  typename Triangulation<dim>::active_cell_iterator cell = tria.begin_active(),
+                                                    endc = tria.end();
+  for (; cell != endc; ++cell)
+    if (cell->center().norm() < 0.5)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+#ifndef DEBUG
+  if (dim < 3 || fe_degree < 2)
+    tria.refine_global(1);
+  tria.begin(tria.n_levels() - 1)->set_refine_flag();
+  tria.last()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  if (dim == 2 && fe_degree < 2)
+    tria.refine_global(2);
+  else
+    tria.refine_global(1);
+#endif
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  deallog << "Testing " << fe.get_name() << std::endl;
+
+  // run test for several different meshes
+  for (unsigned int i = 0; i < 8 - 2 * dim; ++i)
+    {
+      cell                 = tria.begin_active();
+      endc                 = tria.end();
+      unsigned int counter = 0;
+      for (; cell != endc; ++cell, ++counter)
+        if (counter % (9 - i) == 0)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+
+      dof.distribute_dofs(fe);
+      AffineConstraints<double> constraints;
+      DoFTools::make_hanging_node_constraints(dof, constraints);
+      VectorTools::interpolate_boundary_values(dof,
+                                               0,
+                                               Functions::ZeroFunction<dim>(),
+                                               constraints);
+      constraints.close();
+
+      MatrixFree<dim, number> mf_data, mf_data_dynamic;
+      {
+        const QGauss<1> quad(fe_degree + 1);
+        mf_data.reinit(MappingQ1<dim>{},
+                       dof,
+                       constraints,
+                       quad,
+                       typename MatrixFree<dim, number>::AdditionalData(
+                         MatrixFree<dim, number>::AdditionalData::none));
+
+        // choose block size of 3 which introduces
+        // some irregularity to the blocks (stress the
+        // non-overlapping computation harder)
+        mf_data_dynamic.reinit(
+          MappingQ1<dim>{},
+          dof,
+          constraints,
+          quad,
+          typename MatrixFree<dim, number>::AdditionalData(
+            MatrixFree<dim, number>::AdditionalData::partition_dynamic, 3));
+      }
+
+      MatrixFreeTest<dim, fe_degree, number> mf_ref(mf_data);
+      MatrixFreeTest<dim, fe_degree, number> mf_dynamic(mf_data_dynamic);
+      Vector<number>                         in_dist(dof.n_dofs());
+      Vector<number> out_dist(in_dist), out_dynamic(in_dist);
+
+      for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+        {
+          if (constraints.is_constrained(i))
+            continue;
+          const double entry = random_value<double>();
+          in_dist(i)         = entry;
+        }
+
+      mf_ref.vmult(out_dist, in_dist);
+
+      // make 10 sweeps in order to get in some
+      // variation to the threaded program
+      const double float_factor = std::is_same_v<number, float> ? 0.01 : 1.;
+      for (unsigned int sweep = 0; sweep < 10; ++sweep)
+        {
+          mf_dynamic.vmult(out_dynamic, in_dist);
+
+          out_dynamic -= out_dist;
+          const double diff_norm = out_dynamic.linfty_norm();
+          deallog << "Sweep " << sweep << ", error in partition/dynamic: "
+                  << diff_norm * float_factor << std::endl;
+        }
+      deallog << std::endl;
+    }
+  deallog << std::endl;
+}
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  deallog << "Test doubles" << std::endl;
+  sub_test<dim, fe_degree, double>();
+  deallog << "Test floats" << std::endl;
+  sub_test<dim, fe_degree, float>();
+}
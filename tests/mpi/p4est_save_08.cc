@@ -0,0 +1,154 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// save and load a triangulation with fixed and variable size data attached,
+// using the memory_mapped_checkpoint setting for either or both of save()
+// and load(). The files are the same in both modes, so all combinations need
+// to restore the same data.
+
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+std::vector<char>
+pack_fixed(
+  const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+  const CellStatus)
+{
+  const unsigned int value = cell->center()[0] * 1000 + cell->level();
+  return Utilities::pack(value, /*allow_compression=*/false);
+}
+
+
+
+template <int dim>
+std::vector<char>
+pack_variable(
+  const typename parallel::distributed::Triangulation<dim>::cell_iterator &cell,
+  const CellStatus)
+{
+  return Utilities::pack(cell->id().to_string(), /*allow_compression=*/false);
+}
+
+
+
+template <int dim>
+void
+test(const bool save_memory_mapped, const bool load_memory_mapped)
+{
+  using Tria = parallel::distributed::Triangulation<dim>;
+
+  {
+    Tria tr(MPI_COMM_WORLD,
+            Triangulation<dim>::none,
+            save_memory_mapped ? Tria::memory_mapped_checkpoint :
+                                 Tria::default_setting);
+    GridGenerator::subdivided_hyper_cube(tr, 2);
+    tr.refine_global(2);
+    for (const auto &cell : tr.active_cell_iterators())
+      if (cell->is_locally_owned() && cell->center()[0] < 0.3)
+        cell->set_refine_flag();
+    tr.execute_coarsening_and_refinement();
+
+    tr.register_data_attach(pack_fixed<dim>,
+                            /*returns_variable_size_data=*/false);
+    tr.register_data_attach(pack_variable<dim>,
+                            /*returns_variable_size_data=*/true);
+    tr.save("file");
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  {
+    Tria tr(MPI_COMM_WORLD,
+            Triangulation<dim>::none,
+            load_memory_mapped ? Tria::memory_mapped_checkpoint :
+                                 Tria::default_setting);
+    GridGenerator::subdivided_hyper_cube(tr, 2);
+    tr.load("file");
+
+    unsigned int n_checked = 0;
+    unsigned int n_errors  = 0;
+
+    const unsigned int handle_fixed =
+      tr.register_data_attach(pack_fixed<dim>,
+                              /*returns_variable_size_data=*/false);
+    tr.notify_ready_to_unpack(
+      handle_fixed,
+      [&](const typename Tria::cell_iterator &cell,
+          const CellStatus,
+          const boost::iterator_range<std::vector<char>::const_iterator>
+            &data_range) {
+        const unsigned int value =
+          Utilities::unpack<unsigned int>(data_range.begin(),
+                                          data_range.end(),
+                                          /*allow_compression=*/false);
+        if (value !=
+            static_cast<unsigned int>(cell->center()[0] * 1000 + cell->level()))
+          ++n_errors;
+        ++n_checked;
+      });
+
+    const unsigned int handle_variable =
+      tr.register_data_attach(pack_variable<dim>,
+                              /*returns_variable_size_data=*/true);
+    tr.notify_ready_to_unpack(
+      handle_variable,
+      [&](const typename Tria::cell_iterator &cell,
+          const CellStatus,
+          const boost::iterator_range<std::vector<char>::const_iterator>
+            &data_range) {
+        const std::string id =
+          Utilities::unpack<std::string>(data_range.begin(),
+                                         data_range.end(),
+                                         /*allow_compression=*/false);
+        if (id != cell->id().to_string())
+          ++n_errors;
+      });
+
+    n_checked = Utilities::MPI::sum(n_checked, MPI_COMM_WORLD);
+    n_errors  = Utilities::MPI::sum(n_errors, MPI_COMM_WORLD);
+
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+      deallog << "save memory mapped: " << save_memory_mapped
+              << ", load memory mapped: " << load_memory_mapped
+              << ", #cells = " << tr.n_global_active_cells()
+              << ", cells checked: " << n_checked << ", errors: " << n_errors
+              << std::endl;
+  }
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  test<2>(true, true);
+  test<2>(true, false);
+  test<2>(false, true);
+  test<3>(true, true);
+}
@@ -210,7 +210,8 @@ test(const unsigned numRefinementLevels = 2)
     {
       deallog << "Coordinates:" << std::endl;
       deallog << i << '@' << supportPoints[i] << std::endl;
-      for (auto c : *constraints.get_constraint_entries(i))
+      const auto entries = *constraints.get_constraint_entries(i);
+      for (auto c : entries)
         deallog << c.first << '@' << supportPoints[c.first] << std::endl;
     }
 }
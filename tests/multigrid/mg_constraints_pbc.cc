@@ -73,9 +73,13 @@ main()
       if (af_level.is_constrained(i) == false)
         continue;
 
-      Assert(*af_level.get_constraint_entries(i) ==
-               *af.get_constraint_entries(i),
-             ExcInternalError());
+      const auto entries_level = *af_level.get_constraint_entries(i);
+      const auto entries       = *af.get_constraint_entries(i);
+      AssertThrow(std::equal(entries_level.begin(),
+                             entries_level.end(),
+                             entries.begin(),
+                             entries.end()),
+                  ExcInternalError());
     }
 
 #if 0
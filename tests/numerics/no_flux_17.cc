@@ -64,16 +64,17 @@ compare_constraints(const AffineConstraints<double> &constraints1,
           return false;
         }
 
-      const std::vector<std::pair<types::global_dof_index, double>>
-        *constraint_entries_1 = constraints1.get_constraint_entries(line_index);
-      const std::vector<std::pair<types::global_dof_index, double>>
-        *constraint_entries_2 = constraints2.get_constraint_entries(line_index);
-      if (constraint_entries_1 == nullptr && constraint_entries_2 == nullptr)
+      const auto constraint_entries_1 =
+        constraints1.get_constraint_entries(line_index);
+      const auto constraint_entries_2 =
+        constraints2.get_constraint_entries(line_index);
+      if (!constraint_entries_1.has_value() &&
+          !constraint_entries_2.has_value())
         {
           return true;
         }
-      else if (constraint_entries_1 != nullptr &&
-               constraint_entries_2 != nullptr)
+      else if (constraint_entries_1.has_value() &&
+               constraint_entries_2.has_value())
         {
           if (constraint_entries_1->size() != constraint_entries_2->size() ||
               std::abs(constraints1.get_inhomogeneity(line_index) -
@@ -0,0 +1,218 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that writes a checkpoint of a
+// parallel::distributed::Triangulation with several FE_Q(2) solution vectors
+// attached via SolutionTransfer and restarts from it, once with the default
+// I/O path (MPI I/O, or streams on a single process) and once with the
+// memory_mapped_checkpoint setting. In order to make the results comparable
+// between different mesh sizes, all numbers are reported as seconds per GiB
+// of checkpoint data, i.e., the inverse of the checkpoint and restart
+// bandwidth.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/solution_transfer.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <filesystem>
+#include <iostream>
+
+#define ENABLE_MPI
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int dim       = 3;
+const unsigned int n_vectors = 4;
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+using Tria       = parallel::distributed::Triangulation<dim>;
+
+
+
+void
+create_mesh(Tria &triangulation)
+{
+  GridGenerator::subdivided_hyper_cube(triangulation, 2);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(5);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(6);
+        break;
+    }
+}
+
+
+
+// Write a checkpoint with the given triangulation settings and return the
+// wall time in seconds, including the synchronization at the end.
+double
+checkpoint(const Tria::Settings settings, const std::string &filename)
+{
+  Tria triangulation(MPI_COMM_WORLD, Triangulation<dim>::none, settings);
+  create_mesh(triangulation);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  const IndexSet locally_relevant_dofs =
+    DoFTools::extract_locally_relevant_dofs(dof_handler);
+
+  std::vector<VectorType> vectors(n_vectors);
+  for (unsigned int v = 0; v < n_vectors; ++v)
+    {
+      vectors[v].reinit(dof_handler.locally_owned_dofs(),
+                        locally_relevant_dofs,
+                        MPI_COMM_WORLD);
+      VectorTools::interpolate(dof_handler,
+                               Functions::CosineFunction<dim>(),
+                               vectors[v]);
+      vectors[v] *= 1. + v;
+      vectors[v].update_ghost_values();
+    }
+
+  std::vector<const VectorType *> vector_pointers;
+  for (const VectorType &vector : vectors)
+    vector_pointers.push_back(&vector);
+
+  SolutionTransfer<dim, VectorType> solution_transfer(dof_handler);
+  solution_transfer.prepare_for_serialization(vector_pointers);
+
+  Timer timer;
+  triangulation.save(filename);
+  MPI_Barrier(MPI_COMM_WORLD);
+  timer.stop();
+
+  debug_output << "Checkpoint with " << dof_handler.n_dofs() << " DoFs and "
+               << n_vectors << " vectors written in " << timer.wall_time()
+               << "s" << std::endl;
+
+  return timer.wall_time();
+}
+
+
+
+// Restart from the checkpoint written by checkpoint() and return the wall
+// time in seconds, including the unpacking of the vectors.
+double
+restart(const Tria::Settings settings, const std::string &filename)
+{
+  Tria triangulation(MPI_COMM_WORLD, Triangulation<dim>::none, settings);
+  GridGenerator::subdivided_hyper_cube(triangulation, 2);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(triangulation);
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  Timer timer;
+  triangulation.load(filename);
+  dof_handler.distribute_dofs(fe);
+
+  std::vector<VectorType> vectors(n_vectors);
+  for (VectorType &vector : vectors)
+    vector.reinit(dof_handler.locally_owned_dofs(), MPI_COMM_WORLD);
+
+  std::vector<VectorType *> vector_pointers;
+  for (VectorType &vector : vectors)
+    vector_pointers.push_back(&vector);
+
+  SolutionTransfer<dim, VectorType> solution_transfer(dof_handler);
+  solution_transfer.deserialize(vector_pointers);
+  MPI_Barrier(MPI_COMM_WORLD);
+  timer.stop();
+
+  debug_output << "Restart with " << dof_handler.n_dofs()
+               << " DoFs finished in " << timer.wall_time()
+               << "s, |v_0| = " << vectors[0].l2_norm() << std::endl;
+
+  return timer.wall_time();
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"checkpoint_default",
+           "checkpoint_memory_mapped",
+           "restart_default",
+           "restart_memory_mapped"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  const std::string filename = "checkpoint";
+
+  const double time_checkpoint_default =
+    checkpoint(Tria::default_setting, filename);
+  const double time_checkpoint_memory_mapped =
+    checkpoint(Tria::memory_mapped_checkpoint, filename);
+
+  // both modes write identical files, so the size of the last checkpoint
+  // serves as the data volume for all four measurements
+  double gibibytes = 0.;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    for (const char *suffix : {"_fixed.data", "_variable.data"})
+      if (std::filesystem::exists(filename + suffix))
+        gibibytes += std::filesystem::file_size(filename + suffix) /
+                     static_cast<double>(1ULL << 30);
+  gibibytes = Utilities::MPI::broadcast(MPI_COMM_WORLD, gibibytes);
+
+  const double time_restart_default = restart(Tria::default_setting, filename);
+  const double time_restart_memory_mapped =
+    restart(Tria::memory_mapped_checkpoint, filename);
+
+  debug_output << "Checkpoint size: " << gibibytes << " GiB" << std::endl
+               << std::endl;
+
+  return {time_checkpoint_default / gibibytes,
+          time_checkpoint_memory_mapped / gibibytes,
+          time_restart_default / gibibytes,
+          time_restart_memory_mapped / gibibytes};
+}
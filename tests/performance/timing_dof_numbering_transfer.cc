@@ -0,0 +1,189 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that measures the setup of the degrees of freedom
+// and the sparsity pattern after refining about two percent of the cells of a
+// 3d mesh, in a ball around a point, with FE_Q elements of degree two. We
+// compare the full setup, consisting of DoFHandler::distribute_dofs(), a
+// Cuthill-McKee renumbering, the hanging node constraints and
+// DoFTools::make_sparsity_pattern(), with the incremental one that replaces
+// the renumbering and the creation of the sparsity pattern by
+// DoFNumberingTransfer::renumber_dofs() and
+// DoFNumberingTransfer::update_sparsity_pattern().
+//
+// Status: experimental
+//
+
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_numbering_transfer.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int n_cycles = 3;
+
+
+
+template <int dim>
+void
+setup_constraints(const DoFHandler<dim>     &dof_handler,
+                  AffineConstraints<double> &constraints)
+{
+  constraints.clear();
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+}
+
+
+
+template <int dim>
+void
+setup_sparsity_pattern(const DoFHandler<dim>           &dof_handler,
+                       const AffineConstraints<double> &constraints,
+                       SparsityPattern                 &sparsity_pattern)
+{
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  sparsity_pattern.copy_from(dsp);
+}
+
+
+
+template <int dim>
+std::array<double, 2>
+run()
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(2);
+
+  GridGenerator::hyper_cube(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(5);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(6);
+        break;
+    }
+
+  // one DoFHandler that is set up from scratch after every refinement, and
+  // one that is updated incrementally
+  DoFHandler<dim>           dof_handler_full(triangulation);
+  AffineConstraints<double> constraints_full;
+  SparsityPattern           sparsity_pattern_full;
+
+  DoFHandler<dim>           dof_handler(triangulation);
+  DoFNumberingTransfer<dim> numbering_transfer(dof_handler);
+  AffineConstraints<double> constraints;
+  SparsityPattern           sparsity_pattern;
+
+  dof_handler_full.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_handler_full);
+  setup_constraints(dof_handler_full, constraints_full);
+  setup_sparsity_pattern(dof_handler_full,
+                         constraints_full,
+                         sparsity_pattern_full);
+
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+  setup_constraints(dof_handler, constraints);
+  setup_sparsity_pattern(dof_handler, constraints, sparsity_pattern);
+
+  double time_full = 0, time_incremental = 0;
+  for (unsigned int cycle = 0; cycle < n_cycles; ++cycle)
+    {
+      // refine the cells in a ball that covers about two percent of the
+      // domain and moves in every cycle
+      Point<dim> center;
+      for (unsigned int d = 0; d < dim; ++d)
+        center[d] = 0.5;
+      center[0] = 0.3 + 0.2 * cycle;
+      for (const auto &cell : triangulation.active_cell_iterators())
+        if (cell->center().distance(center) < 0.17)
+          cell->set_refine_flag();
+      triangulation.execute_coarsening_and_refinement();
+
+      Timer timer;
+      dof_handler_full.distribute_dofs(fe);
+      DoFRenumbering::Cuthill_McKee(dof_handler_full);
+      setup_constraints(dof_handler_full, constraints_full);
+      setup_sparsity_pattern(dof_handler_full,
+                             constraints_full,
+                             sparsity_pattern_full);
+      timer.stop();
+      time_full += timer.wall_time();
+
+      timer.restart();
+      dof_handler.distribute_dofs(fe);
+      numbering_transfer.renumber_dofs();
+      AffineConstraints<double> new_constraints;
+      setup_constraints(dof_handler, new_constraints);
+      numbering_transfer.update_sparsity_pattern(constraints,
+                                                 new_constraints,
+                                                 sparsity_pattern,
+                                                 false);
+      constraints.copy_from(new_constraints);
+      timer.stop();
+      time_incremental += timer.wall_time();
+
+      debug_output << "Cycle " << cycle
+                   << ": number of DoFs: " << dof_handler.n_dofs()
+                   << ", bandwidth full: " << sparsity_pattern_full.bandwidth()
+                   << ", bandwidth incremental: "
+                   << sparsity_pattern.bandwidth() << std::endl;
+    }
+
+  return {{time_full, time_incremental}};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing, 4, {"full_setup", "incremental_setup"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  const auto times = run<3>();
+  debug_output << std::endl;
+  return {times[0], times[1]};
+}
@@ -0,0 +1,213 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that compares the numbering of degrees of freedom
+// created by DoFHandler::distribute_dofs() with the ones of
+// DoFRenumbering::Cuthill_McKee() and DoFRenumbering::space_filling_curve(),
+// for FE_Q elements of degree two on a distorted 3d mesh. We measure the time
+// of the renumbering itself, the time of matrix-vector products with the mass
+// plus Laplace matrix, which mostly depends on how well the vector entries are
+// reused in the caches, and the time to solve a linear system with this matrix
+// with the conjugate gradient method preconditioned by SSOR, whose number of
+// iterations depends on the numbering. The bandwidth of the matrix and the
+// number of iterations are printed to the debug output.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int n_matrix_vector_products = 50;
+
+
+
+enum class Numbering
+{
+  default_numbering,
+  cuthill_mckee,
+  space_filling_curve
+};
+
+
+
+template <int dim>
+std::array<double, 3>
+run(const Numbering numbering)
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(2);
+  DoFHandler<dim>    dof_handler(triangulation);
+
+  GridGenerator::hyper_cube(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(5);
+        break;
+    }
+  GridTools::distort_random(0.2, triangulation, false, 42);
+
+  dof_handler.distribute_dofs(fe);
+
+  Timer timer;
+  switch (numbering)
+    {
+      case Numbering::default_numbering:
+        break;
+      case Numbering::cuthill_mckee:
+        DoFRenumbering::Cuthill_McKee(dof_handler);
+        break;
+      case Numbering::space_filling_curve:
+        DoFRenumbering::space_filling_curve(dof_handler);
+        break;
+    }
+  timer.stop();
+  const double time_renumber = timer.wall_time();
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+
+  SparseMatrix<double> system_matrix(sparsity_pattern);
+  {
+    QGauss<dim>   quadrature(fe.degree + 1);
+    FEValues<dim> fe_values(fe,
+                            quadrature,
+                            update_values | update_gradients |
+                              update_JxW_values);
+
+    FullMatrix<double> cell_matrix(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+    std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        fe_values.reinit(cell);
+        cell_matrix = 0;
+        for (const unsigned int q : fe_values.quadrature_point_indices())
+          for (const unsigned int i : fe_values.dof_indices())
+            for (const unsigned int j : fe_values.dof_indices())
+              cell_matrix(i, j) +=
+                (fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q) +
+                 fe_values.shape_value(i, q) * fe_values.shape_value(j, q)) *
+                fe_values.JxW(q);
+        cell->get_dof_indices(dof_indices);
+        system_matrix.add(dof_indices, cell_matrix);
+      }
+  }
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = 1. + (i % 7);
+
+  timer.restart();
+  for (unsigned int t = 0; t < n_matrix_vector_products; ++t)
+    {
+      system_matrix.vmult(dst, src);
+      src.sadd(0.1, 1e-3, dst);
+    }
+  timer.stop();
+  const double time_vmult = timer.wall_time();
+
+  Vector<double> solution(dof_handler.n_dofs()), rhs(dof_handler.n_dofs());
+  rhs = 1.;
+  SolverControl            solver_control(1000, 1e-10 * rhs.l2_norm());
+  SolverCG<Vector<double>> solver(solver_control);
+  PreconditionSSOR<SparseMatrix<double>> preconditioner;
+  preconditioner.initialize(system_matrix, 1.2);
+
+  timer.restart();
+  solver.solve(system_matrix, solution, rhs, preconditioner);
+  timer.stop();
+  const double time_solve = timer.wall_time();
+
+  debug_output << "Number of DoFs: " << dof_handler.n_dofs()
+               << ", bandwidth: " << sparsity_pattern.bandwidth()
+               << ", CG iterations: " << solver_control.last_step()
+               << std::endl;
+
+  return {{time_renumber, time_vmult, time_solve}};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"default_vmult",
+           "default_solve",
+           "cuthill_mckee_renumber",
+           "cuthill_mckee_vmult",
+           "cuthill_mckee_solve",
+           "space_filling_curve_renumber",
+           "space_filling_curve_vmult",
+           "space_filling_curve_solve"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  const auto default_times = run<3>(Numbering::default_numbering);
+  const auto cuthill_mckee = run<3>(Numbering::cuthill_mckee);
+  const auto curve         = run<3>(Numbering::space_filling_curve);
+
+  debug_output << std::endl;
+  return {default_times[1],
+          default_times[2],
+          cuthill_mckee[0],
+          cuthill_mckee[1],
+          cuthill_mckee[2],
+          curve[0],
+          curve[1],
+          curve[2]};
+}
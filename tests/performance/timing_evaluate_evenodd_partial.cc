@@ -0,0 +1,248 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A microbenchmark for the sum-factorization kernels of the matrix-free
+// framework on a quadrature formula that is only partly symmetric (a Gauss
+// formula with n+2 points where the innermost pair has been moved off the
+// symmetric position, as used for over-integration). It compares the
+// evaluate_general kernel against the evaluate_evenodd_partial kernel for
+// the interpolation of values and gradients to the quadrature points and
+// the respective integration on a batch of 3d cells, for polynomial degrees
+// 2 to 6. The reported numbers are the effective GFLOP/s, i.e., the number
+// of arithmetic operations of the general algorithm divided by the run time,
+// such that higher numbers mean faster evaluation for both kernels.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+using VectorizedArrayType = VectorizedArray<double>;
+
+
+Quadrature<1>
+create_partly_symmetric_quadrature(const unsigned int n_points)
+{
+  QGauss<1>             gauss(n_points);
+  std::vector<Point<1>> points  = gauss.get_points();
+  std::vector<double>   weights = gauss.get_weights();
+  const unsigned int    index   = n_points / 2 - 1;
+  points[index][0] += 0.25 * (points[index + 1][0] - points[index][0]);
+  return Quadrature<1>(points, weights);
+}
+
+
+
+template <int dim, int degree, typename Evaluator>
+double
+run_kernel(const Evaluator                  &eval,
+           AlignedVector<VectorizedArrayType> &dof_values,
+           AlignedVector<VectorizedArrayType> &quad_values,
+           const unsigned int                n_cells,
+           const unsigned int                n_repetitions)
+{
+  constexpr unsigned int n_q_points_1d = degree + 2;
+  constexpr unsigned int n_dofs        = Utilities::pow(degree + 1, dim);
+  constexpr unsigned int n_q_points    = Utilities::pow(n_q_points_1d, dim);
+
+  AlignedVector<VectorizedArrayType> tmp(2 * n_q_points);
+
+  Timer time;
+  for (unsigned int r = 0; r < n_repetitions; ++r)
+    for (unsigned int cell = 0; cell < n_cells; ++cell)
+      {
+        VectorizedArrayType *dofs = dof_values.begin() + cell * n_dofs;
+        VectorizedArrayType *quad =
+          quad_values.begin() + cell * (dim + 1) * n_q_points;
+
+        // evaluate values and gradients, see FEEvaluationImpl::evaluate
+        eval.template gradients<0, true, false>(dofs, tmp.begin());
+        eval.template values<1, true, false>(tmp.begin(),
+                                             tmp.begin() + n_q_points);
+        eval.template values<2, true, false, dim>(tmp.begin() + n_q_points,
+                                                  quad);
+        eval.template values<0, true, false>(dofs, tmp.begin());
+        eval.template gradients<1, true, false>(tmp.begin(),
+                                                tmp.begin() + n_q_points);
+        eval.template values<2, true, false, dim>(tmp.begin() + n_q_points,
+                                                  quad + 1);
+        eval.template values<1, true, false>(tmp.begin(),
+                                             tmp.begin() + n_q_points);
+        eval.template gradients<2, true, false, dim>(tmp.begin() +
+                                                       n_q_points,
+                                                     quad + 2);
+        eval.template values<2, true, false>(tmp.begin() + n_q_points,
+                                             quad + dim * n_q_points);
+
+        // integrate with values and gradients, see
+        // FEEvaluationImpl::integrate
+        eval.template gradients<2, false, false, dim>(quad + 2, tmp.begin());
+        eval.template values<2, false, true>(quad + dim * n_q_points,
+                                             tmp.begin());
+        eval.template values<1, false, false>(tmp.begin(),
+                                              tmp.begin() + n_q_points);
+        eval.template values<2, false, false, dim>(quad + 1, tmp.begin());
+        eval.template gradients<1, false, true>(tmp.begin(),
+                                                tmp.begin() + n_q_points);
+        eval.template values<0, false, false>(tmp.begin() + n_q_points, dofs);
+        eval.template values<2, false, false, dim>(quad, tmp.begin());
+        eval.template values<1, false, false>(tmp.begin(),
+                                              tmp.begin() + n_q_points);
+        eval.template gradients<0, false, true>(tmp.begin() + n_q_points,
+                                                dofs);
+      }
+  return time.wall_time();
+}
+
+
+
+template <int dim, int degree>
+std::pair<double, double>
+run_degree()
+{
+  constexpr unsigned int n_q_points_1d = degree + 2;
+  constexpr unsigned int n_dofs_1d     = degree + 1;
+  constexpr unsigned int n_dofs        = Utilities::pow(n_dofs_1d, dim);
+  constexpr unsigned int n_q_points    = Utilities::pow(n_q_points_1d, dim);
+
+  const internal::MatrixFreeFunctions::ShapeInfo<double> shape_info(
+    create_partly_symmetric_quadrature(n_q_points_1d),
+    FE_DGQ<dim>(degree));
+  AssertThrow(shape_info.element_type ==
+                internal::MatrixFreeFunctions::tensor_partially_symmetric,
+              ExcInternalError());
+  const auto &data = shape_info.data.front();
+
+  // make the data set clearly larger than the caches
+  unsigned int n_cells = 1;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        n_cells = 2000000 / (n_dofs * VectorizedArrayType::size());
+        break;
+      case TestingEnvironment::medium:
+        DEAL_II_FALLTHROUGH;
+      case TestingEnvironment::heavy:
+        n_cells = 8000000 / (n_dofs * VectorizedArrayType::size());
+        break;
+    }
+  const unsigned int n_repetitions = 10;
+
+  AlignedVector<VectorizedArrayType> dof_values(n_cells * n_dofs);
+  AlignedVector<VectorizedArrayType> quad_values(n_cells * (dim + 1) *
+                                                 n_q_points);
+  for (unsigned int i = 0; i < dof_values.size(); ++i)
+    dof_values[i] = static_cast<double>(i % 7) / 7.;
+
+  const internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                         dim,
+                                         n_dofs_1d,
+                                         n_q_points_1d,
+                                         VectorizedArrayType,
+                                         double>
+    eval_general(data.shape_values, data.shape_gradients, {});
+  const internal::EvaluatorTensorProductPartialEvenOdd<dim,
+                                                       n_dofs_1d,
+                                                       n_q_points_1d,
+                                                       VectorizedArrayType,
+                                                       double>
+    eval_partial(data.shape_values_eo_partial,
+                 data.shape_gradients_eo_partial,
+                 {},
+                 data.symmetric_point_pairs);
+
+  // run_kernel calls 2 * (d + 2) kernels in direction d for evaluation and
+  // integration together, each with the given number of 1d lines and 2 *
+  // n_rows * n_columns operations of a general matrix-vector product per
+  // line
+  std::size_t operations_per_cell = 0;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      const std::size_t lines = Utilities::pow(n_q_points_1d, d) *
+                                Utilities::pow(n_dofs_1d, dim - 1 - d);
+      operations_per_cell +=
+        2 * (d + 2) * lines * 2 * n_dofs_1d * n_q_points_1d;
+    }
+  const double n_operations = static_cast<double>(operations_per_cell) *
+                              n_cells * n_repetitions *
+                              VectorizedArrayType::size();
+
+  const double time_general = run_kernel<dim, degree>(
+    eval_general, dof_values, quad_values, n_cells, n_repetitions);
+  const double time_partial = run_kernel<dim, degree>(
+    eval_partial, dof_values, quad_values, n_cells, n_repetitions);
+
+  debug_output << "Degree " << degree << ": general " << time_general
+               << " s, evenodd_partial " << time_partial << " s" << std::endl;
+
+  return {1e-9 * n_operations / time_general,
+          1e-9 * n_operations / time_partial};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"gflops_general_degree_2",
+           "gflops_evenodd_partial_degree_2",
+           "gflops_general_degree_3",
+           "gflops_evenodd_partial_degree_3",
+           "gflops_general_degree_4",
+           "gflops_evenodd_partial_degree_4",
+           "gflops_general_degree_5",
+           "gflops_evenodd_partial_degree_5",
+           "gflops_general_degree_6",
+           "gflops_evenodd_partial_degree_6"}};
+}
+
+
+Measurement
+perform_single_measurement()
+{
+  const auto p2 = run_degree<3, 2>();
+  const auto p3 = run_degree<3, 3>();
+  const auto p4 = run_degree<3, 4>();
+  const auto p5 = run_degree<3, 5>();
+  const auto p6 = run_degree<3, 6>();
+
+  return {p2.first,
+          p2.second,
+          p3.first,
+          p3.second,
+          p4.first,
+          p4.second,
+          p5.first,
+          p5.second,
+          p6.first,
+          p6.second};
+}
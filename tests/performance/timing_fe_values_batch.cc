@@ -0,0 +1,181 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for the assembly of the Laplace matrix with FE_Q
+// elements of degree two on a distorted 3d mesh. The cell matrices are
+// computed once with FEValues, one cell at a time, and once with
+// FEValuesBatch, which computes the matrices of VectorizedArray::size()
+// cells at once. In both cases, the cell matrices are added into a
+// SparseMatrix. The difference between the two matrices is printed to the
+// debug output.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_batch.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(2);
+  QGauss<dim>        quadrature(fe.degree + 1);
+  DoFHandler<dim>    dof_handler(triangulation);
+
+  GridGenerator::hyper_cube(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(5);
+        break;
+    }
+  GridTools::distort_random(0.2, triangulation, false, 42);
+  dof_handler.distribute_dofs(fe);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+
+  const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+  FullMatrix<double> cell_matrix(dofs_per_cell, dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+  SparseMatrix<double> matrix(sparsity_pattern);
+  Timer                timer;
+  {
+    FEValues<dim> fe_values(fe,
+                            quadrature,
+                            update_gradients | update_JxW_values);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        fe_values.reinit(cell);
+        cell_matrix = 0;
+        for (const unsigned int q : fe_values.quadrature_point_indices())
+          for (const unsigned int i : fe_values.dof_indices())
+            for (const unsigned int j : fe_values.dof_indices())
+              cell_matrix(i, j) += fe_values.shape_grad(i, q) *
+                                   fe_values.shape_grad(j, q) *
+                                   fe_values.JxW(q);
+        cell->get_dof_indices(dof_indices);
+        matrix.add(dof_indices, cell_matrix);
+      }
+  }
+  timer.stop();
+  const double time_fe_values = timer.wall_time();
+
+  SparseMatrix<double> matrix_batch(sparsity_pattern);
+  timer.restart();
+  {
+    FEValuesBatch<dim> fe_batch(fe,
+                                quadrature,
+                                update_gradients | update_JxW_values);
+    Table<2, VectorizedArray<double>> cell_matrices(dofs_per_cell,
+                                                    dofs_per_cell);
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        cells.push_back(cell);
+        if (cells.size() < fe_batch.n_lanes &&
+            cell->active_cell_index() + 1 < triangulation.n_active_cells())
+          continue;
+
+        fe_batch.reinit(cells);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            cell_matrices(i, j) = 0.;
+        for (const unsigned int q : fe_batch.quadrature_point_indices())
+          for (const unsigned int i : fe_batch.dof_indices())
+            {
+              const Tensor<1, dim, VectorizedArray<double>> grad_i_JxW =
+                fe_batch.shape_grad(i, q) * fe_batch.JxW(q);
+              for (const unsigned int j : fe_batch.dof_indices())
+                cell_matrices(i, j) += grad_i_JxW * fe_batch.shape_grad(j, q);
+            }
+
+        for (unsigned int l = 0; l < fe_batch.n_active_lanes(); ++l)
+          {
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                cell_matrix(i, j) = cell_matrices(i, j)[l];
+            const auto batch_dof_indices = fe_batch.get_dof_indices(l);
+            dof_indices.assign(batch_dof_indices.begin(),
+                               batch_dof_indices.end());
+            matrix_batch.add(dof_indices, cell_matrix);
+          }
+        cells.clear();
+      }
+  }
+  timer.stop();
+  const double time_fe_values_batch = timer.wall_time();
+
+  matrix_batch.add(-1., matrix);
+  debug_output << "Number of DoFs: " << dof_handler.n_dofs()
+               << ", difference between matrices: "
+               << matrix_batch.frobenius_norm() / matrix.frobenius_norm()
+               << std::endl;
+
+  return {time_fe_values, time_fe_values_batch};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing, 4, {"fe_values", "fe_values_batch"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
@@ -0,0 +1,154 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for the evaluation of a finite element function
+// with FE_Q elements of degree five in 3d, as done in postprocessing and
+// error estimation: the values and gradients of the function are computed
+// in the quadrature points of all cells to integrate the squares of the
+// function and its gradient. FEValues::get_function_values() and
+// FEValues::get_function_gradients() evaluate by sum factorization for this
+// element. The same integrals are also computed by summing over all shape
+// functions in all quadrature points. The difference between the results
+// is printed to the debug output.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(5);
+  QGauss<dim>        quadrature(fe.degree + 1);
+  DoFHandler<dim>    dof_handler(triangulation);
+
+  GridGenerator::hyper_cube(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(2);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(4);
+        break;
+    }
+  GridTools::distort_random(0.2, triangulation, false, 42);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution[i] = std::sin(0.1 * i);
+
+  FEValues<dim> fe_values(fe,
+                          quadrature,
+                          update_values | update_gradients |
+                            update_inverse_jacobians | update_JxW_values);
+  std::vector<double>                  values(quadrature.size());
+  std::vector<Tensor<1, dim>>          gradients(quadrature.size());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  Timer  timer;
+  double integral_sum_factorization = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        integral_sum_factorization +=
+          (values[q] * values[q] + gradients[q] * gradients[q]) *
+          fe_values.JxW(q);
+    }
+  timer.stop();
+  const double time_sum_factorization = timer.wall_time();
+
+  timer.restart();
+  double integral_shape_functions = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+      std::fill(values.begin(), values.end(), 0.);
+      std::fill(gradients.begin(), gradients.end(), Tensor<1, dim>());
+      for (const unsigned int i : fe_values.dof_indices())
+        {
+          const double dof_value = solution(dof_indices[i]);
+          for (const unsigned int q : fe_values.quadrature_point_indices())
+            {
+              values[q] += dof_value * fe_values.shape_value(i, q);
+              gradients[q] += dof_value * fe_values.shape_grad(i, q);
+            }
+        }
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        integral_shape_functions +=
+          (values[q] * values[q] + gradients[q] * gradients[q]) *
+          fe_values.JxW(q);
+    }
+  timer.stop();
+  const double time_shape_functions = timer.wall_time();
+
+  debug_output << "Number of DoFs: " << dof_handler.n_dofs()
+               << ", relative difference between integrals: "
+               << std::abs(integral_sum_factorization -
+                           integral_shape_functions) /
+                    integral_shape_functions
+               << std::endl;
+
+  return {time_sum_factorization, time_shape_functions};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing, 4, {"sum_factorization", "shape_functions"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
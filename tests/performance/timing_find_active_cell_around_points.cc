@@ -0,0 +1,136 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for locating many points in a mesh: random points
+// in a 3d ball, described by a quadratic MappingQ, are located once with a
+// loop calling GridTools::find_active_cell_around_point() for each point and
+// once with a single call to GridTools::find_active_cell_around_points(),
+// which groups the points by candidate cell, uses the vectorized inverse
+// mapping and processes batches of points in parallel. Both searches use
+// an already filled GridTools::Cache.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/timer.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include <random>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_ball_balanced(triangulation);
+
+  unsigned int n_points = 0;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(3);
+        n_points = 20000;
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(4);
+        n_points = 100000;
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(5);
+        n_points = 500000;
+        break;
+    }
+
+  MappingQ<dim>         mapping(2);
+  GridTools::Cache<dim> cache(triangulation, mapping);
+
+  // points in the cube around the ball, of which those in the ball are
+  // found
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(-0.6, 0.6);
+  std::vector<Point<dim>>                points(n_points);
+  for (Point<dim> &p : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = distribution(generator);
+
+  // fill the cache
+  GridTools::find_active_cell_around_point(cache, points[0]);
+  GridTools::find_active_cell_around_points(cache, points);
+
+  Timer        timer;
+  unsigned int n_found_single = 0;
+  auto         cell_hint = triangulation.begin_active();
+  for (const Point<dim> &p : points)
+    {
+      const auto cell_and_point =
+        GridTools::find_active_cell_around_point(cache, p, cell_hint);
+      if (cell_and_point.first != triangulation.end())
+        {
+          cell_hint = cell_and_point.first;
+          ++n_found_single;
+        }
+    }
+  timer.stop();
+  const double time_single = timer.wall_time();
+
+  timer.restart();
+  const auto cells_and_points =
+    GridTools::find_active_cell_around_points(cache, points);
+  timer.stop();
+  const double time_batched = timer.wall_time();
+
+  unsigned int n_found_batched = 0;
+  for (const auto &cell_and_point : cells_and_points)
+    if (cell_and_point.first != triangulation.end())
+      ++n_found_batched;
+
+  debug_output << "Number of cells: " << triangulation.n_active_cells()
+               << ", points: " << n_points << ", found: " << n_found_single
+               << " / " << n_found_batched << std::endl;
+
+  return {time_single, time_batched};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing, 4, {"single_point_search", "batched_search"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
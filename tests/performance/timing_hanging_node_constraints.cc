@@ -0,0 +1,127 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that measures the time to set up the hanging node
+// constraints of FE_Q elements of degree two in 3d, i.e.,
+// DoFTools::make_hanging_node_constraints() followed by
+// AffineConstraints::close(), for different numbers of hanging nodes: a
+// globally refined mesh is refined once more on a small, a medium, and a
+// large fraction of its cells, chosen at random.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <random>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+
+template <int dim>
+std::pair<double, double>
+time_setup(const double fraction_of_refined_cells)
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(2);
+  DoFHandler<dim>    dof_handler(triangulation);
+
+  GridGenerator::hyper_cube(triangulation);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(5);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(6);
+        break;
+    }
+
+  std::mt19937                           random_number_generator(42);
+  std::uniform_real_distribution<double> distribution(0., 1.);
+  for (const auto &cell : triangulation.active_cell_iterators())
+    if (distribution(random_number_generator) < fraction_of_refined_cells)
+      cell->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+
+  Timer timer;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  timer.stop();
+  const double time_make = timer.wall_time();
+
+  timer.restart();
+  constraints.close();
+  timer.stop();
+  const double time_close = timer.wall_time();
+
+  debug_output << "Fraction of refined cells: " << fraction_of_refined_cells
+               << ", number of DoFs: " << dof_handler.n_dofs()
+               << ", number of hanging node constraints: "
+               << constraints.n_constraints() << std::endl;
+
+  return {time_make, time_close};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"make_constraints_5%",
+           "close_5%",
+           "make_constraints_20%",
+           "close_20%",
+           "make_constraints_50%",
+           "close_50%"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  const auto [make_5, close_5]   = time_setup<3>(0.05);
+  const auto [make_20, close_20] = time_setup<3>(0.2);
+  const auto [make_50, close_50] = time_setup<3>(0.5);
+
+  debug_output << std::endl;
+  return {make_5, close_5, make_20, close_20, make_50, close_50};
+}
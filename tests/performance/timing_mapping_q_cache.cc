@@ -0,0 +1,132 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for the setup of MappingQCache of degree four on
+// a curved 3d mesh. The cache is initialized from a MappingQ with the
+// support points stored in double and in single precision, and the support
+// points of every tenth active cell are updated afterwards, as in a mesh
+// that is deformed in some cells. The memory consumption of the two caches
+// is printed to the debug output.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/timer.h>
+
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+
+// Give access to the support points of MappingQ
+template <int dim>
+class MappingQWithSupportPoints : public MappingQ<dim>
+{
+public:
+  using MappingQ<dim>::MappingQ;
+  using MappingQ<dim>::compute_mapping_support_points;
+};
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_shell(triangulation, Point<dim>(), 0.5, 1.);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(2);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(4);
+        break;
+    }
+
+  const unsigned int             degree = 4;
+  MappingQWithSupportPoints<dim> mapping(degree);
+
+  Timer              timer;
+  MappingQCache<dim> mapping_double(degree);
+  mapping_double.initialize(mapping, triangulation);
+  timer.stop();
+  const double time_initialize_double = timer.wall_time();
+
+  timer.restart();
+  MappingQCache<dim> mapping_single(degree, true);
+  mapping_single.initialize(mapping, triangulation);
+  timer.stop();
+  const double time_initialize_single = timer.wall_time();
+
+  std::vector<typename Triangulation<dim>::cell_iterator> moving_cells;
+  for (const auto &cell : triangulation.active_cell_iterators())
+    if (cell->active_cell_index() % 10 == 0)
+      moving_cells.push_back(cell);
+
+  Tensor<1, dim> shift;
+  shift[0] = 1e-3;
+  timer.restart();
+  mapping_double.update(
+    moving_cells, [&](const typename Triangulation<dim>::cell_iterator &cell) {
+      std::vector<Point<dim>> points =
+        mapping.compute_mapping_support_points(cell);
+      for (Point<dim> &p : points)
+        p += shift;
+      return points;
+    });
+  timer.stop();
+  const double time_update = timer.wall_time();
+
+  debug_output << "Number of cells: " << triangulation.n_cells()
+               << ", memory double: " << mapping_double.memory_consumption()
+               << ", memory single: " << mapping_single.memory_consumption()
+               << std::endl;
+
+  return {time_initialize_double, time_initialize_single, time_update};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"initialize_double", "initialize_single", "update"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
@@ -0,0 +1,179 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A strong-scaling benchmark for the thread-parallel loops of MatrixFree:
+// the operator evaluation of step 37 (without variable coefficient) is run
+// with the partition_dynamic scheme on 1, 2, 4 and the maximal number of
+// threads, and in serial without any thread parallelism as a reference.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <iostream>
+#include <memory>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int degree_finite_element = 3;
+const unsigned int n_matvecs             = 100;
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(degree_finite_element);
+  DoFHandler<dim>    dof_handler(triangulation);
+  MappingQ1<dim>     mapping;
+
+  GridGenerator::hyper_cube(triangulation, 0., 1.);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(5);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(6);
+        break;
+    }
+
+  dof_handler.distribute_dofs(fe);
+  debug_output << "Number of DoFs: " << dof_handler.n_dofs() << std::endl;
+
+  AffineConstraints<double> constraints;
+  VectorTools::interpolate_boundary_values(
+    mapping, dof_handler, 0, Functions::ZeroFunction<dim>(), constraints);
+  constraints.close();
+
+  using SystemMatrixType =
+    MatrixFreeOperators::LaplaceOperator<dim,
+                                         degree_finite_element,
+                                         degree_finite_element + 1,
+                                         1,
+                                         VectorType>;
+
+  const unsigned int max_threads = MultithreadInfo::n_threads();
+
+  // time the operator evaluation for a given scheme and number of threads,
+  // the setup of MatrixFree is repeated because the partitions depend on the
+  // number of threads
+  const auto time_matvec =
+    [&](const typename MatrixFree<dim, double>::AdditionalData::
+          TasksParallelScheme scheme,
+        const unsigned int    n_threads) {
+      MultithreadInfo::set_thread_limit(std::min(n_threads, max_threads));
+
+      typename MatrixFree<dim, double>::AdditionalData additional_data;
+      additional_data.tasks_parallel_scheme = scheme;
+      additional_data.mapping_update_flags =
+        (update_gradients | update_JxW_values);
+
+      const auto matrix_free = std::make_shared<MatrixFree<dim, double>>();
+      matrix_free->reinit(mapping,
+                          dof_handler,
+                          constraints,
+                          QGauss<1>(fe.degree + 1),
+                          additional_data);
+
+      SystemMatrixType system_matrix;
+      system_matrix.initialize(matrix_free);
+
+      VectorType src, dst;
+      system_matrix.initialize_dof_vector(src);
+      system_matrix.initialize_dof_vector(dst);
+      src = 1.;
+
+      // one evaluation before measuring to get the memory allocations out of
+      // the way
+      system_matrix.vmult(dst, src);
+
+      Timer timer;
+      for (unsigned int t = 0; t < n_matvecs; ++t)
+        system_matrix.vmult(dst, src);
+      timer.stop();
+
+      debug_output << "threads: " << MultithreadInfo::n_threads()
+                   << " norm: " << dst.l2_norm()
+                   << " time: " << timer.wall_time() << std::endl;
+      return timer.wall_time();
+    };
+
+  using AdditionalData = typename MatrixFree<dim, double>::AdditionalData;
+
+  Measurement result = {
+    time_matvec(AdditionalData::none, 1),
+    time_matvec(AdditionalData::partition_dynamic, 1),
+    time_matvec(AdditionalData::partition_dynamic, 2),
+    time_matvec(AdditionalData::partition_dynamic, 4),
+    time_matvec(AdditionalData::partition_dynamic, max_threads)};
+
+  MultithreadInfo::set_thread_limit(max_threads);
+
+  debug_output << std::endl;
+  return result;
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"serial", "dynamic_1", "dynamic_2", "dynamic_4", "dynamic_max"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
@@ -0,0 +1,115 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A strong-scaling benchmark for the thread-parallel parts of
+// Triangulation::execute_coarsening_and_refinement(): a ball, whose cells
+// are described by a spherical manifold on the boundary and a transfinite
+// interpolation manifold in the interior, is refined globally once in 2d and
+// in 3d, with 1, 2, 4 and the maximal number of threads. The number of cells
+// refined per second is printed to the debug output.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+
+template <int dim>
+double
+time_refinement(const unsigned int n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_ball_balanced(triangulation);
+
+  unsigned int n_refinements = 0;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        n_refinements = (dim == 2 ? 7 : 3);
+        break;
+      case TestingEnvironment::medium:
+        n_refinements = (dim == 2 ? 8 : 4);
+        break;
+      case TestingEnvironment::heavy:
+        n_refinements = (dim == 2 ? 9 : 5);
+        break;
+    }
+  triangulation.refine_global(n_refinements);
+
+  const unsigned int n_refined_cells = triangulation.n_active_cells();
+  Timer              timer;
+  triangulation.refine_global(1);
+  timer.stop();
+
+  debug_output << "dim: " << dim << " threads: " << MultithreadInfo::n_threads()
+               << " refined cells: " << n_refined_cells
+               << " cells per second: " << n_refined_cells / timer.wall_time()
+               << std::endl;
+  return timer.wall_time();
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"refine_2d_1",
+           "refine_2d_2",
+           "refine_2d_4",
+           "refine_2d_max",
+           "refine_3d_1",
+           "refine_3d_2",
+           "refine_3d_4",
+           "refine_3d_max"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  const unsigned int max_threads = MultithreadInfo::n_threads();
+
+  Measurement result = {time_refinement<2>(1),
+                        time_refinement<2>(std::min(2U, max_threads)),
+                        time_refinement<2>(std::min(4U, max_threads)),
+                        time_refinement<2>(max_threads),
+                        time_refinement<3>(1),
+                        time_refinement<3>(std::min(2U, max_threads)),
+                        time_refinement<3>(std::min(4U, max_threads)),
+                        time_refinement<3>(max_threads)};
+
+  MultithreadInfo::set_thread_limit(max_threads);
+
+  debug_output << std::endl;
+  return result;
+}
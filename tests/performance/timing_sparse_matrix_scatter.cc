@@ -0,0 +1,219 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that compares adding the cell matrices of a step-3
+// like Laplace problem into the global matrix with
+// AffineConstraints::distribute_local_to_global() against SparseMatrixScatter,
+// for FE_Q elements of degree four on an adaptively refined mesh with hanging
+// node and boundary constraints. The cell matrices are computed once up
+// front, so that only the time spent in adding them to the global matrix is
+// measured, repeated as in a time stepping scheme. We measure the setup of
+// the SparseMatrixScatter object and the assembly with the three variants:
+// AffineConstraints, SparseMatrixScatter cell by cell, and SparseMatrixScatter
+// with batches of cells.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_scatter.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int n_assemblies = 10;
+const unsigned int batch_size   = 128;
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(4);
+  DoFHandler<dim>    dof_handler(triangulation);
+
+  GridGenerator::hyper_cube(triangulation, -1, 1);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(5);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(6);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(7);
+        break;
+    }
+
+  // refine twice around a circle to get many hanging nodes
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      for (const auto &cell : triangulation.active_cell_iterators())
+        if (std::abs(cell->center().norm() - 0.5) < 0.2)
+          cell->set_refine_flag();
+      triangulation.execute_coarsening_and_refinement();
+    }
+
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  DoFTools::make_zero_boundary_constraints(dof_handler, 0, constraints);
+  constraints.close();
+
+  debug_output << "Number of active cells: " << triangulation.n_active_cells()
+               << ", number of DoFs: " << dof_handler.n_dofs()
+               << ", number of constraints: " << constraints.n_constraints()
+               << std::endl;
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+
+  const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+  std::vector<FullMatrix<double>> cell_matrices(
+    triangulation.n_active_cells(),
+    FullMatrix<double>(dofs_per_cell, dofs_per_cell));
+  std::vector<std::vector<types::global_dof_index>> dof_indices(
+    triangulation.n_active_cells(),
+    std::vector<types::global_dof_index>(dofs_per_cell));
+  std::vector<unsigned int> cell_indices(triangulation.n_active_cells());
+  {
+    QGauss<dim>   quadrature(fe.degree + 1);
+    FEValues<dim> fe_values(fe,
+                            quadrature,
+                            update_gradients | update_JxW_values);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        const unsigned int index = cell->active_cell_index();
+        fe_values.reinit(cell);
+        for (const unsigned int q : fe_values.quadrature_point_indices())
+          for (const unsigned int i : fe_values.dof_indices())
+            for (const unsigned int j : fe_values.dof_indices())
+              cell_matrices[index](i, j) += fe_values.shape_grad(i, q) *
+                                            fe_values.shape_grad(j, q) *
+                                            fe_values.JxW(q);
+        cell->get_dof_indices(dof_indices[index]);
+        cell_indices[index] = index;
+      }
+  }
+
+  std::map<std::string, dealii::Timer> timer;
+
+  SparseMatrix<double> system_matrix(sparsity_pattern);
+
+  timer["affine_constraints"].start();
+  for (unsigned int t = 0; t < n_assemblies; ++t)
+    {
+      system_matrix = 0;
+      for (const unsigned int c : cell_indices)
+        constraints.distribute_local_to_global(cell_matrices[c],
+                                               dof_indices[c],
+                                               system_matrix);
+    }
+  timer["affine_constraints"].stop();
+
+  timer["scatter_setup"].start();
+  SparseMatrixScatter<double> scatter;
+  scatter.reinit(constraints,
+                 sparsity_pattern,
+                 triangulation.n_active_cells());
+  for (const unsigned int c : cell_indices)
+    scatter.add_cell(c, dof_indices[c]);
+  timer["scatter_setup"].stop();
+
+  debug_output << "Memory of the matrix: " << system_matrix.memory_consumption()
+               << ", memory of the scatter plans: "
+               << scatter.memory_consumption() << std::endl;
+
+  timer["scatter_cells"].start();
+  for (unsigned int t = 0; t < n_assemblies; ++t)
+    {
+      system_matrix = 0;
+      for (const unsigned int c : cell_indices)
+        scatter.distribute_local_to_global(c, cell_matrices[c], system_matrix);
+    }
+  timer["scatter_cells"].stop();
+
+  timer["scatter_batches"].start();
+  for (unsigned int t = 0; t < n_assemblies; ++t)
+    {
+      system_matrix = 0;
+      for (unsigned int c = 0; c < cell_indices.size(); c += batch_size)
+        {
+          const unsigned int n =
+            std::min<unsigned int>(batch_size, cell_indices.size() - c);
+          scatter.distribute_local_to_global(
+            make_array_view(cell_indices.data() + c,
+                            cell_indices.data() + c + n),
+            make_array_view(cell_matrices.data() + c,
+                            cell_matrices.data() + c + n),
+            system_matrix);
+        }
+    }
+  timer["scatter_batches"].stop();
+
+  debug_output << std::endl;
+  return {timer["scatter_setup"].wall_time(),
+          timer["affine_constraints"].wall_time(),
+          timer["scatter_cells"].wall_time(),
+          timer["scatter_batches"].wall_time()};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"scatter_setup",
+           "affine_constraints",
+           "scatter_cells",
+           "scatter_batches"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<2>();
+}
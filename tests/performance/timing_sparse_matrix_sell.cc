@@ -0,0 +1,186 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark that compares the matrix-vector product of a
+// SparseMatrix in the compressed row storage against the same matrix copied
+// into SparseMatrixSELL, for the Laplace matrix of FE_Q elements of degree
+// two in 3d (27 to 125 entries per row). We measure the conversion into the
+// sliced ELLPACK format, repeated matrix-vector products, and a conjugate
+// gradient solver with a fixed number of iterations using the Jacobi
+// preconditioner of the respective matrix.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_creator.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int n_matvecs       = 100;
+const unsigned int n_cg_iterations = 100;
+
+
+
+template <typename MatrixType>
+double
+time_cg(const MatrixType &matrix, const Vector<double> &rhs)
+{
+  PreconditionJacobi<MatrixType> preconditioner;
+  preconditioner.initialize(matrix);
+
+  Vector<double>           solution(rhs.size());
+  IterationNumberControl   solver_control(n_cg_iterations, 1e-30);
+  SolverCG<Vector<double>> cg(solver_control);
+
+  Timer timer;
+  cg.solve(matrix, solution, rhs, preconditioner);
+  timer.stop();
+
+  debug_output << "CG residual after " << n_cg_iterations
+               << " iterations: " << solver_control.last_value() << std::endl;
+  return timer.wall_time();
+}
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  Triangulation<dim> triangulation;
+  FE_Q<dim>          fe(2);
+  DoFHandler<dim>    dof_handler(triangulation);
+
+  GridGenerator::hyper_cube(triangulation, 0., 1.);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(3);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(5);
+        break;
+    }
+
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+  debug_output << "Number of DoFs: " << dof_handler.n_dofs() << std::endl;
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+
+  // the mass matrix is added to make the matrix positive definite without
+  // boundary conditions
+  SparseMatrix<double> laplace_matrix(sparsity_pattern);
+  SparseMatrix<double> system_matrix(sparsity_pattern);
+  MatrixCreator::create_laplace_matrix(MappingQ1<dim>(),
+                                       dof_handler,
+                                       QGauss<dim>(fe.degree + 1),
+                                       laplace_matrix);
+  MatrixCreator::create_mass_matrix(MappingQ1<dim>(),
+                                    dof_handler,
+                                    QGauss<dim>(fe.degree + 1),
+                                    system_matrix);
+  system_matrix.add(1., laplace_matrix);
+
+  std::map<std::string, dealii::Timer> timer;
+
+  timer["sell_setup"].start();
+  SparseMatrixSELL<double> sell_matrix(system_matrix);
+  timer["sell_setup"].stop();
+
+  debug_output << "Nonzero entries: " << sell_matrix.n_nonzero_elements()
+               << ", stored in SELL format: "
+               << sell_matrix.n_stored_elements() << std::endl;
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = 1. + (i % 7) * 0.1;
+
+  // one product each before measuring to get the memory allocations and
+  // first-touch effects out of the way
+  system_matrix.vmult(dst, src);
+  sell_matrix.vmult(dst, src);
+
+  timer["csr_vmult"].start();
+  for (unsigned int t = 0; t < n_matvecs; ++t)
+    system_matrix.vmult(dst, src);
+  timer["csr_vmult"].stop();
+
+  timer["sell_vmult"].start();
+  for (unsigned int t = 0; t < n_matvecs; ++t)
+    sell_matrix.vmult(dst, src);
+  timer["sell_vmult"].stop();
+
+  const double time_csr_cg  = time_cg(system_matrix, src);
+  const double time_sell_cg = time_cg(sell_matrix, src);
+
+  debug_output << std::endl;
+  return {timer["sell_setup"].wall_time(),
+          timer["csr_vmult"].wall_time(),
+          timer["sell_vmult"].wall_time(),
+          time_csr_cg,
+          time_sell_cg};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"sell_setup", "csr_vmult", "sell_vmult", "csr_cg", "sell_cg"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
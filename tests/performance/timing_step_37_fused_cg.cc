@@ -0,0 +1,244 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2024 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark based on step 37 (without variable coefficient)
+// that compares a conjugate gradient solver with a point-Jacobi
+// preconditioner where the vector updates run separately from the operator
+// evaluation against the variant where the vector updates, inner products
+// and the preconditioner are interleaved with the cell loop of
+// MatrixFreeOperators::LaplaceOperator. Both solvers run the same fixed
+// number of iterations.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_cg.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <iostream>
+#include <memory>
+
+#define ENABLE_MPI
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+const unsigned int degree_finite_element = 3;
+const unsigned int n_cg_iterations       = 100;
+
+
+
+// Hide the interleaved vmult() of the operator, such that SolverCG falls back
+// to separate vector updates
+template <typename OperatorType>
+class NonInterleavedOperator
+{
+public:
+  NonInterleavedOperator(const OperatorType &op)
+    : op(op)
+  {}
+
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+private:
+  const OperatorType &op;
+};
+
+
+
+template <int dim>
+Measurement
+run()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+#ifdef DEAL_II_WITH_P4EST
+  parallel::distributed::Triangulation<dim> triangulation(MPI_COMM_WORLD);
+#else
+  Triangulation<dim> triangulation;
+#endif
+  FE_Q<dim>       fe(degree_finite_element);
+  DoFHandler<dim> dof_handler(triangulation);
+  MappingQ1<dim>  mapping;
+
+  std::map<std::string, dealii::Timer> timer;
+
+  GridGenerator::hyper_cube(triangulation, 0., 1.);
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        triangulation.refine_global(4);
+        break;
+      case TestingEnvironment::medium:
+        triangulation.refine_global(5);
+        break;
+      case TestingEnvironment::heavy:
+        triangulation.refine_global(6);
+        break;
+    }
+
+  dof_handler.distribute_dofs(fe);
+  debug_output << "Number of DoFs: " << dof_handler.n_dofs() << std::endl;
+
+  AffineConstraints<double> constraints;
+  constraints.reinit(dof_handler.locally_owned_dofs(),
+                     DoFTools::extract_locally_relevant_dofs(dof_handler));
+  VectorTools::interpolate_boundary_values(
+    mapping, dof_handler, 0, Functions::ZeroFunction<dim>(), constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, double>::AdditionalData::none;
+  additional_data.mapping_update_flags =
+    (update_gradients | update_JxW_values | update_quadrature_points);
+
+  // renumber the unknowns such that the ranges of the operations before and
+  // after the cell loop become as local as possible
+  DoFRenumbering::matrix_free_data_locality(dof_handler,
+                                            constraints,
+                                            additional_data);
+  constraints.clear();
+  constraints.reinit(dof_handler.locally_owned_dofs(),
+                     DoFTools::extract_locally_relevant_dofs(dof_handler));
+  VectorTools::interpolate_boundary_values(
+    mapping, dof_handler, 0, Functions::ZeroFunction<dim>(), constraints);
+  constraints.close();
+
+  const auto matrix_free = std::make_shared<MatrixFree<dim, double>>();
+  matrix_free->reinit(mapping,
+                      dof_handler,
+                      constraints,
+                      QGauss<1>(fe.degree + 1),
+                      additional_data);
+
+  using SystemMatrixType =
+    MatrixFreeOperators::LaplaceOperator<dim,
+                                         degree_finite_element,
+                                         degree_finite_element + 1,
+                                         1,
+                                         VectorType>;
+  SystemMatrixType system_matrix;
+  system_matrix.initialize(matrix_free);
+  system_matrix.compute_diagonal();
+  const DiagonalMatrix<VectorType> &preconditioner =
+    *system_matrix.get_matrix_diagonal_inverse();
+
+  VectorType solution, system_rhs;
+  system_matrix.initialize_dof_vector(solution);
+  system_matrix.initialize_dof_vector(system_rhs);
+  {
+    FEEvaluation<dim, degree_finite_element> phi(*matrix_free);
+    for (unsigned int cell = 0; cell < matrix_free->n_cell_batches(); ++cell)
+      {
+        phi.reinit(cell);
+        for (const unsigned int q : phi.quadrature_point_indices())
+          phi.submit_value(make_vectorized_array<double>(1.0), q);
+        phi.integrate(EvaluationFlags::values);
+        phi.distribute_local_to_global(system_rhs);
+      }
+    system_rhs.compress(VectorOperation::add);
+  }
+
+  const NonInterleavedOperator<SystemMatrixType> non_interleaved_matrix(
+    system_matrix);
+
+  // do one solve each before measuring to get the memory allocations out of
+  // the way
+  for (const std::string name : {"cg_separate", "cg_interleaved"})
+    for (unsigned int t = 0; t < 2; ++t)
+      {
+        IterationNumberControl solver_control(n_cg_iterations, 1e-30);
+        SolverCG<VectorType>   cg(solver_control);
+        solution = 0;
+
+        if (t == 1)
+          timer[name].start();
+        if (name == "cg_separate")
+          cg.solve(non_interleaved_matrix,
+                   solution,
+                   system_rhs,
+                   preconditioner);
+        else
+          cg.solve(system_matrix, solution, system_rhs, preconditioner);
+        if (t == 1)
+          timer[name].stop();
+
+        debug_output << name << " residual after " << n_cg_iterations
+                     << " iterations: " << solver_control.last_value()
+                     << std::endl;
+      }
+
+  // the operator evaluation alone as a reference for the cost of the vector
+  // operations
+  timer["matvec"].start();
+  for (unsigned int t = 0; t < n_cg_iterations; ++t)
+    system_matrix.vmult(system_rhs, solution);
+  timer["matvec"].stop();
+
+  debug_output << std::endl;
+  return {timer["cg_separate"].wall_time(),
+          timer["cg_interleaved"].wall_time(),
+          timer["matvec"].wall_time()};
+}
+
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing, 4, {"cg_separate", "cg_interleaved", "matvec"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  return run<3>();
+}
@@ -0,0 +1,239 @@
+// ------------------------------------------------------------------------
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+// Copyright (C) 2025 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// Part of the source code is dual licensed under Apache-2.0 WITH
+// LLVM-exception OR LGPL-2.1-or-later. Detailed license information
+// governing the source code and code contributions can be found in
+// LICENSE.md and CONTRIBUTING.md at the top level directory of deal.II.
+//
+// ------------------------------------------------------------------------
+
+
+
+// Check that creating a SparsityPattern from a SparsityPatternBuilder gives
+// the same result as going through a DynamicSparsityPattern, both for the
+// sequential and the multithreaded loops of DoFTools and for entries added
+// directly through AffineConstraints::add_entries_local_to_global(). Also
+// check that the multithreaded loops of DoFTools::make_sparsity_pattern()
+// and DoFTools::make_flux_sparsity_pattern() create the same
+// DynamicSparsityPattern as the sequential ones, on a mesh that is large
+// enough to use the parallel code path and with hanging node constraints.
+
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern_builder.h>
+
+#include "../tests.h"
+
+
+
+// Compare the patterns created through a SparsityPatternBuilder and through
+// a DynamicSparsityPattern with one and with four threads to the one
+// created through a DynamicSparsityPattern with one thread
+template <typename Function>
+void
+compare(const std::string            &name,
+        const types::global_dof_index n_dofs,
+        const Function               &make_pattern)
+{
+  MultithreadInfo::set_thread_limit(1);
+  DynamicSparsityPattern dsp(n_dofs);
+  make_pattern(dsp);
+  SparsityPattern reference;
+  reference.copy_from(dsp);
+
+  for (const unsigned int n_threads : {1, 4})
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+
+      SparsityPatternBuilder builder(n_dofs, n_dofs);
+      make_pattern(builder);
+      SparsityPattern sparsity;
+      sparsity.copy_from(builder);
+
+      DynamicSparsityPattern threaded_dsp(n_dofs);
+      make_pattern(threaded_dsp);
+      SparsityPattern threaded_sparsity;
+      threaded_sparsity.copy_from(threaded_dsp);
+
+      deallog << name << ", " << n_threads
+              << " threads: " << sparsity.n_nonzero_elements() << " -- "
+              << (sparsity == reference && threaded_sparsity == reference ?
+                    "ok" :
+                    "failed")
+              << std::endl;
+    }
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(dim == 2 ? 5 : 3);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  for (const bool keep_constrained_dofs : {true, false})
+    compare(std::string("make_sparsity_pattern, keep=") +
+              (keep_constrained_dofs ? "true" : "false"),
+            dof.n_dofs(),
+            [&](auto &sparsity) {
+              DoFTools::make_sparsity_pattern(dof,
+                                              sparsity,
+                                              constraints,
+                                              keep_constrained_dofs);
+            });
+
+  // add entries for a coupling of every degree of freedom on the first cell
+  // with those of the last cell, as with some non-local operator
+  compare("add_entries_local_to_global", dof.n_dofs(), [&](auto &sparsity) {
+    std::vector<types::global_dof_index> first_dofs(fe.n_dofs_per_cell());
+    std::vector<types::global_dof_index> last_dofs(fe.n_dofs_per_cell());
+    dof.begin_active()->get_dof_indices(first_dofs);
+    std::next(dof.begin_active(), tria.n_active_cells() - 1)
+      ->get_dof_indices(last_dofs);
+    constraints.add_entries_local_to_global(first_dofs,
+                                            last_dofs,
+                                            sparsity,
+                                            true);
+    constraints.add_entries_local_to_global(last_dofs, sparsity, false);
+  });
+
+  FE_DGQ<dim>     fe_dg(1);
+  DoFHandler<dim> dof_dg(tria);
+  dof_dg.distribute_dofs(fe_dg);
+
+  compare("make_flux_sparsity_pattern", dof_dg.n_dofs(), [&](auto &sparsity) {
+    DoFTools::make_flux_sparsity_pattern(dof_dg, sparsity);
+  });
+
+  const AffineConstraints<double> no_constraints;
+  compare("make_flux_sparsity_pattern with constraints",
+          dof_dg.n_dofs(),
+          [&](auto &sparsity) {
+            DoFTools::make_flux_sparsity_pattern(dof_dg,
+                                                 sparsity,
+                                                 no_constraints);
+          });
+
+  Table<2, DoFTools::Coupling> cell_mask(1, 1), face_mask(1, 1);
+  cell_mask(0, 0) = DoFTools::always;
+  face_mask(0, 0) = DoFTools::nonzero;
+  compare("make_flux_sparsity_pattern with masks",
+          dof_dg.n_dofs(),
+          [&](auto &sparsity) {
+            DoFTools::make_flux_sparsity_pattern(dof_dg,
+                                                 sparsity,
+                                                 cell_mask,
+                                                 face_mask);
+          });
+
+  // the function deciding on face couplings does not need to be
+  // thread-safe: count its calls without any synchronization, and check
+  // that every call to make_flux_sparsity_pattern() makes the same number
+  // of calls
+  std::vector<unsigned int> n_face_calls;
+  compare("make_flux_sparsity_pattern with face couplings",
+          dof_dg.n_dofs(),
+          [&](auto &sparsity) {
+            unsigned int n_calls = 0;
+            DoFTools::make_flux_sparsity_pattern(
+              dof_dg,
+              sparsity,
+              no_constraints,
+              true,
+              cell_mask,
+              cell_mask,
+              numbers::invalid_subdomain_id,
+              [&](const typename DoFHandler<dim>::active_cell_iterator &,
+                  const unsigned int) {
+                ++n_calls;
+                return true;
+              });
+            n_face_calls.push_back(n_calls);
+          });
+  deallog << "face coupling calls: "
+          << (std::all_of(n_face_calls.begin(),
+                          n_face_calls.end(),
+                          [&](const unsigned int n) {
+                            return n > 0 && n == n_face_calls[0];
+                          }) ?
+                "ok" :
+                "failed")
+          << std::endl;
+
+  FESystem<dim>   fe_system(FE_Q<dim>(2), 1, FE_Q<dim>(1), 1);
+  DoFHandler<dim> dof_system(tria);
+  dof_system.distribute_dofs(fe_system);
+
+  AffineConstraints<double> system_constraints;
+  DoFTools::make_hanging_node_constraints(dof_system, system_constraints);
+  system_constraints.close();
+
+  compare("make_sparsity_pattern for system",
+          dof_system.n_dofs(),
+          [&](auto &sparsity) {
+            DoFTools::make_sparsity_pattern(dof_system,
+                                            sparsity,
+                                            system_constraints,
+                                            false);
+          });
+
+  Table<2, DoFTools::Coupling> mask(2, 2);
+  mask(0, 0) = DoFTools::always;
+  mask(0, 1) = DoFTools::always;
+  mask(1, 0) = DoFTools::none;
+  mask(1, 1) = DoFTools::always;
+  compare("make_sparsity_pattern for system with couplings",
+          dof_system.n_dofs(),
+          [&](auto &sparsity) {
+            DoFTools::make_sparsity_pattern(
+              dof_system, mask, sparsity, system_constraints, true);
+          });
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>();
+  check<3>();
+}